@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "watch.h"
+#include "watch_utility.h"
+#include "spiflash.h"
+
+// Binary export of the accelerometer recordings that accelerometer_data_acquisition_face writes to SPI flash.
+// Pages are sent raw, so the watch does no formatting at all; utils/motion_express_utilities/export_motion_data.py
+// requests them, checks them and decodes them to CSV or NumPy.
+//
+// The host sends a line of the form "X<first page>\n" (i.e. "X0\n" for everything). The watch answers with one frame
+// for every used page at or after the first page, then an end frame. All values are little endian.
+//
+//   page frame: 'P', uint16_t page number, 256 bytes of page data, uint32_t CRC-32 of the page number and data
+//   end frame:  'E', uint16_t number of page frames sent, uint32_t CRC-32 of that count
+//
+// If the host sees a bad CRC, it can send a new request starting at the bad page to pick up where it left off.
+
+#define MOTION_EXPORT_PAGE_SIZE 256
+#define MOTION_EXPORT_BITMAP_PAGES 4    // pages 0-3 hold the map of used pages, and are marked used themselves
+
+typedef struct __attribute__((packed)) {
+    uint8_t type;
+    uint16_t page;
+    uint8_t data[MOTION_EXPORT_PAGE_SIZE];
+    uint32_t crc;
+} motion_export_page_frame_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t type;
+    uint16_t count;
+    uint32_t crc;
+} motion_export_end_frame_t;
+
+static bool wait_for_flash_ready(void) {
+    watch_set_pin_level(A3, false);
+    bool ok = true;
+    uint8_t read_status_response[1] = {0x00};
+    do {
+        ok = spi_flash_read_command(CMD_READ_STATUS, read_status_response, 1);
+    } while ((read_status_response[0] & 0x3) != 0);
+    watch_set_pin_level(A3, true);
+    return ok;
+}
+
+static bool send_page(uint16_t page) {
+    static motion_export_page_frame_t frame;
+
+    frame.type = 'P';
+    frame.page = page;
+    wait_for_flash_ready();
+    if (!spi_flash_read_data(page * MOTION_EXPORT_PAGE_SIZE, frame.data, MOTION_EXPORT_PAGE_SIZE)) return false;
+    frame.crc = watch_utility_crc32(0, (uint8_t *)&frame.page, sizeof(frame.page) + sizeof(frame.data));
+    fwrite(&frame, sizeof(frame), 1, stdout);
+
+    return true;
+}
+
+static void export_pages(uint16_t first_page) {
+    uint8_t bitmap[MOTION_EXPORT_PAGE_SIZE];
+    motion_export_end_frame_t end_frame = {'E', 0, 0};
+
+    for(uint16_t bitmap_page = 0; bitmap_page < MOTION_EXPORT_BITMAP_PAGES; bitmap_page++) {
+        wait_for_flash_ready();
+        spi_flash_read_data(bitmap_page * MOTION_EXPORT_PAGE_SIZE, bitmap, MOTION_EXPORT_PAGE_SIZE);
+        for(uint16_t i = 0; i < MOTION_EXPORT_PAGE_SIZE; i++) {
+            // a zero bit marks a used page, MSB first. skip whole bytes of unused pages.
+            if (bitmap[i] == 0xFF) continue;
+            for(uint8_t bit = 0; bit < 8; bit++) {
+                uint16_t page = (bitmap_page * MOTION_EXPORT_PAGE_SIZE + i) * 8 + bit;
+                if (page < MOTION_EXPORT_BITMAP_PAGES || page < first_page) continue;
+                if (bitmap[i] & (0x80 >> bit)) continue;
+                if (send_page(page)) end_frame.count++;
+            }
+        }
+    }
+
+    end_frame.crc = watch_utility_crc32(0, (uint8_t *)&end_frame.count, sizeof(end_frame.count));
+    fwrite(&end_frame, sizeof(end_frame), 1, stdout);
+    fflush(stdout);
+}
+
+void app_init(void) {
+}
+
+void app_wake_from_backup(void) {
+}
+
+void app_setup(void) {
+    spi_flash_init();
+}
+
+void app_prepare_for_standby(void) {
+}
+
+void app_wake_from_standby(void) {
+}
+
+bool app_loop(void) {
+    char line[256];
+
+    int length = read(0, line, sizeof(line) - 1);
+    line[length] = 0;
+    if (line[0] == 'X') {
+        watch_set_led_green();
+        export_pages(atoi(line + 1));
+        watch_set_led_off();
+    }
+
+    return true;
+}
@@ -41,7 +41,7 @@ ifeq ($(DETECTED_OS), WINDOWS)
   MAKEFLAGS += -j $(NUMBER_OF_PROCESSORS)
 endif
 
-ifndef EMSCRIPTEN
+ifeq ($(EMSCRIPTEN)$(HOST),)
 CC = arm-none-eabi-gcc
 OBJCOPY = arm-none-eabi-objcopy
 SIZE = arm-none-eabi-size
@@ -148,6 +148,7 @@ SRCS += \
   $(TOP)/watch-library/shared/driver/lis2dw.c \
   $(TOP)/watch-library/shared/driver/spiflash.c \
   $(TOP)/watch-library/shared/watch/watch_private_buzzer.c \
+  $(TOP)/watch-library/shared/watch/watch_private_led.c \
   $(TOP)/watch-library/shared/watch/watch_private_display.c \
   $(TOP)/watch-library/shared/watch/watch_utility.c \
 
@@ -160,6 +161,33 @@ else
 CFLAGS += -W -Wall -Wextra -Wmissing-prototypes -Wmissing-declarations
 CFLAGS += -Wno-format -Wno-unused-parameter
 
+ifdef HOST
+# make HOST=1 builds the simulator natively, on a virtual clock, to replay traces without a browser (see
+# watch-library/host/main.c). the shims in host/include stand in for Emscripten's headers.
+BUILD = ./build-host
+CC = cc
+CFLAGS += -O1
+LIBS += -lm
+
+INCLUDES += \
+  -I$(TOP)/watch-library/host/include/ \
+  -I$(TOP)/watch-library/host/ \
+
+DEFINES += \
+  -D__EMSCRIPTEN__=1
+
+SRCS += \
+  $(TOP)/watch-library/host/main.c \
+  $(TOP)/watch-library/host/watch_rtc.c \
+
+else
+
+SRCS += \
+  $(TOP)/watch-library/simulator/main.c \
+  $(TOP)/watch-library/simulator/watch/watch_rtc.c \
+
+endif
+
 INCLUDES += \
   -I$(TOP)/boards/$(BOARD) \
   -I$(TOP)/watch-library/shared/driver/ \
@@ -174,8 +202,6 @@ INCLUDES += \
   -I$(TOP)/watch-library/hardware/hw/ \
 
 SRCS += \
-  $(TOP)/watch-library/simulator/main.c \
-  $(TOP)/watch-library/simulator/watch/watch_rtc.c \
   $(TOP)/watch-library/simulator/watch/watch_slcd.c \
   $(TOP)/watch-library/simulator/watch/watch_extint.c \
   $(TOP)/watch-library/simulator/watch/watch_led.c \
@@ -188,9 +214,16 @@ SRCS += \
   $(TOP)/watch-library/simulator/watch/watch_storage.c \
   $(TOP)/watch-library/simulator/watch/watch_deepsleep.c \
   $(TOP)/watch-library/simulator/watch/watch_private.c \
+  $(TOP)/watch-library/simulator/watch/watch_sim_bus.c \
+  $(TOP)/watch-library/simulator/watch/watch_sim_lis2dw.c \
+  $(TOP)/watch-library/simulator/watch/watch_sim_flash.c \
+  $(TOP)/watch-library/simulator/watch/watch_trace.c \
   $(TOP)/watch-library/simulator/watch/watch.c \
   $(TOP)/watch-library/shared/driver/thermistor_driver.c \
+  $(TOP)/watch-library/shared/driver/lis2dw.c \
+  $(TOP)/watch-library/shared/driver/spiflash.c \
   $(TOP)/watch-library/shared/watch/watch_private_buzzer.c \
+  $(TOP)/watch-library/shared/watch/watch_private_led.c \
   $(TOP)/watch-library/shared/watch/watch_private_display.c \
   $(TOP)/watch-library/shared/watch/watch_utility.c \
 
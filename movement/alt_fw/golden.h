@@ -0,0 +1,68 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_CONFIG_H_
+#define MOVEMENT_CONFIG_H_
+
+#include "movement_faces.h"
+
+// every face, for utils/golden_faces. it finds each one by how many times it has to press MODE to get there, so add
+// new faces before the settings at the end, and regenerate the goldens when you do.
+const watch_face_t watch_faces[] = {
+    simple_clock_face,
+    world_clock_face,
+    beats_face,
+    mars_time_face,
+    pulsometer_face,
+    day_one_face,
+    stopwatch_face,
+    totp_face,
+    sunrise_sunset_face,
+    countdown_face,
+    counter_face,
+    blinky_face,
+    moon_phase_face,
+    orrery_face,
+    astronomy_face,
+    tomato_face,
+    probability_face,
+    wake_face,
+    thermistor_readout_face,
+    thermistor_logging_face,
+    thermistor_testing_face,
+    accelerometer_data_acquisition_face,
+    activity_face,
+    character_set_face,
+    voltage_face,
+    lis2dw_logging_face,
+    demo_face,
+    hello_there_face,
+
+    preferences_face,
+    set_time_face,
+};
+
+#define MOVEMENT_NUM_FACES (sizeof(watch_faces) / sizeof(watch_face_t))
+
+#endif // MOVEMENT_CONFIG_H_
@@ -0,0 +1,186 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "battery.h"
+#include "watch_utility.h"
+
+#define BATTERY_SAMPLE_INTERVAL 10          // minutes between samples
+#define BATTERY_MAX_DEFERRALS 5             // minutes we'll wait for the cell to recover before correcting instead
+#define BATTERY_LPEFF_ENABLE 2700           // millivolts; same threshold _watch_init uses at boot...
+#define BATTERY_LPEFF_DISABLE 2600          // ...with some hysteresis on the way down, where the brownout detector is.
+
+typedef struct {
+    uint16_t millivolts;
+    uint8_t percent;
+    uint8_t resistance;     // internal resistance in ohms; it climbs steeply as the cell runs down.
+} battery_curve_point_t;
+
+// CR2016 at a few microamps, from the manufacturers' discharge curves: flat around 3 V for most of its life,
+// then falling off a cliff. Highest voltage first.
+static const battery_curve_point_t battery_curve[] = {
+    { 3000, 100,  30 },
+    { 2950,  90,  30 },
+    { 2900,  80,  35 },
+    { 2850,  65,  40 },
+    { 2800,  50,  45 },
+    { 2750,  35,  55 },
+    { 2700,  25,  65 },
+    { 2600,  15,  80 },
+    { 2500,  10, 100 },
+    { 2400,   6, 130 },
+    { 2200,   2, 180 },
+    { 2000,   0, 250 },
+};
+
+#define BATTERY_CURVE_LENGTH (sizeof(battery_curve) / sizeof(battery_curve[0]))
+
+typedef struct {
+    uint16_t microamps;     // rough draw while on
+    uint8_t recovery;       // seconds for the cell to bounce back once it's off
+} battery_load_profile_t;
+
+static const battery_load_profile_t battery_load_profiles[BATTERY_NUM_LOADS] = {
+    [BATTERY_LOAD_LED] = { 3000, 30 },
+    [BATTERY_LOAD_BUZZER] = { 1000, 10 },
+    [BATTERY_LOAD_ADC] = { 300, 2 },
+};
+
+static struct {
+    uint32_t load_ends[BATTERY_NUM_LOADS];  // unix time each load stops drawing current; 0 if never seen
+    uint32_t filtered;                      // smoothed millivolts, times 16
+    uint8_t minutes_until_sample;
+    uint8_t deferrals;
+    bool valid;
+} battery_state;
+
+static inline uint32_t _battery_now(void) {
+    return watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), 0);
+}
+
+static inline uint16_t _battery_filtered_millivolts(void) {
+    return battery_state.filtered >> 4;
+}
+
+// finds the curve segment the voltage falls in, returning the index of its upper end, or -1 above the curve.
+static int8_t _battery_curve_segment(uint16_t millivolts) {
+    for(uint8_t i = 0; i < BATTERY_CURVE_LENGTH; i++) {
+        if (millivolts >= battery_curve[i].millivolts) return i - 1;
+    }
+    return BATTERY_CURVE_LENGTH - 1;
+}
+
+static uint8_t _battery_interpolate(uint16_t millivolts, bool resistance) {
+    int8_t i = _battery_curve_segment(millivolts);
+    if (i < 0) return resistance ? battery_curve[0].resistance : battery_curve[0].percent;
+    if (i == BATTERY_CURVE_LENGTH - 1) return resistance ? battery_curve[i].resistance : battery_curve[i].percent;
+
+    const battery_curve_point_t *upper = &battery_curve[i];
+    const battery_curve_point_t *lower = &battery_curve[i + 1];
+    int32_t from = resistance ? upper->resistance : upper->percent;
+    int32_t to = resistance ? lower->resistance : lower->percent;
+    int32_t span = upper->millivolts - lower->millivolts;
+    return from + (to - from) * (upper->millivolts - millivolts) / span;
+}
+
+// how far the loads have pulled the cell down right now, in millivolts. a load that just stopped still counts,
+// tapering off over its recovery time.
+static uint16_t _battery_sag(uint32_t now) {
+    uint32_t ohms = battery_state.valid ? _battery_interpolate(_battery_filtered_millivolts(), true) : battery_curve[0].resistance;
+    uint32_t microvolts = 0;
+
+    for(uint8_t i = 0; i < BATTERY_NUM_LOADS; i++) {
+        uint32_t end = battery_state.load_ends[i];
+        uint32_t recovery = battery_load_profiles[i].recovery;
+        // the buzzer's state we can check for ourselves, in case a face played something without telling us.
+        if (i == BATTERY_LOAD_BUZZER && watch_buzzer_is_playing()) end = now + 1;
+        if (end == 0 || now >= end + recovery) continue;
+
+        uint32_t remaining = now < end ? recovery : end + recovery - now;
+        microvolts += battery_load_profiles[i].microamps * ohms * remaining / recovery;
+    }
+
+    return microvolts / 1000;
+}
+
+static void _battery_sample(uint32_t now) {
+    watch_adc_read_t read = {
+        .pin = WATCH_ADC_VCC,
+        .samples = 16,
+    };
+    watch_enable_adc();
+    watch_adc_read(&read, 1);
+    watch_disable_adc();
+
+    uint32_t millivolts = read.result + _battery_sag(now);
+    if (battery_state.valid) {
+        // an exponential moving average with a weight of 1/4; a coin cell only moves a few millivolts a day.
+        battery_state.filtered += ((int32_t)(millivolts << 4) - (int32_t)battery_state.filtered) / 4;
+    } else {
+        battery_state.filtered = millivolts << 4;
+        battery_state.valid = true;
+    }
+
+    battery_state.deferrals = 0;
+    battery_state.minutes_until_sample = BATTERY_SAMPLE_INTERVAL - 1;
+
+    uint16_t filtered = _battery_filtered_millivolts();
+    bool lpeff = watch_get_low_power_efficiency();
+    if (!lpeff && filtered >= BATTERY_LPEFF_ENABLE) watch_set_low_power_efficiency(true);
+    else if (lpeff && filtered < BATTERY_LPEFF_DISABLE) watch_set_low_power_efficiency(false);
+}
+
+void battery_handle_background_task(void) {
+    if (battery_state.valid && battery_state.minutes_until_sample) {
+        battery_state.minutes_until_sample--;
+        return;
+    }
+
+    uint32_t now = _battery_now();
+    // a sample taken under load reads low, so wait a minute for things to settle if we can.
+    if (battery_state.valid && _battery_sag(now) && battery_state.deferrals < BATTERY_MAX_DEFERRALS) {
+        battery_state.deferrals++;
+        return;
+    }
+    _battery_sample(now);
+}
+
+void battery_note_load(battery_load_t load, uint32_t duration_ms) {
+    if (load >= BATTERY_NUM_LOADS) return;
+    // "until further notice" stops short of the end of time, so adding the recovery time can't wrap around.
+    if (duration_ms == UINT32_MAX) battery_state.load_ends[load] = UINT32_MAX - UINT8_MAX;
+    else battery_state.load_ends[load] = _battery_now() + (duration_ms + 999) / 1000;
+}
+
+uint16_t battery_get_millivolts(void) {
+    if (!battery_state.valid) _battery_sample(_battery_now());
+    return _battery_filtered_millivolts();
+}
+
+uint8_t battery_get_percent(void) {
+    return _battery_interpolate(battery_get_millivolts(), false);
+}
+
+bool battery_is_low(void) {
+    return battery_get_millivolts() < BATTERY_LOW_MILLIVOLTS;
+}
@@ -0,0 +1,74 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BATTERY_H_
+#define BATTERY_H_
+#include <stdio.h>
+#include <stdbool.h>
+#include "watch.h"
+
+// Movement's battery service samples VCC every few minutes in the background, so faces can show the battery level
+// without turning on the ADC themselves. A coin cell's voltage sags under load and takes a while to recover, so
+// Movement reports when it lights the LED or sounds the buzzer, and faces can report their own analog sensors; the
+// service puts off sampling until the cell has recovered, or corrects for the sag if it can't wait any longer.
+// Samples are smoothed, mapped to a percentage with a CR2016 discharge curve, and used to keep the regulator's
+// low power efficiency mode on for as long as the battery can take it.
+
+#define BATTERY_LOW_MILLIVOLTS 2200     // maybe 5% left in a CR2016; the clock faces show LAP below this.
+
+typedef enum {
+    BATTERY_LOAD_LED = 0,       // the LED, lit by movement_illuminate_led or a face
+    BATTERY_LOAD_BUZZER,        // the piezo buzzer
+    BATTERY_LOAD_ADC,           // an analog sensor circuit, like the thermistor's divider
+    BATTERY_NUM_LOADS
+} battery_load_t;
+
+/** @brief Samples the battery if one is due. Movement calls this once a minute, before any face's background task,
+  *        so you should not need to call it yourself.
+  */
+void battery_handle_background_task(void);
+
+/** @brief Tells the battery service that something is drawing current, so it doesn't mistake the sag for a drained
+  *        battery. Movement reports the LED and its own sounds; call this if your face drives a load on its own.
+  * @param load What is drawing current.
+  * @param duration_ms How much longer it will keep drawing current, or 0 if it already stopped. UINT32_MAX means
+  *                    until further notice; report the load again with the real duration once you know it.
+  */
+void battery_note_load(battery_load_t load, uint32_t duration_ms);
+
+/** @brief Gets the smoothed battery voltage. The first call after boot samples the battery right away.
+  * @return The battery voltage in millivolts (i.e. 3000 mV == 3.0 V).
+  */
+uint16_t battery_get_millivolts(void);
+
+/** @brief Gets the estimated state of charge.
+  * @return A percentage from 0 to 100, read off a CR2016 discharge curve.
+  */
+uint8_t battery_get_percent(void);
+
+/** @brief Returns true if the battery is below BATTERY_LOW_MILLIVOLTS and should be replaced soon.
+  */
+bool battery_is_low(void);
+
+#endif // BATTERY_H_
@@ -3,6 +3,7 @@
 #include <string.h>
 #include <peripheral_clk_config.h>
 #include "filesystem.h"
+#include "shell.h"
 #include "watch.h"
 #include "lfs.h"
 #include "hpl_flash.h"
@@ -53,6 +54,8 @@ static lfs_t lfs;
 static lfs_file_t file;
 static struct lfs_info info;
 
+static void filesystem_register_commands(void);
+
 static int _traverse_df_cb(void *p, lfs_block_t block) {
     (void) block;
 	uint32_t *nb = p;
@@ -114,6 +117,8 @@ static int filesystem_ls(lfs_t *lfs, const char *path) {
 bool filesystem_init(void) {
     int err = lfs_mount(&lfs, &cfg);
 
+    filesystem_register_commands();
+
     // reformat if we can't mount the filesystem
     // this should only happen on the first boot
     if (err < 0) {
@@ -191,55 +196,150 @@ bool filesystem_write_file(char *filename, char *text, int32_t length) {
     return lfs_file_close(&lfs, &file) == LFS_ERR_OK;
 }
 
-void filesystem_process_command(char *line) {
-    printf("$ %s", line);
-    char *command = strtok(line, " \n");
-    
-    if (strcmp(command, "ls") == 0) {
-        char *directory = strtok(NULL, " \n");
-        if (directory == NULL) {
-            filesystem_ls(&lfs, "/");
-        } else {
-            printf("usage: ls\n");
-        }
-    } else if (strcmp(command, "cat") == 0) {
-        char *filename = strtok(NULL, " \n");
-        if (filename == NULL) {
-            printf("usage: cat file\n");
-        } else {
-            filesystem_cat(filename);
-        }
-    } else if (strcmp(command, "df") == 0) {
-        printf("free space: %ld bytes\n", filesystem_get_free_space());
-    } else if (strcmp(command, "rm") == 0) {
-        char *filename = strtok(NULL, " \n");
-        if (filename == NULL) {
-            printf("usage: rm file\n");
-        } else {
-            filesystem_rm(filename);
-        } 
-    } else if (strcmp(command, "echo") == 0) {
-        char *text = malloc(248);
-        memset(text, 0, 248);
-        size_t pos = 0;
-        char *word = strtok(NULL, " \n");
-        while (strcmp(word, ">")) {
-            sprintf(text + pos, "%s ", word);
-            pos += strlen(word) + 1;
-            word = strtok(NULL, " \n");
-            if (word == NULL) break;
+static int filesystem_cmd_ls(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+    return filesystem_ls(&lfs, "/");
+}
+
+static int filesystem_cmd_cat(int argc, char *argv[]) {
+    (void) argc;
+    filesystem_cat(argv[1]);
+    return 0;
+}
+
+static int filesystem_cmd_df(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+    printf("free space: %ld bytes\n", filesystem_get_free_space());
+    return 0;
+}
+
+static int filesystem_cmd_rm(int argc, char *argv[]) {
+    (void) argc;
+    return filesystem_rm(argv[1]) ? 0 : 1;
+}
+
+static int filesystem_cmd_echo(int argc, char *argv[]) {
+    char text[256] = {0};
+    size_t pos = 0;
+    int i;
+
+    for(i = 1; i < argc && strcmp(argv[i], ">"); i++) {
+        pos += snprintf(text + pos, sizeof(text) - pos, i > 1 ? " %s" : "%s", argv[i]);
+        if (pos >= sizeof(text)) pos = sizeof(text) - 1;
+    }
+    // we want exactly one word after the >, and that's the file name.
+    if (i != argc - 2) {
+        printf("usage: echo text > file\n");
+        return 1;
+    }
+    char *filename = argv[argc - 1];
+    if (strchr(filename, '/') || strchr(filename, '\\')) {
+        printf("subdirectories are not supported\n");
+        return 1;
+    }
+
+    return filesystem_write_file(filename, text, strlen(text)) ? 0 : 1;
+}
+
+static void filesystem_send_error(const char *message) {
+    shell_send_frame(SHELL_FRAME_ERROR, (const uint8_t *)message, strlen(message));
+}
+
+static int filesystem_cmd_get(int argc, char *argv[]) {
+    (void) argc;
+    uint8_t buf[SHELL_MAX_PAYLOAD];
+    int32_t size = filesystem_get_file_size(argv[1]);
+
+    if (size < 0) {
+        filesystem_send_error("No such file");
+        return 1;
+    }
+    if (lfs_file_open(&lfs, &file, argv[1], LFS_O_RDONLY) < 0) {
+        filesystem_send_error("Could not open file");
+        return 1;
+    }
+
+    uint8_t size_bytes[4] = {size & 0xFF, (size >> 8) & 0xFF, (size >> 16) & 0xFF, (size >> 24) & 0xFF};
+    bool ok = shell_send_frame(SHELL_FRAME_START, size_bytes, sizeof(size_bytes));
+    while (ok && size > 0) {
+        lfs_ssize_t count = lfs_file_read(&lfs, &file, buf, min(size, SHELL_MAX_PAYLOAD));
+        if (count <= 0) {
+            ok = false;
+            break;
         }
-        text[strlen(text) - 1] = 0;
-        char *filename = strtok(NULL, " \n");
-        if (filename == NULL) {
-            printf("usage: echo text > file\n");
-        } else if (strchr(filename, '/') || strchr(filename, '\\')) {
-            printf("subdirectories are not supported\n");
+        ok = shell_send_frame(SHELL_FRAME_DATA, buf, count);
+        size -= count;
+    }
+    lfs_file_close(&lfs, &file);
+    if (ok) ok = shell_send_frame(SHELL_FRAME_END, NULL, 0);
+
+    return ok ? 0 : 1;
+}
+
+static int filesystem_cmd_put(int argc, char *argv[]) {
+    (void) argc;
+    uint8_t buf[SHELL_MAX_PAYLOAD];
+    char *filename = argv[1];
+    int32_t size = atol(argv[2]);
+    int32_t received = 0;
+    uint8_t type = 0;
+
+    if (strchr(filename, '/') || strchr(filename, '\\')) {
+        filesystem_send_error("Subdirectories are not supported");
+        return 1;
+    }
+    if (size < 0 || size > filesystem_get_free_space()) {
+        filesystem_send_error("Not enough space");
+        return 1;
+    }
+    if (lfs_file_open(&lfs, &file, filename, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) < 0) {
+        filesystem_send_error("Could not create file");
+        return 1;
+    }
+
+    // the start frame tells the host we're ready for data.
+    uint8_t size_bytes[4] = {size & 0xFF, (size >> 8) & 0xFF, (size >> 16) & 0xFF, (size >> 24) & 0xFF};
+    bool ok = shell_send_frame(SHELL_FRAME_START, size_bytes, sizeof(size_bytes));
+    while (ok) {
+        int16_t length = shell_receive_frame(&type, buf);
+        if (length < 0) {
+            ok = false;
+        } else if (type == SHELL_FRAME_DATA && received + length <= size && lfs_file_write(&lfs, &file, buf, length) == length) {
+            received += length;
+            shell_reply(SHELL_ACK);
+        } else if (type == SHELL_FRAME_END) {
+            break;
         } else {
-            filesystem_write_file(filename, text, strlen(text));
+            shell_reply(SHELL_FAIL);
+            ok = false;
         }
-        free(text);
+    }
+    // we only acknowledge the end frame once the file is safely closed.
+    ok = (lfs_file_close(&lfs, &file) == LFS_ERR_OK) && ok && received == size;
+    if (ok) {
+        shell_reply(SHELL_ACK);
     } else {
-        printf("%s: command not found\n", command);
+        if (type == SHELL_FRAME_END) shell_reply(SHELL_FAIL);
+        lfs_remove(&lfs, filename);
+    }
+
+    return ok ? 0 : 1;
+}
+
+static const shell_command_t filesystem_commands[] = {
+    { "ls", "ls", 0, 0, filesystem_cmd_ls },
+    { "cat", "cat file", 1, 1, filesystem_cmd_cat },
+    { "df", "df", 0, 0, filesystem_cmd_df },
+    { "rm", "rm file", 1, 1, filesystem_cmd_rm },
+    { "echo", "echo text > file", 2, SHELL_MAX_ARGS - 1, filesystem_cmd_echo },
+    { "get", "get file (binary; use movement_file_transfer.py)", 1, 1, filesystem_cmd_get },
+    { "put", "put file size (binary; use movement_file_transfer.py)", 2, 2, filesystem_cmd_put },
+};
+
+static void filesystem_register_commands(void) {
+    for(size_t i = 0; i < sizeof(filesystem_commands) / sizeof(shell_command_t); i++) {
+        shell_register_command(&filesystem_commands[i]);
     }
 }
@@ -28,7 +28,8 @@
 #include <stdbool.h>
 #include "watch.h"
 
-/** @brief Initializes and mounts the tiny 8kb filesystem, formatting it if need be.
+/** @brief Initializes and mounts the tiny 8kb filesystem, formatting it if need be, and adds the
+  *        file commands (ls, cat, df, rm, echo, get and put) to the USB shell.
   * @return true if the filesystem was mounted successfully.
   */
 bool filesystem_init(void);
@@ -77,9 +78,4 @@ bool filesystem_read_file(char *filename, char *buf, int32_t length);
   */
 bool filesystem_write_file(char *filename, char *text, int32_t length);
 
-/** @brief Handles the interactive file browser when Movement is plugged in to USB.
-  * @param line The command that the user typed into the serial console.
-  */
-void filesystem_process_command(char *line);
-
 #endif // FILESYSTEM_H_
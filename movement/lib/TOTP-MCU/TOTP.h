@@ -1,13 +1,34 @@
-#ifndef TOTP_H_
-#define TOTP_H_
-
-#include <inttypes.h>
-#include "time.h"
-
-void TOTP(uint8_t* hmacKey, uint8_t keyLength, uint32_t timeStep);
-void setTimezone(uint8_t timezone);
-uint32_t getCodeFromTimestamp(uint32_t timeStamp);
-uint32_t getCodeFromTimeStruct(struct tm time);
-uint32_t getCodeFromSteps(uint32_t steps);
-
-#endif // TOTP_H_
+#ifndef TOTP_H_
+#define TOTP_H_
+
+#include <inttypes.h>
+#include "time.h"
+
+typedef enum {
+    TOTP_SHA1 = 0,
+    TOTP_SHA256,
+} totp_algorithm_t;
+
+// Per-key state: the HMAC midstates after the padded key blocks, so each new
+// code only costs the two compressions over the counter and inner digest.
+// SHA-1 keys only use the first five words of each state.
+typedef struct {
+    uint32_t innerState[8];
+    uint32_t outerState[8];
+    uint32_t timeStep;
+    uint8_t digits;
+    uint8_t algorithm;
+} totp_key_context;
+
+void TOTP(uint8_t* hmacKey, uint8_t keyLength, uint32_t timeStep);
+void setTimezone(uint8_t timezone);
+uint32_t getCodeFromTimestamp(uint32_t timeStamp);
+uint32_t getCodeFromTimeStruct(struct tm time);
+uint32_t getCodeFromSteps(uint32_t steps);
+
+void initKeyContext(totp_key_context* context, const uint8_t* hmacKey, uint8_t keyLength, uint32_t timeStep);
+void initKeyContextWithOptions(totp_key_context* context, const uint8_t* hmacKey, uint8_t keyLength, uint32_t timeStep, uint8_t digits, totp_algorithm_t algorithm);
+uint32_t getCodeFromContextTimestamp(const totp_key_context* context, uint32_t timeStamp);
+uint32_t getCodeFromContextSteps(const totp_key_context* context, uint32_t steps);
+
+#endif // TOTP_H_
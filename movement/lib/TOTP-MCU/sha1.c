@@ -1,169 +1,262 @@
-#include <string.h>
-#include "sha1.h"
-
-#define SHA1_K0 0x5a827999
-#define SHA1_K20 0x6ed9eba1
-#define SHA1_K40 0x8f1bbcdc
-#define SHA1_K60 0xca62c1d6
-
-uint8_t sha1InitState[] = {
-  0x01,0x23,0x45,0x67, // H0
-  0x89,0xab,0xcd,0xef, // H1
-  0xfe,0xdc,0xba,0x98, // H2
-  0x76,0x54,0x32,0x10, // H3
-  0xf0,0xe1,0xd2,0xc3  // H4
-};
-
-union _buffer {
-  uint8_t b[BLOCK_LENGTH];
-  uint32_t w[BLOCK_LENGTH/4];
-} buffer;
-union _state {
-  uint8_t b[HASH_LENGTH];
-  uint32_t w[HASH_LENGTH/4];
-} state;
-
-uint8_t bufferOffset;
-uint32_t byteCount;
-uint8_t keyBuffer[BLOCK_LENGTH];
-uint8_t innerHash[HASH_LENGTH];
-
-void init(void) {
-  memcpy(state.b,sha1InitState,HASH_LENGTH);
-  byteCount = 0;
-  bufferOffset = 0;
-}
-
-static uint32_t rol32(uint32_t number, uint8_t bits) {
-  return ((number << bits) | (uint32_t)(number >> (32-bits)));
-}
-
-static void hashBlock(void) {
-  uint8_t i;
-  uint32_t a,b,c,d,e,t;
-
-  a=state.w[0];
-  b=state.w[1];
-  c=state.w[2];
-  d=state.w[3];
-  e=state.w[4];
-  for (i=0; i<80; i++) {
-    if (i>=16) {
-      t = buffer.w[(i+13)&15] ^ buffer.w[(i+8)&15] ^ buffer.w[(i+2)&15] ^ buffer.w[i&15];
-      buffer.w[i&15] = rol32(t,1);
-    }
-    if (i<20) {
-      t = (d ^ (b & (c ^ d))) + SHA1_K0;
-    } else if (i<40) {
-      t = (b ^ c ^ d) + SHA1_K20;
-    } else if (i<60) {
-      t = ((b & c) | (d & (b | c))) + SHA1_K40;
-    } else {
-      t = (b ^ c ^ d) + SHA1_K60;
-    }
-    t+=rol32(a,5) + e + buffer.w[i&15];
-    e=d;
-    d=c;
-    c=rol32(b,30);
-    b=a;
-    a=t;
-  }
-  state.w[0] += a;
-  state.w[1] += b;
-  state.w[2] += c;
-  state.w[3] += d;
-  state.w[4] += e;
-}
-
-static void addUncounted(uint8_t data) {
-  buffer.b[bufferOffset ^ 3] = data;
-  bufferOffset++;
-  if (bufferOffset == BLOCK_LENGTH) {
-    hashBlock();
-    bufferOffset = 0;
-  }
-}
-
-static void __write(uint8_t data) {
-  ++byteCount;
-  addUncounted(data);
-
-  return;
-}
-
-void writeArray(uint8_t *buffer, uint8_t size){
-    while (size--) {
-        __write(*buffer++);
-    }
-}
-
-static void pad(void) {
-  // Implement SHA-1 padding (fips180-2 ��5.1.1)
-
-  // Pad with 0x80 followed by 0x00 until the end of the block
-  addUncounted(0x80);
-  while (bufferOffset != 56) addUncounted(0x00);
-
-  // Append length in the last 8 bytes
-  addUncounted(0); // We're only using 32 bit lengths
-  addUncounted(0); // But SHA-1 supports 64 bit lengths
-  addUncounted(0); // So zero pad the top bits
-  addUncounted(byteCount >> 29); // Shifting to multiply by 8
-  addUncounted(byteCount >> 21); // as SHA-1 supports bitstreams as well as
-  addUncounted(byteCount >> 13); // byte.
-  addUncounted(byteCount >> 5);
-  addUncounted(byteCount << 3);
-}
-
-uint8_t* result(void) {
-  // Pad to complete the last block
-  pad();
-
-  // Swap byte order back
-  uint8_t i;
-  for (i=0; i<5; i++) {
-    uint32_t a,b;
-    a=state.w[i];
-    b=a<<24;
-    b|=(a<<8) & 0x00ff0000;
-    b|=(a>>8) & 0x0000ff00;
-    b|=a>>24;
-    state.w[i]=b;
-  }
-
-  // Return pointer to hash (20 characters)
-  return state.b;
-}
-
-#define HMAC_IPAD 0x36
-#define HMAC_OPAD 0x5c
-
-void initHmac(const uint8_t* key, uint8_t keyLength) {
-  uint8_t i;
-  memset(keyBuffer,0,BLOCK_LENGTH);
-  if (keyLength > BLOCK_LENGTH) {
-    // Hash long keys
-    init();
-    for (;keyLength--;) __write(*key++);
-    memcpy(keyBuffer,result(),HASH_LENGTH);
-  } else {
-    // Block length keys are used as is
-    memcpy(keyBuffer,key,keyLength);
-  }
-  // Start inner hash
-  init();
-  for (i=0; i<BLOCK_LENGTH; i++) {
-    __write(keyBuffer[i] ^ HMAC_IPAD);
-  }
-}
-
-uint8_t* resultHmac(void) {
-  uint8_t i;
-  // Complete inner hash
-  memcpy(innerHash,result(),HASH_LENGTH);
-  // Calculate outer hash
-  init();
-  for (i=0; i<BLOCK_LENGTH; i++) __write(keyBuffer[i] ^ HMAC_OPAD);
-  for (i=0; i<HASH_LENGTH; i++) __write(innerHash[i]);
-  return result();
-}
+#include <string.h>
+#include "sha1.h"
+
+#define SHA1_K0 0x5a827999
+#define SHA1_K20 0x6ed9eba1
+#define SHA1_K40 0x8f1bbcdc
+#define SHA1_K60 0xca62c1d6
+
+static const uint32_t sha1InitState[HASH_LENGTH/4] = {
+  0x67452301, // H0
+  0xefcdab89, // H1
+  0x98badcfe, // H2
+  0x10325476, // H3
+  0xc3d2e1f0  // H4
+};
+
+// The schedule words are kept in native order: addUncounted stores byte n of
+// the block at n ^ 3, and whole blocks are byte swapped as they're loaded, so
+// each word reads big-endian. Both only work on a little-endian machine, as the
+// Cortex-M0+ and the hosts the simulator builds on are.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "sha1.c assumes a little-endian target"
+#endif
+
+union _buffer {
+  uint8_t b[BLOCK_LENGTH];
+  uint32_t w[BLOCK_LENGTH/4];
+} buffer;
+union _state {
+  uint8_t b[HASH_LENGTH];
+  uint32_t w[HASH_LENGTH/4];
+} state;
+
+uint8_t bufferOffset;
+uint32_t byteCount;
+uint8_t keyBuffer[BLOCK_LENGTH];
+uint8_t innerHash[HASH_LENGTH];
+
+void init(void) {
+  memcpy(state.w,sha1InitState,HASH_LENGTH);
+  byteCount = 0;
+  bufferOffset = 0;
+}
+
+#define ROL32(number, bits) (((number) << (bits)) | ((number) >> (32 - (bits))))
+
+static inline uint32_t loadBigEndian(const uint8_t* data) {
+  return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+}
+
+// Message schedule, kept as a rolling window of 16 words in the block buffer
+#define W(i) (buffer.w[(i) & 15])
+#define SCHEDULE(i) (W(i) = ROL32(W((i)+13) ^ W((i)+8) ^ W((i)+2) ^ W(i), 1))
+
+#define F0(b,c,d) ((d) ^ ((b) & ((c) ^ (d))))
+#define F1(b,c,d) ((b) ^ (c) ^ (d))
+#define F2(b,c,d) (((b) & (c)) | ((d) & ((b) | (c))))
+
+// One round. Rather than shuffling a..e after every round, the callers rotate
+// the argument names, so five consecutive rounds leave the variables in place.
+#define ROUND(a,b,c,d,e,f,k,w) \
+  e += ROL32(a,5) + f(b,c,d) + (k) + (w); \
+  b = ROL32(b,30);
+
+#define ROUNDS5(f,k,i,w) \
+  ROUND(a,b,c,d,e,f,k,w(i)); \
+  ROUND(e,a,b,c,d,f,k,w((i)+1)); \
+  ROUND(d,e,a,b,c,f,k,w((i)+2)); \
+  ROUND(c,d,e,a,b,f,k,w((i)+3)); \
+  ROUND(b,c,d,e,a,f,k,w((i)+4));
+
+static void hashBlock(void) {
+  uint8_t i;
+  uint32_t a,b,c,d,e;
+
+  a=state.w[0];
+  b=state.w[1];
+  c=state.w[2];
+  d=state.w[3];
+  e=state.w[4];
+
+  // Rounds 0-15 use the block as loaded, the rest extend the schedule in place.
+  // The outer loops are kept so the code still fits comfortably in flash.
+  for (i=0; i<15; i+=5) {
+    ROUNDS5(F0, SHA1_K0, i, W);
+  }
+  ROUND(a,b,c,d,e,F0,SHA1_K0,W(15));
+  ROUND(e,a,b,c,d,F0,SHA1_K0,SCHEDULE(16));
+  ROUND(d,e,a,b,c,F0,SHA1_K0,SCHEDULE(17));
+  ROUND(c,d,e,a,b,F0,SHA1_K0,SCHEDULE(18));
+  ROUND(b,c,d,e,a,F0,SHA1_K0,SCHEDULE(19));
+  for (i=20; i<40; i+=5) {
+    ROUNDS5(F1, SHA1_K20, i, SCHEDULE);
+  }
+  for (i=40; i<60; i+=5) {
+    ROUNDS5(F2, SHA1_K40, i, SCHEDULE);
+  }
+  for (i=60; i<80; i+=5) {
+    ROUNDS5(F1, SHA1_K60, i, SCHEDULE);
+  }
+
+  state.w[0] += a;
+  state.w[1] += b;
+  state.w[2] += c;
+  state.w[3] += d;
+  state.w[4] += e;
+}
+
+static void addUncounted(uint8_t data) {
+  buffer.b[bufferOffset ^ 3] = data;
+  bufferOffset++;
+  if (bufferOffset == BLOCK_LENGTH) {
+    hashBlock();
+    bufferOffset = 0;
+  }
+}
+
+void writeBytes(const uint8_t* data, uint32_t length) {
+  byteCount += length;
+
+  // Writes that don't fill the block (a byte at a time, or a TOTP counter)
+  // only need buffering; keep them off the block path below
+  if (length < (uint32_t)(BLOCK_LENGTH - bufferOffset)) {
+    uint8_t offset = bufferOffset;
+    while (length--) {
+      buffer.b[offset ^ 3] = *data++;
+      offset++;
+    }
+    bufferOffset = offset;
+    return;
+  }
+
+  // Top up a partially filled block byte by byte
+  while (bufferOffset && length) {
+    addUncounted(*data++);
+    length--;
+  }
+
+  // Then ingest whole blocks straight into the schedule, a word at a time
+  while (length >= BLOCK_LENGTH) {
+    uint8_t i;
+    if (((uintptr_t)data & 3) == 0) {
+      const uint32_t* words = (const uint32_t*)data;
+      for (i=0; i<BLOCK_LENGTH/4; i++) buffer.w[i] = __builtin_bswap32(words[i]);
+    } else {
+      for (i=0; i<BLOCK_LENGTH/4; i++) buffer.w[i] = loadBigEndian(data + i * 4);
+    }
+    hashBlock();
+    data += BLOCK_LENGTH;
+    length -= BLOCK_LENGTH;
+  }
+
+  // The tail starts at offset 0, so it can be buffered word by word as well
+  while (length >= 4) {
+    buffer.w[bufferOffset >> 2] = loadBigEndian(data);
+    bufferOffset += 4;
+    data += 4;
+    length -= 4;
+  }
+  while (length--) addUncounted(*data++);
+}
+
+void writeArray(uint8_t *buffer, uint8_t size){
+  writeBytes(buffer, size);
+}
+
+static void pad(void) {
+  // Implement SHA-1 padding (fips180-2 5.1.1)
+
+  // Pad with 0x80 followed by 0x00 until the end of the block
+  addUncounted(0x80);
+  if (bufferOffset > 56) {
+    while (bufferOffset) addUncounted(0x00);
+  }
+  while (bufferOffset & 3) addUncounted(0x00);
+  while (bufferOffset < 56) {
+    buffer.w[bufferOffset >> 2] = 0;
+    bufferOffset += 4;
+  }
+
+  // Append length in the last 8 bytes. We're only using 32 bit lengths, but
+  // SHA-1 supports 64 bit lengths (in bits, hence the multiplication by 8).
+  buffer.w[14] = byteCount >> 29;
+  buffer.w[15] = byteCount << 3;
+  hashBlock();
+  bufferOffset = 0;
+}
+
+uint8_t* result(void) {
+  // Pad to complete the last block
+  pad();
+
+  // Swap byte order back
+  uint8_t i;
+  for (i=0; i<5; i++) {
+    state.w[i] = __builtin_bswap32(state.w[i]);
+  }
+
+  // Return pointer to hash (20 characters)
+  return state.b;
+}
+
+#define HMAC_IPAD 0x36
+#define HMAC_OPAD 0x5c
+
+static void initPaddedKeyBlock(uint8_t pad) {
+  uint8_t i;
+  uint32_t padWord = pad * 0x01010101UL;
+  init();
+  for (i=0; i<BLOCK_LENGTH/4; i++) {
+    buffer.w[i] = loadBigEndian(keyBuffer + i * 4) ^ padWord;
+  }
+  hashBlock();
+  byteCount = BLOCK_LENGTH;
+}
+
+void initHmac(const uint8_t* key, uint8_t keyLength) {
+  memset(keyBuffer,0,BLOCK_LENGTH);
+  if (keyLength > BLOCK_LENGTH) {
+    // Hash long keys
+    init();
+    writeBytes(key, keyLength);
+    memcpy(keyBuffer,result(),HASH_LENGTH);
+  } else {
+    // Block length keys are used as is
+    memcpy(keyBuffer,key,keyLength);
+  }
+  // Start inner hash
+  initPaddedKeyBlock(HMAC_IPAD);
+}
+
+void initHmacMidstates(const uint8_t* key, uint8_t keyLength, uint32_t* innerState, uint32_t* outerState) {
+  // initHmac leaves the state right after the inner padded key block
+  initHmac(key, keyLength);
+  memcpy(innerState,state.w,HASH_LENGTH);
+  initPaddedKeyBlock(HMAC_OPAD);
+  memcpy(outerState,state.w,HASH_LENGTH);
+}
+
+void initHmacFromMidstate(const uint32_t* innerState) {
+  memcpy(state.w,innerState,HASH_LENGTH);
+  byteCount = BLOCK_LENGTH;
+  bufferOffset = 0;
+}
+
+uint8_t* resultHmacFromMidstate(const uint32_t* outerState) {
+  // Complete inner hash
+  memcpy(innerHash,result(),HASH_LENGTH);
+  // Resume the outer hash after its padded key block
+  initHmacFromMidstate(outerState);
+  writeBytes(innerHash, HASH_LENGTH);
+  return result();
+}
+
+uint8_t* resultHmac(void) {
+  // Complete inner hash
+  memcpy(innerHash,result(),HASH_LENGTH);
+  // Calculate outer hash
+  initPaddedKeyBlock(HMAC_OPAD);
+  writeBytes(innerHash, HASH_LENGTH);
+  return result();
+}
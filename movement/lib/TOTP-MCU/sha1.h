@@ -1,15 +1,25 @@
-#ifndef SHA1_H_
-#define SHA1_H_
-
-#include <inttypes.h>
-
-#define HASH_LENGTH 20
-#define BLOCK_LENGTH 64
-
-void init(void);
-void initHmac(const uint8_t* secret, uint8_t secretLength);
-uint8_t* result(void);
-uint8_t* resultHmac(void);
-void writeArray(uint8_t *buffer, uint8_t size);
-
-#endif // SHA1_H
+#ifndef SHA1_H_
+#define SHA1_H_
+
+#include <inttypes.h>
+
+#define HASH_LENGTH 20
+#define BLOCK_LENGTH 64
+
+void init(void);
+void initHmac(const uint8_t* secret, uint8_t secretLength);
+uint8_t* result(void);
+uint8_t* resultHmac(void);
+void writeArray(uint8_t *buffer, uint8_t size);
+// Streaming input: whole blocks are loaded a word at a time (faster still
+// when data is 4-byte aligned), only a partial block is buffered per byte.
+void writeBytes(const uint8_t* data, uint32_t length);
+
+// HMAC midstates: the SHA-1 state after hashing the key ^ ipad and key ^ opad
+// blocks. They depend only on the key, so they can be computed once and reused
+// for every message, saving two of the four compressions per short HMAC.
+void initHmacMidstates(const uint8_t* secret, uint8_t secretLength, uint32_t* innerState, uint32_t* outerState);
+void initHmacFromMidstate(const uint32_t* innerState);
+uint8_t* resultHmacFromMidstate(const uint32_t* outerState);
+
+#endif // SHA1_H
@@ -0,0 +1,175 @@
+#include <string.h>
+#include "sha256.h"
+
+static const uint32_t sha256InitState[SHA256_HASH_LENGTH/4] = {
+  0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+  0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static const uint32_t sha256K[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+// Kept separate from the SHA-1 globals so both can be linked into one image.
+static union {
+  uint8_t b[SHA256_BLOCK_LENGTH];
+  uint32_t w[SHA256_BLOCK_LENGTH/4];
+} sha256Buffer;
+static union {
+  uint8_t b[SHA256_HASH_LENGTH];
+  uint32_t w[SHA256_HASH_LENGTH/4];
+} sha256State;
+
+static uint8_t sha256BufferOffset;
+static uint32_t sha256ByteCount;
+
+#define ROR32(number, bits) (((number) >> (bits)) | ((number) << (32 - (bits))))
+
+#define S0(x) (ROR32(x,2) ^ ROR32(x,13) ^ ROR32(x,22))
+#define S1(x) (ROR32(x,6) ^ ROR32(x,11) ^ ROR32(x,25))
+#define G0(x) (ROR32(x,7) ^ ROR32(x,18) ^ ((x) >> 3))
+#define G1(x) (ROR32(x,17) ^ ROR32(x,19) ^ ((x) >> 10))
+#define CH(e,f,g) ((g) ^ ((e) & ((f) ^ (g))))
+#define MAJ(a,b,c) (((a) & (b)) | ((c) & ((a) | (b))))
+
+static uint32_t loadBigEndian(const uint8_t* data) {
+  return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+}
+
+static void sha256HashBlock(void) {
+  uint8_t i;
+  uint32_t a,b,c,d,e,f,g,h,t1,t2;
+  uint32_t* w = sha256Buffer.w;
+
+  a=sha256State.w[0];
+  b=sha256State.w[1];
+  c=sha256State.w[2];
+  d=sha256State.w[3];
+  e=sha256State.w[4];
+  f=sha256State.w[5];
+  g=sha256State.w[6];
+  h=sha256State.w[7];
+  for (i=0; i<64; i++) {
+    // 16 word rolling message schedule, as in sha1.c
+    if (i>=16) {
+      w[i&15] += G1(w[(i+14)&15]) + w[(i+9)&15] + G0(w[(i+1)&15]);
+    }
+    t1 = h + S1(e) + CH(e,f,g) + sha256K[i] + w[i&15];
+    t2 = S0(a) + MAJ(a,b,c);
+    h=g;
+    g=f;
+    f=e;
+    e=d+t1;
+    d=c;
+    c=b;
+    b=a;
+    a=t1+t2;
+  }
+  sha256State.w[0] += a;
+  sha256State.w[1] += b;
+  sha256State.w[2] += c;
+  sha256State.w[3] += d;
+  sha256State.w[4] += e;
+  sha256State.w[5] += f;
+  sha256State.w[6] += g;
+  sha256State.w[7] += h;
+}
+
+static void sha256AddUncounted(uint8_t data) {
+  sha256Buffer.b[sha256BufferOffset ^ 3] = data;
+  sha256BufferOffset++;
+  if (sha256BufferOffset == SHA256_BLOCK_LENGTH) {
+    sha256HashBlock();
+    sha256BufferOffset = 0;
+  }
+}
+
+void sha256Init(void) {
+  memcpy(sha256State.w,sha256InitState,SHA256_HASH_LENGTH);
+  sha256ByteCount = 0;
+  sha256BufferOffset = 0;
+}
+
+void sha256WriteBytes(const uint8_t* data, uint32_t length) {
+  sha256ByteCount += length;
+  while (sha256BufferOffset && length) {
+    sha256AddUncounted(*data++);
+    length--;
+  }
+  while (length >= SHA256_BLOCK_LENGTH) {
+    uint8_t i;
+    for (i=0; i<SHA256_BLOCK_LENGTH/4; i++) sha256Buffer.w[i] = loadBigEndian(data + i * 4);
+    sha256HashBlock();
+    data += SHA256_BLOCK_LENGTH;
+    length -= SHA256_BLOCK_LENGTH;
+  }
+  while (length--) sha256AddUncounted(*data++);
+}
+
+uint8_t* sha256Result(void) {
+  uint8_t i;
+  // Same padding as SHA-1 (fips180-2 5.1.1), with 32 bit lengths
+  sha256AddUncounted(0x80);
+  while (sha256BufferOffset != 56) sha256AddUncounted(0x00);
+  sha256Buffer.w[14] = sha256ByteCount >> 29;
+  sha256Buffer.w[15] = sha256ByteCount << 3;
+  sha256HashBlock();
+  sha256BufferOffset = 0;
+
+  for (i=0; i<8; i++) {
+    sha256State.w[i] = __builtin_bswap32(sha256State.w[i]);
+  }
+  return sha256State.b;
+}
+
+#define HMAC_IPAD 0x36
+#define HMAC_OPAD 0x5c
+
+static void sha256PaddedKeyMidstate(const uint8_t* keyBlock, uint8_t pad, uint32_t* midstate) {
+  uint8_t i;
+  uint32_t padWord = pad * 0x01010101UL;
+  sha256Init();
+  for (i=0; i<SHA256_BLOCK_LENGTH/4; i++) {
+    sha256Buffer.w[i] = loadBigEndian(keyBlock + i * 4) ^ padWord;
+  }
+  sha256HashBlock();
+  memcpy(midstate,sha256State.w,SHA256_HASH_LENGTH);
+}
+
+void sha256HmacMidstates(const uint8_t* key, uint8_t keyLength, uint32_t* innerState, uint32_t* outerState) {
+  uint8_t keyBlock[SHA256_BLOCK_LENGTH];
+  memset(keyBlock,0,SHA256_BLOCK_LENGTH);
+  if (keyLength > SHA256_BLOCK_LENGTH) {
+    // Hash long keys
+    sha256Init();
+    sha256WriteBytes(key, keyLength);
+    memcpy(keyBlock,sha256Result(),SHA256_HASH_LENGTH);
+  } else {
+    memcpy(keyBlock,key,keyLength);
+  }
+  sha256PaddedKeyMidstate(keyBlock, HMAC_IPAD, innerState);
+  sha256PaddedKeyMidstate(keyBlock, HMAC_OPAD, outerState);
+}
+
+uint8_t* sha256HmacFromMidstates(const uint32_t* innerState, const uint32_t* outerState, const uint8_t* message, uint8_t length) {
+  uint8_t innerHash[SHA256_HASH_LENGTH];
+  // Inner hash, resumed after its padded key block
+  memcpy(sha256State.w,innerState,SHA256_HASH_LENGTH);
+  sha256ByteCount = SHA256_BLOCK_LENGTH;
+  sha256BufferOffset = 0;
+  sha256WriteBytes(message, length);
+  memcpy(innerHash,sha256Result(),SHA256_HASH_LENGTH);
+  // Outer hash
+  memcpy(sha256State.w,outerState,SHA256_HASH_LENGTH);
+  sha256ByteCount = SHA256_BLOCK_LENGTH;
+  sha256BufferOffset = 0;
+  sha256WriteBytes(innerHash, SHA256_HASH_LENGTH);
+  return sha256Result();
+}
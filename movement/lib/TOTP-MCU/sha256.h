@@ -0,0 +1,18 @@
+#ifndef SHA256_H_
+#define SHA256_H_
+
+#include <inttypes.h>
+
+#define SHA256_HASH_LENGTH 32
+#define SHA256_BLOCK_LENGTH 64
+
+void sha256Init(void);
+void sha256WriteBytes(const uint8_t* data, uint32_t length);
+uint8_t* sha256Result(void);
+
+// HMAC-SHA256 midstates, as for SHA-1 in sha1.h: the state after hashing the
+// key ^ ipad and key ^ opad blocks, computed once per key.
+void sha256HmacMidstates(const uint8_t* secret, uint8_t secretLength, uint32_t* innerState, uint32_t* outerState);
+uint8_t* sha256HmacFromMidstates(const uint32_t* innerState, const uint32_t* outerState, const uint8_t* message, uint8_t length);
+
+#endif // SHA256_H_
@@ -0,0 +1,147 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "activity_classifier.h"
+
+// 2 * cos(2 * pi * k / N) in Q14, for k = 2, 3, 4, 5, 6 and 10 with N = 50.
+static const int32_t goertzel_coefficients[ACTIVITY_CLASSIFIER_NUM_BANDS] = { 31739, 30467, 28715, 26510, 23887, 10126 };
+
+static uint16_t _isqrt32(uint32_t value) {
+    uint32_t result = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > value) bit >>= 2;
+    while (bit) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return result;
+}
+
+static void _activity_classifier_reset_window(activity_classifier_t *classifier) {
+    classifier->sum = 0;
+    classifier->sum_squares = 0;
+    classifier->count = 0;
+    classifier->zero_crossings = 0;
+    memset(classifier->s1, 0, sizeof(classifier->s1));
+    memset(classifier->s2, 0, sizeof(classifier->s2));
+}
+
+void activity_classifier_init(activity_classifier_t *classifier) {
+    memset(classifier, 0, sizeof(activity_classifier_t));
+}
+
+bool activity_classifier_push_sample(activity_classifier_t *classifier, int16_t x, int16_t y, int16_t z, activity_features_t *features) {
+    // at ±16g, each square is under 2^28, so the sum of three still fits.
+    uint32_t magnitude = _isqrt32((int32_t)x * x + (int32_t)y * y + (int32_t)z * z);
+
+    if (!classifier->primed) {
+        classifier->reference = magnitude;
+        classifier->primed = true;
+    }
+
+    // work relative to the last window's mean; this keeps the sums small and takes gravity out of the Goertzel filters.
+    int32_t delta = (int32_t)magnitude - classifier->reference;
+    if (delta > 4095) delta = 4095;
+    if (delta < -4095) delta = -4095;
+
+    classifier->sum += delta;
+    classifier->sum_squares += delta * delta;
+
+    if (delta > ACTIVITY_CLASSIFIER_ZC_HYSTERESIS) {
+        if (classifier->last_sign < 0) classifier->zero_crossings++;
+        classifier->last_sign = 1;
+    } else if (delta < -ACTIVITY_CLASSIFIER_ZC_HYSTERESIS) {
+        if (classifier->last_sign > 0) classifier->zero_crossings++;
+        classifier->last_sign = -1;
+    }
+
+    // scaled down by 8 so the filter state can't overflow over a 50-sample window.
+    int32_t input = delta >> 3;
+    for(uint8_t i = 0; i < ACTIVITY_CLASSIFIER_NUM_BANDS; i++) {
+        int32_t s = input + ((goertzel_coefficients[i] * classifier->s1[i]) >> 14) - classifier->s2[i];
+        classifier->s2[i] = classifier->s1[i];
+        classifier->s1[i] = s;
+    }
+
+    if (++classifier->count < ACTIVITY_CLASSIFIER_WINDOW_LENGTH) return false;
+
+    int32_t mean_delta = classifier->sum / ACTIVITY_CLASSIFIER_WINDOW_LENGTH;
+    uint32_t mean_square = classifier->sum_squares / ACTIVITY_CLASSIFIER_WINDOW_LENGTH;
+    uint32_t mean_delta_squared = mean_delta * mean_delta;
+
+    features->mean = classifier->reference + mean_delta;
+    features->variance = mean_square > mean_delta_squared ? mean_square - mean_delta_squared : 0;
+    features->zero_crossings = classifier->zero_crossings;
+    for(uint8_t i = 0; i < ACTIVITY_CLASSIFIER_NUM_BANDS; i++) {
+        int32_t a = classifier->s1[i] >> 4;
+        int32_t b = classifier->s2[i] >> 4;
+        int32_t power = a * a + b * b - ((goertzel_coefficients[i] * a) >> 14) * b;
+        features->band_energy[i] = power > 0 ? power : 0;
+    }
+
+    classifier->reference = features->mean;
+    _activity_classifier_reset_window(classifier);
+
+    return true;
+}
+
+activity_type_t activity_classifier_classify(const activity_features_t *features) {
+    if (features->variance < ACTIVITY_CLASSIFIER_STILL_VARIANCE) return ACTIVITY_TYPE_STILL;
+
+    uint8_t dominant_band = 0;
+    uint32_t total_energy = 0;
+    for(uint8_t i = 0; i < ACTIVITY_CLASSIFIER_NUM_BANDS; i++) {
+        total_energy += features->band_energy[i];
+        if (features->band_energy[i] > features->band_energy[dominant_band]) dominant_band = i;
+    }
+    // a stride rarely lands exactly on a bin, so count the stronger neighbour of the dominant band along with it.
+    uint32_t dominant_energy = features->band_energy[dominant_band];
+    uint32_t neighbour_energy = 0;
+    if (dominant_band > 0) neighbour_energy = features->band_energy[dominant_band - 1];
+    if (dominant_band < ACTIVITY_CLASSIFIER_NUM_BANDS - 2 && features->band_energy[dominant_band + 1] > neighbour_energy) {
+        neighbour_energy = features->band_energy[dominant_band + 1];
+    }
+    dominant_energy += neighbour_energy;
+
+    // a gait is periodic: one band should stand well clear of the rest.
+    if (dominant_energy == 0 || dominant_energy < ACTIVITY_CLASSIFIER_PERIODIC_RATIO * (total_energy - dominant_energy)) {
+        return ACTIVITY_TYPE_OTHER;
+    }
+
+    // 5 Hz is too fast for a stride; that's more likely a tremor, a vehicle or a toothbrush.
+    if (dominant_band == ACTIVITY_CLASSIFIER_NUM_BANDS - 1) return ACTIVITY_TYPE_OTHER;
+
+    // running cadence is 2 Hz and up; walking can be just as vigorous at the wrist, but it's slower.
+    if (features->variance >= ACTIVITY_CLASSIFIER_RUNNING_VARIANCE && dominant_band >= 2) return ACTIVITY_TYPE_RUNNING;
+
+    return ACTIVITY_TYPE_WALKING;
+}
@@ -0,0 +1,91 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ACTIVITY_CLASSIFIER_H_
+#define ACTIVITY_CLASSIFIER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// A streaming, integer-only activity classifier for 25 Hz accelerometer data.
+// Samples are consumed one at a time and never stored: each window keeps a handful of running sums, a
+// zero-crossing counter and six Goertzel filters, so the whole state is just over 60 bytes. At the end
+// of each window, the features are handed back to the caller, who can classify them or log them.
+// The thresholds below are a starting point; tune them against recordings made with the accelerometer data
+// acquisition face (see utils/motion_express_utilities), replayed with utils/activity_replay, which also reports
+// what each window costs.
+
+#define ACTIVITY_CLASSIFIER_SAMPLE_RATE 25
+#define ACTIVITY_CLASSIFIER_WINDOW_LENGTH 50        // two seconds at 25 Hz; Goertzel bins are 0.5 Hz apart.
+#define ACTIVITY_CLASSIFIER_NUM_BANDS 6             // 1, 1.5, 2, 2.5, 3 and 5 Hz.
+#define ACTIVITY_CLASSIFIER_ZC_HYSTERESIS 40        // milli-g either side of the mean before a crossing counts.
+
+#define ACTIVITY_CLASSIFIER_STILL_VARIANCE 1600     // (40 mg)^2; below this, the wearer is not moving.
+#define ACTIVITY_CLASSIFIER_RUNNING_VARIANCE 122500 // (350 mg)^2; periodic motion above this is running.
+#define ACTIVITY_CLASSIFIER_PERIODIC_RATIO 2        // dominant band pair must beat the other bands combined by this much.
+
+typedef enum {
+    ACTIVITY_TYPE_STILL = 0,    // idle, sleeping or off-wrist
+    ACTIVITY_TYPE_WALKING,
+    ACTIVITY_TYPE_RUNNING,
+    ACTIVITY_TYPE_OTHER,        // moving, but not in a way that looks like a gait
+    ACTIVITY_TYPE_COUNT
+} activity_type_t;
+
+typedef struct {
+    int16_t mean;               // mean magnitude of acceleration over the window, in milli-g
+    uint32_t variance;          // variance of the magnitude, in milli-g squared
+    uint8_t zero_crossings;     // number of times the magnitude crossed its mean
+    uint32_t band_energy[ACTIVITY_CLASSIFIER_NUM_BANDS]; // relative energy at 1, 1.5, 2, 2.5, 3 and 5 Hz
+} activity_features_t;
+
+typedef struct {
+    int32_t sum;
+    uint32_t sum_squares;
+    int32_t s1[ACTIVITY_CLASSIFIER_NUM_BANDS];
+    int32_t s2[ACTIVITY_CLASSIFIER_NUM_BANDS];
+    int16_t reference;          // the previous window's mean, used to remove gravity from this one
+    uint8_t count;
+    uint8_t zero_crossings;
+    int8_t last_sign;
+    bool primed;
+} activity_classifier_t;
+
+/** @brief Resets the classifier to its initial state.
+  */
+void activity_classifier_init(activity_classifier_t *classifier);
+
+/** @brief Feeds one accelerometer sample into the current window.
+  * @param classifier The classifier state.
+  * @param x, y, z The acceleration on each axis, in milli-g.
+  * @param features If this sample completes a window, the window's features are written here.
+  * @return true if a window was completed and features was filled in; false otherwise.
+  */
+bool activity_classifier_push_sample(activity_classifier_t *classifier, int16_t x, int16_t y, int16_t z, activity_features_t *features);
+
+/** @brief Classifies a window of features.
+  */
+activity_type_t activity_classifier_classify(const activity_features_t *features);
+
+#endif // ACTIVITY_CLASSIFIER_H_
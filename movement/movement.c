@@ -29,8 +29,14 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "watch.h"
+#include "watch_utility.h"
 #include "filesystem.h"
 #include "movement.h"
+#include "movement_timezones.h"
+#include "sensor_hub.h"
+#include "battery.h"
+#include "shell.h"
+#include "step_counter.h"
 
 #ifndef MOVEMENT_FIRMWARE
 #include "movement_config.h"
@@ -48,6 +54,8 @@
 #include "alt_fw/the_stargazer.h"
 #elif MOVEMENT_FIRMWARE == MOVEMENT_FIRMWARE_DEEP_SPACE_NOW
 #include "alt_fw/deep_space_now.h"
+#elif MOVEMENT_FIRMWARE == MOVEMENT_FIRMWARE_GOLDEN
+#include "alt_fw/golden.h"
 #endif
 
 #if __EMSCRIPTEN__
@@ -104,6 +112,11 @@ const int16_t movement_timezone_offsets[] = {
     -120,   // 39 :  -2:00:00 (Fernando de Noronha Time)
     -60,    // 40 :  -1:00:00 (Azores Standard Time)
 };
+// zones 41 and up observe daylight saving time; see movement_timezones.h, which utils/tz_rules_compiler.py generates.
+
+#if MOVEMENT_NUM_DST_TIMEZONES != MOVEMENT_NUM_DST_ZONES
+#error "MOVEMENT_NUM_DST_TIMEZONES in movement.h doesn't match the number of zones in movement_timezones.h"
+#endif
 
 const char movement_valid_position_0_chars[] = " AaBbCcDdEeFGgHhIiJKLMNnOoPQrSTtUuWXYZ-='+\\/0123456789";
 const char movement_valid_position_1_chars[] = " ABCDEFHlJLNORTtUX-='01378";
@@ -113,7 +126,6 @@ void cb_light_btn_interrupt(void);
 void cb_alarm_btn_interrupt(void);
 void cb_alarm_btn_extwake(void);
 void cb_alarm_fired(void);
-void cb_fast_tick(void);
 void cb_tick(void);
 
 static inline void _movement_reset_inactivity_countdown(void) {
@@ -121,23 +133,9 @@ static inline void _movement_reset_inactivity_countdown(void) {
     movement_state.timeout_ticks = movement_timeout_inactivity_deadlines[movement_state.settings.bit.to_interval];
 }
 
-static inline void _movement_enable_fast_tick_if_needed(void) {
-    if (!movement_state.fast_tick_enabled) {
-        movement_state.fast_ticks = 0;
-        watch_rtc_register_periodic_callback(cb_fast_tick, 128);
-    }
-}
-
-static inline void _movement_disable_fast_tick_if_possible(void) {
-    if ((movement_state.light_ticks == -1) &&
-        (movement_state.alarm_ticks == -1) &&
-        ((movement_state.light_down_timestamp + movement_state.mode_down_timestamp + movement_state.alarm_down_timestamp) == 0)) {
-        movement_state.fast_tick_enabled = false;
-        watch_rtc_disable_periodic_callback(128);
-    }
-}
-
 static void _movement_handle_background_tasks(void) {
+    // sample the battery first, before any face's background task can put a load on it.
+    battery_handle_background_task();
     for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
         // For each face, if the watch face wants a background task...
         if (watch_faces[i].wants_background_task != NULL && watch_faces[i].wants_background_task(&movement_state.settings, watch_face_contexts[i])) {
@@ -172,28 +170,151 @@ static void _movement_handle_scheduled_tasks(void) {
     }
 }
 
-void movement_request_tick_frequency(uint8_t freq) {
-    // Movement uses the 128 Hz tick internally
-    if (freq == 128) return;
+static uint32_t _movement_year_start(uint16_t year) {
+    // good from 1970 through 2099, which covers everything the RTC can hold. the day count times 86400 passes
+    // INT32_MAX in 2038, so the multiply has to happen unsigned.
+    return (uint32_t)(365 * (year - 1970) + (year - 1969) / 4) * 86400UL;
+}
+
+static int32_t _movement_timezone_offset(uint8_t zone_index, uint32_t utc_timestamp, uint32_t *next_transition) {
+    if (next_transition != NULL) *next_transition = UINT32_MAX;
+    if (zone_index < MOVEMENT_NUM_FIXED_TIMEZONES) return movement_timezone_offsets[zone_index] * 60;
+
+    const movement_dst_zone_t *zone = &movement_dst_zones[zone_index - MOVEMENT_NUM_FIXED_TIMEZONES];
+    uint16_t year = 1970 + utc_timestamp / 31557600;
+    if (utc_timestamp < _movement_year_start(year)) year--;
+    else if (utc_timestamp >= _movement_year_start(year + 1)) year++;
+
+    // before and after the table, stay on whatever the zone observes at new year.
+    bool dst = zone->dst_at_year_start;
+    if (year < MOVEMENT_DST_FIRST_YEAR) {
+        if (next_transition != NULL) *next_transition = _movement_year_start(MOVEMENT_DST_FIRST_YEAR) + zone->transitions[0] * 900;
+    } else if (year <= MOVEMENT_DST_LAST_YEAR) {
+        const uint16_t *transitions = &zone->transitions[(year - MOVEMENT_DST_FIRST_YEAR) * 2];
+        uint32_t quarter_hours = (utc_timestamp - _movement_year_start(year)) / 900;
+        uint8_t passed = (quarter_hours >= transitions[0]) + (quarter_hours >= transitions[1]);
+        if (passed == 1) dst = !dst;
+        if (next_transition != NULL) {
+            if (passed < 2) *next_transition = _movement_year_start(year) + transitions[passed] * 900;
+            else if (year < MOVEMENT_DST_LAST_YEAR) *next_transition = _movement_year_start(year + 1) + transitions[2] * 900;
+        }
+    }
+
+    return (zone->standard_offset + (dst ? zone->dst_delta : 0)) * 60;
+}
+
+static uint32_t _movement_local_to_utc(uint8_t zone_index, watch_date_time local, bool prefer_cached_offset) {
+    if (zone_index < MOVEMENT_NUM_FIXED_TIMEZONES) {
+        return watch_utility_date_time_to_unix_time(local, movement_timezone_offsets[zone_index] * 60);
+    }
+
+    // an hour a year happens twice, so try the offset we were already on first; that keeps the clock from jumping
+    // back and forth through the repeated hour.
+    const movement_dst_zone_t *zone = &movement_dst_zones[zone_index - MOVEMENT_NUM_FIXED_TIMEZONES];
+    int32_t standard_offset = zone->standard_offset * 60;
+    int32_t candidates[3] = {movement_state.cached_timezone_offset, standard_offset, standard_offset + zone->dst_delta * 60};
+    for (uint8_t i = prefer_cached_offset ? 0 : 1; i < 3; i++) {
+        uint32_t timestamp = watch_utility_date_time_to_unix_time(local, candidates[i]);
+        if (_movement_timezone_offset(zone_index, timestamp, NULL) == candidates[i]) return timestamp;
+    }
+
+    // and an hour a year never happens; reading it as standard time lands just after the clocks went forward.
+    return watch_utility_date_time_to_unix_time(local, standard_offset);
+}
+
+// call this from the main loop only (see app_loop). the getters below only read what it leaves behind.
+static void _movement_update_time_cache(watch_date_time now) {
+    uint8_t zone = movement_state.settings.bit.time_zone;
+    uint32_t timestamp;
+
+    if (movement_state.time_cache_valid && movement_state.cached_time_zone == zone) {
+        if (now.reg == movement_state.cached_local_date_time.reg) return;
+        // every time zone is a whole number of minutes off UTC, so if only the seconds moved, that's all that moved.
+        if ((now.reg >> 6) == (movement_state.cached_local_date_time.reg >> 6)) {
+            movement_state.cached_utc_timestamp += (int8_t)(now.unit.second - movement_state.cached_local_date_time.unit.second);
+            movement_state.cached_utc_date_time.unit.second = now.unit.second;
+            movement_state.cached_local_date_time = now;
+            return;
+        }
+        // if the clock just ran past a daylight saving time transition (rather than being set across one), the RTC
+        // still reads in the old offset, and the time it reads is only valid in that offset.
+        timestamp = watch_utility_date_time_to_unix_time(now, movement_state.cached_timezone_offset);
+        uint32_t next_transition = movement_state.next_timezone_transition;
+        if (movement_state.cached_utc_timestamp >= next_transition || timestamp < next_transition || timestamp - movement_state.cached_utc_timestamp > 3600) {
+            timestamp = _movement_local_to_utc(zone, now, true);
+        }
+    } else {
+        timestamp = _movement_local_to_utc(zone, now, false);
+    }
+
+    int32_t offset = _movement_timezone_offset(zone, timestamp, &movement_state.next_timezone_transition);
+    watch_date_time local = watch_utility_date_time_from_unix_time(timestamp, offset);
+    if (local.reg != now.reg) {
+        // we crossed a transition, or someone set the clock to a time that gets skipped; either way, move the clock.
+        watch_rtc_set_date_time(local);
+    }
+    movement_state.cached_utc_timestamp = timestamp;
+    movement_state.cached_utc_date_time = watch_utility_date_time_from_unix_time(timestamp, 0);
+    movement_state.cached_local_date_time = local;
+    movement_state.cached_timezone_offset = offset;
+    movement_state.cached_time_zone = zone;
+    movement_state.time_cache_valid = true;
+}
+
+int32_t movement_get_timezone_offset(uint8_t zone_index, uint32_t utc_timestamp) {
+    return _movement_timezone_offset(zone_index, utc_timestamp, NULL);
+}
+
+int32_t movement_get_current_timezone_offset(void) {
+    return movement_state.cached_timezone_offset;
+}
+
+const char *movement_get_timezone_code(uint8_t zone_index) {
+    if (zone_index < MOVEMENT_NUM_FIXED_TIMEZONES) return NULL;
+    return movement_dst_zones[zone_index - MOVEMENT_NUM_FIXED_TIMEZONES].code;
+}
 
+uint32_t movement_get_utc_timestamp(void) {
+    return movement_state.cached_utc_timestamp;
+}
+
+watch_date_time movement_get_local_date_time(void) {
+    return movement_state.cached_local_date_time;
+}
+
+watch_date_time movement_get_utc_date_time(void) {
+    return movement_state.cached_utc_date_time;
+}
+
+void movement_request_tick_frequency(uint8_t freq) {
     // Movement requires at least a 1 Hz tick.
     // If we are asked for an invalid frequency, default back to 1 Hz.
     if (freq == 0 || __builtin_popcount(freq) != 1) freq = 1;
 
-    // disable all callbacks except the 128 Hz one
-    watch_rtc_disable_matching_periodic_callbacks(0xFE);
+    watch_rtc_disable_all_periodic_callbacks();
 
     movement_state.subsecond = 0;
     movement_state.tick_frequency = freq;
     watch_rtc_register_periodic_callback(cb_tick, freq);
 }
 
+static inline uint32_t _movement_led_duration_ms(void) {
+    return (movement_state.settings.bit.led_duration * 2 - 1) * 1000;
+}
+
 void movement_illuminate_led(void) {
     if (movement_state.settings.bit.led_duration) {
         watch_set_led_color(movement_state.settings.bit.led_red_color ? (0xF | movement_state.settings.bit.led_red_color << 4) : 0,
                             movement_state.settings.bit.led_green_color ? (0xF | movement_state.settings.bit.led_green_color << 4) : 0);
-        movement_state.light_ticks = (movement_state.settings.bit.led_duration * 2 - 1) * 128;
-        _movement_enable_fast_tick_if_needed();
+        if (watch_get_pin_level(BTN_LIGHT)) {
+            // the user is holding down the LIGHT button; stay lit until they let go (see cb_light_btn_interrupt).
+            movement_state.light_held = true;
+            watch_led_hold();
+            battery_note_load(BATTERY_LOAD_LED, UINT32_MAX);
+        } else {
+            watch_led_off_after(_movement_led_duration_ms());
+            battery_note_load(BATTERY_LOAD_LED, _movement_led_duration_ms());
+        }
     }
 }
 
@@ -231,19 +352,54 @@ void movement_request_wake() {
     _movement_reset_inactivity_countdown();
 }
 
+// Movement's sounds, in the melody format described in watch_buzzer.h. All of them count time in units of 25 ms.
+static const uint8_t movement_signal_melody[] = {
+    25, BUZZER_MELODY_OCTAVE(8),
+    BUZZER_MELODY_NOTE(0, 2),   // C8, 75 ms
+    BUZZER_MELODY_REST(3),      // 100 ms
+    BUZZER_MELODY_NOTE(0, 3),   // C8, 100 ms
+    BUZZER_MELODY_END
+};
+
+// our alarm tone is 0.375 seconds of beeps and 0.625 of silence; movement_play_alarm repeats it five times.
+static const uint8_t movement_alarm_melody[] = {
+    25, BUZZER_MELODY_OCTAVE(8),
+    BUZZER_MELODY_REPEAT_START,
+    BUZZER_MELODY_NOTE(0, 1),   // C8, 50 ms
+    BUZZER_MELODY_REST(1),      // 50 ms
+    BUZZER_MELODY_REPEAT(2),
+    BUZZER_MELODY_NOTE(0, 2),   // C8, 75 ms
+    BUZZER_MELODY_REST(8),      // 600 ms
+    BUZZER_MELODY_REST(0),      // 25 ms
+    BUZZER_MELODY_END
+};
+
+// high note for returning to watch face 0, low note for changing to any other
+static const uint8_t movement_button_melodies[][4] = {
+    {25, BUZZER_MELODY_OCTAVE(8), BUZZER_MELODY_NOTE(0, 1), BUZZER_MELODY_END},
+    {25, BUZZER_MELODY_OCTAVE(7), BUZZER_MELODY_NOTE(0, 1), BUZZER_MELODY_END},
+};
+
+static void _movement_alarm_finished(void) {
+    movement_state.alarm_playing = false;
+    battery_note_load(BATTERY_LOAD_BUZZER, 0);
+}
+
+void movement_play_melody(const uint8_t *melody) {
+    // the alarm has the buzzer to itself until it's done.
+    if (movement_state.alarm_playing) return;
+    watch_buzzer_play_melody(melody, 1, NULL);
+    battery_note_load(BATTERY_LOAD_BUZZER, 0);
+}
+
 void movement_play_signal(void) {
-    watch_buzzer_play_note(BUZZER_NOTE_C8, 75);
-    watch_buzzer_play_note(BUZZER_NOTE_REST, 100);
-    watch_buzzer_play_note(BUZZER_NOTE_C8, 100);
+    movement_play_melody(movement_signal_melody);
 }
 
 void movement_play_alarm(void) {
     movement_request_wake();
-    // alarm length: 75 ticks short of 5 seconds, or 4.414 seconds:
-    // our tone is 0.375 seconds of beep and 0.625 of silence, repeated five times.
-    // so 4.375 + a few ticks to wake up from sleep mode.
-    movement_state.alarm_ticks = 128 * 5 - 75;
-    _movement_enable_fast_tick_if_needed();
+    // the buzzer is off in low energy mode, so app_loop starts the alarm once we're awake.
+    movement_state.alarm_pending = true;
 }
 
 uint8_t movement_claim_backup_register(void) {
@@ -258,8 +414,6 @@ void app_init(void) {
     movement_state.settings.bit.button_should_sound = true;
     movement_state.settings.bit.le_interval = 1;
     movement_state.settings.bit.led_duration = 1;
-    movement_state.light_ticks = -1;
-    movement_state.alarm_ticks = -1;
     movement_state.next_available_backup_register = 4;
     _movement_reset_inactivity_countdown();
 
@@ -315,8 +469,17 @@ void app_setup(void) {
         watch_enable_buzzer();
         watch_enable_leds();
         watch_enable_display();
+        // button presses are timed with this, rather than a fast tick.
+        watch_rtc_enable_timestamp_counter();
+
+        sensor_hub_resume();
+#ifdef MOVEMENT_ENABLE_STEP_COUNTER
+        step_counter_setup();
+#endif
 
         movement_request_tick_frequency(1);
+        // the faces may ask for the time as they set up, before the first tick.
+        _movement_update_time_cache(watch_rtc_get_date_time());
 
         for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
             watch_faces[i].setup(&movement_state.settings, i, &watch_face_contexts[i]);
@@ -338,6 +501,8 @@ static void _sleep_mode_app_loop(void) {
     movement_state.needs_wake = false;
     // as long as le_mode_ticks is -1 (i.e. we are in low energy mode), we wake up here, update the screen, and go right back to sleep.
     while (movement_state.le_mode_ticks == -1) {
+        // daylight saving time transitions happen on the minute, so we'll catch them on this wake.
+        _movement_update_time_cache(watch_rtc_get_date_time());
         // we also have to handle background tasks here in the mini-runloop
         if (movement_state.needs_background_tasks_handled) _movement_handle_background_tasks();
 
@@ -348,14 +513,23 @@ static void _sleep_mode_app_loop(void) {
         if (movement_state.needs_wake) return;
         // otherwise enter sleep mode, and when the extwake handler is called, it will reset le_mode_ticks and force us out at the next loop.
         else watch_enter_sleep_mode();
+
+        // the sensor hub keeps wake-ups armed through sleep mode (see sensor_hub_suspend). if motion woke us, go back
+        // to the main loop just long enough for the sensor hub to hand the wake-up to its subscribers.
+        if (sensor_hub_has_pending_wakeup()) movement_state.le_mode_ticks = 1;
     }
 }
 
 bool app_loop(void) {
+    // keep the UTC cache moving along with the clock, once per tick and whenever a face comes up, so that everyone
+    // asking for the time on this pass finds it current. the cache is only ever touched from the main loop: its fast
+    // path is a read-modify-write that an interrupt could tear, and a daylight saving time change rewrites the RTC,
+    // which is no job for an interrupt handler.
+    if (event.event_type == EVENT_TICK || movement_state.watch_face_changed) _movement_update_time_cache(watch_rtc_get_date_time());
+
     if (movement_state.watch_face_changed) {
         if (movement_state.settings.bit.button_should_sound) {
-            // low note for nonzero case, high note for return to watch_face 0
-            watch_buzzer_play_note(movement_state.next_watch_face ? BUZZER_NOTE_C7 : BUZZER_NOTE_C8, 50);
+            movement_play_melody(movement_button_melodies[movement_state.next_watch_face ? 1 : 0]);
         }
         watch_faces[movement_state.current_watch_face].resign(&movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
         movement_state.current_watch_face = movement_state.next_watch_face;
@@ -367,30 +541,35 @@ bool app_loop(void) {
         movement_state.watch_face_changed = false;
     }
 
-    // if the LED should be off, turn it off
-    if (movement_state.light_ticks == 0) {
-        // unless the user is holding down the LIGHT button, in which case, give them more time.
-        if (watch_get_pin_level(BTN_LIGHT)) {
-            movement_state.light_ticks = 1;
-        } else {
-            watch_set_led_off();
-            movement_state.light_ticks = -1;
-            _movement_disable_fast_tick_if_possible();
-        }
-    }
-
     // handle background tasks, if the alarm handler told us we need to
     if (movement_state.needs_background_tasks_handled) _movement_handle_background_tasks();
 
     // if we have a scheduled background task, handle that here:
     if (event.event_type == EVENT_TICK && movement_state.has_scheduled_background_task) _movement_handle_scheduled_tasks();
 
+    // the sensor hub hands out accelerometer data before faces see the tick.
+    if (event.event_type == EVENT_TICK) {
+        sensor_hub_update();
+#ifdef MOVEMENT_ENABLE_STEP_COUNTER
+        step_counter_handle_tick();
+#endif
+    }
+
+#ifdef MOVEMENT_ENABLE_STEP_COUNTER
+    // the step counter can only count while we're awake; put off low energy mode until it's done.
+    if (movement_state.le_mode_ticks == 0 && step_counter_is_counting()) movement_state.le_mode_ticks = 1;
+#endif
+
     // if we have timed out of our low energy mode countdown, enter low energy mode.
     if (movement_state.le_mode_ticks == 0) {
         movement_state.le_mode_ticks = -1;
         watch_register_extwake_callback(BTN_ALARM, cb_alarm_btn_extwake, true);
         event.event_type = EVENT_NONE;
         event.subsecond = 0;
+#ifdef MOVEMENT_ENABLE_STEP_COUNTER
+        step_counter_suspend();
+#endif
+        sensor_hub_suspend();
 
         // _sleep_mode_app_loop takes over at this point and loops until le_mode_ticks is reset by the extwake handler,
         // or wake is requested using the movement_request_wake function.
@@ -431,73 +610,53 @@ bool app_loop(void) {
         }
     }
 
-    // Now that we've handled all display update tasks, handle the alarm.
-    if (movement_state.alarm_ticks >= 0) {
-        uint8_t buzzer_phase = (movement_state.alarm_ticks + 80) % 128;
-        if(buzzer_phase == 127) {
-            for(uint8_t i = 0; i < 4; i++) {
-                // TODO: This method of playing the buzzer blocks the UI while it's beeping.
-                // It might be better to time it with the fast tick.
-                watch_buzzer_play_note(BUZZER_NOTE_C8, (i != 3) ? 50 : 75);
-                if (i != 3) watch_buzzer_play_note(BUZZER_NOTE_REST, 50);
-            }
-        }
-        if (movement_state.alarm_ticks == 0) {
-            movement_state.alarm_ticks = -1;
-            _movement_disable_fast_tick_if_possible();
-        }
+    // Now that we've handled all display update tasks, start the alarm if one was requested. It plays in the background.
+    if (movement_state.alarm_pending) {
+        movement_state.alarm_pending = false;
+        movement_state.alarm_playing = true;
+        watch_buzzer_play_melody(movement_alarm_melody, 5, _movement_alarm_finished);
+        // while it plays, the battery service sees the buzzer running for itself; we report again when it's done.
+        battery_note_load(BATTERY_LOAD_BUZZER, 0);
     }
 
     // if we are plugged into USB, handle the file browser tasks
     if (watch_is_usb_enabled()) {
-        char line[256] = {0};
+        char line[256];
 #if __EMSCRIPTEN__
-        // This is a terrible hack; ideally this should be handled deeper in the watch library.
-        // Alas, emscripten treats read() as something that should pop up an input box, so I
-        // wasn't able to implement this over there. I sense that this relates to read() being
-        // the wrong way to read data from USB (like we should be using fgets or something), but
-        // until I untangle that, this will have to do.
-        char *received_data = (char*)EM_ASM_INT({
-            var len = lengthBytesUTF8(tx) + 1;
-            var s = _malloc(len);
-            stringToUTF8(tx, s, len);
-            return s;
-        });
-        memcpy(line, received_data, min(255, strlen(received_data)));
-        free(received_data);
-        EM_ASM({
-            tx = "";
-        });
+        // emscripten treats read() as something that should pop up an input box, so go straight to the watch
+        // library's hook; the simulator hands it whatever line the page (or a replayed trace) typed.
+        int length = _read(0, line, sizeof(line) - 1);
+        line[length] = 0;
 #else
-        read(0, line, 256);
+        // the console only hands us complete lines, so this is cheap while the host is quiet.
+        int length = read(0, line, sizeof(line) - 1);
+        line[length] = 0;
 #endif
-        if (strlen(line)) filesystem_process_command(line);
+        if (line[0]) shell_process_command(line);
     }
 
     event.subsecond = 0;
 
-    return can_sleep && (movement_state.light_ticks == -1) && !movement_state.is_buzzing;
+    return can_sleep;
 }
 
-static movement_event_type_t _figure_out_button_event(bool pin_level, movement_event_type_t button_down_event_type, uint8_t *down_timestamp) {
+static movement_event_type_t _figure_out_button_event(bool pin_level, movement_event_type_t button_down_event_type, uint32_t *down_timestamp) {
     // force alarm off if the user pressed a button.
-    if (movement_state.alarm_ticks) movement_state.alarm_ticks = 0;
+    if (movement_state.alarm_playing) {
+        watch_buzzer_abort_sequence();
+        movement_state.alarm_playing = false;
+        battery_note_load(BATTERY_LOAD_BUZZER, 0);
+    }
 
     if (pin_level) {
         // handle rising edge
-        _movement_enable_fast_tick_if_needed();
-        *down_timestamp = movement_state.fast_ticks + 1;
+        *down_timestamp = watch_rtc_get_timestamp();
         return button_down_event_type;
     } else {
-        // this line is hack but it handles the situation where the light button was held for more than 10 seconds.
-        // fast tick is disabled by then, and the LED would get stuck on since there's no one left decrementing light_ticks.
-        if (movement_state.light_ticks == 1) movement_state.light_ticks = 0;
-        // now that that's out of the way, handle falling edge
-        uint16_t diff = movement_state.fast_ticks - *down_timestamp;
-        *down_timestamp = 0;
-        _movement_disable_fast_tick_if_possible();
+        // handle falling edge
+        uint32_t diff = watch_rtc_get_timestamp() - *down_timestamp;
         // any press over a half second is considered a long press.
-        if (diff > 64) return button_down_event_type + 2;
+        if (diff > WATCH_RTC_TIMESTAMP_FREQUENCY / 2) return button_down_event_type + 2;
         else return button_down_event_type + 1;
     }
 }
@@ -506,6 +665,11 @@ void cb_light_btn_interrupt(void) {
     bool pin_level = watch_get_pin_level(BTN_LIGHT);
     _movement_reset_inactivity_countdown();
     event.event_type = _figure_out_button_event(pin_level, EVENT_LIGHT_BUTTON_DOWN, &movement_state.light_down_timestamp);
+    if (!pin_level && movement_state.light_held) {
+        movement_state.light_held = false;
+        watch_led_off_after(_movement_led_duration_ms());
+        battery_note_load(BATTERY_LOAD_LED, _movement_led_duration_ms());
+    }
 }
 
 void cb_mode_btn_interrupt(void) {
@@ -529,15 +693,6 @@ void cb_alarm_fired(void) {
     movement_state.needs_background_tasks_handled = true;
 }
 
-void cb_fast_tick(void) {
-    movement_state.fast_ticks++;
-    if (movement_state.light_ticks > 0) movement_state.light_ticks--;
-    if (movement_state.alarm_ticks > 0) movement_state.alarm_ticks--;
-    // this is just a fail-safe; fast tick should be disabled as soon as the button is up, the LED times out, and/or the alarm finishes.
-    // but if for whatever reason it isn't, this forces the fast tick off after 10 seconds.
-    if (movement_state.fast_ticks >= 1280) watch_rtc_disable_periodic_callback(128);
-}
-
 void cb_tick(void) {
     event.event_type = EVENT_TICK;
     watch_date_time date_time = watch_rtc_get_date_time();
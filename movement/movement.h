@@ -123,6 +123,12 @@ typedef struct {
     uint8_t subsecond;
 } movement_event_t;
 
+// time zones 0 through 40 are fixed offsets, in minutes, from movement_timezone_offsets. the rest follow daylight
+// saving time rules compiled into movement_timezones.h; use movement_get_timezone_offset to handle both.
+#define MOVEMENT_NUM_FIXED_TIMEZONES 41
+#define MOVEMENT_NUM_DST_TIMEZONES 19
+#define MOVEMENT_NUM_TIMEZONES (MOVEMENT_NUM_FIXED_TIMEZONES + MOVEMENT_NUM_DST_TIMEZONES)
+
 extern const int16_t movement_timezone_offsets[];
 extern const char movement_valid_position_0_chars[];
 extern const char movement_valid_position_1_chars[];
@@ -239,20 +245,18 @@ typedef struct {
     int16_t current_watch_face;
     int16_t next_watch_face;
     bool watch_face_changed;
-    bool fast_tick_enabled;
-    int16_t fast_ticks;
 
     // LED stuff
-    int16_t light_ticks;
+    bool light_held;
 
     // alarm stuff
-    int16_t alarm_ticks;
-    bool is_buzzing;
+    bool alarm_pending;
+    volatile bool alarm_playing;
 
     // button tracking for long press
-    uint8_t light_down_timestamp;
-    uint8_t mode_down_timestamp;
-    uint8_t alarm_down_timestamp;
+    uint32_t light_down_timestamp;
+    uint32_t mode_down_timestamp;
+    uint32_t alarm_down_timestamp;
 
     // background task handling
     bool needs_background_tasks_handled;
@@ -272,6 +276,15 @@ typedef struct {
 
     // backup register stuff
     uint8_t next_available_backup_register;
+
+    // the local time (which is what the RTC keeps) and the same moment in UTC, as of the last look at the RTC.
+    watch_date_time cached_local_date_time;
+    watch_date_time cached_utc_date_time;
+    uint32_t cached_utc_timestamp;
+    int32_t cached_timezone_offset;
+    uint32_t next_timezone_transition;
+    uint8_t cached_time_zone;
+    bool time_cache_valid;
 } movement_state_t;
 
 void movement_move_to_face(uint8_t watch_face_index);
@@ -293,6 +306,27 @@ void movement_request_wake(void);
 void movement_play_signal(void);
 void movement_play_alarm(void);
 
+// plays a melody (in the format described in watch_buzzer.h) in the background and returns right away; faces should
+// use this rather than watch_buzzer_play_note, which blocks the UI for as long as the note lasts. does nothing while
+// the alarm is playing. the melody is read as it plays, so make it static const.
+void movement_play_melody(const uint8_t *melody);
+
 uint8_t movement_claim_backup_register(void);
 
+// the current time, as a UNIX timestamp (seconds since 1970 in UTC). Movement converts the RTC's local time once per
+// tick and when a face comes up, and these getters only read the result; so they're cheap, but a face that sets the
+// RTC or the time zone sees the change from its next tick on.
+uint32_t movement_get_utc_timestamp(void);
+// the current local date and time; the same as watch_rtc_get_date_time().
+watch_date_time movement_get_local_date_time(void);
+// the current date and time in UTC, as cheap as movement_get_utc_timestamp.
+watch_date_time movement_get_utc_date_time(void);
+
+// the offset from UTC, in seconds, of a time zone at a given moment, accounting for daylight saving time.
+int32_t movement_get_timezone_offset(uint8_t zone_index, uint32_t utc_timestamp);
+// the offset from UTC, in seconds, of the watch's time zone right now.
+int32_t movement_get_current_timezone_offset(void);
+// a two letter name for a daylight saving time zone, to show in place of its offset; NULL for the fixed zones.
+const char *movement_get_timezone_code(uint8_t zone_index);
+
 #endif // MOVEMENT_H_
@@ -39,4 +39,7 @@ const watch_face_t watch_faces[] = {
 
 #define MOVEMENT_NUM_FACES (sizeof(watch_faces) / sizeof(watch_face_t))
 
+// Uncomment to count steps in the background. Requires a LIS2DW accelerometer board with INT1 wired to A0.
+// #define MOVEMENT_ENABLE_STEP_COUNTER
+
 #endif // MOVEMENT_CONFIG_H_
@@ -54,6 +54,7 @@
 #include "tomato_face.h"
 #include "probability_face.h"
 #include "wake_face.h"
+#include "activity_face.h"
 // #include "interval_face.h"
 // New includes go above this line.
 
@@ -0,0 +1,329 @@
+// Generated by utils/tz_rules_compiler.py from tzdata 2025b; do not edit.
+// Each zone has two transitions a year from 2020 through 2083, as quarter hours since January 1st, 00:00 UTC.
+
+#ifndef MOVEMENT_TIMEZONES_H_
+#define MOVEMENT_TIMEZONES_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MOVEMENT_DST_FIRST_YEAR 2020
+#define MOVEMENT_DST_LAST_YEAR 2083
+#define MOVEMENT_NUM_DST_ZONES 19
+
+typedef struct {
+    int16_t standard_offset;    // minutes east of UTC
+    uint8_t dst_delta;          // minutes added during daylight saving time
+    bool dst_at_year_start;     // true south of the equator, where summer spans the new year
+    char code[3];               // shown on the watch in place of the offset
+    const uint16_t *transitions;
+} movement_dst_zone_t;
+
+// America/New_York (US Eastern)
+static const uint16_t movement_dst_transitions_ny[] = {
+     6460, 29304,  6940, 29784,  6844, 29688,  6748, 29592,  6652, 29496,  6460, 29304,
+     6364, 29208,  6940, 29784,  6844, 29688,  6652, 29496,  6556, 29400,  6460, 29304,
+     7036, 29880,  6844, 29688,  6748, 29592,  6652, 29496,  6556, 29400,  6364, 29208,
+     6940, 29784,  6844, 29688,  6748, 29592,  6556, 29400,  6460, 29304,  6364, 29208,
+     6940, 29784,  6748, 29592,  6652, 29496,  6556, 29400,  6460, 29304,  6940, 29784,
+     6844, 29688,  6748, 29592,  6652, 29496,  6460, 29304,  6364, 29208,  6940, 29784,
+     6844, 29688,  6652, 29496,  6556, 29400,  6460, 29304,  7036, 29880,  6844, 29688,
+     6748, 29592,  6652, 29496,  6556, 29400,  6364, 29208,  6940, 29784,  6844, 29688,
+     6748, 29592,  6556, 29400,  6460, 29304,  6364, 29208,  6940, 29784,  6748, 29592,
+     6652, 29496,  6556, 29400,  6460, 29304,  6940, 29784,  6844, 29688,  6748, 29592,
+     6652, 29496,  6460, 29304,  6364, 29208,  6940, 29784,
+};
+
+// America/Chicago (US Central)
+static const uint16_t movement_dst_transitions_ch[] = {
+     6464, 29308,  6944, 29788,  6848, 29692,  6752, 29596,  6656, 29500,  6464, 29308,
+     6368, 29212,  6944, 29788,  6848, 29692,  6656, 29500,  6560, 29404,  6464, 29308,
+     7040, 29884,  6848, 29692,  6752, 29596,  6656, 29500,  6560, 29404,  6368, 29212,
+     6944, 29788,  6848, 29692,  6752, 29596,  6560, 29404,  6464, 29308,  6368, 29212,
+     6944, 29788,  6752, 29596,  6656, 29500,  6560, 29404,  6464, 29308,  6944, 29788,
+     6848, 29692,  6752, 29596,  6656, 29500,  6464, 29308,  6368, 29212,  6944, 29788,
+     6848, 29692,  6656, 29500,  6560, 29404,  6464, 29308,  7040, 29884,  6848, 29692,
+     6752, 29596,  6656, 29500,  6560, 29404,  6368, 29212,  6944, 29788,  6848, 29692,
+     6752, 29596,  6560, 29404,  6464, 29308,  6368, 29212,  6944, 29788,  6752, 29596,
+     6656, 29500,  6560, 29404,  6464, 29308,  6944, 29788,  6848, 29692,  6752, 29596,
+     6656, 29500,  6464, 29308,  6368, 29212,  6944, 29788,
+};
+
+// America/Denver (US Mountain)
+static const uint16_t movement_dst_transitions_de[] = {
+     6468, 29312,  6948, 29792,  6852, 29696,  6756, 29600,  6660, 29504,  6468, 29312,
+     6372, 29216,  6948, 29792,  6852, 29696,  6660, 29504,  6564, 29408,  6468, 29312,
+     7044, 29888,  6852, 29696,  6756, 29600,  6660, 29504,  6564, 29408,  6372, 29216,
+     6948, 29792,  6852, 29696,  6756, 29600,  6564, 29408,  6468, 29312,  6372, 29216,
+     6948, 29792,  6756, 29600,  6660, 29504,  6564, 29408,  6468, 29312,  6948, 29792,
+     6852, 29696,  6756, 29600,  6660, 29504,  6468, 29312,  6372, 29216,  6948, 29792,
+     6852, 29696,  6660, 29504,  6564, 29408,  6468, 29312,  7044, 29888,  6852, 29696,
+     6756, 29600,  6660, 29504,  6564, 29408,  6372, 29216,  6948, 29792,  6852, 29696,
+     6756, 29600,  6564, 29408,  6468, 29312,  6372, 29216,  6948, 29792,  6756, 29600,
+     6660, 29504,  6564, 29408,  6468, 29312,  6948, 29792,  6852, 29696,  6756, 29600,
+     6660, 29504,  6468, 29312,  6372, 29216,  6948, 29792,
+};
+
+// America/Los_Angeles (US Pacific)
+static const uint16_t movement_dst_transitions_la[] = {
+     6472, 29316,  6952, 29796,  6856, 29700,  6760, 29604,  6664, 29508,  6472, 29316,
+     6376, 29220,  6952, 29796,  6856, 29700,  6664, 29508,  6568, 29412,  6472, 29316,
+     7048, 29892,  6856, 29700,  6760, 29604,  6664, 29508,  6568, 29412,  6376, 29220,
+     6952, 29796,  6856, 29700,  6760, 29604,  6568, 29412,  6472, 29316,  6376, 29220,
+     6952, 29796,  6760, 29604,  6664, 29508,  6568, 29412,  6472, 29316,  6952, 29796,
+     6856, 29700,  6760, 29604,  6664, 29508,  6472, 29316,  6376, 29220,  6952, 29796,
+     6856, 29700,  6664, 29508,  6568, 29412,  6472, 29316,  7048, 29892,  6856, 29700,
+     6760, 29604,  6664, 29508,  6568, 29412,  6376, 29220,  6952, 29796,  6856, 29700,
+     6760, 29604,  6568, 29412,  6472, 29316,  6376, 29220,  6952, 29796,  6760, 29604,
+     6664, 29508,  6568, 29412,  6472, 29316,  6952, 29796,  6856, 29700,  6760, 29604,
+     6664, 29508,  6472, 29316,  6376, 29220,  6952, 29796,
+};
+
+// America/Anchorage (Alaska)
+static const uint16_t movement_dst_transitions_an[] = {
+     6476, 29320,  6956, 29800,  6860, 29704,  6764, 29608,  6668, 29512,  6476, 29320,
+     6380, 29224,  6956, 29800,  6860, 29704,  6668, 29512,  6572, 29416,  6476, 29320,
+     7052, 29896,  6860, 29704,  6764, 29608,  6668, 29512,  6572, 29416,  6380, 29224,
+     6956, 29800,  6860, 29704,  6764, 29608,  6572, 29416,  6476, 29320,  6380, 29224,
+     6956, 29800,  6764, 29608,  6668, 29512,  6572, 29416,  6476, 29320,  6956, 29800,
+     6860, 29704,  6764, 29608,  6668, 29512,  6476, 29320,  6380, 29224,  6956, 29800,
+     6860, 29704,  6668, 29512,  6572, 29416,  6476, 29320,  7052, 29896,  6860, 29704,
+     6764, 29608,  6668, 29512,  6572, 29416,  6380, 29224,  6956, 29800,  6860, 29704,
+     6764, 29608,  6572, 29416,  6476, 29320,  6380, 29224,  6956, 29800,  6764, 29608,
+     6668, 29512,  6572, 29416,  6476, 29320,  6956, 29800,  6860, 29704,  6764, 29608,
+     6668, 29512,  6476, 29320,  6380, 29224,  6956, 29800,
+};
+
+// America/Halifax (Atlantic)
+static const uint16_t movement_dst_transitions_ha[] = {
+     6456, 29300,  6936, 29780,  6840, 29684,  6744, 29588,  6648, 29492,  6456, 29300,
+     6360, 29204,  6936, 29780,  6840, 29684,  6648, 29492,  6552, 29396,  6456, 29300,
+     7032, 29876,  6840, 29684,  6744, 29588,  6648, 29492,  6552, 29396,  6360, 29204,
+     6936, 29780,  6840, 29684,  6744, 29588,  6552, 29396,  6456, 29300,  6360, 29204,
+     6936, 29780,  6744, 29588,  6648, 29492,  6552, 29396,  6456, 29300,  6936, 29780,
+     6840, 29684,  6744, 29588,  6648, 29492,  6456, 29300,  6360, 29204,  6936, 29780,
+     6840, 29684,  6648, 29492,  6552, 29396,  6456, 29300,  7032, 29876,  6840, 29684,
+     6744, 29588,  6648, 29492,  6552, 29396,  6360, 29204,  6936, 29780,  6840, 29684,
+     6744, 29588,  6552, 29396,  6456, 29300,  6360, 29204,  6936, 29780,  6744, 29588,
+     6648, 29492,  6552, 29396,  6456, 29300,  6936, 29780,  6840, 29684,  6744, 29588,
+     6648, 29492,  6456, 29300,  6360, 29204,  6936, 29780,
+};
+
+// America/St_Johns (Newfoundland)
+static const uint16_t movement_dst_transitions_sj[] = {
+     6454, 29298,  6934, 29778,  6838, 29682,  6742, 29586,  6646, 29490,  6454, 29298,
+     6358, 29202,  6934, 29778,  6838, 29682,  6646, 29490,  6550, 29394,  6454, 29298,
+     7030, 29874,  6838, 29682,  6742, 29586,  6646, 29490,  6550, 29394,  6358, 29202,
+     6934, 29778,  6838, 29682,  6742, 29586,  6550, 29394,  6454, 29298,  6358, 29202,
+     6934, 29778,  6742, 29586,  6646, 29490,  6550, 29394,  6454, 29298,  6934, 29778,
+     6838, 29682,  6742, 29586,  6646, 29490,  6454, 29298,  6358, 29202,  6934, 29778,
+     6838, 29682,  6646, 29490,  6550, 29394,  6454, 29298,  7030, 29874,  6838, 29682,
+     6742, 29586,  6646, 29490,  6550, 29394,  6358, 29202,  6934, 29778,  6838, 29682,
+     6742, 29586,  6550, 29394,  6454, 29298,  6358, 29202,  6934, 29778,  6742, 29586,
+     6646, 29490,  6550, 29394,  6454, 29298,  6934, 29778,  6838, 29682,  6742, 29586,
+     6646, 29490,  6454, 29298,  6358, 29202,  6934, 29778,
+};
+
+// America/Santiago (Chile)
+static const uint16_t movement_dst_transitions_sa[] = {
+     9132, 23920,  8940, 23728,  8844, 24304,  8748, 23536,  9324, 24112,  9132, 23920,
+     9036, 23824,  8940, 23728,  8844, 23632,  9324, 23440,  9228, 24016,  9132, 23920,
+     9036, 23824,  8844, 23632,  8748, 23536,  9324, 23440,  9228, 24016,  9036, 23824,
+     8940, 23728,  8844, 23632,  9420, 23536,  9228, 24016,  9132, 23920,  9036, 23824,
+     8940, 23728,  8748, 23536,  9324, 23440,  9228, 24016,  9132, 23920,  8940, 23728,
+     8844, 23632,  8748, 23536,  9324, 24112,  9132, 23920,  9036, 23824,  8940, 23728,
+     8844, 23632,  9324, 23440,  9228, 24016,  9132, 23920,  9036, 23824,  8844, 23632,
+     8748, 23536,  9324, 23440,  9228, 24016,  9036, 23824,  8940, 23728,  8844, 23632,
+     9420, 23536,  9228, 24016,  9132, 23920,  9036, 23824,  8940, 23728,  8748, 23536,
+     9324, 23440,  9228, 24016,  9132, 23920,  8940, 23728,  8844, 23632,  8748, 23536,
+     9324, 24112,  9132, 23920,  9036, 23824,  8940, 23728,
+};
+
+// Europe/London (UK)
+static const uint16_t movement_dst_transitions_lo[] = {
+     8452, 28612,  8260, 29092,  8164, 28996,  8068, 28900,  8644, 28804,  8452, 28612,
+     8356, 28516,  8260, 29092,  8164, 28996,  7972, 28804,  8548, 28708,  8452, 28612,
+     8356, 29188,  8164, 28996,  8068, 28900,  7972, 28804,  8548, 28708,  8356, 28516,
+     8260, 29092,  8164, 28996,  8068, 28900,  8548, 28708,  8452, 28612,  8356, 28516,
+     8260, 29092,  8068, 28900,  7972, 28804,  8548, 28708,  8452, 28612,  8260, 29092,
+     8164, 28996,  8068, 28900,  8644, 28804,  8452, 28612,  8356, 28516,  8260, 29092,
+     8164, 28996,  7972, 28804,  8548, 28708,  8452, 28612,  8356, 29188,  8164, 28996,
+     8068, 28900,  7972, 28804,  8548, 28708,  8356, 28516,  8260, 29092,  8164, 28996,
+     8068, 28900,  8548, 28708,  8452, 28612,  8356, 28516,  8260, 29092,  8068, 28900,
+     7972, 28804,  8548, 28708,  8452, 28612,  8260, 29092,  8164, 28996,  8068, 28900,
+     8644, 28804,  8452, 28612,  8356, 28516,  8260, 29092,
+};
+
+// Europe/Lisbon (Western Europe)
+static const uint16_t movement_dst_transitions_li[] = {
+     8452, 28612,  8260, 29092,  8164, 28996,  8068, 28900,  8644, 28804,  8452, 28612,
+     8356, 28516,  8260, 29092,  8164, 28996,  7972, 28804,  8548, 28708,  8452, 28612,
+     8356, 29188,  8164, 28996,  8068, 28900,  7972, 28804,  8548, 28708,  8356, 28516,
+     8260, 29092,  8164, 28996,  8068, 28900,  8548, 28708,  8452, 28612,  8356, 28516,
+     8260, 29092,  8068, 28900,  7972, 28804,  8548, 28708,  8452, 28612,  8260, 29092,
+     8164, 28996,  8068, 28900,  8644, 28804,  8452, 28612,  8356, 28516,  8260, 29092,
+     8164, 28996,  7972, 28804,  8548, 28708,  8452, 28612,  8356, 29188,  8164, 28996,
+     8068, 28900,  7972, 28804,  8548, 28708,  8356, 28516,  8260, 29092,  8164, 28996,
+     8068, 28900,  8548, 28708,  8452, 28612,  8356, 28516,  8260, 29092,  8068, 28900,
+     7972, 28804,  8548, 28708,  8452, 28612,  8260, 29092,  8164, 28996,  8068, 28900,
+     8644, 28804,  8452, 28612,  8356, 28516,  8260, 29092,
+};
+
+// Europe/Paris (Central Europe)
+static const uint16_t movement_dst_transitions_ce[] = {
+     8452, 28612,  8260, 29092,  8164, 28996,  8068, 28900,  8644, 28804,  8452, 28612,
+     8356, 28516,  8260, 29092,  8164, 28996,  7972, 28804,  8548, 28708,  8452, 28612,
+     8356, 29188,  8164, 28996,  8068, 28900,  7972, 28804,  8548, 28708,  8356, 28516,
+     8260, 29092,  8164, 28996,  8068, 28900,  8548, 28708,  8452, 28612,  8356, 28516,
+     8260, 29092,  8068, 28900,  7972, 28804,  8548, 28708,  8452, 28612,  8260, 29092,
+     8164, 28996,  8068, 28900,  8644, 28804,  8452, 28612,  8356, 28516,  8260, 29092,
+     8164, 28996,  7972, 28804,  8548, 28708,  8452, 28612,  8356, 29188,  8164, 28996,
+     8068, 28900,  7972, 28804,  8548, 28708,  8356, 28516,  8260, 29092,  8164, 28996,
+     8068, 28900,  8548, 28708,  8452, 28612,  8356, 28516,  8260, 29092,  8068, 28900,
+     7972, 28804,  8548, 28708,  8452, 28612,  8260, 29092,  8164, 28996,  8068, 28900,
+     8644, 28804,  8452, 28612,  8356, 28516,  8260, 29092,
+};
+
+// Europe/Helsinki (Eastern Europe)
+static const uint16_t movement_dst_transitions_ee[] = {
+     8452, 28612,  8260, 29092,  8164, 28996,  8068, 28900,  8644, 28804,  8452, 28612,
+     8356, 28516,  8260, 29092,  8164, 28996,  7972, 28804,  8548, 28708,  8452, 28612,
+     8356, 29188,  8164, 28996,  8068, 28900,  7972, 28804,  8548, 28708,  8356, 28516,
+     8260, 29092,  8164, 28996,  8068, 28900,  8548, 28708,  8452, 28612,  8356, 28516,
+     8260, 29092,  8068, 28900,  7972, 28804,  8548, 28708,  8452, 28612,  8260, 29092,
+     8164, 28996,  8068, 28900,  8644, 28804,  8452, 28612,  8356, 28516,  8260, 29092,
+     8164, 28996,  7972, 28804,  8548, 28708,  8452, 28612,  8356, 29188,  8164, 28996,
+     8068, 28900,  7972, 28804,  8548, 28708,  8356, 28516,  8260, 29092,  8164, 28996,
+     8068, 28900,  8548, 28708,  8452, 28612,  8356, 28516,  8260, 29092,  8068, 28900,
+     7972, 28804,  8548, 28708,  8452, 28612,  8260, 29092,  8164, 28996,  8068, 28900,
+     8644, 28804,  8452, 28612,  8356, 28516,  8260, 29092,
+};
+
+// Atlantic/Azores (Azores)
+static const uint16_t movement_dst_transitions_az[] = {
+     8452, 28612,  8260, 29092,  8164, 28996,  8068, 28900,  8644, 28804,  8452, 28612,
+     8356, 28516,  8260, 29092,  8164, 28996,  7972, 28804,  8548, 28708,  8452, 28612,
+     8356, 29188,  8164, 28996,  8068, 28900,  7972, 28804,  8548, 28708,  8356, 28516,
+     8260, 29092,  8164, 28996,  8068, 28900,  8548, 28708,  8452, 28612,  8356, 28516,
+     8260, 29092,  8068, 28900,  7972, 28804,  8548, 28708,  8452, 28612,  8260, 29092,
+     8164, 28996,  8068, 28900,  8644, 28804,  8452, 28612,  8356, 28516,  8260, 29092,
+     8164, 28996,  7972, 28804,  8548, 28708,  8452, 28612,  8356, 29188,  8164, 28996,
+     8068, 28900,  7972, 28804,  8548, 28708,  8356, 28516,  8260, 29092,  8164, 28996,
+     8068, 28900,  8548, 28708,  8452, 28612,  8356, 28516,  8260, 29092,  8068, 28900,
+     7972, 28804,  8548, 28708,  8452, 28612,  8260, 29092,  8164, 28996,  8068, 28900,
+     8644, 28804,  8452, 28612,  8356, 28516,  8260, 29092,
+};
+
+// Asia/Jerusalem (Israel)
+static const uint16_t movement_dst_transitions_je[] = {
+     8256, 28604,  8064, 29084,  7968, 28988,  7872, 28892,  8448, 28796,  8256, 28604,
+     8160, 28508,  8064, 29084,  7968, 28988,  7776, 28796,  8352, 28700,  8256, 28604,
+     8160, 29180,  7968, 28988,  7872, 28892,  7776, 28796,  8352, 28700,  8160, 28508,
+     8064, 29084,  7968, 28988,  7872, 28892,  8352, 28700,  8256, 28604,  8160, 28508,
+     8064, 29084,  7872, 28892,  7776, 28796,  8352, 28700,  8256, 28604,  8064, 29084,
+     7968, 28988,  7872, 28892,  8448, 28796,  8256, 28604,  8160, 28508,  8064, 29084,
+     7968, 28988,  7776, 28796,  8352, 28700,  8256, 28604,  8160, 29180,  7968, 28988,
+     7872, 28892,  7776, 28796,  8352, 28700,  8160, 28508,  8064, 29084,  7968, 28988,
+     7872, 28892,  8352, 28700,  8256, 28604,  8160, 28508,  8064, 29084,  7872, 28892,
+     7776, 28796,  8352, 28700,  8256, 28604,  8064, 29084,  7968, 28988,  7872, 28892,
+     8448, 28796,  8256, 28604,  8160, 28508,  8064, 29084,
+};
+
+// Australia/Sydney (Australian Eastern)
+static const uint16_t movement_dst_transitions_sy[] = {
+     9088, 26560,  8896, 26368,  8800, 26272,  8704, 26176,  9280, 26752,  9088, 26560,
+     8992, 26464,  8896, 26368,  8800, 26272,  8608, 26752,  9184, 26656,  9088, 26560,
+     8992, 26464,  8800, 26272,  8704, 26176,  8608, 26752,  9184, 26656,  8992, 26464,
+     8896, 26368,  8800, 26272,  8704, 26848,  9184, 26656,  9088, 26560,  8992, 26464,
+     8896, 26368,  8704, 26176,  8608, 26752,  9184, 26656,  9088, 26560,  8896, 26368,
+     8800, 26272,  8704, 26176,  9280, 26752,  9088, 26560,  8992, 26464,  8896, 26368,
+     8800, 26272,  8608, 26752,  9184, 26656,  9088, 26560,  8992, 26464,  8800, 26272,
+     8704, 26176,  8608, 26752,  9184, 26656,  8992, 26464,  8896, 26368,  8800, 26272,
+     8704, 26848,  9184, 26656,  9088, 26560,  8992, 26464,  8896, 26368,  8704, 26176,
+     8608, 26752,  9184, 26656,  9088, 26560,  8896, 26368,  8800, 26272,  8704, 26176,
+     9280, 26752,  9088, 26560,  8992, 26464,  8896, 26368,
+};
+
+// Australia/Adelaide (Australian Central)
+static const uint16_t movement_dst_transitions_ad[] = {
+     9090, 26562,  8898, 26370,  8802, 26274,  8706, 26178,  9282, 26754,  9090, 26562,
+     8994, 26466,  8898, 26370,  8802, 26274,  8610, 26754,  9186, 26658,  9090, 26562,
+     8994, 26466,  8802, 26274,  8706, 26178,  8610, 26754,  9186, 26658,  8994, 26466,
+     8898, 26370,  8802, 26274,  8706, 26850,  9186, 26658,  9090, 26562,  8994, 26466,
+     8898, 26370,  8706, 26178,  8610, 26754,  9186, 26658,  9090, 26562,  8898, 26370,
+     8802, 26274,  8706, 26178,  9282, 26754,  9090, 26562,  8994, 26466,  8898, 26370,
+     8802, 26274,  8610, 26754,  9186, 26658,  9090, 26562,  8994, 26466,  8802, 26274,
+     8706, 26178,  8610, 26754,  9186, 26658,  8994, 26466,  8898, 26370,  8802, 26274,
+     8706, 26850,  9186, 26658,  9090, 26562,  8994, 26466,  8898, 26370,  8706, 26178,
+     8610, 26754,  9186, 26658,  9090, 26562,  8898, 26370,  8802, 26274,  8706, 26178,
+     9282, 26754,  9090, 26562,  8994, 26466,  8898, 26370,
+};
+
+// Australia/Lord_Howe (Lord Howe Island)
+static const uint16_t movement_dst_transitions_lh[] = {
+     9084, 26558,  8892, 26366,  8796, 26270,  8700, 26174,  9276, 26750,  9084, 26558,
+     8988, 26462,  8892, 26366,  8796, 26270,  8604, 26750,  9180, 26654,  9084, 26558,
+     8988, 26462,  8796, 26270,  8700, 26174,  8604, 26750,  9180, 26654,  8988, 26462,
+     8892, 26366,  8796, 26270,  8700, 26846,  9180, 26654,  9084, 26558,  8988, 26462,
+     8892, 26366,  8700, 26174,  8604, 26750,  9180, 26654,  9084, 26558,  8892, 26366,
+     8796, 26270,  8700, 26174,  9276, 26750,  9084, 26558,  8988, 26462,  8892, 26366,
+     8796, 26270,  8604, 26750,  9180, 26654,  9084, 26558,  8988, 26462,  8796, 26270,
+     8700, 26174,  8604, 26750,  9180, 26654,  8988, 26462,  8892, 26366,  8796, 26270,
+     8700, 26846,  9180, 26654,  9084, 26558,  8988, 26462,  8892, 26366,  8700, 26174,
+     8604, 26750,  9180, 26654,  9084, 26558,  8892, 26366,  8796, 26270,  8700, 26174,
+     9276, 26750,  9084, 26558,  8988, 26462,  8892, 26366,
+};
+
+// Pacific/Auckland (New Zealand)
+static const uint16_t movement_dst_transitions_nz[] = {
+     9080, 25880,  8888, 25688,  8792, 25592,  8696, 25496,  9272, 26072,  9080, 25880,
+     8984, 25784,  8888, 25688,  8792, 25592,  8600, 26072,  9176, 25976,  9080, 25880,
+     8984, 25784,  8792, 25592,  8696, 25496,  8600, 26072,  9176, 25976,  8984, 25784,
+     8888, 25688,  8792, 25592,  8696, 26168,  9176, 25976,  9080, 25880,  8984, 25784,
+     8888, 25688,  8696, 25496,  8600, 26072,  9176, 25976,  9080, 25880,  8888, 25688,
+     8792, 25592,  8696, 25496,  9272, 26072,  9080, 25880,  8984, 25784,  8888, 25688,
+     8792, 25592,  8600, 26072,  9176, 25976,  9080, 25880,  8984, 25784,  8792, 25592,
+     8696, 25496,  8600, 26072,  9176, 25976,  8984, 25784,  8888, 25688,  8792, 25592,
+     8696, 26168,  9176, 25976,  9080, 25880,  8984, 25784,  8888, 25688,  8696, 25496,
+     8600, 26072,  9176, 25976,  9080, 25880,  8888, 25688,  8792, 25592,  8696, 25496,
+     9272, 26072,  9080, 25880,  8984, 25784,  8888, 25688,
+};
+
+// Pacific/Chatham (Chatham Islands)
+static const uint16_t movement_dst_transitions_ct[] = {
+     9080, 25880,  8888, 25688,  8792, 25592,  8696, 25496,  9272, 26072,  9080, 25880,
+     8984, 25784,  8888, 25688,  8792, 25592,  8600, 26072,  9176, 25976,  9080, 25880,
+     8984, 25784,  8792, 25592,  8696, 25496,  8600, 26072,  9176, 25976,  8984, 25784,
+     8888, 25688,  8792, 25592,  8696, 26168,  9176, 25976,  9080, 25880,  8984, 25784,
+     8888, 25688,  8696, 25496,  8600, 26072,  9176, 25976,  9080, 25880,  8888, 25688,
+     8792, 25592,  8696, 25496,  9272, 26072,  9080, 25880,  8984, 25784,  8888, 25688,
+     8792, 25592,  8600, 26072,  9176, 25976,  9080, 25880,  8984, 25784,  8792, 25592,
+     8696, 25496,  8600, 26072,  9176, 25976,  8984, 25784,  8888, 25688,  8792, 25592,
+     8696, 26168,  9176, 25976,  9080, 25880,  8984, 25784,  8888, 25688,  8696, 25496,
+     8600, 26072,  9176, 25976,  9080, 25880,  8888, 25688,  8792, 25592,  8696, 25496,
+     9272, 26072,  9080, 25880,  8984, 25784,  8888, 25688,
+};
+
+static const movement_dst_zone_t movement_dst_zones[MOVEMENT_NUM_DST_ZONES] = {
+    {  -300,  60, false, "NY", movement_dst_transitions_ny },
+    {  -360,  60, false, "CH", movement_dst_transitions_ch },
+    {  -420,  60, false, "DE", movement_dst_transitions_de },
+    {  -480,  60, false, "LA", movement_dst_transitions_la },
+    {  -540,  60, false, "AN", movement_dst_transitions_an },
+    {  -240,  60, false, "HA", movement_dst_transitions_ha },
+    {  -210,  60, false, "SJ", movement_dst_transitions_sj },
+    {  -240,  60, true , "SA", movement_dst_transitions_sa },
+    {     0,  60, false, "LO", movement_dst_transitions_lo },
+    {     0,  60, false, "LI", movement_dst_transitions_li },
+    {    60,  60, false, "CE", movement_dst_transitions_ce },
+    {   120,  60, false, "EE", movement_dst_transitions_ee },
+    {   -60,  60, false, "AZ", movement_dst_transitions_az },
+    {   120,  60, false, "JE", movement_dst_transitions_je },
+    {   600,  60, true , "SY", movement_dst_transitions_sy },
+    {   570,  60, true , "AD", movement_dst_transitions_ad },
+    {   630,  30, true , "LH", movement_dst_transitions_lh },
+    {   720,  60, true , "NZ", movement_dst_transitions_nz },
+    {   765,  60, true , "CT", movement_dst_transitions_ct },
+};
+
+#endif // MOVEMENT_TIMEZONES_H_
@@ -0,0 +1,368 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "sensor_hub.h"
+#include "watch.h"
+
+// subscribers get their batches decimated and rescaled by shifting, by the difference between two rates or ranges.
+_Static_assert(LIS2DW_RANGE_4_G == LIS2DW_RANGE_2_G + 1 && LIS2DW_RANGE_8_G == LIS2DW_RANGE_4_G + 1 &&
+               LIS2DW_RANGE_16_G == LIS2DW_RANGE_8_G + 1, "each step up in lis2dw_range_t must double the full scale");
+_Static_assert(LIS2DW_DATA_RATE_25_HZ == LIS2DW_DATA_RATE_12_5_HZ + 1 && LIS2DW_DATA_RATE_50_HZ == LIS2DW_DATA_RATE_25_HZ + 1 &&
+               LIS2DW_DATA_RATE_100_HZ == LIS2DW_DATA_RATE_50_HZ + 1 && LIS2DW_DATA_RATE_200_HZ == LIS2DW_DATA_RATE_100_HZ + 1,
+               "each step up in lis2dw_data_rate_t from 12.5 Hz must double the rate");
+
+static struct {
+    sensor_hub_subscription_t *head;
+    // what the sensor is set to right now
+    lis2dw_data_rate_t data_rate;
+    lis2dw_range_t range;
+    bool low_noise;
+    uint8_t wakeup_threshold;
+    bool fifo_enabled;
+    bool running;
+    bool suspended;
+    volatile bool wakeup_pending;
+    // bookkeeping, in I2C transactions as the bus counts them (see watch_i2c_get_transaction_count).
+    uint32_t transactions_standalone;
+    uint32_t transactions_actual;
+    uint32_t bus_mark;          // the bus's count when the hub started its current piece of work
+    uint32_t setup_cost;        // what it took to bring the sensor up from a reset, last time we did
+    uint32_t source_read_cost;  // what reading the wake-up source takes
+    // the batch as read from the FIFO, and the one a subscriber gets when it wants a different rate or range.
+    lis2dw_fifo_t fifo;
+    lis2dw_fifo_t batch;
+    // the FIFO is read in the background, between ticks, and delivered on the tick after.
+    volatile bool fifo_reading;
+    volatile bool fifo_ready;
+    uint32_t fifo_read_mark;
+    volatile uint32_t fifo_read_cost;
+} sensor_hub_state;
+
+static inline void _sensor_hub_start_counting(void) {
+    // let a FIFO read finish first; it keeps its own count.
+    watch_i2c_wait_for_idle();
+    sensor_hub_state.bus_mark = watch_i2c_get_transaction_count();
+}
+
+// returns the transactions since _sensor_hub_start_counting (or the last call to this), and adds them to our total.
+static uint32_t _sensor_hub_count_transactions(void) {
+    uint32_t now = watch_i2c_get_transaction_count();
+    uint32_t transactions = now - sensor_hub_state.bus_mark;
+    sensor_hub_state.bus_mark = now;
+    sensor_hub_state.transactions_actual += transactions;
+    return transactions;
+}
+
+static void _sensor_hub_fifo_read_done(lis2dw_fifo_t *fifo, bool success, void *context) {
+    (void) context;
+    // I2C interrupt context; the batch waits for the next sensor_hub_update. A failed read just misses a tick, and the
+    // samples it would have had stay in the FIFO for the next one.
+    sensor_hub_state.fifo_read_cost = watch_i2c_get_transaction_count() - sensor_hub_state.fifo_read_mark;
+    sensor_hub_state.fifo_ready = success;
+    sensor_hub_state.fifo_reading = false;
+}
+
+static void _sensor_hub_interrupt_callback(void) {
+    // interrupt context; we read the source on the next tick.
+    sensor_hub_state.wakeup_pending = true;
+}
+
+static uint8_t _sensor_hub_effective_rate(sensor_hub_subscription_t *subscription) {
+    // below 12.5 Hz the rates stop doubling, so batches are decimated as if the subscriber had asked for 12.5 Hz.
+    if (subscription->fifo_callback && subscription->data_rate < LIS2DW_DATA_RATE_12_5_HZ) return LIS2DW_DATA_RATE_12_5_HZ;
+    return subscription->data_rate;
+}
+
+// in low energy mode, only the subscriptions that asked to keep their wake-ups armed are configured.
+static bool _sensor_hub_is_live(sensor_hub_subscription_t *subscription) {
+    return !sensor_hub_state.suspended || (subscription->keep_in_low_energy && subscription->fifo_callback == NULL);
+}
+
+static void _sensor_hub_power_down(void) {
+    if (!sensor_hub_state.running) return;
+    if (sensor_hub_state.wakeup_threshold) watch_register_interrupt_callback(A0, NULL, INTERRUPT_TRIGGER_NONE);
+    _sensor_hub_start_counting();
+    lis2dw_set_fifo_mode(LIS2DW_FIFO_MODE_OFF);
+    lis2dw_set_data_rate(LIS2DW_DATA_RATE_POWERDOWN);
+    _sensor_hub_count_transactions();
+    watch_disable_i2c();
+    sensor_hub_state.running = false;
+    sensor_hub_state.wakeup_pending = false;
+    sensor_hub_state.fifo_ready = false;
+}
+
+static bool _sensor_hub_configure(void) {
+    lis2dw_data_rate_t data_rate = LIS2DW_DATA_RATE_POWERDOWN;
+    lis2dw_range_t range = LIS2DW_RANGE_2_G;
+    bool low_noise = false;
+    bool fifo_enabled = false;
+    uint8_t wakeup_threshold = 0;
+    bool live = false;
+
+    // first pass: the widest range and the fastest rate anyone wants.
+    for(sensor_hub_subscription_t *subscription = sensor_hub_state.head; subscription != NULL; subscription = subscription->next) {
+        if (!_sensor_hub_is_live(subscription)) continue;
+        live = true;
+        uint8_t rate = _sensor_hub_effective_rate(subscription);
+        if (rate > data_rate) data_rate = rate;
+        if (subscription->range > range) range = subscription->range;
+        low_noise |= subscription->low_noise;
+        if (subscription->fifo_callback) fifo_enabled = true;
+    }
+    if (!live) {
+        _sensor_hub_power_down();
+        return true;
+    }
+    // second pass: thresholds are relative to full scale, so they have to be translated to the range we settled on.
+    for(sensor_hub_subscription_t *subscription = sensor_hub_state.head; subscription != NULL; subscription = subscription->next) {
+        if (subscription->wakeup_threshold == 0 || !_sensor_hub_is_live(subscription)) continue;
+        uint8_t threshold = subscription->wakeup_threshold >> (range - subscription->range);
+        if (threshold == 0) threshold = 1;
+        if (wakeup_threshold == 0 || threshold < wakeup_threshold) wakeup_threshold = threshold;
+    }
+
+    bool starting = !sensor_hub_state.running;
+    if (starting) watch_enable_i2c();
+    _sensor_hub_start_counting();
+    if (starting) {
+        if (!lis2dw_begin()) {
+            _sensor_hub_count_transactions();
+            watch_disable_i2c();
+            return false;
+        }
+        lis2dw_set_low_power_mode(LIS2DW_LP_MODE_2);
+        sensor_hub_state.setup_cost = _sensor_hub_count_transactions();
+        // clear an interrupt a previous owner may have left latched, and find out what a read of the source costs.
+        lis2dw_get_wakeup_source();
+        sensor_hub_state.source_read_cost = _sensor_hub_count_transactions();
+        // these match the sensor's state after a reset.
+        sensor_hub_state.data_rate = LIS2DW_DATA_RATE_POWERDOWN;
+        sensor_hub_state.range = LIS2DW_RANGE_2_G;
+        sensor_hub_state.low_noise = false;
+        sensor_hub_state.wakeup_threshold = 0;
+        sensor_hub_state.fifo_enabled = false;
+        sensor_hub_state.running = true;
+    }
+
+    // changing rate or range leaves samples in the FIFO that don't match; stop it, and restart it below.
+    if (sensor_hub_state.fifo_enabled && (data_rate != sensor_hub_state.data_rate || range != sensor_hub_state.range || !fifo_enabled)) {
+        lis2dw_set_fifo_mode(LIS2DW_FIFO_MODE_OFF);
+        sensor_hub_state.fifo_enabled = false;
+        // and so does the batch we read last.
+        sensor_hub_state.fifo_ready = false;
+    }
+    if (data_rate != sensor_hub_state.data_rate) {
+        lis2dw_set_data_rate(data_rate);
+        sensor_hub_state.data_rate = data_rate;
+    }
+    if (range != sensor_hub_state.range) {
+        lis2dw_set_range(range);
+        sensor_hub_state.range = range;
+    }
+    if (low_noise != sensor_hub_state.low_noise) {
+        lis2dw_set_low_noise_mode(low_noise);
+        sensor_hub_state.low_noise = low_noise;
+    }
+    if (wakeup_threshold != sensor_hub_state.wakeup_threshold) {
+        if (wakeup_threshold) {
+            lis2dw_configure_wakeup_int1(wakeup_threshold, true, true);
+            if (sensor_hub_state.wakeup_threshold == 0) {
+                watch_enable_pull_down(A0);
+                watch_register_interrupt_callback(A0, _sensor_hub_interrupt_callback, INTERRUPT_TRIGGER_RISING);
+            }
+        } else {
+            lis2dw_disable_wakeup_int1();
+            watch_register_interrupt_callback(A0, NULL, INTERRUPT_TRIGGER_NONE);
+            sensor_hub_state.wakeup_pending = false;
+        }
+        sensor_hub_state.wakeup_threshold = wakeup_threshold;
+    }
+    if (fifo_enabled && !sensor_hub_state.fifo_enabled) {
+        lis2dw_set_fifo_mode(LIS2DW_FIFO_MODE_COLLECT_CONTINUOUS);
+        sensor_hub_state.fifo_enabled = true;
+    }
+
+    uint32_t transactions = _sensor_hub_count_transactions();
+    // only a start from a reset counts as setup: that's what each subscriber would have paid on its own.
+    if (starting) sensor_hub_state.setup_cost += transactions;
+
+    return true;
+}
+
+static void _sensor_hub_deliver_fifo(sensor_hub_subscription_t *subscription) {
+    lis2dw_fifo_t *fifo = &sensor_hub_state.fifo;
+    lis2dw_fifo_t *batch = &sensor_hub_state.batch;
+    uint8_t rate_shift = sensor_hub_state.data_rate - _sensor_hub_effective_rate(subscription);
+    uint8_t range_shift = sensor_hub_state.range - subscription->range;
+    uint8_t phase_mask = (1 << rate_shift) - 1;
+
+    if (!rate_shift && !range_shift) {
+        // the subscriber wants what we're running; it can have the FIFO read as-is.
+        subscription->fifo_callback(fifo, subscription->context);
+        return;
+    }
+
+    batch->count = 0;
+    for(int8_t i = 0; i < fifo->count; i++) {
+        uint8_t phase = subscription->decimation_phase;
+        subscription->decimation_phase = (phase + 1) & phase_mask;
+        if (phase) continue;
+
+        lis2dw_reading_t reading = fifo->readings[i];
+        if (range_shift) {
+            // the subscriber wants a narrower range than we're running; scale up, and clip like the sensor would.
+            int32_t values[3] = {reading.x, reading.y, reading.z};
+            for(uint8_t axis = 0; axis < 3; axis++) {
+                values[axis] *= 1 << range_shift;
+                if (values[axis] > INT16_MAX) values[axis] = INT16_MAX;
+                if (values[axis] < INT16_MIN) values[axis] = INT16_MIN;
+            }
+            reading.x = values[0];
+            reading.y = values[1];
+            reading.z = values[2];
+        }
+        batch->readings[batch->count++] = reading;
+    }
+
+    subscription->fifo_callback(batch, subscription->context);
+}
+
+bool sensor_hub_subscribe(sensor_hub_subscription_t *subscription) {
+    bool already_subscribed = false;
+
+    for(sensor_hub_subscription_t *current = sensor_hub_state.head; current != NULL; current = current->next) {
+        if (current == subscription) already_subscribed = true;
+    }
+    if (!already_subscribed) {
+        subscription->decimation_phase = 0;
+        subscription->next = sensor_hub_state.head;
+        sensor_hub_state.head = subscription;
+    }
+
+    if (!_sensor_hub_configure()) {
+        sensor_hub_unsubscribe(subscription);
+        return false;
+    }
+
+    // on its own, this subscriber would have had to bring up and configure the sensor itself.
+    if (!already_subscribed) sensor_hub_state.transactions_standalone += sensor_hub_state.setup_cost;
+
+    return true;
+}
+
+void sensor_hub_unsubscribe(sensor_hub_subscription_t *subscription) {
+    sensor_hub_subscription_t **link = &sensor_hub_state.head;
+
+    while (*link != NULL) {
+        if (*link == subscription) {
+            *link = subscription->next;
+            subscription->next = NULL;
+            _sensor_hub_configure();
+            return;
+        }
+        link = &(*link)->next;
+    }
+}
+
+void sensor_hub_update(void) {
+    uint8_t fifo_subscribers = 0;
+    uint8_t wakeup_subscribers = 0;
+
+    if (!sensor_hub_state.running) return;
+
+    for(sensor_hub_subscription_t *subscription = sensor_hub_state.head; subscription != NULL; subscription = subscription->next) {
+        if (subscription->fifo_callback) fifo_subscribers++;
+        if (subscription->wakeup_callback) wakeup_subscribers++;
+    }
+
+    // without the interrupt, each of these would have polled the interrupt source on every tick.
+    sensor_hub_state.transactions_standalone += wakeup_subscribers * sensor_hub_state.source_read_cost;
+    if (sensor_hub_state.wakeup_pending) {
+        sensor_hub_state.wakeup_pending = false;
+        // reading the source also clears the latched interrupt.
+        _sensor_hub_start_counting();
+        lis2dw_wakeup_source wakeup_source = lis2dw_get_wakeup_source();
+        sensor_hub_state.transactions_standalone += wakeup_subscribers * _sensor_hub_count_transactions();
+        if (wakeup_source & LIS2DW_WAKEUP_SRC_WAKEUP) {
+            sensor_hub_subscription_t *subscription = sensor_hub_state.head;
+            while (subscription != NULL) {
+                // callbacks may unsubscribe themselves, so get the next one first.
+                sensor_hub_subscription_t *next = subscription->next;
+                if (subscription->wakeup_callback) subscription->wakeup_callback(wakeup_source, subscription->context);
+                subscription = next;
+            }
+        }
+    }
+
+    if (sensor_hub_state.fifo_ready) {
+        sensor_hub_state.fifo_ready = false;
+        sensor_hub_state.transactions_actual += sensor_hub_state.fifo_read_cost;
+        sensor_hub_state.transactions_standalone += fifo_subscribers * sensor_hub_state.fifo_read_cost;
+        sensor_hub_subscription_t *subscription = sensor_hub_state.head;
+        while (subscription != NULL) {
+            sensor_hub_subscription_t *next = subscription->next;
+            if (subscription->fifo_callback) _sensor_hub_deliver_fifo(subscription);
+            subscription = next;
+        }
+    }
+
+    // start the next read now, and let it run on the bus while we sleep.
+    if (fifo_subscribers && sensor_hub_state.fifo_enabled && !sensor_hub_state.fifo_reading) {
+        sensor_hub_state.fifo_reading = true;
+        sensor_hub_state.fifo_read_mark = watch_i2c_get_transaction_count();
+        if (!lis2dw_read_fifo_async(&sensor_hub_state.fifo, _sensor_hub_fifo_read_done, NULL)) sensor_hub_state.fifo_reading = false;
+    }
+}
+
+void sensor_hub_suspend(void) {
+    sensor_hub_state.suspended = true;
+    _sensor_hub_configure();
+    // sleep mode turns off the I2C bus, but the sensor keeps its settings and can still reach us on A0.
+    watch_set_sleep_mode_wake_pin(A0, sensor_hub_state.running && sensor_hub_state.wakeup_threshold);
+}
+
+void sensor_hub_resume(void) {
+    sensor_hub_state.suspended = false;
+    watch_set_sleep_mode_wake_pin(A0, false);
+    if (sensor_hub_state.running) {
+        // the sensor kept running through low energy mode, but sleep mode turned off the bus and app_setup reset
+        // the EIC; bring both back before reconfiguring for everyone.
+        watch_enable_i2c();
+        if (sensor_hub_state.wakeup_threshold) {
+            watch_enable_pull_down(A0);
+            watch_register_interrupt_callback(A0, _sensor_hub_interrupt_callback, INTERRUPT_TRIGGER_RISING);
+        }
+    }
+    if (sensor_hub_state.head != NULL) _sensor_hub_configure();
+}
+
+bool sensor_hub_has_pending_wakeup(void) {
+    return sensor_hub_state.wakeup_pending;
+}
+
+uint32_t sensor_hub_get_i2c_transactions_saved(void) {
+    if (sensor_hub_state.transactions_standalone < sensor_hub_state.transactions_actual) return 0;
+    return sensor_hub_state.transactions_standalone - sensor_hub_state.transactions_actual;
+}
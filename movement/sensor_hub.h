@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SENSOR_HUB_H_
+#define SENSOR_HUB_H_
+#include <stdio.h>
+#include <stdbool.h>
+#include "lis2dw.h"
+
+// Movement's sensor hub owns the LIS2DW accelerometer, so that several faces and services can use it at once.
+// Each consumer fills out a subscription with the data rate, range and wake-up threshold it needs, and the hub
+// configures the sensor for the union of them: the fastest rate, the widest range and the most sensitive threshold.
+// On each tick, the hub hands every subscriber the batch it read in the background since the last one, decimated to
+// the rate it asked for and rescaled to the range it asked for, then starts reading the next. Batches live in the hub's own buffers and are reused for the next
+// subscriber, so a FIFO callback must not modify the batch or keep the pointer after it returns.
+// When the last subscriber leaves, the sensor powers down.
+// The hub expects the LIS2DW's INT1 pin on A0, configured active high.
+
+typedef void (*sensor_hub_fifo_cb_t)(lis2dw_fifo_t *fifo, void *context);
+typedef void (*sensor_hub_wakeup_cb_t)(lis2dw_wakeup_source wakeup_source, void *context);
+
+typedef struct sensor_hub_subscription_t {
+    lis2dw_data_rate_t data_rate;           // 12.5 Hz or faster if you want FIFO batches; 1.6 Hz is fine for wake-ups.
+    lis2dw_range_t range;                   // samples are delivered as if the sensor were set to this range.
+    bool low_noise;                         // set if you want low noise mode; it costs a little more power.
+    uint8_t wakeup_threshold;               // 1/64 of your range; 0 if you don't want wake-up callbacks.
+    sensor_hub_fifo_cb_t fifo_callback;     // called on each tick with new samples, or NULL for none.
+    sensor_hub_wakeup_cb_t wakeup_callback; // called on the tick after the wake-up interrupt fires, or NULL.
+    bool keep_in_low_energy;                // keep wake-ups armed in low energy mode, where they wake Movement.
+    void *context;                          // passed to both callbacks.
+    // private
+    uint8_t decimation_phase;
+    struct sensor_hub_subscription_t *next;
+} sensor_hub_subscription_t;
+
+/** @brief Adds a subscription, or applies changes to one that is already subscribed.
+  * @param subscription The subscription. It must stay valid (i.e. not on the stack) until you unsubscribe.
+  * @return true if the accelerometer is present and configured; false if it is missing.
+  */
+bool sensor_hub_subscribe(sensor_hub_subscription_t *subscription);
+
+/** @brief Removes a subscription. If it was the last one, the accelerometer powers down.
+  */
+void sensor_hub_unsubscribe(sensor_hub_subscription_t *subscription);
+
+/** @brief Calls subscriber callbacks with new data, and starts the next FIFO read. Movement calls this on every tick.
+  * @details The FIFO read runs on the I2C interrupt while Movement sleeps, so batches arrive one tick after they were
+  *          read. The sensor's FIFO holds 32 samples, so the tick has to be at least as fast as the data rate / 32.
+  */
+void sensor_hub_update(void);
+
+/** @brief Gets the sensor ready for low energy mode, keeping subscriptions. Movement calls this before entering it.
+  * @details Subscriptions that set keep_in_low_energy and take no FIFO batches stay armed, and their wake-up
+  *          interrupt can wake the watch from sleep mode; if there are none, the accelerometer powers down.
+  */
+void sensor_hub_suspend(void);
+
+/** @brief Brings the accelerometer back up for existing subscriptions. Movement calls this on wake.
+  */
+void sensor_hub_resume(void);
+
+/** @brief Returns true if the wake-up interrupt has fired and the hub hasn't yet handled it. Movement checks this on
+  *        each wake in low energy mode, to tell whether motion woke it.
+  */
+bool sensor_hub_has_pending_wakeup(void);
+
+/** @brief Returns the number of I2C transactions the hub has avoided, compared to each subscriber
+  *        configuring and reading the sensor on its own.
+  */
+uint32_t sensor_hub_get_i2c_transactions_saved(void);
+
+#endif // SENSOR_HUB_H_
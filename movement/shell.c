@@ -0,0 +1,156 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "shell.h"
+#include "watch_utility.h"
+
+#define SHELL_TIMEOUT_MS 2000
+#define SHELL_MAX_RETRIES 5
+
+static const shell_command_t *shell_commands[SHELL_MAX_COMMANDS];
+static uint8_t shell_num_commands = 0;
+
+static int _shell_help(int argc, char *argv[]);
+
+static const shell_command_t shell_help_command = {
+    .name = "help",
+    .usage = "help",
+    .min_args = 0,
+    .max_args = 0,
+    .handler = _shell_help,
+};
+
+static int _shell_help(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+    for(uint8_t i = 0; i < shell_num_commands; i++) {
+        printf("%s\n", shell_commands[i]->usage);
+    }
+    return 0;
+}
+
+static const shell_command_t *_shell_find_command(const char *name) {
+    for(uint8_t i = 0; i < shell_num_commands; i++) {
+        if (strcmp(shell_commands[i]->name, name) == 0) return shell_commands[i];
+    }
+    return NULL;
+}
+
+bool shell_register_command(const shell_command_t *command) {
+    // help is always first, so it gets registered the first time anyone else registers anything.
+    if (shell_num_commands == 0) shell_commands[shell_num_commands++] = &shell_help_command;
+
+    const shell_command_t *existing = _shell_find_command(command->name);
+    if (existing != NULL) return existing == command;
+    if (shell_num_commands >= SHELL_MAX_COMMANDS) return false;
+    shell_commands[shell_num_commands++] = command;
+
+    return true;
+}
+
+void shell_process_command(char *line) {
+    char *argv[SHELL_MAX_ARGS + 1];
+    int argc = 0;
+
+    printf("$ %s", line);
+
+    char *word = strtok(line, " \n");
+    while (word != NULL && argc < SHELL_MAX_ARGS) {
+        argv[argc++] = word;
+        word = strtok(NULL, " \n");
+    }
+    argv[argc] = NULL;
+    if (argc == 0) return;
+
+    const shell_command_t *command = _shell_find_command(argv[0]);
+    if (command == NULL) {
+        printf("%s: command not found\n", argv[0]);
+    } else if (argc - 1 < command->min_args || argc - 1 > command->max_args) {
+        printf("usage: %s\n", command->usage);
+    } else {
+        command->handler(argc, argv);
+    }
+}
+
+static void _shell_write(const void *data, size_t length) {
+    fwrite(data, 1, length, stdout);
+}
+
+static void _shell_drain_input(void) {
+    uint8_t discard[16];
+    while (watch_usb_read_bytes(discard, sizeof(discard), 10) != 0);
+}
+
+void shell_reply(uint8_t response) {
+    _shell_write(&response, 1);
+    fflush(stdout);
+}
+
+bool shell_send_frame(uint8_t type, const uint8_t *payload, uint16_t length) {
+    uint8_t header[3] = {type, length & 0xFF, length >> 8};
+    uint32_t crc = watch_utility_crc32(0, header, sizeof(header));
+    crc = watch_utility_crc32(crc, payload, length);
+    uint8_t trailer[4] = {crc & 0xFF, (crc >> 8) & 0xFF, (crc >> 16) & 0xFF, crc >> 24};
+
+    for(uint8_t attempt = 0; attempt < SHELL_MAX_RETRIES; attempt++) {
+        uint8_t response = 0;
+        _shell_write(header, sizeof(header));
+        if (length) _shell_write(payload, length);
+        _shell_write(trailer, sizeof(trailer));
+        fflush(stdout);
+
+        if (!watch_usb_read_bytes(&response, 1, SHELL_TIMEOUT_MS)) return false;
+        if (response == SHELL_ACK) return true;
+        if (response != SHELL_NAK) return false;
+    }
+
+    return false;
+}
+
+int16_t shell_receive_frame(uint8_t *type, uint8_t *payload) {
+    for(uint8_t attempt = 0; attempt < SHELL_MAX_RETRIES; attempt++) {
+        uint8_t header[3];
+        uint8_t trailer[4];
+
+        if (watch_usb_read_bytes(header, sizeof(header), SHELL_TIMEOUT_MS) != sizeof(header)) return -1;
+        uint16_t length = header[1] | (header[2] << 8);
+        if (length <= SHELL_MAX_PAYLOAD &&
+            watch_usb_read_bytes(payload, length, SHELL_TIMEOUT_MS) == length &&
+            watch_usb_read_bytes(trailer, sizeof(trailer), SHELL_TIMEOUT_MS) == sizeof(trailer)) {
+            uint32_t expected = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | ((uint32_t)trailer[3] << 24);
+            uint32_t crc = watch_utility_crc32(0, header, sizeof(header));
+            crc = watch_utility_crc32(crc, payload, length);
+            if (crc == expected) {
+                *type = header[0];
+                return length;
+            }
+        }
+        // garbled; throw away whatever else is in flight, and ask for it again.
+        _shell_drain_input();
+        shell_reply(SHELL_NAK);
+    }
+
+    return -1;
+}
@@ -0,0 +1,94 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SHELL_H_
+#define SHELL_H_
+#include <stdio.h>
+#include <stdbool.h>
+#include "watch.h"
+
+// Movement's USB shell. Commands live in a table that anyone can add to: the filesystem registers ls, cat and
+// friends at startup, and a watch face can register its own commands in its setup function. When a line arrives,
+// the shell splits it into words and hands them to the matching command's handler, argc / argv style.
+//
+// For moving binary data, the shell also speaks a simple framed protocol. Every frame is a type byte, a uint16_t
+// payload length, the payload, and a uint32_t CRC-32 of everything before it; all values are little endian.
+// The receiver answers each frame with a single byte: SHELL_ACK to accept it, SHELL_NAK if the CRC didn't match
+// (and the sender should resend it), or SHELL_FAIL to abort the transfer. utils/movement_file_transfer.py speaks
+// the other end of this protocol.
+
+#define SHELL_MAX_COMMANDS 24
+#define SHELL_MAX_ARGS 16
+#define SHELL_MAX_PAYLOAD 256
+
+#define SHELL_ACK 'A'
+#define SHELL_NAK 'N'
+#define SHELL_FAIL 'F'
+
+#define SHELL_FRAME_START 'S'   // payload: uint32_t total size
+#define SHELL_FRAME_DATA 'D'    // payload: up to SHELL_MAX_PAYLOAD bytes
+#define SHELL_FRAME_END 'E'     // no payload
+#define SHELL_FRAME_ERROR 'X'   // payload: an error message
+
+typedef struct {
+    const char *name;       // what the user types
+    const char *usage;      // shown by help, and when the arguments don't fit
+    uint8_t min_args;       // not counting the command itself
+    uint8_t max_args;       // not counting the command itself
+    int (*handler)(int argc, char *argv[]);     // argv[0] is the command; returns 0 on success
+} shell_command_t;
+
+/** @brief Adds a command to the shell. Registering the same command twice is harmless.
+  * @param command The command to add. It must stay valid forever, so make it static const.
+  * @return true if the command was added; false if the table is full or the name is taken.
+  */
+bool shell_register_command(const shell_command_t *command);
+
+/** @brief Handles a line typed into the serial console when Movement is plugged in to USB.
+  * @param line The command line. It will be modified.
+  */
+void shell_process_command(char *line);
+
+/** @brief Sends a frame, and waits for the host to acknowledge it, resending it if need be.
+  * @param type One of the SHELL_FRAME_ types.
+  * @param payload The payload, or NULL if length is 0.
+  * @param length The length of the payload, at most SHELL_MAX_PAYLOAD.
+  * @return true if the host acknowledged the frame; false if it gave up or went quiet.
+  */
+bool shell_send_frame(uint8_t type, const uint8_t *payload, uint16_t length);
+
+/** @brief Receives a frame from the host, asking it to resend until the CRC matches.
+  * @param type Receives the frame type.
+  * @param payload A buffer of at least SHELL_MAX_PAYLOAD bytes, which receives the payload.
+  * @return The payload length, or -1 if the host went quiet or kept sending bad frames.
+  * @note Once you've dealt with the frame, answer it with shell_reply(SHELL_ACK) or shell_reply(SHELL_FAIL).
+  */
+int16_t shell_receive_frame(uint8_t *type, uint8_t *payload);
+
+/** @brief Sends a one-byte response to a frame from the host.
+  * @param response SHELL_ACK, SHELL_NAK or SHELL_FAIL.
+  */
+void shell_reply(uint8_t response);
+
+#endif // SHELL_H_
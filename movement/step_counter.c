@@ -0,0 +1,240 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "step_counter.h"
+#include "filesystem.h"
+#include "sensor_hub.h"
+
+// detector tuning, in milli-g and samples at 25 Hz.
+#define STEP_COUNTER_THRESHOLD 80           // filtered peak must rise this far above the baseline
+#define STEP_COUNTER_MIN_INTERVAL 6         // 0.24 s; anything faster is a bounce, not a step
+#define STEP_COUNTER_MAX_INTERVAL 50        // 2 s; anything slower breaks the current run of steps
+#define STEP_COUNTER_RUN_LENGTH 4           // steps don't count until we see this many in a row
+#define STEP_COUNTER_IDLE_TIMEOUT 10        // seconds without a step before we go dormant again
+#define STEP_COUNTER_WAKE_THRESHOLD 2       // 1/64 of full scale; at ±4g, this is 125 mg
+#define STEP_COUNTER_SAVE_INTERVAL 60       // minutes between checkpoints of today's total
+
+static char step_counter_filename[] = "steps.dat";
+
+static struct {
+    step_counter_day_t days[STEP_COUNTER_NUM_DAYS];
+    // filter state
+    int32_t baseline;           // running mean of the magnitude, times 16
+    int32_t filtered;
+    bool baseline_seeded;
+    bool above_threshold;
+    // step timing
+    uint16_t samples_since_step;
+    uint8_t run_length;
+    uint8_t idle_seconds;
+    uint8_t last_second;
+    uint8_t minutes_since_save;
+    uint8_t last_minute;
+    // status
+    bool available;
+    bool loaded;
+    bool active;
+    bool dirty;
+    sensor_hub_subscription_t subscription;
+} step_counter_state;
+
+// 14-bit samples at ±4g are 0.488 milli-g per LSB; 1999 / 4096 is close enough, and avoids a division.
+static inline int32_t _step_counter_raw_to_milli_g(int16_t raw) {
+    return ((int32_t)(raw >> 2) * 1999) >> 12;
+}
+
+static void _step_counter_save(void) {
+    if (!step_counter_state.dirty) return;
+    filesystem_write_file(step_counter_filename, (char *)step_counter_state.days, sizeof(step_counter_state.days));
+    step_counter_state.dirty = false;
+    step_counter_state.minutes_since_save = 0;
+}
+
+static void _step_counter_load(void) {
+    if (filesystem_get_file_size(step_counter_filename) == sizeof(step_counter_state.days)) {
+        filesystem_read_file(step_counter_filename, (char *)step_counter_state.days, sizeof(step_counter_state.days));
+    }
+    step_counter_state.loaded = true;
+}
+
+static void _step_counter_roll_over_if_needed(watch_date_time now) {
+    watch_date_time today = step_counter_state.days[0].date;
+
+    if (today.unit.year == now.unit.year && today.unit.month == now.unit.month && today.unit.day == now.unit.day) return;
+
+    // a new day: shift history back one slot and start today at zero.
+    memmove(&step_counter_state.days[1], &step_counter_state.days[0], sizeof(step_counter_day_t) * (STEP_COUNTER_NUM_DAYS - 1));
+    step_counter_state.days[0].date.reg = 0;
+    step_counter_state.days[0].date.unit.year = now.unit.year;
+    step_counter_state.days[0].date.unit.month = now.unit.month;
+    step_counter_state.days[0].date.unit.day = now.unit.day;
+    step_counter_state.days[0].steps = 0;
+    step_counter_state.dirty = true;
+    _step_counter_save();
+}
+
+static void _step_counter_register_peak(void) {
+    uint16_t interval = step_counter_state.samples_since_step;
+
+    // too soon after the last one; most likely the same footfall ringing through the wrist.
+    if (interval < STEP_COUNTER_MIN_INTERVAL) return;
+
+    step_counter_state.samples_since_step = 0;
+    if (interval > STEP_COUNTER_MAX_INTERVAL) {
+        step_counter_state.run_length = 1;
+        return;
+    }
+
+    if (step_counter_state.run_length < STEP_COUNTER_RUN_LENGTH) {
+        step_counter_state.run_length++;
+        // once the run is long enough to believe, count all the steps that got us here.
+        if (step_counter_state.run_length == STEP_COUNTER_RUN_LENGTH) {
+            step_counter_state.days[0].steps += STEP_COUNTER_RUN_LENGTH;
+            step_counter_state.dirty = true;
+        }
+    } else {
+        step_counter_state.days[0].steps++;
+        step_counter_state.dirty = true;
+    }
+    step_counter_state.idle_seconds = 0;
+}
+
+static void _step_counter_process_sample(lis2dw_reading_t reading) {
+    // the L1 norm is orientation-dependent, but it's cheap, and the band-pass below only cares about its swings.
+    int32_t magnitude = abs(_step_counter_raw_to_milli_g(reading.x)) +
+                        abs(_step_counter_raw_to_milli_g(reading.y)) +
+                        abs(_step_counter_raw_to_milli_g(reading.z));
+
+    // start the running mean at the first sample; from zero, it would take a second or two to climb to 1 g, and
+    // the filter would read that climb as one long swing.
+    if (!step_counter_state.baseline_seeded) {
+        step_counter_state.baseline = magnitude << 4;
+        step_counter_state.baseline_seeded = true;
+    }
+
+    // high pass: subtract a running mean with a time constant of 16 samples...
+    step_counter_state.baseline += magnitude - (step_counter_state.baseline >> 4);
+    int32_t high_passed = magnitude - (step_counter_state.baseline >> 4);
+    // ...then low pass, to knock down anything much above 4 Hz.
+    step_counter_state.filtered += (high_passed - step_counter_state.filtered) >> 1;
+
+    if (step_counter_state.samples_since_step < UINT16_MAX) step_counter_state.samples_since_step++;
+
+    if (step_counter_state.above_threshold) {
+        // once the signal swings back through the baseline, the peak is complete.
+        if (step_counter_state.filtered < 0) {
+            step_counter_state.above_threshold = false;
+            _step_counter_register_peak();
+        }
+    } else if (step_counter_state.filtered > STEP_COUNTER_THRESHOLD) {
+        step_counter_state.above_threshold = true;
+    }
+}
+
+static void _step_counter_fifo_callback(lis2dw_fifo_t *fifo, void *context) {
+    (void) context;
+    for(int8_t i = 0; i < fifo->count; i++) _step_counter_process_sample(fifo->readings[i]);
+}
+
+static void _step_counter_go_dormant(void) {
+    // the wake-up function still works at 12.5 Hz, at half the current, and we don't need the FIFO.
+    step_counter_state.subscription.data_rate = LIS2DW_DATA_RATE_12_5_HZ;
+    step_counter_state.subscription.fifo_callback = NULL;
+    step_counter_state.active = false;
+    sensor_hub_subscribe(&step_counter_state.subscription);
+}
+
+static void _step_counter_wakeup_callback(lis2dw_wakeup_source wakeup_source, void *context) {
+    (void) wakeup_source;
+    (void) context;
+    if (step_counter_state.active) {
+        step_counter_state.idle_seconds = 0;
+        return;
+    }
+    step_counter_state.baseline_seeded = false;
+    step_counter_state.filtered = 0;
+    step_counter_state.above_threshold = false;
+    step_counter_state.samples_since_step = UINT16_MAX;
+    step_counter_state.run_length = 0;
+    step_counter_state.idle_seconds = 0;
+    step_counter_state.active = true;
+    step_counter_state.subscription.data_rate = LIS2DW_DATA_RATE_25_HZ;
+    step_counter_state.subscription.fifo_callback = _step_counter_fifo_callback;
+    sensor_hub_subscribe(&step_counter_state.subscription);
+}
+
+bool step_counter_setup(void) {
+    if (!step_counter_state.loaded) _step_counter_load();
+    // after low energy mode, the sensor hub brings our subscription back on its own.
+    if (step_counter_state.available) return true;
+
+    step_counter_state.subscription.range = LIS2DW_RANGE_4_G;
+    step_counter_state.subscription.wakeup_threshold = STEP_COUNTER_WAKE_THRESHOLD;
+    step_counter_state.subscription.wakeup_callback = _step_counter_wakeup_callback;
+    step_counter_state.subscription.keep_in_low_energy = true;
+    step_counter_state.subscription.data_rate = LIS2DW_DATA_RATE_12_5_HZ;
+    step_counter_state.subscription.fifo_callback = NULL;
+    step_counter_state.active = false;
+    step_counter_state.available = sensor_hub_subscribe(&step_counter_state.subscription);
+
+    return step_counter_state.available;
+}
+
+void step_counter_handle_tick(void) {
+    if (!step_counter_state.available) return;
+
+    watch_date_time now = watch_rtc_get_date_time();
+    if (now.unit.minute != step_counter_state.last_minute) {
+        step_counter_state.last_minute = now.unit.minute;
+        _step_counter_roll_over_if_needed(now);
+        if (++step_counter_state.minutes_since_save >= STEP_COUNTER_SAVE_INTERVAL) _step_counter_save();
+    }
+
+    if (!step_counter_state.active) return;
+
+    // faces can ask for a faster tick, so only count the ticks where the second changed. the sensor hub has
+    // already handed us this tick's samples, so a step in them has reset the count by now.
+    if (now.unit.second == step_counter_state.last_second) return;
+    step_counter_state.last_second = now.unit.second;
+    if (++step_counter_state.idle_seconds >= STEP_COUNTER_IDLE_TIMEOUT) _step_counter_go_dormant();
+}
+
+void step_counter_suspend(void) {
+    if (!step_counter_state.available) return;
+
+    _step_counter_save();
+    // the sensor hub keeps the dormant subscription armed through low energy mode, so a step wakes us back up.
+    if (step_counter_state.active) _step_counter_go_dormant();
+}
+
+bool step_counter_is_counting(void) {
+    return step_counter_state.active;
+}
+
+uint32_t step_counter_get_steps(uint8_t days_ago) {
+    if (days_ago >= STEP_COUNTER_NUM_DAYS) return 0;
+    return step_counter_state.days[days_ago].steps;
+}
@@ -0,0 +1,71 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef STEP_COUNTER_H_
+#define STEP_COUNTER_H_
+#include <stdio.h>
+#include <stdbool.h>
+#include "watch.h"
+
+// Movement's step counter runs in the background as a subscriber to the sensor hub (see sensor_hub.h).
+// It stays dormant, asking only for wake-up interrupts at a low data rate, until the LIS2DW's wake-up interrupt fires.
+// Then it takes 25 Hz FIFO batches through an integer band-pass filter and peak detector on each tick,
+// and goes dormant again after a few seconds without a step. The dormant subscription stays armed in low energy mode,
+// so walking wakes Movement, which stays awake until the counter goes dormant again. To enable it, define
+// MOVEMENT_ENABLE_STEP_COUNTER in movement_config.h.
+
+#define STEP_COUNTER_NUM_DAYS 7
+
+typedef struct {
+    watch_date_time date;   // the day these steps were counted; only the date fields are used.
+    uint32_t steps;
+} step_counter_day_t;
+
+/** @brief Configures the accelerometer and the wake-up interrupt. Movement calls this at boot and after waking
+  *        from low energy mode, so you should not need to call it yourself.
+  * @return true if an accelerometer was found; false otherwise. If false, the step counter stays off.
+  */
+bool step_counter_setup(void);
+
+/** @brief Processes any pending accelerometer data. Movement calls this on every tick.
+  */
+void step_counter_handle_tick(void);
+
+/** @brief Saves the day's totals and goes dormant before Movement enters low energy mode. The wake-up interrupt
+  *        stays armed, so the next step wakes Movement and counting picks up again.
+  */
+void step_counter_suspend(void);
+
+/** @brief Returns true while the counter is taking samples, i.e. from a wake-up until a few seconds after the last
+  *        step. Movement stays out of low energy mode until this goes false.
+  */
+bool step_counter_is_counting(void);
+
+/** @brief Gets the number of steps counted on a given day.
+  * @param days_ago 0 for today, 1 for yesterday, up to STEP_COUNTER_NUM_DAYS - 1.
+  * @return The number of steps counted that day, or 0 if there is no record of it.
+  */
+uint32_t step_counter_get_steps(uint8_t days_ago);
+
+#endif // STEP_COUNTER_H_
@@ -0,0 +1,358 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "totp_vault.h"
+#include "filesystem.h"
+#include "shell.h"
+
+#define TOTP_VAULT_MAGIC 0x50544f54 // "TOTP"
+#define TOTP_VAULT_VERSION 1
+
+// The vault file is a header followed by one fixed size record per account, so an HOTP counter can be updated in place.
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t count;
+    uint16_t reserved;
+} totp_vault_header_t;
+
+typedef struct {
+    totp_vault_account_t account;
+    uint8_t key_length;
+    uint8_t reserved[3];
+    uint8_t key[TOTP_VAULT_MAX_KEY_LENGTH];
+} totp_vault_record_t;
+
+// In RAM we only keep the settings, plus the HMAC context once an account has been used.
+typedef struct {
+    totp_vault_account_t account;
+    bool has_context;
+    totp_key_context context;
+} totp_vault_entry_t;
+
+static char totp_vault_filename[] = "totp.dat";
+
+static struct {
+    bool loaded;
+    uint8_t count;
+    totp_vault_entry_t *entries;
+} totp_vault_state;
+
+static int _totp_vault_cmd(int argc, char *argv[]);
+
+static const shell_command_t totp_vault_command = {
+    .name = "totp",
+    .usage = "totp [list | add label base32secret [digits] [period] [sha1|sha256] | rm label]",
+    .min_args = 0,
+    .max_args = 6,
+    .handler = _totp_vault_cmd,
+};
+
+static inline totp_vault_record_t *_totp_vault_records(char *buf) {
+    return (totp_vault_record_t *)(buf + sizeof(totp_vault_header_t));
+}
+
+// Checks a record read back from the file against what _totp_vault_add would have written. Any period is valid:
+// 0 is an HOTP account, and the rest of the 16-bit range is seconds.
+static bool _totp_vault_record_is_valid(const totp_vault_record_t *record) {
+    return record->key_length > 0 && record->key_length <= TOTP_VAULT_MAX_KEY_LENGTH &&
+           record->account.digits >= 6 && record->account.digits <= 8 &&
+           (record->account.algorithm == TOTP_SHA1 || record->account.algorithm == TOTP_SHA256);
+}
+
+// Reads the whole vault file into a new buffer, with room for extra_records more records at the end.
+// Returns NULL if there is no valid vault; otherwise the caller must free the buffer.
+static char *_totp_vault_read(uint8_t extra_records) {
+    int32_t size = filesystem_get_file_size(totp_vault_filename);
+    if (size < (int32_t)sizeof(totp_vault_header_t)) return NULL;
+
+    char *buf = malloc(size + extra_records * sizeof(totp_vault_record_t));
+    if (buf == NULL) return NULL;
+
+    totp_vault_header_t *header = (totp_vault_header_t *)buf;
+    if (!filesystem_read_file(totp_vault_filename, buf, size) ||
+        header->magic != TOTP_VAULT_MAGIC ||
+        header->version != TOTP_VAULT_VERSION ||
+        header->count > TOTP_VAULT_MAX_ACCOUNTS ||
+        size != (int32_t)(sizeof(totp_vault_header_t) + header->count * sizeof(totp_vault_record_t))) {
+        free(buf);
+        return NULL;
+    }
+    // a record that doesn't make sense would have the HMAC read past its key, so don't trust any of the file.
+    for(uint8_t i = 0; i < header->count; i++) {
+        if (!_totp_vault_record_is_valid(&_totp_vault_records(buf)[i])) {
+            free(buf);
+            return NULL;
+        }
+    }
+
+    return buf;
+}
+
+static bool _totp_vault_write(char *buf) {
+    totp_vault_header_t *header = (totp_vault_header_t *)buf;
+    int32_t size = sizeof(totp_vault_header_t) + header->count * sizeof(totp_vault_record_t);
+    return filesystem_write_file(totp_vault_filename, buf, size);
+}
+
+// (Re)loads the account settings, and forgets any cached contexts.
+static void _totp_vault_load(void) {
+    free(totp_vault_state.entries);
+    totp_vault_state.entries = NULL;
+    totp_vault_state.count = 0;
+    totp_vault_state.loaded = true;
+
+    char *buf = _totp_vault_read(0);
+    if (buf == NULL) return;
+
+    uint8_t count = ((totp_vault_header_t *)buf)->count;
+    if (count) totp_vault_state.entries = calloc(count, sizeof(totp_vault_entry_t));
+    if (totp_vault_state.entries != NULL) {
+        totp_vault_record_t *records = _totp_vault_records(buf);
+        for(uint8_t i = 0; i < count; i++) {
+            totp_vault_state.entries[i].account = records[i].account;
+        }
+        totp_vault_state.count = count;
+    }
+    free(buf);
+}
+
+static totp_key_context *_totp_vault_get_context(uint8_t index) {
+    totp_vault_entry_t *entry = &totp_vault_state.entries[index];
+
+    if (!entry->has_context) {
+        char *buf = _totp_vault_read(0);
+        if (buf == NULL) return NULL;
+        if (index < ((totp_vault_header_t *)buf)->count) {
+            totp_vault_record_t *record = &_totp_vault_records(buf)[index];
+            initKeyContextWithOptions(&entry->context, record->key, record->key_length, record->account.period,
+                                      record->account.digits, (totp_algorithm_t)record->account.algorithm);
+            entry->has_context = true;
+        }
+        free(buf);
+    }
+
+    return entry->has_context ? &entry->context : NULL;
+}
+
+void totp_vault_init(void) {
+    if (!totp_vault_state.loaded) _totp_vault_load();
+    shell_register_command(&totp_vault_command);
+}
+
+uint8_t totp_vault_get_count(void) {
+    return totp_vault_state.count;
+}
+
+const totp_vault_account_t *totp_vault_get_account(uint8_t index) {
+    if (index >= totp_vault_state.count) return NULL;
+    return &totp_vault_state.entries[index].account;
+}
+
+uint32_t totp_vault_get_code(uint8_t index, uint32_t timestamp) {
+    if (index >= totp_vault_state.count) return 0;
+    totp_key_context *context = _totp_vault_get_context(index);
+    if (context == NULL) return 0;
+
+    totp_vault_account_t *account = &totp_vault_state.entries[index].account;
+    if (account->period == 0) return getCodeFromContextSteps(context, account->counter);
+    return getCodeFromContextTimestamp(context, timestamp);
+}
+
+bool totp_vault_advance_counter(uint8_t index) {
+    if (index >= totp_vault_state.count || totp_vault_state.entries[index].account.period != 0) return false;
+
+    char *buf = _totp_vault_read(0);
+    if (buf == NULL) return false;
+
+    bool success = false;
+    if (index < ((totp_vault_header_t *)buf)->count) {
+        totp_vault_record_t *record = &_totp_vault_records(buf)[index];
+        record->account.counter++;
+        if (_totp_vault_write(buf)) {
+            totp_vault_state.entries[index].account.counter = record->account.counter;
+            success = true;
+        }
+    }
+    free(buf);
+
+    return success;
+}
+
+static int _totp_vault_base32_decode(const char *in, uint8_t *out, size_t max_length) {
+    uint32_t bits = 0;
+    uint8_t num_bits = 0;
+    size_t length = 0;
+
+    for(; *in && *in != '='; in++) {
+        char c = *in;
+        uint8_t value;
+        if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+        if (c >= 'A' && c <= 'Z') value = c - 'A';
+        else if (c >= '2' && c <= '7') value = c - '2' + 26;
+        else if (c == '-') continue;    // some services group the secret with dashes
+        else return -1;
+
+        bits = (bits << 5) | value;
+        num_bits += 5;
+        if (num_bits >= 8) {
+            if (length == max_length) return -1;
+            num_bits -= 8;
+            out[length++] = bits >> num_bits;
+        }
+    }
+
+    return length;
+}
+
+static int _totp_vault_find(char *buf, const char *label) {
+    totp_vault_record_t *records = _totp_vault_records(buf);
+    for(uint8_t i = 0; i < ((totp_vault_header_t *)buf)->count; i++) {
+        if (records[i].account.label[0] == label[0] && records[i].account.label[1] == label[1]) return i;
+    }
+    return -1;
+}
+
+static int _totp_vault_list(void) {
+    if (totp_vault_state.count == 0) {
+        printf("no accounts\n");
+        return 0;
+    }
+    for(uint8_t i = 0; i < totp_vault_state.count; i++) {
+        totp_vault_account_t *account = &totp_vault_state.entries[i].account;
+        printf("%c%c  %d digits  ", account->label[0], account->label[1], account->digits);
+        if (account->period) printf("%d s", account->period);
+        else printf("counter %lu", (unsigned long)account->counter);
+        printf("  %s\n", account->algorithm == TOTP_SHA256 ? "sha256" : "sha1");
+    }
+    return 0;
+}
+
+static int _totp_vault_add(int argc, char *argv[]) {
+    totp_vault_record_t record;
+    memset(&record, 0, sizeof(record));
+
+    size_t label_length = strlen(argv[0]);
+    if (label_length < 1 || label_length > 2) {
+        printf("the label must be one or two characters\n");
+        return 1;
+    }
+    record.account.label[0] = argv[0][0];
+    record.account.label[1] = label_length == 2 ? argv[0][1] : ' ';
+
+    int key_length = _totp_vault_base32_decode(argv[1], record.key, TOTP_VAULT_MAX_KEY_LENGTH);
+    if (key_length <= 0) {
+        printf("the secret must be base32, at most %d bytes long\n", TOTP_VAULT_MAX_KEY_LENGTH);
+        return 1;
+    }
+    record.key_length = key_length;
+
+    // the display has room for up to eight digits
+    record.account.digits = argc > 2 ? atoi(argv[2]) : 6;
+    if (record.account.digits < 6 || record.account.digits > 8) {
+        printf("digits must be 6, 7 or 8\n");
+        return 1;
+    }
+    int period = argc > 3 ? atoi(argv[3]) : 30;
+    if (period < 0 || period > UINT16_MAX) {
+        printf("invalid period\n");
+        return 1;
+    }
+    record.account.period = period;
+    record.account.algorithm = TOTP_SHA1;
+    if (argc > 4) {
+        if (strcmp(argv[4], "sha256") == 0) record.account.algorithm = TOTP_SHA256;
+        else if (strcmp(argv[4], "sha1") != 0) {
+            printf("the algorithm must be sha1 or sha256\n");
+            return 1;
+        }
+    }
+
+    char *buf = _totp_vault_read(1);
+    if (buf == NULL) {
+        // no vault yet (or an unreadable one): start a new one.
+        buf = malloc(sizeof(totp_vault_header_t) + sizeof(totp_vault_record_t));
+        if (buf == NULL) return 1;
+        totp_vault_header_t *header = (totp_vault_header_t *)buf;
+        header->magic = TOTP_VAULT_MAGIC;
+        header->version = TOTP_VAULT_VERSION;
+        header->count = 0;
+        header->reserved = 0;
+    }
+
+    // adding an existing label replaces that account, which is how you rotate a secret.
+    totp_vault_header_t *header = (totp_vault_header_t *)buf;
+    int index = _totp_vault_find(buf, record.account.label);
+    if (index < 0) {
+        if (header->count == TOTP_VAULT_MAX_ACCOUNTS) {
+            printf("the vault is full\n");
+            free(buf);
+            return 1;
+        }
+        index = header->count++;
+    }
+    _totp_vault_records(buf)[index] = record;
+
+    bool success = _totp_vault_write(buf);
+    free(buf);
+    _totp_vault_load();
+
+    return success ? 0 : 1;
+}
+
+static int _totp_vault_remove(const char *label) {
+    char *buf = _totp_vault_read(0);
+    int index = -1;
+    if (buf != NULL && strlen(label) <= 2) {
+        char padded[2] = { label[0], label[1] ? label[1] : ' ' };
+        index = _totp_vault_find(buf, padded);
+    }
+    if (index < 0) {
+        printf("no such account\n");
+        free(buf);
+        return 1;
+    }
+
+    totp_vault_header_t *header = (totp_vault_header_t *)buf;
+    totp_vault_record_t *records = _totp_vault_records(buf);
+    header->count--;
+    memmove(&records[index], &records[index + 1], (header->count - index) * sizeof(totp_vault_record_t));
+
+    bool success = _totp_vault_write(buf);
+    free(buf);
+    _totp_vault_load();
+
+    return success ? 0 : 1;
+}
+
+static int _totp_vault_cmd(int argc, char *argv[]) {
+    if (argc == 1 || (argc == 2 && strcmp(argv[1], "list") == 0)) return _totp_vault_list();
+    if (argc >= 4 && strcmp(argv[1], "add") == 0) return _totp_vault_add(argc - 2, argv + 2);
+    if (argc == 3 && strcmp(argv[1], "rm") == 0) return _totp_vault_remove(argv[2]);
+
+    printf("usage: %s\n", totp_vault_command.usage);
+    return 1;
+}
@@ -0,0 +1,86 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TOTP_VAULT_H_
+#define TOTP_VAULT_H_
+#include <stdio.h>
+#include <stdbool.h>
+#include "watch.h"
+#include "TOTP.h"
+
+// The TOTP vault keeps one-time password accounts in a file on the filesystem, so they can be added and removed
+// over USB without reflashing the watch. From the serial console:
+//
+//   totp add ab JBSWY3DPEHPK3PXP          adds account "ab": 6 digits, 30 second period, SHA-1
+//   totp add cd <secret> 8 60 sha256      sets digits (6-8), period in seconds and algorithm (sha1 or sha256)
+//   totp add ef <secret> 6 0              a period of 0 makes it a counter based (HOTP) account
+//   totp list
+//   totp rm ab
+//
+// Secrets are given in base32, as most services show them. The file holds the decoded keys, not anything derived
+// from them, so anyone with access to the USB shell can read them back; treat the watch accordingly.
+//
+// Hashing the key into an HMAC context is the expensive part of making a code, so the vault does it on first use
+// of each account and keeps the result in RAM, making later codes and account switches cheap.
+
+#define TOTP_VAULT_MAX_ACCOUNTS 16
+#define TOTP_VAULT_MAX_KEY_LENGTH 64
+
+typedef struct {
+    char label[2];          // shown in the top left of the display
+    uint8_t digits;
+    uint8_t algorithm;      // a totp_algorithm_t
+    uint16_t period;        // seconds per code, or 0 for a counter based (HOTP) account
+    uint32_t counter;       // HOTP only: the counter value of the current code
+} totp_vault_account_t;
+
+/** @brief Loads the vault and adds the totp command to the USB shell. Calling it again is harmless.
+  */
+void totp_vault_init(void);
+
+/** @brief Gets the number of accounts in the vault.
+  */
+uint8_t totp_vault_get_count(void);
+
+/** @brief Gets an account's settings.
+  * @param index The account, from 0 to totp_vault_get_count() - 1.
+  * @return The account, or NULL if there is no such account.
+  */
+const totp_vault_account_t *totp_vault_get_account(uint8_t index);
+
+/** @brief Generates an account's current code.
+  * @param index The account, from 0 to totp_vault_get_count() - 1.
+  * @param timestamp The current UTC time as a UNIX timestamp. Ignored for HOTP accounts.
+  * @return The code, or 0 if there is no such account.
+  */
+uint32_t totp_vault_get_code(uint8_t index, uint32_t timestamp);
+
+/** @brief Moves an HOTP account on to its next code, and saves the new counter value.
+  * @param index The account, from 0 to totp_vault_get_count() - 1.
+  * @return true if the counter was advanced and saved; false if the account doesn't exist, isn't an HOTP account,
+  *         or the vault could not be written.
+  */
+bool totp_vault_advance_counter(uint8_t index);
+
+#endif // TOTP_VAULT_H_
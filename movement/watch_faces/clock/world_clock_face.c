@@ -66,9 +66,8 @@ static bool world_clock_face_do_display_mode(movement_event_t event, movement_se
             // fall through
         case EVENT_TICK:
         case EVENT_LOW_ENERGY_UPDATE:
-            date_time = watch_rtc_get_date_time();
-            timestamp = watch_utility_date_time_to_unix_time(date_time, movement_timezone_offsets[settings->bit.time_zone] * 60);
-            date_time = watch_utility_date_time_from_unix_time(timestamp, movement_timezone_offsets[state->settings.bit.timezone_index] * 60);
+            timestamp = movement_get_utc_timestamp();
+            date_time = watch_utility_date_time_from_unix_time(timestamp, movement_get_timezone_offset(state->settings.bit.timezone_index, timestamp));
             previous_date_time = state->previous_date_time;
             state->previous_date_time = date_time.reg;
 
@@ -162,7 +161,7 @@ static bool _world_clock_face_do_settings_mode(movement_event_t event, movement_
                     break;
                 case 3:
                     state->settings.bit.timezone_index++;
-                    if (state->settings.bit.timezone_index > 40) state->settings.bit.timezone_index = 0;
+                    if (state->settings.bit.timezone_index >= MOVEMENT_NUM_TIMEZONES) state->settings.bit.timezone_index = 0;
                     break;
             }
             break;
@@ -174,11 +173,14 @@ static bool _world_clock_face_do_settings_mode(movement_event_t event, movement_
     }
 
     char buf[13];
-    sprintf(buf, "%c%c %3d%02d  ",
+    int16_t offset = movement_get_timezone_offset(state->settings.bit.timezone_index, movement_get_utc_timestamp()) / 60;
+    const char *code = movement_get_timezone_code(state->settings.bit.timezone_index);
+    sprintf(buf, "%c%c %3d%02d%s",
         movement_valid_position_0_chars[state->settings.bit.char_0],
         movement_valid_position_1_chars[state->settings.bit.char_1],
-        (int8_t) (movement_timezone_offsets[state->settings.bit.timezone_index] / 60),
-        (int8_t) (movement_timezone_offsets[state->settings.bit.timezone_index] % 60) * (movement_timezone_offsets[state->settings.bit.timezone_index] < 0 ? -1 : 1));
+        (int8_t) (offset / 60),
+        (int8_t) (offset % 60) * (offset < 0 ? -1 : 1),
+        code ? code : "  ");
     watch_set_colon();
     watch_clear_indicator(WATCH_INDICATOR_PM);
 
@@ -28,6 +28,7 @@
 #include <math.h>
 #include "astronomy_face.h"
 #include "watch_utility.h"
+#include "shell.h"
 
 #if __EMSCRIPTEN__
 #include <emscripten.h>
@@ -59,7 +60,67 @@ static const char astronomy_celestial_body_names[NUM_AVAILABLE_BODIES][3] = {
     "NE"    // Neptune
 };
 
+static astronomy_state_t *astronomy_bench_state;
+
+static int _astronomy_face_bench_cmd(int argc, char *argv[]);
+
+static const shell_command_t astronomy_bench_command = {
+    .name = "astrobench",
+    .usage = "astrobench [runs]",
+    .min_args = 0,
+    .max_args = 1,
+    .handler = _astronomy_face_bench_cmd,
+};
+
+// just the math, without the printouts; the benchmark times this.
+static void _astronomy_face_calculate(astronomy_state_t *state, double jd, astro_equatorial_coordinates_t *radec_precession, astro_equatorial_coordinates_t *radec) {
+    *radec_precession = astro_get_ra_dec(jd, astronomy_available_celestial_bodies[state->active_body_index], state->latitude_radians, state->longitude_radians, true);
+    astro_horizontal_coordinates_t horiz = astro_ra_dec_to_alt_az(jd, state->latitude_radians, state->longitude_radians, radec_precession->right_ascension, radec_precession->declination);
+    *radec = astro_get_ra_dec(jd, astronomy_available_celestial_bodies[state->active_body_index], state->latitude_radians, state->longitude_radians, false);
+    state->altitude = astro_radians_to_degrees(horiz.altitude);
+    state->azimuth = astro_radians_to_degrees(horiz.azimuth);
+    state->right_ascension = astro_radians_to_hms(radec->right_ascension);
+    state->declination = astro_radians_to_dms(radec->declination);
+    state->distance = radec->distance;
+}
+
+static double _astronomy_face_julian_date_now(void) {
+    watch_date_time date_time = movement_get_utc_date_time();
+    return astro_convert_date_to_julian_date(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day, date_time.unit.hour, date_time.unit.minute, date_time.unit.second);
+}
+
+// times the calculation for the selected body at the usual clock and boosted. cycles are the elapsed time at the clock
+// speed; the watch doesn't measure its own current, so compare energy on a bench supply.
+static int _astronomy_face_bench_cmd(int argc, char *argv[]) {
+    int runs = argc > 1 ? atoi(argv[1]) : 3;
+    if (runs < 1 || runs > 100) {
+        printf("usage: %s\n", astronomy_bench_command.usage);
+        return 1;
+    }
+
+    // work on a copy, so the face's own results are left alone.
+    astronomy_state_t scratch = *astronomy_bench_state;
+    astro_equatorial_coordinates_t radec_precession, radec;
+    double jd = _astronomy_face_julian_date_now();
+
+    for(uint8_t boosted = 0; boosted < 2; boosted++) {
+        if (boosted) watch_performance_boost();
+        uint32_t frequency = watch_get_cpu_frequency();
+        uint32_t start = watch_rtc_get_timestamp();
+        for(int i = 0; i < runs; i++) _astronomy_face_calculate(&scratch, jd, &radec_precession, &radec);
+        uint32_t ticks = watch_rtc_get_timestamp() - start;
+        if (boosted) watch_performance_restore();
+
+        uint32_t ms = ticks * 1000 / (WATCH_RTC_TIMESTAMP_FREQUENCY * runs);
+        uint32_t kilocycles = (uint64_t)ticks * (frequency / 1000) / (WATCH_RTC_TIMESTAMP_FREQUENCY * runs);
+        printf("%2lu MHz: %lu ms, %lu kcycles per recompute\n", frequency / 1000000, ms, kilocycles);
+    }
+
+    return 0;
+}
+
 static void _astronomy_face_recalculate(movement_settings_t *settings, astronomy_state_t *state) {
+    (void) settings;
 #if __EMSCRIPTEN__
     int16_t browser_lat = EM_ASM_INT({
         return lat;
@@ -79,12 +140,14 @@ static void _astronomy_face_recalculate(movement_settings_t *settings, astronomy
     }
 #endif
 
-    watch_date_time date_time = watch_rtc_get_date_time();
-    uint32_t timestamp = watch_utility_date_time_to_unix_time(date_time, movement_timezone_offsets[settings->bit.time_zone] * 60);
-    date_time = watch_utility_date_time_from_unix_time(timestamp, 0);
-    double jd = astro_convert_date_to_julian_date(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day, date_time.unit.hour, date_time.unit.minute, date_time.unit.second);
+    double jd = _astronomy_face_julian_date_now();
+    astro_equatorial_coordinates_t radec_precession, radec;
+
+    // soft-float trig takes seconds at 4 MHz; at 16 it's over sooner, and costs less charge all told.
+    watch_performance_boost();
+    _astronomy_face_calculate(state, jd, &radec_precession, &radec);
+    watch_performance_restore();
 
-    astro_equatorial_coordinates_t radec_precession = astro_get_ra_dec(jd, astronomy_available_celestial_bodies[state->active_body_index], state->latitude_radians, state->longitude_radians, true);
     printf("\nParams to convert: %f %f %f %f %f\n",
             jd,
             astro_radians_to_degrees(state->latitude_radians),
@@ -92,14 +155,6 @@ static void _astronomy_face_recalculate(movement_settings_t *settings, astronomy
             astro_radians_to_degrees(radec_precession.right_ascension),
             astro_radians_to_degrees(radec_precession.declination));
 
-    astro_horizontal_coordinates_t horiz = astro_ra_dec_to_alt_az(jd, state->latitude_radians, state->longitude_radians, radec_precession.right_ascension, radec_precession.declination);
-    astro_equatorial_coordinates_t radec = astro_get_ra_dec(jd, astronomy_available_celestial_bodies[state->active_body_index], state->latitude_radians, state->longitude_radians, false);
-    state->altitude = astro_radians_to_degrees(horiz.altitude);
-    state->azimuth = astro_radians_to_degrees(horiz.azimuth);
-    state->right_ascension = astro_radians_to_hms(radec.right_ascension);
-    state->declination = astro_radians_to_dms(radec.declination);
-    state->distance = radec.distance;
-
     printf("Calculated coordinates for %s on %f: \n\tRA  = %f / %2dh %2dm %2ds\n\tDec = %f / %3d° %3d' %3d\"\n\tAzi = %f\n\tAlt = %f\n\tDst = %f AU\n",
             astronomy_celestial_body_names[state->active_body_index],
             jd,
@@ -194,6 +249,9 @@ void astronomy_face_setup(movement_settings_t *settings, uint8_t watch_face_inde
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(astronomy_state_t));
         memset(*context_ptr, 0, sizeof(astronomy_state_t));
+        // the context lives as long as the watch is on, so the command only needs registering the first time.
+        astronomy_bench_state = (astronomy_state_t *)*context_ptr;
+        shell_register_command(&astronomy_bench_command);
     }
 }
 
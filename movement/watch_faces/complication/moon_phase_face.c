@@ -58,9 +58,8 @@ void moon_phase_face_activate(movement_settings_t *settings, void *context) {
 static void _update(movement_settings_t *settings, moon_phase_state_t *state, uint32_t offset) {
     (void)state;
     char buf[11];
-    watch_date_time date_time = watch_rtc_get_date_time();
-    uint32_t now = watch_utility_date_time_to_unix_time(date_time, movement_timezone_offsets[settings->bit.time_zone] * 60) + offset;
-    date_time = watch_utility_date_time_from_unix_time(now, movement_timezone_offsets[settings->bit.time_zone] * 60);
+    uint32_t now = movement_get_utc_timestamp() + offset;
+    watch_date_time date_time = offset ? watch_utility_date_time_from_unix_time(now, movement_get_timezone_offset(settings->bit.time_zone, now)) : movement_get_local_date_time();
     double currentfrac = fmod(now - FIRST_MOON, LUNAR_SECONDS) / LUNAR_SECONDS;
     double currentday = currentfrac * LUNAR_DAYS;
     uint8_t phase_index = 0;
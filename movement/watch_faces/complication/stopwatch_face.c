@@ -38,22 +38,32 @@ void stopwatch_face_setup(movement_settings_t *settings, uint8_t watch_face_inde
     }
 }
 
+// while the stopwatch runs in its first day, tick fast enough to keep the hundredths moving; otherwise once a second.
+static void _stopwatch_face_update_tick_frequency(stopwatch_state_t *stopwatch_state) {
+    uint8_t tick_frequency = 1;
+    if (stopwatch_state->running && stopwatch_state->ticks_counted < 86400 * WATCH_RTC_TIMESTAMP_FREQUENCY) {
+        tick_frequency = STOPWATCH_FACE_FAST_TICK_FREQUENCY;
+    }
+    if (tick_frequency != stopwatch_state->tick_frequency) {
+        stopwatch_state->tick_frequency = tick_frequency;
+        movement_request_tick_frequency(tick_frequency);
+    }
+}
+
 static void _stopwatch_face_update_display(stopwatch_state_t *stopwatch_state, bool show_seconds) {
     if (stopwatch_state->running) {
-        watch_date_time now = watch_rtc_get_date_time();
-        uint32_t now_timestamp = watch_utility_date_time_to_unix_time(now, 0);
-        uint32_t start_timestamp = watch_utility_date_time_to_unix_time(stopwatch_state->start_time, 0);
-        stopwatch_state->seconds_counted = now_timestamp - start_timestamp;
+        stopwatch_state->ticks_counted = watch_rtc_get_timestamp() - stopwatch_state->start_timestamp;
     }
+    uint32_t seconds_counted = stopwatch_state->ticks_counted / WATCH_RTC_TIMESTAMP_FREQUENCY;
 
-    if (stopwatch_state->seconds_counted >= 3456000) {
+    if (seconds_counted >= 3456000) {
         // display maxes out just shy of 40 days, thanks to the limit on the day digits (0-39)
         stopwatch_state->running = false;
         watch_display_string("st39235959", 0);
         return;
     }
 
-    watch_duration_t duration = watch_utility_seconds_to_duration(stopwatch_state->seconds_counted);
+    watch_duration_t duration = watch_utility_seconds_to_duration(seconds_counted);
     char buf[14];
 
     sprintf(buf, "st  %02d%02d  ", duration.hours, duration.minutes);
@@ -62,6 +72,10 @@ static void _stopwatch_face_update_display(stopwatch_state_t *stopwatch_state, b
     if (duration.days != 0) {
         sprintf(buf, "%2d", (uint8_t)duration.days);
         watch_display_string(buf, 2);
+    } else if (show_seconds) {
+        // in the first day, the hundredths go where the days would be.
+        sprintf(buf, "%02d", (uint8_t)((stopwatch_state->ticks_counted % WATCH_RTC_TIMESTAMP_FREQUENCY) * 100 / WATCH_RTC_TIMESTAMP_FREQUENCY));
+        watch_display_string(buf, 2);
     }
 
     if (show_seconds) {
@@ -72,8 +86,10 @@ static void _stopwatch_face_update_display(stopwatch_state_t *stopwatch_state, b
 
 void stopwatch_face_activate(movement_settings_t *settings, void *context) {
     (void) settings;
-    (void) context;
+    stopwatch_state_t *stopwatch_state = (stopwatch_state_t *)context;
     if (watch_tick_animation_is_running()) watch_stop_tick_animation();
+    // Movement puts us back on a 1 Hz tick whenever we're activated.
+    stopwatch_state->tick_frequency = 1;
 }
 
 bool stopwatch_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
@@ -85,11 +101,12 @@ bool stopwatch_face_loop(movement_event_t event, movement_settings_t *settings,
             watch_set_colon();
             // fall through
         case EVENT_TICK:
-            if (stopwatch_state->start_time.reg == 0) {
+            if (!stopwatch_state->running && stopwatch_state->ticks_counted == 0) {
                 watch_display_string("st  000000", 0);
             } else {
                 _stopwatch_face_update_display(stopwatch_state, true);
             }
+            _stopwatch_face_update_tick_frequency(stopwatch_state);
             break;
         case EVENT_MODE_BUTTON_UP:
             movement_move_to_next_face();
@@ -97,29 +114,27 @@ bool stopwatch_face_loop(movement_event_t event, movement_settings_t *settings,
         case EVENT_LIGHT_BUTTON_DOWN:
             movement_illuminate_led();
             if (!stopwatch_state->running) {
-                stopwatch_state->start_time.reg = 0;
-                stopwatch_state->seconds_counted = 0;
+                stopwatch_state->ticks_counted = 0;
                 watch_display_string("st  000000", 0);
             }
             break;
         case EVENT_ALARM_BUTTON_DOWN:
+        {
+            // take the timestamp first thing, so the time it takes to update the display doesn't count.
+            uint32_t now = watch_rtc_get_timestamp();
             stopwatch_state->running = !stopwatch_state->running;
             if (stopwatch_state->running) {
-                // we're running now, so we need to set the start_time.
-                if (stopwatch_state->start_time.reg == 0) {
-                    // if starting from the reset state, easy: we start now.
-                    stopwatch_state->start_time = watch_rtc_get_date_time();
-                } else {
-                    // if resuming with time already on the clock, the original start time isn't valid anymore!
-                    // so let's fetch the current time...
-                    uint32_t timestamp = watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), 0);
-                    // ...subtract the seconds we've already counted...
-                    timestamp -= stopwatch_state->seconds_counted;
-                    // and resume from the "virtual" start time that's that many seconds ago.
-                    stopwatch_state->start_time = watch_utility_date_time_from_unix_time(timestamp, 0);
-                }
+                // we're running now, so we need to set the start timestamp. if resuming with time already on the
+                // clock, we resume from the "virtual" start that's that much time ago (from the reset state, that's now).
+                stopwatch_state->start_timestamp = now - stopwatch_state->ticks_counted;
+            } else {
+                // stopping: freeze the count to the press, and show it down to the hundredth.
+                stopwatch_state->ticks_counted = now - stopwatch_state->start_timestamp;
+                _stopwatch_face_update_display(stopwatch_state, true);
             }
+            _stopwatch_face_update_tick_frequency(stopwatch_state);
             break;
+        }
         case EVENT_TIMEOUT:
             // explicitly ignore the timeout event so we stay on screen
             break;
@@ -30,10 +30,14 @@
 
 typedef struct {
     bool running;
-    watch_date_time start_time; // while running, show the difference between this time and now
-    uint32_t seconds_counted;   // set this value when paused, and show that instead.
+    uint32_t start_timestamp;   // while running, show the difference between this timestamp and now
+    uint32_t ticks_counted;     // set this value when paused, and show that instead (in 1/1024ths of a second).
+    uint8_t tick_frequency;     // the tick frequency we last asked Movement for
 } stopwatch_state_t;
 
+// the tick frequency while running, which is how often the hundredths change on screen.
+#define STOPWATCH_FACE_FAST_TICK_FREQUENCY 16
+
 void stopwatch_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
 void stopwatch_face_activate(movement_settings_t *settings, void *context);
 bool stopwatch_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
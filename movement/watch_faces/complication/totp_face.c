@@ -3,67 +3,75 @@
 #include "totp_face.h"
 #include "watch.h"
 #include "watch_utility.h"
-#include "TOTP.h"
-
-// Use https://cryptii.com/pipes/base32-to-hex to convert base32 to hex
-// Use https://totp.danhersam.com/ to generate test codes for verification
-
-static const uint8_t num_keys = 2;
-static uint8_t keys[] = {
-    0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x21, 0xde, 0xad, 0xbe, 0xef, // 1 - JBSWY3DPEHPK3PXP
-    0x5c, 0x0d, 0x27, 0x6b, 0x6d, 0x9a, 0x01, 0x22, 0x20, 0x4f  // 2 - E9M348K0ADIDFBC2
-};
-static const uint8_t key_sizes[] = {
-    10,
-    10
-};
-static const uint32_t timesteps[] = {
-    30,
-    30
-};
-static const char labels[][2] = {
-    { 'a', 'b' },
-    { 'c', 'd' }
-};
+#include "totp_vault.h"
 
 void totp_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
+    totp_vault_init();
     if (*context_ptr == NULL) *context_ptr = malloc(sizeof(totp_state_t));
 }
 
+static void _totp_face_update_code(totp_state_t *totp_state) {
+    const totp_vault_account_t *account = totp_vault_get_account(totp_state->current_index);
+    if (account == NULL) return;
+    totp_state->steps = account->period ? totp_state->timestamp / account->period : account->counter;
+    totp_state->current_code = totp_vault_get_code(totp_state->current_index, totp_state->timestamp);
+}
+
+static void _totp_face_display(totp_state_t *totp_state) {
+    const totp_vault_account_t *account = totp_vault_get_account(totp_state->current_index);
+    char code[10];
+    char buf[14];
+
+    if (account == NULL) {
+        watch_display_string("2F  no key", 0);
+        return;
+    }
+
+    if (account->period) {
+        uint32_t steps = totp_state->timestamp / account->period;
+        if (steps != totp_state->steps) _totp_face_update_code(totp_state);
+    }
+    sprintf(code, "%0*lu", account->digits, totp_state->current_code);
+    if (account->digits > 6) {
+        // long codes take over the top right digits
+        sprintf(buf, "%c%c%8s", account->label[0], account->label[1], code);
+    } else if (account->period) {
+        uint8_t valid_for = account->period - totp_state->timestamp % account->period;
+        sprintf(buf, "%c%c%2d%6s", account->label[0], account->label[1], valid_for % 100, code);
+    } else {
+        sprintf(buf, "%c%c%2lu%6s", account->label[0], account->label[1], account->counter % 100, code);
+    }
+
+    watch_display_string(buf, 0);
+}
+
 void totp_face_activate(movement_settings_t *settings, void *context) {
     (void) settings;
     memset(context, 0, sizeof(totp_state_t));
     totp_state_t *totp_state = (totp_state_t *)context;
-    TOTP(keys, key_sizes[0], timesteps[0]);
-    totp_state->timestamp = watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), movement_timezone_offsets[settings->bit.time_zone] * 60);
-    totp_state->current_code = getCodeFromTimestamp(totp_state->timestamp);
+    totp_state->timestamp = movement_get_utc_timestamp();
+    _totp_face_update_code(totp_state);
 }
 
 bool totp_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
     (void) settings;
 
     totp_state_t *totp_state = (totp_state_t *)context;
-    char buf[14];
-    uint8_t valid_for;
-    div_t result;
-    uint8_t index = totp_state->current_index;
+
+    // accounts can come and go over USB while we're on screen
+    if (totp_state->current_index >= totp_vault_get_count()) {
+        totp_state->current_index = 0;
+        _totp_face_update_code(totp_state);
+    }
 
     switch (event.event_type) {
         case EVENT_TICK:
             totp_state->timestamp++;
             // fall through
         case EVENT_ACTIVATE:
-            result = div(totp_state->timestamp, timesteps[index]);
-            if (result.quot != totp_state->steps) {
-                totp_state->current_code = getCodeFromTimestamp(totp_state->timestamp);
-                totp_state->steps = result.quot;
-            }
-            valid_for = timesteps[index] - result.rem;
-            sprintf(buf, "%c%c%2d%06lu", labels[index][0], labels[index][1], valid_for, totp_state->current_code);
-
-            watch_display_string(buf, 0);
+            _totp_face_display(totp_state);
             break;
         case EVENT_MODE_BUTTON_UP:
             movement_move_to_next_face();
@@ -75,18 +83,22 @@ bool totp_face_loop(movement_event_t event, movement_settings_t *settings, void
             movement_move_to_face(0);
             break;
         case EVENT_ALARM_BUTTON_UP:
-            if (index + 1 < num_keys) {
-                totp_state->current_key_offset += key_sizes[index];
+            if (totp_state->current_index + 1 < totp_vault_get_count()) {
                 totp_state->current_index++;
             } else {
-                // wrap around to first key
-                totp_state->current_key_offset = 0;
+                // wrap around to first account
                 totp_state->current_index = 0;
             }
-            TOTP(keys + totp_state->current_key_offset, key_sizes[totp_state->current_index], timesteps[totp_state->current_index]);
+            _totp_face_update_code(totp_state);
+            _totp_face_display(totp_state);
             break;
-        case EVENT_ALARM_BUTTON_DOWN:
         case EVENT_ALARM_LONG_PRESS:
+            if (totp_vault_advance_counter(totp_state->current_index)) {
+                _totp_face_update_code(totp_state);
+                _totp_face_display(totp_state);
+            }
+            break;
+        case EVENT_ALARM_BUTTON_DOWN:
         default:
             break;
     }
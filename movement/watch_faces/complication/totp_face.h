@@ -3,12 +3,15 @@
 
 #include "movement.h"
 
+// Shows one-time passwords for the accounts in the TOTP vault (see totp_vault.h for adding them over USB).
+// ALARM moves to the next account. For time based accounts, the top right shows how many seconds the code has left;
+// for counter based (HOTP) accounts, it shows the counter, and a long press on ALARM moves on to the next code.
+
 typedef struct {
     uint32_t timestamp;
-    uint8_t steps;
+    uint32_t steps;
     uint32_t current_code;
     uint8_t current_index;
-    uint8_t current_key_offset;
 } totp_state_t;
 
 void totp_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
@@ -25,10 +25,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include "lis2dw_logging_face.h"
-#include "lis2dw.h"
 #include "watch.h"
 
-// This watch face is just for testing; if we want to build accelerometer support, it will likely have to be part of Movement itself.
+// This watch face is just for testing; it gets its wake-up interrupts from Movement's sensor hub.
 // The watch face only logs events when it is on screen and not in low energy mode, so you should set LE mode to Never when using it
 // and make it the first watch face in the list (so we come back to it from other modes).
 // On an interrupt, it flashes the Signal icon, and displays the axis or axes that were over the threshold.
@@ -111,20 +110,31 @@ static void _lis2dw_logging_face_log_data(lis2dw_logger_state_t *logger_state) {
     logger_state->z_interrupts_this_hour = 0;
 }
 
+static void _lis2dw_logging_face_wakeup_callback(lis2dw_wakeup_source wakeup_source, void *context) {
+    lis2dw_logger_state_t *logger_state = (lis2dw_logger_state_t *)context;
+    logger_state->wakeup_source |= wakeup_source;
+    logger_state->interrupts[0]++;
+    if (wakeup_source & LIS2DW_WAKEUP_SRC_WAKEUP_X) logger_state->x_interrupts_this_hour++;
+    if (wakeup_source & LIS2DW_WAKEUP_SRC_WAKEUP_Y) logger_state->y_interrupts_this_hour++;
+    if (wakeup_source & LIS2DW_WAKEUP_SRC_WAKEUP_Z) logger_state->z_interrupts_this_hour++;
+}
+
 void lis2dw_logging_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(lis2dw_logger_state_t));
         memset(*context_ptr, 0, sizeof(lis2dw_logger_state_t));
-        watch_enable_i2c();
-        lis2dw_begin();
-        lis2dw_set_low_power_mode(LIS2DW_LP_MODE_2); // lowest power 14-bit mode, 25 Hz is 3.5 µA @ 1.8V w/ low noise, 3µA without
-        lis2dw_set_low_noise_mode(true); // consumes a little more power
-        lis2dw_set_range(LIS2DW_CTRL6_VAL_RANGE_4G);
-        lis2dw_set_data_rate(LIS2DW_DATA_RATE_25_HZ); // is this enough for training?
-        // threshold is 1/64th of full scale, so for a FS of ±4G this is 1.25G
-        lis2dw_configure_wakeup_int1(10, true, false);
+        lis2dw_logger_state_t *logger_state = (lis2dw_logger_state_t *)*context_ptr;
+        logger_state->subscription = (sensor_hub_subscription_t) {
+            .data_rate = LIS2DW_DATA_RATE_25_HZ,
+            .range = LIS2DW_RANGE_4_G,
+            .low_noise = true, // consumes a little more power
+            // threshold is 1/64th of full scale, so for a FS of ±4G this is 625 mg
+            .wakeup_threshold = 10,
+            .wakeup_callback = _lis2dw_logging_face_wakeup_callback,
+            .context = logger_state,
+        };
     }
 }
 
@@ -137,13 +147,13 @@ void lis2dw_logging_face_activate(movement_settings_t *settings, void *context)
 
     logger_state->display_index = 0;
     logger_state->log_ticks = 0;
-    watch_enable_digital_input(A0);
+    logger_state->wakeup_source = 0;
+    sensor_hub_subscribe(&logger_state->subscription);
 }
 
 bool lis2dw_logging_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
     lis2dw_logger_state_t *logger_state = (lis2dw_logger_state_t *)context;
     lis2dw_wakeup_source wakeup_source = 0;
-    lis2dw_interrupt_source interrupt_source = 0;
 
     switch (event.event_type) {
         case EVENT_MODE_BUTTON_UP:
@@ -170,14 +180,11 @@ bool lis2dw_logging_face_loop(movement_event_t event, movement_settings_t *setti
             } else {
                 logger_state->display_index = 0;
             }
-            interrupt_source = lis2dw_get_interrupt_source();
-            if (interrupt_source) {
+            // the sensor hub has already called us back with anything that happened since the last tick.
+            wakeup_source = logger_state->wakeup_source;
+            logger_state->wakeup_source = 0;
+            if (wakeup_source) {
                 watch_set_indicator(WATCH_INDICATOR_SIGNAL);
-                wakeup_source = lis2dw_get_wakeup_source();
-                logger_state->interrupts[0]++;
-                if (wakeup_source & LIS2DW_WAKEUP_SRC_WAKEUP_X) logger_state->x_interrupts_this_hour++;
-                if (wakeup_source & LIS2DW_WAKEUP_SRC_WAKEUP_Y) logger_state->y_interrupts_this_hour++;
-                if (wakeup_source & LIS2DW_WAKEUP_SRC_WAKEUP_Z) logger_state->z_interrupts_this_hour++;
             } else {
                 watch_clear_indicator(WATCH_INDICATOR_SIGNAL);
             }
@@ -195,8 +202,8 @@ bool lis2dw_logging_face_loop(movement_event_t event, movement_settings_t *setti
 
 void lis2dw_logging_face_resign(movement_settings_t *settings, void *context) {
     (void) settings;
-    (void) context;
-    watch_disable_digital_input(A0);
+    lis2dw_logger_state_t *logger_state = (lis2dw_logger_state_t *)context;
+    sensor_hub_unsubscribe(&logger_state->subscription);
 }
 
 bool lis2dw_logging_face_wants_background_task(movement_settings_t *settings, void *context) {
@@ -26,6 +26,7 @@
 #define LIS2DW_LOGGING_FACE_H_
 
 #include "movement.h"
+#include "sensor_hub.h"
 #include "watch.h"
 
 #define LIS2DW_LOGGING_NUM_DATA_POINTS (96)
@@ -47,6 +48,8 @@ typedef struct {
     uint32_t y_interrupts_this_hour;  // the number of interrupts we have logged in the last hour
     uint32_t z_interrupts_this_hour;  // the number of interrupts we have logged in the last hour
     lis2dw_logger_data_point_t data[LIS2DW_LOGGING_NUM_DATA_POINTS];
+    lis2dw_wakeup_source wakeup_source;  // axes that crossed the threshold since the last tick
+    sensor_hub_subscription_t subscription;
 } lis2dw_logger_state_t;
 
 void lis2dw_logging_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
@@ -25,14 +25,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include "voltage_face.h"
+#include "battery.h"
 #include "watch.h"
 
 static void _voltage_face_update_display(void) {
     char buf[14];
 
-    watch_enable_adc();
-    float voltage = (float)watch_get_vcc_voltage() / 1000.0;
-    watch_disable_adc();
+    float voltage = (float)battery_get_millivolts() / 1000.0;
 
     sprintf(buf, "BA  %4.2f V", voltage);
     // printf("%s\n", buf);
@@ -35,6 +35,17 @@
 #define ACCELEROMETER_LOW_NOISE true
 #define SECONDS_TO_RECORD 15
 
+// beeps for the countdown, in Movement's 25 ms units: the last two seconds, then the start, then the end of a reading.
+static const uint8_t countdown_melody[] = {25, BUZZER_MELODY_OCTAVE(5), BUZZER_MELODY_NOTE(0, 2), BUZZER_MELODY_END};
+static const uint8_t start_melody[] = {25, BUZZER_MELODY_OCTAVE(6), BUZZER_MELODY_NOTE(0, 2), BUZZER_MELODY_END};
+static const uint8_t finish_melody[] = {
+    25, BUZZER_MELODY_OCTAVE(4),
+    BUZZER_MELODY_NOTE(0, 4),   // C4, 150 ms
+    BUZZER_MELODY_REST(1),      // 50 ms
+    BUZZER_MELODY_NOTE(0, 4),
+    BUZZER_MELODY_END
+};
+
 static const char activity_types[][3] = {
     "TE",   // Testing
     "ID",   // Idle
@@ -64,6 +75,7 @@ static int16_t get_next_available_page(void);
 static void write_buffer_to_page(uint8_t *buf, uint16_t page);
 static void write_page(accelerometer_data_acquisition_state_t *state);
 static void log_data_point(accelerometer_data_acquisition_state_t *state, lis2dw_reading_t reading, uint8_t centiseconds);
+static void fifo_callback(lis2dw_fifo_t *fifo, void *context);
 
 void accelerometer_data_acquisition_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
@@ -130,11 +142,11 @@ bool accelerometer_data_acquisition_face_loop(movement_event_t event, movement_s
                             state->mode = ACCELEROMETER_DATA_ACQUISITION_MODE_SENSING;
                             state->reading_ticks = SECONDS_TO_RECORD + 1;
                             // also beep if the user asked for it
-                            if (state->beep_with_countdown) watch_buzzer_play_note(BUZZER_NOTE_C6, 75);
+                            if (state->beep_with_countdown) movement_play_melody(start_melody);
                             start_reading(state, settings);
                         } else if (state->countdown_ticks < 3) {
                             // beep for last two ticks before reading
-                            if (state->beep_with_countdown) watch_buzzer_play_note(BUZZER_NOTE_C5, 75);
+                            if (state->beep_with_countdown) movement_play_melody(countdown_melody);
                         }
                     }
                     update(state);
@@ -147,9 +159,7 @@ bool accelerometer_data_acquisition_face_loop(movement_event_t event, movement_s
                         } else {
                             finish_reading(state);
                             state->mode = ACCELEROMETER_DATA_ACQUISITION_MODE_IDLE;
-                            watch_buzzer_play_note(BUZZER_NOTE_C4, 125);
-                            watch_buzzer_play_note(BUZZER_NOTE_REST, 50);
-                            watch_buzzer_play_note(BUZZER_NOTE_C4, 125);
+                            movement_play_melody(finish_melody);
                         }
                     }
                     update(state);
@@ -428,20 +438,27 @@ static void log_data_point(accelerometer_data_acquisition_state_t *state, lis2dw
     }
 }
 
+static void fifo_callback(lis2dw_fifo_t *fifo, void *context) {
+    accelerometer_data_acquisition_state_t *state = (accelerometer_data_acquisition_state_t *)context;
+    // hold on to it; continue_reading will log it when the tick reaches the face.
+    state->fifo = *fifo;
+}
+
 static void start_reading(accelerometer_data_acquisition_state_t *state, movement_settings_t *settings) {
+    (void) settings;
     printf("Start reading\n");
-    watch_enable_i2c();
-    lis2dw_begin();
-    lis2dw_set_data_rate(LIS2DW_DATA_RATE_25_HZ);
-    lis2dw_set_range(ACCELEROMETER_RANGE);
-    lis2dw_set_low_power_mode(ACCELEROMETER_LPMODE);
-    lis2dw_set_bandwidth_filtering(ACCELEROMETER_FILTER);
-    if (ACCELEROMETER_LOW_NOISE) lis2dw_set_low_noise_mode(true);
-    lis2dw_enable_fifo();
+    // the sensor hub always runs in ACCELEROMETER_LPMODE with ACCELEROMETER_FILTER, so the record fields stay accurate.
+    state->subscription = (sensor_hub_subscription_t) {
+        .data_rate = LIS2DW_DATA_RATE_25_HZ,
+        .range = ACCELEROMETER_RANGE,
+        .low_noise = ACCELEROMETER_LOW_NOISE,
+        .fifo_callback = fifo_callback,
+        .context = state,
+    };
+    sensor_hub_subscribe(&state->subscription);
 
     accelerometer_data_acquisition_record_t record;
-    watch_date_time date_time = watch_rtc_get_date_time();
-    state->starting_timestamp = watch_utility_date_time_to_unix_time(date_time, movement_timezone_offsets[settings->bit.time_zone] * 60);
+    state->starting_timestamp = movement_get_utc_timestamp();
     record.header.info.record_type = ACCELEROMETER_DATA_ACQUISITION_HEADER;
     record.header.info.range = ACCELEROMETER_RANGE;
     record.header.info.temperature = lis2dw_get_temperature();
@@ -450,14 +467,13 @@ static void start_reading(accelerometer_data_acquisition_state_t *state, movemen
     record.header.timestamp = state->starting_timestamp;
 
     state->records[state->pos++] = record;
-    lis2dw_fifo_t fifo;
-    lis2dw_read_fifo(&fifo); // dump the fifo, this starts a fresh round of data in continue_reading
+    state->fifo.count = 0; // the first batch arrives on the next tick
 }
 
 static void continue_reading(accelerometer_data_acquisition_state_t *state) {
     printf("Continue reading\n");
-    lis2dw_fifo_t fifo;
-    lis2dw_read_fifo(&fifo);
+    lis2dw_fifo_t fifo = state->fifo;
+    state->fifo.count = 0;
 
     fifo.count = min(fifo.count, 25); // hacky, but we need a consistent data rate; if we got a 26th data point, chuck it.
     uint8_t offset = 4 * (25 - fifo.count); // also hacky: we're sometimes short at the start. align to beginning of next second.
@@ -473,8 +489,7 @@ static void finish_reading(accelerometer_data_acquisition_state_t *state) {
     if (state->pos != 0) {
         write_page(state);
     }
-    lis2dw_set_data_rate(LIS2DW_DATA_RATE_POWERDOWN);
-    watch_disable_i2c();
+    sensor_hub_unsubscribe(&state->subscription);
 
     state->repeat_ticks = state->repeat_interval;
 }
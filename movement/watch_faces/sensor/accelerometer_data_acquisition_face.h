@@ -26,6 +26,7 @@
 #define ACCELEROMETER_DATA_ACQUISITION_FACE_H_
 
 #include "movement.h"
+#include "sensor_hub.h"
 
 #define ACCELEROMETER_DATA_ACQUISITION_INVALID ((uint64_t)(0b11))   // all bits are 1 when the flash is erased
 #define ACCELEROMETER_DATA_ACQUISITION_HEADER ((uint64_t)(0b10))
@@ -93,6 +94,8 @@ typedef struct {
     uint32_t starting_timestamp;
     accelerometer_data_acquisition_record_t records[32];
     uint16_t pos;
+    sensor_hub_subscription_t subscription;
+    lis2dw_fifo_t fifo;         // the latest batch from the sensor hub
 } accelerometer_data_acquisition_state_t;
 
 void accelerometer_data_acquisition_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
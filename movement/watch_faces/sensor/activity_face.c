@@ -0,0 +1,150 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "activity_face.h"
+#include "sensor_hub.h"
+#include "watch.h"
+
+static const char activity_face_titles[ACTIVITY_TYPE_COUNT][3] = {
+    "ID",   // Still
+    "WA",   // Walking
+    "RU",   // Running
+    "AC",   // Other activity
+};
+
+// what the watch thinks you're doing right now, in the day digits, which can't show a W or an uppercase R.
+static const char activity_face_labels[ACTIVITY_TYPE_COUNT][3] = {
+    "St",   // Still
+    "Go",   // Walking
+    "ru",   // Running
+    "AC",   // Other activity
+};
+
+// 14-bit samples at ±4g are 0.488 milli-g per LSB; 1999 / 4096 is close enough, and avoids a division.
+static inline int16_t _activity_face_raw_to_milli_g(int16_t raw) {
+    return ((int32_t)(raw >> 2) * 1999) >> 12;
+}
+
+static void _activity_face_update_display(activity_state_t *state) {
+    char buf[14];
+    uint32_t minutes = state->seconds[state->display_index] / 60;
+
+    sprintf(buf, "%s%s%6lu", activity_face_titles[state->display_index], activity_face_labels[state->current_activity], minutes);
+    watch_display_string(buf, 0);
+    if (state->sensing) watch_set_indicator(WATCH_INDICATOR_SIGNAL);
+    else watch_clear_indicator(WATCH_INDICATOR_SIGNAL);
+}
+
+static void _activity_face_fifo_callback(lis2dw_fifo_t *fifo, void *context) {
+    activity_state_t *state = (activity_state_t *)context;
+    activity_features_t features;
+
+    for(int8_t i = 0; i < fifo->count; i++) {
+        if (activity_classifier_push_sample(&state->classifier,
+                                            _activity_face_raw_to_milli_g(fifo->readings[i].x),
+                                            _activity_face_raw_to_milli_g(fifo->readings[i].y),
+                                            _activity_face_raw_to_milli_g(fifo->readings[i].z),
+                                            &features)) {
+            state->current_activity = activity_classifier_classify(&features);
+            state->seconds[state->current_activity] += ACTIVITY_CLASSIFIER_WINDOW_LENGTH / ACTIVITY_CLASSIFIER_SAMPLE_RATE;
+        }
+    }
+}
+
+static void _activity_face_start_sensing(activity_state_t *state) {
+    activity_classifier_init(&state->classifier);
+    state->subscription = (sensor_hub_subscription_t) {
+        .data_rate = LIS2DW_DATA_RATE_25_HZ,
+        .range = LIS2DW_RANGE_4_G,
+        .fifo_callback = _activity_face_fifo_callback,
+        .context = state,
+    };
+    state->sensing = sensor_hub_subscribe(&state->subscription);
+}
+
+static void _activity_face_stop_sensing(activity_state_t *state) {
+    if (!state->sensing) return;
+    sensor_hub_unsubscribe(&state->subscription);
+    state->sensing = false;
+}
+
+void activity_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
+    (void) settings;
+    (void) watch_face_index;
+    if (*context_ptr == NULL) {
+        *context_ptr = malloc(sizeof(activity_state_t));
+        memset(*context_ptr, 0, sizeof(activity_state_t));
+    }
+}
+
+void activity_face_activate(movement_settings_t *settings, void *context) {
+    (void) settings;
+    activity_state_t *state = (activity_state_t *)context;
+    _activity_face_start_sensing(state);
+}
+
+bool activity_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
+    (void) settings;
+    activity_state_t *state = (activity_state_t *)context;
+
+    switch (event.event_type) {
+        case EVENT_ACTIVATE:
+            _activity_face_update_display(state);
+            break;
+        case EVENT_TICK:
+            // the sensor hub has already fed this tick's samples through the classifier.
+            _activity_face_update_display(state);
+            break;
+        case EVENT_MODE_BUTTON_UP:
+            movement_move_to_next_face();
+            break;
+        case EVENT_LIGHT_BUTTON_DOWN:
+            movement_illuminate_led();
+            break;
+        case EVENT_ALARM_BUTTON_UP:
+            state->display_index = (state->display_index + 1) % ACTIVITY_TYPE_COUNT;
+            _activity_face_update_display(state);
+            break;
+        case EVENT_ALARM_LONG_PRESS:
+            memset(state->seconds, 0, sizeof(state->seconds));
+            _activity_face_update_display(state);
+            break;
+        case EVENT_LOW_ENERGY_UPDATE:
+            // the sensor hub powers the accelerometer down in low energy mode; there's nothing to classify.
+            watch_display_string("AC  SLEEP ", 0);
+            break;
+        default:
+            break;
+    }
+
+    return true;
+}
+
+void activity_face_resign(movement_settings_t *settings, void *context) {
+    (void) settings;
+    activity_state_t *state = (activity_state_t *)context;
+    _activity_face_stop_sensing(state);
+}
@@ -0,0 +1,60 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ACTIVITY_FACE_H_
+#define ACTIVITY_FACE_H_
+
+#include "movement.h"
+#include "activity_classifier.h"
+#include "sensor_hub.h"
+
+// Activity face: while on screen, streams 25 Hz accelerometer data through the activity classifier and tallies
+// time spent in each activity type. No raw samples are kept; only the running totals.
+// The top left shows whose total is on screen (ID, WA, RU or AC), the day digits what the watch thinks you're doing now
+// (St for still, Go for walking, ru for running, AC for anything else), and the bottom the total in minutes.
+// ALARM cycles through the totals, and a long press on ALARM resets them.
+
+typedef struct {
+    activity_classifier_t classifier;
+    uint32_t seconds[ACTIVITY_TYPE_COUNT];  // time spent in each activity type
+    activity_type_t current_activity;       // the most recent classification
+    uint8_t display_index;                  // the activity type whose total is on screen
+    sensor_hub_subscription_t subscription;
+    bool sensing;
+} activity_state_t;
+
+void activity_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
+void activity_face_activate(movement_settings_t *settings, void *context);
+bool activity_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
+void activity_face_resign(movement_settings_t *settings, void *context);
+
+#define activity_face ((const watch_face_t){ \
+    activity_face_setup, \
+    activity_face_activate, \
+    activity_face_loop, \
+    activity_face_resign, \
+    NULL, \
+})
+
+#endif // ACTIVITY_FACE_H_
@@ -26,6 +26,7 @@
 #include <string.h>
 #include "thermistor_logging_face.h"
 #include "thermistor_driver.h"
+#include "battery.h"
 #include "watch.h"
 
 static void _thermistor_logging_face_log_data(thermistor_logger_state_t *logger_state) {
@@ -38,6 +39,7 @@ static void _thermistor_logging_face_log_data(thermistor_logger_state_t *logger_
     logger_state->data_points++;
 
     thermistor_driver_disable();
+    battery_note_load(BATTERY_LOAD_ADC, 0);
 }
 
 static void _thermistor_logging_face_update_display(thermistor_logger_state_t *logger_state, bool in_fahrenheit, bool clock_mode_24h) {
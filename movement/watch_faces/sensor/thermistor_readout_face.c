@@ -26,6 +26,7 @@
 #include <string.h>
 #include "thermistor_readout_face.h"
 #include "thermistor_driver.h"
+#include "battery.h"
 #include "watch.h"
 
 static void _thermistor_readout_face_update_display(bool in_fahrenheit) {
@@ -39,6 +40,7 @@ static void _thermistor_readout_face_update_display(bool in_fahrenheit) {
     }
     watch_display_string(buf, 4);
     thermistor_driver_disable();
+    battery_note_load(BATTERY_LOAD_ADC, 0);
 }
 
 void thermistor_readout_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
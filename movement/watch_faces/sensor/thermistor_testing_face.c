@@ -26,6 +26,7 @@
 #include <string.h>
 #include "thermistor_testing_face.h"
 #include "thermistor_driver.h"
+#include "battery.h"
 #include "watch.h"
 
 // This watch face is designed for testing temperature sensor boards.
@@ -44,6 +45,7 @@ static void _thermistor_testing_face_update_display(bool in_fahrenheit) {
     }
     watch_display_string(buf, 4);
     thermistor_driver_disable();
+    battery_note_load(BATTERY_LOAD_ADC, 0);
 }
 
 void thermistor_testing_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
@@ -82,7 +82,7 @@ bool set_time_face_loop(movement_event_t event, movement_settings_t *settings, v
                     break;
                 case 6: // time zone
                     settings->bit.time_zone++;
-                    if (settings->bit.time_zone > 40) settings->bit.time_zone = 0;
+                    if (settings->bit.time_zone >= MOVEMENT_NUM_TIMEZONES) settings->bit.time_zone = 0;
                     break;
             }
             watch_rtc_set_date_time(date_time);
@@ -116,7 +116,10 @@ bool set_time_face_loop(movement_event_t event, movement_settings_t *settings, v
             sprintf(buf, "%s        ", set_time_face_titles[current_page]);
         } else {
             watch_set_colon();
-            sprintf(buf, "%s %3d%02d  ", set_time_face_titles[current_page], (int8_t) (movement_timezone_offsets[settings->bit.time_zone] / 60), (int8_t) (movement_timezone_offsets[settings->bit.time_zone] % 60) * (movement_timezone_offsets[settings->bit.time_zone] < 0 ? -1 : 1));
+            // the zone may have changed on this press, and Movement only catches up on the next tick.
+            int16_t offset = movement_get_timezone_offset(settings->bit.time_zone, movement_get_utc_timestamp()) / 60;
+            const char *code = movement_get_timezone_code(settings->bit.time_zone);
+            sprintf(buf, "%s %3d%02d%s", set_time_face_titles[current_page], (int8_t) (offset / 60), (int8_t) (offset % 60) * (offset < 0 ? -1 : 1), code ? code : "  ");
         }
     }
 
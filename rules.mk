@@ -6,17 +6,23 @@ SUBMODULES = tinyusb
 
 COBRA = cobra -f
 
-ifndef EMSCRIPTEN
+ifdef HOST
+all: $(BUILD)/$(BIN)
+else ifndef EMSCRIPTEN
 all: $(BUILD)/$(BIN).elf $(BUILD)/$(BIN).hex $(BUILD)/$(BIN).bin $(BUILD)/$(BIN).uf2 size
 else
 all: $(BUILD)/$(BIN).html
 endif
 
+$(BUILD)/$(BIN): $(OBJS)
+	@echo LD $@
+	@$(CC) $(LDFLAGS) $(OBJS) $(LIBS) -o $@
+
 $(BUILD)/$(BIN).html: $(OBJS)
 	@echo HTML $@
 	@$(CC) $(LDFLAGS) $(OBJS) $(LIBS) -o $@ \
 		-s ASYNCIFY=1 \
-		-s EXPORTED_FUNCTIONS=_main \
+		-s EXPORTED_FUNCTIONS=_main,_malloc,_free \
 		--shell-file=$(TOP)/watch-library/simulator/shell.html
 
 $(BUILD)/$(BIN).elf: $(OBJS)
@@ -0,0 +1,259 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Replays accelerometer recordings through the activity classifier, the way the activity face feeds it: 25 Hz
+// samples, 14 bits at ±4g, converted to milli-g with the face's shortcut. For each recording it reports how many
+// windows came out as each activity, the accuracy against the activity it's labelled with, the cycles each window
+// took, and the RAM the classifier needs. With no arguments, it runs a set of synthetic traces with known activities
+// and exits nonzero if any of them is misclassified.
+//
+// The cycles are the host's (the time stamp counter on x86, nanoseconds elsewhere), so they're for comparing one
+// version of the classifier against another, not for budgeting the watch's Cortex-M0+, which has no FPU or divider
+// and will take several times as many.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "activity_classifier.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLE_UNIT "cycles"
+static inline uint64_t cycles_now(void) {
+    return __rdtsc();
+}
+#else
+#define CYCLE_UNIT "ns"
+static inline uint64_t cycles_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+#endif
+
+#define STANDARD_GRAVITY 9.80665
+#define DEFAULT_MIN_ACCURACY 0.8
+
+static const char *activity_names[ACTIVITY_TYPE_COUNT] = { "still", "walking", "running", "other" };
+
+typedef struct {
+    int16_t (*samples)[3];  // raw, as the LIS2DW would have left them in its FIFO
+    size_t count;
+    size_t capacity;
+} trace_t;
+
+typedef struct {
+    uint32_t windows[ACTIVITY_TYPE_COUNT];
+    uint32_t total_windows;
+    uint64_t cycles;
+    uint64_t worst_cycles;
+} replay_result_t;
+
+/* traces */
+
+static void trace_append(trace_t *trace, double x_mg, double y_mg, double z_mg) {
+    if (trace->count == trace->capacity) {
+        trace->capacity = trace->capacity ? trace->capacity * 2 : 1024;
+        trace->samples = realloc(trace->samples, trace->capacity * sizeof(trace->samples[0]));
+    }
+    // 14-bit samples at ±4g, left justified like the LIS2DW's: the inverse of the face's conversion.
+    double axes[3] = {x_mg, y_mg, z_mg};
+    for(int i = 0; i < 3; i++) {
+        long value = lround(axes[i] * 4096.0 / 1999.0);
+        if (value > 8191) value = 8191;
+        if (value < -8192) value = -8192;
+        trace->samples[trace->count][i] = (int16_t)(value * 4);
+    }
+    trace->count++;
+}
+
+static bool trace_load_csv(trace_t *trace, const char *filename) {
+    FILE *f = fopen(filename, "r");
+    if (f == NULL) return false;
+
+    char line[256];
+    double timestamp, x, y, z;
+    while (fgets(line, sizeof(line), f)) {
+        // skips the header row and anything else that isn't a sample.
+        if (sscanf(line, "%lf,%lf,%lf,%lf", &timestamp, &x, &y, &z) != 4) continue;
+        double scale = 1000.0 / STANDARD_GRAVITY;
+        trace_append(trace, x * scale, y * scale, z * scale);
+    }
+    fclose(f);
+
+    return true;
+}
+
+static uint32_t noise_state = 1;
+
+static double noise(double amplitude_mg) {
+    noise_state = noise_state * 1664525 + 1013904223;
+    return ((double)(noise_state >> 8) / (1 << 24) * 2 - 1) * amplitude_mg;
+}
+
+static void trace_add_still(trace_t *trace, double seconds) {
+    for(int i = 0; i < seconds * ACTIVITY_CLASSIFIER_SAMPLE_RATE; i++) {
+        trace_append(trace, 120 + noise(15), -80 + noise(15), 990 + noise(15));
+    }
+}
+
+// the wrist swings forward and back once per two steps, and the footfalls land on the vertical axis.
+static void trace_add_gait(trace_t *trace, double seconds, double steps_per_second, double amplitude_mg) {
+    for(int i = 0; i < seconds * ACTIVITY_CLASSIFIER_SAMPLE_RATE; i++) {
+        double t = (double)i / ACTIVITY_CLASSIFIER_SAMPLE_RATE;
+        double step = sin(2 * M_PI * steps_per_second * t);
+        double swing = sin(M_PI * steps_per_second * t);
+        trace_append(trace,
+                     120 + amplitude_mg * 0.3 * swing + noise(25),
+                     -80 + amplitude_mg * 0.2 * step + noise(25),
+                     990 + amplitude_mg * step + noise(25));
+    }
+}
+
+// moving about without a rhythm: slow turns of the wrist with jolts at random.
+static void trace_add_fidgeting(trace_t *trace, double seconds) {
+    for(int i = 0; i < seconds * ACTIVITY_CLASSIFIER_SAMPLE_RATE; i++) {
+        double t = (double)i / ACTIVITY_CLASSIFIER_SAMPLE_RATE;
+        double jolt = noise(1) > 0.8 ? noise(600) : 0;
+        trace_append(trace,
+                     400 * sin(2 * M_PI * 0.3 * t) + noise(60),
+                     300 * cos(2 * M_PI * 0.2 * t) + noise(60),
+                     800 + 200 * sin(2 * M_PI * 0.45 * t) + jolt + noise(60));
+    }
+}
+
+/* replay */
+
+static replay_result_t replay(const trace_t *trace) {
+    replay_result_t result = {0};
+    activity_classifier_t classifier;
+    activity_features_t features;
+    uint64_t window_cycles = 0;
+
+    activity_classifier_init(&classifier);
+    for(size_t i = 0; i < trace->count; i++) {
+        // as the face does: 14-bit samples at ±4g are 0.488 milli-g per LSB, and 1999 / 4096 is close enough.
+        int16_t x = ((int32_t)(trace->samples[i][0] >> 2) * 1999) >> 12;
+        int16_t y = ((int32_t)(trace->samples[i][1] >> 2) * 1999) >> 12;
+        int16_t z = ((int32_t)(trace->samples[i][2] >> 2) * 1999) >> 12;
+
+        uint64_t start = cycles_now();
+        bool done = activity_classifier_push_sample(&classifier, x, y, z, &features);
+        activity_type_t activity = done ? activity_classifier_classify(&features) : ACTIVITY_TYPE_COUNT;
+        window_cycles += cycles_now() - start;
+
+        if (!done) continue;
+        result.windows[activity]++;
+        result.total_windows++;
+        result.cycles += window_cycles;
+        if (window_cycles > result.worst_cycles) result.worst_cycles = window_cycles;
+        window_cycles = 0;
+    }
+
+    return result;
+}
+
+static bool check(const char *name, const trace_t *trace, replay_result_t result, int expected) {
+    double seconds = (double)trace->count / ACTIVITY_CLASSIFIER_SAMPLE_RATE;
+    printf("%-36s %7.1f s %4u windows:", name, seconds, result.total_windows);
+    for(int i = 0; i < ACTIVITY_TYPE_COUNT; i++) printf(" %u %s", result.windows[i], activity_names[i]);
+    printf("; %llu %s/window (worst %llu)", (unsigned long long)(result.total_windows ? result.cycles / result.total_windows : 0),
+           CYCLE_UNIT, (unsigned long long)result.worst_cycles);
+    if (expected < 0) {
+        printf("\n");
+        return true;
+    }
+    double accuracy = result.total_windows ? (double)result.windows[expected] / result.total_windows : 0;
+    bool ok = accuracy >= DEFAULT_MIN_ACCURACY;
+    printf(" (%.0f%% %s) %s\n", accuracy * 100, activity_names[expected], ok ? "ok" : "FAIL");
+    return ok;
+}
+
+static bool run_synthetic_traces(void) {
+    bool ok = true;
+    trace_t trace = {0};
+
+    trace.count = 0;
+    trace_add_still(&trace, 60);
+    ok &= check("sitting still", &trace, replay(&trace), ACTIVITY_TYPE_STILL);
+
+    trace.count = 0;
+    trace_add_gait(&trace, 60, 1.8, 350);
+    ok &= check("walking, 1.8 steps/s", &trace, replay(&trace), ACTIVITY_TYPE_WALKING);
+
+    trace.count = 0;
+    trace_add_gait(&trace, 60, 2.2, 450);
+    ok &= check("brisk walking, 2.2 steps/s", &trace, replay(&trace), ACTIVITY_TYPE_WALKING);
+
+    trace.count = 0;
+    trace_add_gait(&trace, 60, 2.8, 900);
+    ok &= check("running, 2.8 steps/s", &trace, replay(&trace), ACTIVITY_TYPE_RUNNING);
+
+    trace.count = 0;
+    trace_add_fidgeting(&trace, 60);
+    ok &= check("fidgeting", &trace, replay(&trace), ACTIVITY_TYPE_OTHER);
+
+    free(trace.samples);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    printf("RAM: %zu bytes of classifier state, %zu bytes of features per window\n",
+           sizeof(activity_classifier_t), sizeof(activity_features_t));
+    if (argc < 2) return run_synthetic_traces() ? 0 : 1;
+
+    bool ok = true;
+    for(int i = 1; i < argc; i++) {
+        // a recording can be given as file.csv=activity, to check the windows against what was really going on.
+        char filename[1024];
+        int expected = -1;
+        snprintf(filename, sizeof(filename), "%s", argv[i]);
+        char *equals = strrchr(filename, '=');
+        if (equals != NULL) {
+            *equals = 0;
+            for(int j = 0; j < ACTIVITY_TYPE_COUNT; j++) {
+                if (strcmp(equals + 1, activity_names[j]) == 0) expected = j;
+            }
+            if (expected < 0) {
+                fprintf(stderr, "%s: the activity is one of still, walking, running or other\n", argv[i]);
+                ok = false;
+                continue;
+            }
+        }
+
+        trace_t trace = {0};
+        if (!trace_load_csv(&trace, filename)) {
+            fprintf(stderr, "can't read %s\n", filename);
+            ok = false;
+            continue;
+        }
+        const char *name = strrchr(filename, '/');
+        ok &= check(name ? name + 1 : filename, &trace, replay(&trace), expected);
+        free(trace.samples);
+    }
+
+    return ok ? 0 : 1;
+}
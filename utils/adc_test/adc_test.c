@@ -0,0 +1,222 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Checks the ADC driver's interrupt-driven read sequences on the host. The driver runs against its registers in
+// memory, and the checks play the ADC: after each conversion the driver starts, they look at how it set the ADC up,
+// put a result in RESULT and call ADC_Handler the way the interrupt would. That shows the order of the conversions, the
+// throwaway one after enabling the ADC, changing its reference or changing the main clock, and the scaling of what
+// comes back.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "watch.h"
+#include "../../watch-library/hardware/watch/watch_adc.c"
+
+Adc fake_adc;
+Gclk fake_gclk;
+Mclk fake_mclk;
+Supc fake_supc;
+uint32_t fake_fuses;
+uint32_t fake_cpu_frequency = 4000000;
+
+static int failures;
+// what a conversion finished by sleep() reads as.
+static uint16_t sleep_result;
+
+uint32_t watch_get_cpu_frequency(void) {
+    return fake_cpu_frequency;
+}
+
+/* the ADC's side */
+
+// RESULT is read-only to the driver.
+static void set_result(uint16_t result) {
+    *(uint16_t *)&ADC->RESULT.reg = result;
+}
+
+// finishes the conversion the driver started, with the given result. false if it hadn't started one.
+static bool convert(uint16_t result) {
+    if (!ADC->SWTRIG.bit.START || !ADC->CTRLA.bit.ENABLE) return false;
+    ADC->SWTRIG.reg = 0;
+    set_result(result);
+    ADC_Handler();
+    return true;
+}
+
+void sleep(const uint8_t mode) {
+    if (!convert(sleep_result)) {
+        printf("slept with no conversion running\n");
+        failures++;
+        // don't wait forever.
+        _adc_reads = NULL;
+    }
+}
+
+static bool converting(uint8_t muxpos, uint8_t samplenum) {
+    return ADC->SWTRIG.bit.START && ADC->INPUTCTRL.bit.MUXPOS == muxpos && ADC->AVGCTRL.bit.SAMPLENUM == samplenum;
+}
+
+/* checks */
+
+static void expect(const char *what, bool ok) {
+    printf("%-72s %s\n", what, ok ? "ok" : "FAIL");
+    if (!ok) failures++;
+}
+
+static bool callback_called;
+static uint8_t callback_count;
+static void *callback_context;
+
+static void reads_done(watch_adc_read_t *reads, uint8_t count, void *context) {
+    callback_called = true;
+    callback_count = count;
+    callback_context = context;
+}
+
+static bool start(watch_adc_read_t *reads, uint8_t count) {
+    callback_called = false;
+    return watch_adc_read_async(reads, count, reads_done, &callback_called);
+}
+
+static void check_enable(void) {
+    fake_fuses = 0x2D;
+    watch_enable_adc();
+    expect("enable: calibrates from the fuses", ADC->CALIB.bit.BIASREFBUF == 5 && ADC->CALIB.bit.BIASCOMP == 5);
+    expect("enable: 16-bit results, 16 samples, VCC reference",
+           ADC->CTRLC.bit.RESSEL == ADC_CTRLC_RESSEL_16BIT_Val && ADC->AVGCTRL.bit.SAMPLENUM == ADC_AVGCTRL_SAMPLENUM_16_Val &&
+           ADC->REFCTRL.bit.REFSEL == ADC_REFCTRL_REFSEL_INTVCC2_Val);
+    expect("enable: a 500 kHz clock at 4 MHz", ADC->CTRLB.bit.PRESCALER == ADC_CTRLB_PRESCALER_DIV8_Val);
+    expect("enable: on", ADC->CTRLA.bit.ENABLE);
+
+    watch_disable_adc();
+    expect("disable: off", !ADC->CTRLA.bit.ENABLE && !(MCLK->APBCMASK.reg & MCLK_APBCMASK_ADC));
+    fake_fuses = 0;
+    ADC->AVGCTRL.bit.SAMPLENUM = ADC_AVGCTRL_SAMPLENUM_1_Val;
+    watch_enable_adc();
+    expect("enable again: keeps the calibration", ADC->CALIB.bit.BIASREFBUF == 5 && ADC->CALIB.bit.BIASCOMP == 5);
+    expect("enable again: back to the defaults", ADC->AVGCTRL.bit.SAMPLENUM == ADC_AVGCTRL_SAMPLENUM_16_Val);
+}
+
+static void check_sequence(void) {
+    watch_adc_read_t reads[] = {
+        { .pin = A0, .samples = 4, .sampling_length = 2 },
+        { .pin = WATCH_ADC_VCC },
+    };
+
+    expect("sequence: starts", start(reads, 2));
+    expect("sequence: busy", watch_adc_is_busy());
+    expect("sequence: another can't start meanwhile", !watch_adc_read_async(reads, 1, NULL, NULL));
+    // the ADC was just enabled, so the first conversion is a throwaway of one sample.
+    expect("sequence: throws away a single sample first",
+           converting(ADC_INPUTCTRL_MUXPOS_AIN12_Val, ADC_AVGCTRL_SAMPLENUM_1_Val) && ADC->SAMPCTRL.bit.SAMPLEN == 1);
+    convert(0xFFFF);
+    expect("sequence: then samples A0 four times", converting(ADC_INPUTCTRL_MUXPOS_AIN12_Val, ADC_AVGCTRL_SAMPLENUM_4_Val));
+    convert(1000);
+    expect("sequence: A0 scaled to 16 bits", reads[0].result == 4000);
+    // the supply is read against the internal reference, which needs a throwaway of its own.
+    expect("sequence: VCC against the internal reference", ADC->REFCTRL.bit.REFSEL == ADC_REFCTRL_REFSEL_INTREF_Val);
+    expect("sequence: throws away a sample after the switch",
+           converting(ADC_INPUTCTRL_MUXPOS_SCALEDIOVCC_Val, ADC_AVGCTRL_SAMPLENUM_1_Val) && ADC->SAMPCTRL.bit.SAMPLEN == 0);
+    convert(0);
+    expect("sequence: then samples VCC 16 times", converting(ADC_INPUTCTRL_MUXPOS_SCALEDIOVCC_Val, ADC_AVGCTRL_SAMPLENUM_16_Val));
+    expect("sequence: no callback before the end", !callback_called);
+    // a quarter of 3 V against 1.024 V, at 16 samples.
+    convert(3 * 16384);
+    expect("sequence: VCC in millivolts", reads[1].result == 3000);
+    expect("sequence: calls back once, with the reads and the context",
+           callback_called && callback_count == 2 && callback_context == &callback_called);
+    expect("sequence: idle after", !watch_adc_is_busy() && !ADC->SWTRIG.bit.START);
+    expect("sequence: puts back the reference and the settings",
+           ADC->REFCTRL.bit.REFSEL == ADC_REFCTRL_REFSEL_INTVCC2_Val &&
+           ADC->AVGCTRL.bit.SAMPLENUM == ADC_AVGCTRL_SAMPLENUM_16_Val && ADC->SAMPCTRL.bit.SAMPLEN == 0);
+
+    expect("sequence: an empty one doesn't start", !start(reads, 0) && !watch_adc_is_busy());
+}
+
+static void check_discard(void) {
+    watch_adc_read_t read = { .pin = A1 };
+
+    // coming back from the VCC read changed the reference, so this one starts with a throwaway; the next one doesn't.
+    start(&read, 1);
+    expect("discard: after the reference comes back", converting(ADC_INPUTCTRL_MUXPOS_AIN9_Val, ADC_AVGCTRL_SAMPLENUM_1_Val));
+    convert(0);
+    convert(1234);
+    start(&read, 1);
+    expect("discard: none with nothing changed", converting(ADC_INPUTCTRL_MUXPOS_AIN9_Val, ADC_AVGCTRL_SAMPLENUM_16_Val));
+    convert(1234);
+    expect("discard: none, and the result is the one read", read.result == 1234 && callback_called);
+
+    // boosting the main clock changes the prescaler, which needs a throwaway conversion too.
+    fake_cpu_frequency = 16000000;
+    _watch_adc_clock_changed();
+    expect("clock change: still a 500 kHz clock at 16 MHz",
+           ADC->CTRLB.bit.PRESCALER == ADC_CTRLB_PRESCALER_DIV32_Val && ADC->CTRLA.bit.ENABLE);
+    start(&read, 1);
+    expect("clock change: the next read throws away a sample", converting(ADC_INPUTCTRL_MUXPOS_AIN9_Val, ADC_AVGCTRL_SAMPLENUM_1_Val));
+    convert(0xFFFF);
+    expect("clock change: then reads for real", converting(ADC_INPUTCTRL_MUXPOS_AIN9_Val, ADC_AVGCTRL_SAMPLENUM_16_Val));
+    convert(4321);
+    expect("clock change: and reports only the real one", read.result == 4321);
+
+    fake_cpu_frequency = 4000000;
+    watch_disable_adc();
+    _watch_adc_clock_changed();
+    expect("clock change: leaves a disabled ADC alone",
+           ADC->CTRLB.bit.PRESCALER == ADC_CTRLB_PRESCALER_DIV32_Val && !ADC->CTRLA.bit.ENABLE);
+    watch_enable_adc();
+    expect("clock change: enabling picks up the clock", ADC->CTRLB.bit.PRESCALER == ADC_CTRLB_PRESCALER_DIV8_Val);
+}
+
+static void check_blocking(void) {
+    watch_adc_read_t reads[] = {
+        { .pin = A2, .samples = 3, .sampling_length = 100 },
+        { .pin = A3, .samples = 1 },
+    };
+
+    // the CPU sleeps until each conversion is done; sleep() does them here, with a throwaway first after enabling.
+    sleep_result = 500;
+    watch_adc_read(reads, 2);
+    expect("blocking: reads everything before returning", !watch_adc_is_busy());
+    expect("blocking: bad sample counts and lengths get the defaults", reads[0].samples == 0 && reads[0].sampling_length == 64);
+    expect("blocking: results scaled by their own sample counts", reads[0].result == 500 && reads[1].result == 500 << 4);
+
+    // the blocking getters see RESRDY set and take what's in RESULT.
+    ADC->INTFLAG.reg = ADC_INTFLAG_RESRDY;
+    set_result(3 * 16384);
+    watch_set_analog_reference_voltage(ADC_REFERENCE_VCC_DIV2);
+    expect("vcc: millivolts", watch_get_vcc_voltage() == 3000);
+    expect("vcc: puts back the pin reference", ADC->REFCTRL.bit.REFSEL == ADC_REFCTRL_REFSEL_INTVCC1_Val);
+    expect("pin: the level", watch_get_analog_pin_level(A4) == 3 * 16384 && ADC->INPUTCTRL.bit.MUXPOS == ADC_INPUTCTRL_MUXPOS_AIN8_Val);
+}
+
+int main(void) {
+    check_enable();
+    check_sequence();
+    check_discard();
+    check_blocking();
+
+    printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
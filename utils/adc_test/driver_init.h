@@ -0,0 +1 @@
+// The ADC driver includes this for the chip's headers and the pins; watch.h here stands in for all of it.
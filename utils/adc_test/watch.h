@@ -0,0 +1,86 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef WATCH_H_
+#define WATCH_H_
+
+// Stands in for the watch library when building the ADC driver on a computer. The driver gets the chip's real register
+// layouts, but ADC, MCLK, GCLK and SUPC point at plain structs in adc_test.c, so the test can see what the driver set
+// and play the part of the ADC: it fills in RESULT and calls ADC_Handler. The ADC never looks busy to a sync, and
+// RESRDY stays set, so the blocking functions take whatever is in RESULT.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define __I volatile const
+#define __O volatile
+#define __IO volatile
+#define _U_(x) x ## U
+typedef volatile const uint8_t RoReg8;
+
+#include "component/adc.h"
+#include "component/gclk.h"
+#include "component/mclk.h"
+#include "component/supc.h"
+
+extern Adc fake_adc;
+extern Gclk fake_gclk;
+extern Mclk fake_mclk;
+extern Supc fake_supc;
+extern uint32_t fake_fuses;
+extern uint32_t fake_cpu_frequency;
+
+#define ADC (&fake_adc)
+#define GCLK (&fake_gclk)
+#define MCLK (&fake_mclk)
+#define SUPC (&fake_supc)
+
+#define ADC_GCLK_ID 25
+#define ADC_FUSES_BIASREFBUF_ADDR (&fake_fuses)
+#define ADC_FUSES_BIASREFBUF_Pos 0
+#define ADC_FUSES_BIASCOMP_ADDR (&fake_fuses)
+#define ADC_FUSES_BIASCOMP_Pos 3
+
+// the pins and the interrupt controller, which the checks don't look at.
+enum { A0, A1, A2, A3, A4 };
+enum { GPIO_DIRECTION_OFF, GPIO_PIN_FUNCTION_OFF };
+enum { PINMUX_PB04B_ADC_AIN12, PINMUX_PB01B_ADC_AIN9, PINMUX_PB02B_ADC_AIN10, PINMUX_PB03B_ADC_AIN11, PINMUX_PB00B_ADC_AIN8 };
+typedef enum { ADC_IRQn = 20 } IRQn_Type;
+
+static inline void gpio_set_pin_direction(uint8_t pin, int direction) {}
+static inline void gpio_set_pin_function(uint8_t pin, int function) {}
+static inline void NVIC_DisableIRQ(IRQn_Type irq) {}
+static inline void NVIC_EnableIRQ(IRQn_Type irq) {}
+static inline void NVIC_ClearPendingIRQ(IRQn_Type irq) {}
+static inline void __disable_irq(void) {}
+static inline void __enable_irq(void) {}
+
+/// Where watch_adc_wait_for_idle sleeps until the next interrupt; adc_test.c finishes a conversion.
+void sleep(const uint8_t mode);
+
+uint32_t watch_get_cpu_frequency(void);
+
+#include "watch_adc.h"
+
+#endif // WATCH_H_
@@ -0,0 +1,192 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Checks Movement's battery service on the host: the CR2016 curve it maps voltages through, how far it reckons the
+// LED, the buzzer and analog sensors pull the cell down and for how long, and how the background task puts off a
+// sample taken under load and then corrects it. The clock and the voltage the ADC reads are variables that the checks
+// set by hand.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "watch.h"
+#include "../../movement/battery.c"
+
+static uint32_t now = 1700000000;
+static uint16_t vcc = 3000;
+static uint32_t vcc_reads;
+static bool buzzer_playing;
+static bool lpeff;
+static int failures;
+
+/* stubs */
+
+watch_date_time watch_rtc_get_date_time(void) {
+    return now;
+}
+
+uint32_t watch_utility_date_time_to_unix_time(watch_date_time date_time, uint32_t utc_offset) {
+    return date_time;
+}
+
+bool watch_buzzer_is_playing(void) {
+    return buzzer_playing;
+}
+
+void watch_set_low_power_efficiency(bool enabled) {
+    lpeff = enabled;
+}
+
+bool watch_get_low_power_efficiency(void) {
+    return lpeff;
+}
+
+void watch_enable_adc(void) {}
+
+void watch_disable_adc(void) {}
+
+void watch_adc_read(watch_adc_read_t *reads, uint8_t count) {
+    for(uint8_t i = 0; i < count; i++) {
+        if (reads[i].pin == WATCH_ADC_VCC) reads[i].result = vcc;
+    }
+    vcc_reads++;
+}
+
+/* checks */
+
+static void expect(const char *what, bool ok) {
+    printf("%-72s %s\n", what, ok ? "ok" : "FAIL");
+    if (!ok) failures++;
+}
+
+static void check_curve(void) {
+    expect("curve: full at 3 V and above", _battery_interpolate(3000, false) == 100 && _battery_interpolate(3300, false) == 100);
+    expect("curve: each point exactly", _battery_interpolate(2800, false) == 50 && _battery_interpolate(2600, false) == 15 &&
+           _battery_interpolate(2800, true) == 45 && _battery_interpolate(2600, true) == 80);
+    expect("curve: empty at 2 V and below", _battery_interpolate(2000, false) == 0 && _battery_interpolate(1500, false) == 0);
+    expect("curve: the lowest resistance above it, the highest below",
+           _battery_interpolate(3300, true) == 30 && _battery_interpolate(1500, true) == 250);
+    // halfway between 2700 mV (25%, 65 ohms) and 2600 mV (15%, 80 ohms).
+    expect("curve: straight lines between points", _battery_interpolate(2650, false) == 20 && _battery_interpolate(2650, true) == 72);
+
+    bool monotonic = true;
+    for(uint16_t millivolts = 1500; millivolts < 3300; millivolts++) {
+        if (_battery_interpolate(millivolts + 1, false) < _battery_interpolate(millivolts, false)) monotonic = false;
+        if (_battery_interpolate(millivolts + 1, true) > _battery_interpolate(millivolts, true)) monotonic = false;
+    }
+    expect("curve: charge only rises and resistance only falls with voltage", monotonic);
+}
+
+static void check_sag(void) {
+    // before the first sample, the cell is taken to be fresh, at 30 ohms.
+    expect("sag: none with nothing on", _battery_sag(now) == 0);
+
+    battery_note_load(BATTERY_LOAD_LED, 5000);
+    expect("sag: 3 mA through 30 ohms while the LED is on", _battery_sag(now) == 90 && _battery_sag(now + 4) == 90);
+    expect("sag: full for a second it might still be on", _battery_sag(now + 5) == 90);
+    expect("sag: halfway through recovering, half", _battery_sag(now + 5 + 15) == 45);
+    expect("sag: gone once recovered", _battery_sag(now + 5 + 30) == 0);
+
+    battery_note_load(BATTERY_LOAD_ADC, 0);
+    expect("sag: loads add up", _battery_sag(now) == 90 + 9);
+    expect("sag: each recovers on its own time", _battery_sag(now + 6) == 90 - 3);
+    battery_note_load(BATTERY_LOAD_LED, 0);
+    battery_note_load(BATTERY_LOAD_ADC, 0);
+
+    buzzer_playing = true;
+    expect("sag: a buzzer nobody told us about still counts", _battery_sag(now + 60) == 30);
+    buzzer_playing = false;
+    expect("sag: and recovers once it stops", _battery_sag(now + 60) == 0);
+
+    battery_note_load(BATTERY_LOAD_LED, UINT32_MAX);
+    expect("sag: on until further notice, a long time from now", _battery_sag(UINT32_MAX - 1000) == 90);
+
+    // a cell that's run down has more resistance, so the same load pulls it down further.
+    battery_state.valid = true;
+    battery_state.filtered = 2500 << 4;
+    expect("sag: 100 ohms at 2.5 V", _battery_sag(now + 60) == 300);
+    battery_state.valid = false;
+    battery_note_load(BATTERY_LOAD_LED, 0);
+    now += 60;
+}
+
+// movement calls the background task once a minute.
+static void minutes_pass(uint8_t minutes) {
+    for(uint8_t i = 0; i < minutes; i++) {
+        now += 60;
+        battery_handle_background_task();
+    }
+}
+
+static void check_sampling(void) {
+    vcc = 3000;
+    expect("sampling: the first reading samples right away", battery_get_millivolts() == 3000 && vcc_reads == 1);
+    expect("sampling: a fresh cell is full and not low", battery_get_percent() == 100 && !battery_is_low());
+    expect("sampling: low power efficiency goes on", lpeff);
+    minutes_pass(9);
+    expect("sampling: not again for ten minutes", vcc_reads == 1);
+    minutes_pass(1);
+    expect("sampling: then again", vcc_reads == 2);
+
+    // the LED comes on and stays on, pulling the cell down 90 mV.
+    vcc = 2910;
+    battery_note_load(BATTERY_LOAD_LED, UINT32_MAX);
+    minutes_pass(9 + 5);
+    expect("sampling: put off for five minutes under load", vcc_reads == 2);
+    minutes_pass(1);
+    expect("sampling: then taken anyway", vcc_reads == 3);
+    expect("sampling: and corrected for the sag", battery_get_millivolts() == 3000);
+
+    // the LED goes off; the cell recovers in 30 seconds, well within the minute before the next try. a quarter of
+    // the 10 mV drop goes into the average.
+    battery_note_load(BATTERY_LOAD_LED, 0);
+    vcc = 2990;
+    minutes_pass(10);
+    expect("sampling: once recovered, on time and uncorrected", vcc_reads == 4 && battery_get_millivolts() == 2997);
+
+    // the cell runs down: low power efficiency stays on to 2.6 V, where the brownout detector is.
+    vcc = 2500;
+    bool on_above = true;
+    while (battery_get_millivolts() >= 2600) {
+        if (!lpeff) on_above = false;
+        minutes_pass(10);
+    }
+    expect("sampling: low power efficiency stays on above 2.6 V", on_above);
+    expect("sampling: and goes off below it", !lpeff);
+    vcc = 2650;
+    for(uint8_t i = 0; i < 20; i++) minutes_pass(10);
+    expect("sampling: and stays off until 2.7 V", battery_get_millivolts() >= 2640 && !lpeff);
+    vcc = 2800;
+    for(uint8_t i = 0; i < 20; i++) minutes_pass(10);
+    expect("sampling: then comes back on", lpeff);
+}
+
+int main(void) {
+    check_curve();
+    check_sag();
+    check_sampling();
+
+    printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,215 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Checks the buzzer's background player on the host: the melody decoder turns each command of the format in
+// watch_buzzer.h into the right notes and durations (octaves, rests, repeats and loops included), step arrays play
+// as given, the note table matches equal temperament, and a step's length comes out right in ticks of the hardware's
+// step timer at each clock speed the watch runs at.
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "watch.h"
+#include "../../watch-library/shared/watch/watch_private_buzzer.c"
+
+#define MAX_STEPS 64
+
+static int failures;
+
+static void expect(const char *what, bool ok) {
+    printf("%-64s %s\n", what, ok ? "ok" : "FAIL");
+    if (!ok) failures++;
+}
+
+static watch_buzzer_step_t steps[MAX_STEPS];
+
+// plays a melody or sequence through a cursor, as the drivers do, and returns the number of steps.
+static uint8_t decode(const watch_buzzer_step_t *sequence, const uint8_t *melody, uint8_t length, uint8_t loops) {
+    watch_buzzer_cursor_t cursor;
+    uint8_t count = 0;
+
+    _watch_buzzer_cursor_init(&cursor, sequence, melody, length, loops);
+    while (count < MAX_STEPS && _watch_buzzer_cursor_next(&cursor, &steps[count])) count++;
+    return count;
+}
+
+static bool steps_are(uint8_t count, const watch_buzzer_step_t *expected, uint8_t expected_count) {
+    if (count != expected_count) return false;
+    for(uint8_t i = 0; i < count; i++) {
+        if (steps[i].note != expected[i].note || steps[i].duration_ms != expected[i].duration_ms) return false;
+    }
+    return true;
+}
+
+static uint32_t total_ms(uint8_t count) {
+    uint32_t total = 0;
+    for(uint8_t i = 0; i < count; i++) total += steps[i].duration_ms;
+    return total;
+}
+
+static void check_notes(void) {
+    // a 10 ms 32nd note keeps the arithmetic easy.
+    static const uint8_t scale[] = {
+        10,
+        BUZZER_MELODY_NOTE(9, 5),   // A4, a quarter note
+        BUZZER_MELODY_NOTE(11, 6),  // B4, dotted quarter
+        BUZZER_MELODY_OCTAVE(5),
+        BUZZER_MELODY_NOTE(0, 0),   // C5, a 32nd
+        BUZZER_MELODY_REST(15),     // the longest rest: eight whole notes
+        BUZZER_MELODY_NOTE(0, 15),
+        BUZZER_MELODY_END
+    };
+    static const watch_buzzer_step_t expected[] = {
+        {BUZZER_NOTE_A4, 80},
+        {BUZZER_NOTE_B4, 120},
+        {BUZZER_NOTE_C5, 10},
+        {BUZZER_NOTE_REST, 2560},
+        {BUZZER_NOTE_C5, 2560},
+    };
+    expect("melody: notes, octaves and durations", steps_are(decode(NULL, scale, 0, 1), expected, 5));
+
+    static const uint8_t edges[] = {
+        10,
+        BUZZER_MELODY_OCTAVE(1),
+        BUZZER_MELODY_NOTE(8, 0),   // G#1, just below the table
+        BUZZER_MELODY_NOTE(9, 0),   // A1, its first note
+        BUZZER_MELODY_OCTAVE(8),
+        BUZZER_MELODY_NOTE(11, 0),  // B8, its last
+        BUZZER_MELODY_OCTAVE(9),
+        BUZZER_MELODY_NOTE(0, 0),   // C9, past the end
+        BUZZER_MELODY_END
+    };
+    static const watch_buzzer_step_t expected_edges[] = {
+        {BUZZER_NOTE_REST, 10},
+        {BUZZER_NOTE_A1, 10},
+        {BUZZER_NOTE_B8, 10},
+        {BUZZER_NOTE_REST, 10},
+    };
+    expect("melody: notes outside A1-B8 are rests", steps_are(decode(NULL, edges, 0, 1), expected_edges, 4));
+}
+
+static void check_repeats(void) {
+    static const uint8_t repeats[] = {
+        10,
+        BUZZER_MELODY_NOTE(0, 0),
+        BUZZER_MELODY_REPEAT_START,
+        BUZZER_MELODY_NOTE(2, 0),
+        BUZZER_MELODY_REPEAT(2),    // D three times in all
+        BUZZER_MELODY_REPEAT_START,
+        BUZZER_MELODY_NOTE(4, 0),
+        BUZZER_MELODY_REPEAT(1),    // then E twice
+        BUZZER_MELODY_END
+    };
+    static const watch_buzzer_step_t expected[] = {
+        {BUZZER_NOTE_C4, 10},
+        {BUZZER_NOTE_D4, 10}, {BUZZER_NOTE_D4, 10}, {BUZZER_NOTE_D4, 10},
+        {BUZZER_NOTE_E4, 10}, {BUZZER_NOTE_E4, 10},
+    };
+    expect("melody: repeated passages, one after another", steps_are(decode(NULL, repeats, 0, 1), expected, 6));
+
+    // a looped melody starts over from the default octave, with its repeats fresh.
+    static const uint8_t looped[] = {
+        10,
+        BUZZER_MELODY_REPEAT_START,
+        BUZZER_MELODY_NOTE(9, 0),
+        BUZZER_MELODY_REPEAT(1),
+        BUZZER_MELODY_OCTAVE(5),
+        BUZZER_MELODY_NOTE(9, 0),
+        BUZZER_MELODY_END
+    };
+    static const watch_buzzer_step_t expected_looped[] = {
+        {BUZZER_NOTE_A4, 10}, {BUZZER_NOTE_A4, 10}, {BUZZER_NOTE_A5, 10},
+        {BUZZER_NOTE_A4, 10}, {BUZZER_NOTE_A4, 10}, {BUZZER_NOTE_A5, 10},
+    };
+    expect("melody: loops start over in octave 4", steps_are(decode(NULL, looped, 0, 2), expected_looped, 6));
+    expect("melody: 0 loops plays once", decode(NULL, looped, 0, 0) == 3);
+}
+
+static void check_timing(void) {
+    // shaped like Movement's alarm: three beeps and a pause, one second in all, in 25 ms units.
+    static const uint8_t alarm[] = {
+        25, BUZZER_MELODY_OCTAVE(8),
+        BUZZER_MELODY_REPEAT_START,
+        BUZZER_MELODY_NOTE(0, 1),
+        BUZZER_MELODY_REST(1),
+        BUZZER_MELODY_REPEAT(2),
+        BUZZER_MELODY_NOTE(0, 2),
+        BUZZER_MELODY_REST(8),
+        BUZZER_MELODY_REST(0),
+        BUZZER_MELODY_END
+    };
+    uint8_t count = decode(NULL, alarm, 0, 5);
+    expect("timing: an alarm-shaped melody lasts a second each time", count == 5 * 9 && total_ms(count) == 5000);
+    expect("timing: its beeps are C8", steps[0].note == BUZZER_NOTE_C8 && steps[6].note == BUZZER_NOTE_C8);
+
+    static const watch_buzzer_step_t sequence[] = {{BUZZER_NOTE_C7, 50}, {BUZZER_NOTE_REST, 950}};
+    count = decode(sequence, NULL, 2, 3);
+    expect("timing: a step array plays as given, three times", count == 6 && total_ms(count) == 3000 &&
+                                                                steps[4].note == BUZZER_NOTE_C7);
+
+    // the step timer counts the main clock divided by 1024; each length should be within a tick of exact.
+    static const uint32_t frequencies[] = {4000000, 8000000, 12000000, 16000000};
+    static const uint16_t lengths[] = {1, 25, 75, 1000, 65535};
+    bool close = true;
+    for(uint8_t f = 0; f < sizeof(frequencies) / sizeof(frequencies[0]); f++) {
+        for(uint8_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            double exact = lengths[l] * (frequencies[f] / 1024.0) / 1000.0;
+            uint32_t ticks = _watch_buzzer_step_ticks(lengths[l], frequencies[f]);
+            if (fabs(ticks - exact) > 1) {
+                printf("    %u ms at %u MHz: %u ticks, %.1f exact\n", lengths[l], frequencies[f] / 1000000, ticks, exact);
+                close = false;
+            }
+        }
+    }
+    expect("timing: step lengths within a tick at 4 to 16 MHz", close);
+    expect("timing: a zero length step still takes a tick", _watch_buzzer_step_ticks(0, 4000000) == 1);
+}
+
+static void check_periods(void) {
+    // the buzzer counts a 1 MHz clock, so a note's period is 1,000,000 / its frequency in equal temperament: to the
+    // nearest count, or within 0.01% for some of the low notes, which the table rounds a little differently. at the
+    // top of the range a count is a big step, and the nearest one can be a few cents out.
+    bool in_tune = true;
+    for(uint8_t note = BUZZER_NOTE_A1; note < BUZZER_NOTE_REST; note++) {
+        double period = 1000000.0 / (55.0 * pow(2, note / 12.0));
+        if (fabs(NotePeriods[note] - period) > 0.5 && fabs(NotePeriods[note] - period) > period / 10000) {
+            printf("    note %d: %d, %.2f exact\n", note, NotePeriods[note], period);
+            in_tune = false;
+        }
+    }
+    expect("periods: every note in tune, to the count", in_tune);
+    expect("periods: A4 is 2273", NotePeriods[BUZZER_NOTE_A4] == 2273);
+}
+
+int main(void) {
+    check_notes();
+    check_repeats();
+    check_timing();
+    check_periods();
+
+    printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,252 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Checks watch_utility_date_time_from_unix_time and watch_utility_convert_to_unix_time against the C library's
+// gmtime_r and timegm: every second the RTC can hold (2020 through 2083), then each date back to its timestamp, then a
+// day's worth of UTC offsets, and the edges of the range. Then it times both against the implementations they
+// replaced, kept below as they were, so a change to either can be measured.
+//
+// The cycles are the host's (the time stamp counter on x86, nanoseconds elsewhere), so they're for comparing one
+// version against another. The watch's Cortex-M0+ has no divide instruction, which makes the old code's divisions
+// far more expensive there than here.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "watch_utility.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLE_UNIT "cycles"
+static inline uint64_t cycles_now(void) {
+    return __rdtsc();
+}
+#else
+#define CYCLE_UNIT "ns"
+static inline uint64_t cycles_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+#endif
+
+#define FIRST_SECOND 1577836800UL   // 2020-01-01 00:00:00
+#define LAST_SECOND 3597523199UL    // 2083-12-31 23:59:59
+#define BENCH_CALLS 10000000
+
+static unsigned long failures;
+
+static void fail(const char *what, uint32_t timestamp, uint32_t utc_offset, watch_date_time got) {
+    if (++failures > 20) return;
+    printf("FAIL %s: %lu at %+ld s gave %04u-%02u-%02u %02u:%02u:%02u\n", what, (unsigned long)timestamp,
+           (long)(int32_t)utc_offset, got.unit.year + WATCH_RTC_REFERENCE_YEAR, got.unit.month, got.unit.day,
+           got.unit.hour, got.unit.minute, got.unit.second);
+}
+
+static bool matches(watch_date_time date_time, const struct tm *tm) {
+    return (unsigned)(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR) == (unsigned)tm->tm_year + 1900 &&
+           date_time.unit.month == (unsigned)tm->tm_mon + 1 && date_time.unit.day == (unsigned)tm->tm_mday &&
+           date_time.unit.hour == (unsigned)tm->tm_hour && date_time.unit.minute == (unsigned)tm->tm_min &&
+           date_time.unit.second == (unsigned)tm->tm_sec;
+}
+
+static void check_second(uint32_t timestamp, uint32_t utc_offset) {
+    time_t local = (time_t)timestamp + (int32_t)utc_offset;
+    struct tm tm;
+    watch_date_time date_time = watch_utility_date_time_from_unix_time(timestamp, utc_offset);
+
+    gmtime_r(&local, &tm);
+    if (!matches(date_time, &tm)) fail("from_unix_time", timestamp, utc_offset, date_time);
+    else if (watch_utility_date_time_to_unix_time(date_time, utc_offset) != timestamp) fail("to_unix_time", timestamp, utc_offset, date_time);
+}
+
+static void check(uint32_t step) {
+    // every second (or every step-th), both ways.
+    for(uint64_t timestamp = FIRST_SECOND; timestamp <= LAST_SECOND; timestamp += step) check_second(timestamp, 0);
+    printf("%s second from 2020 through 2083: %lu failures\n", step == 1 ? "every" : "a sample of every", failures);
+
+    // every UTC offset in use, from -12:00 to +14:00 in quarter hours, at a few times each day.
+    unsigned long before = failures;
+    for(int32_t offset = -12 * 3600; offset <= 14 * 3600; offset += 900) {
+        for(uint64_t timestamp = FIRST_SECOND - offset; timestamp + offset <= LAST_SECOND; timestamp += 86400 * 7 + 3607) {
+            check_second(timestamp, (uint32_t)offset);
+        }
+    }
+    printf("every UTC offset, once a week: %lu failures\n", failures - before);
+
+    // outside the RTC's range, the date comes back empty.
+    before = failures;
+    static const uint32_t outside[] = { 0, 86400 * 365, FIRST_SECOND - 1, LAST_SECOND + 1, 4102444800UL, UINT32_MAX };
+    for(size_t i = 0; i < sizeof(outside) / sizeof(outside[0]); i++) {
+        watch_date_time date_time = watch_utility_date_time_from_unix_time(outside[i], 0);
+        if (date_time.reg != 0) fail("outside the range", outside[i], 0, date_time);
+    }
+    printf("outside the range: %lu failures\n", failures - before);
+}
+
+/* the implementations these replaced, for timing */
+
+__attribute__((noinline))
+static uint32_t legacy_convert_to_unix_time(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second, uint32_t utc_offset) {
+    uint16_t DAYS_SO_FAR[] = { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+
+    uint32_t year_adj = year + 4800;
+    uint32_t febs = year_adj - (month <= 2 ? 1 : 0);
+    uint32_t leap_days = 1 + (febs / 4) - (febs / 100) + (febs / 400);
+    uint32_t days = 365 * year_adj + leap_days + DAYS_SO_FAR[month - 1] + day - 1;
+    days -= 2472692;
+
+    uint32_t timestamp = days * 86400;
+    timestamp += hour * 3600;
+    timestamp += minute * 60;
+    timestamp += second;
+    timestamp -= utc_offset;
+
+    return timestamp;
+}
+
+#define LEAPOCH (946684800LL + 86400*(31+29))
+#define DAYS_PER_400Y (365*400 + 97)
+#define DAYS_PER_100Y (365*100 + 24)
+#define DAYS_PER_4Y   (365*4   + 1)
+
+__attribute__((noinline))
+static watch_date_time legacy_date_time_from_unix_time(uint32_t timestamp, uint32_t utc_offset) {
+    watch_date_time retval;
+    retval.reg = 0;
+    int32_t days, secs;
+    int32_t remdays, remsecs, remyears;
+    int32_t qc_cycles, c_cycles, q_cycles;
+    int32_t years, months;
+    static const int8_t days_in_month[] = {31,30,31,30,31,31,30,31,30,31,31,29};
+    timestamp += utc_offset;
+
+    secs = timestamp - LEAPOCH;
+    days = secs / 86400;
+    remsecs = secs % 86400;
+    if (remsecs < 0) {
+        remsecs += 86400;
+        days--;
+    }
+
+    qc_cycles = (int)(days / DAYS_PER_400Y);
+    remdays = days % DAYS_PER_400Y;
+    if (remdays < 0) {
+        remdays += DAYS_PER_400Y;
+        qc_cycles--;
+    }
+
+    c_cycles = remdays / DAYS_PER_100Y;
+    if (c_cycles == 4) c_cycles--;
+    remdays -= c_cycles * DAYS_PER_100Y;
+
+    q_cycles = remdays / DAYS_PER_4Y;
+    if (q_cycles == 25) q_cycles--;
+    remdays -= q_cycles * DAYS_PER_4Y;
+
+    remyears = remdays / 365;
+    if (remyears == 4) remyears--;
+    remdays -= remyears * 365;
+
+    years = remyears + 4*q_cycles + 100*c_cycles + 400*qc_cycles;
+
+    for (months=0; days_in_month[months] <= remdays; months++)
+        remdays -= days_in_month[months];
+
+    years += 2000;
+
+    months += 2;
+    if (months >= 12) {
+        months -=12;
+        years++;
+    }
+
+    if (years < 2020 || years > 2083) return retval;
+    retval.unit.year = years - WATCH_RTC_REFERENCE_YEAR;
+    retval.unit.month = months + 1;
+    retval.unit.day = remdays + 1;
+
+    retval.unit.hour = remsecs / 3600;
+    retval.unit.minute = remsecs / 60 % 60;
+    retval.unit.second = remsecs % 60;
+
+    return retval;
+}
+
+/* timing */
+
+static uint32_t bench_timestamp(uint32_t i) {
+    // spread over 2020 through 2067, where the old code still worked.
+    return FIRST_SECOND + (uint32_t)(i * 151.7);
+}
+
+static void bench(void) {
+    volatile uint32_t sink = 0;
+    uint64_t start;
+
+    start = cycles_now();
+    for(uint32_t i = 0; i < BENCH_CALLS; i++) sink += watch_utility_date_time_from_unix_time(bench_timestamp(i), 0).reg;
+    double from_new = (double)(cycles_now() - start) / BENCH_CALLS;
+    start = cycles_now();
+    for(uint32_t i = 0; i < BENCH_CALLS; i++) sink += legacy_date_time_from_unix_time(bench_timestamp(i), 0).reg;
+    double from_old = (double)(cycles_now() - start) / BENCH_CALLS;
+
+    start = cycles_now();
+    for(uint32_t i = 0; i < BENCH_CALLS; i++) sink += watch_utility_convert_to_unix_time(2020 + i % 64, 1 + i % 12, 1 + i % 28, i % 24, i % 60, i % 60, 0);
+    double to_new = (double)(cycles_now() - start) / BENCH_CALLS;
+    start = cycles_now();
+    for(uint32_t i = 0; i < BENCH_CALLS; i++) sink += legacy_convert_to_unix_time(2020 + i % 64, 1 + i % 12, 1 + i % 28, i % 24, i % 60, i % 60, 0);
+    double to_old = (double)(cycles_now() - start) / BENCH_CALLS;
+
+    (void)sink;
+    printf("date_time_from_unix_time: %6.1f %s a call, was %6.1f\n", from_new, CYCLE_UNIT, from_old);
+    printf("convert_to_unix_time:     %6.1f %s a call, was %6.1f\n", to_new, CYCLE_UNIT, to_old);
+}
+
+static void usage(const char *name) {
+    fprintf(stderr, "usage: %s [--step N] [--bench]\n", name);
+    fprintf(stderr, "  --step N   checks every Nth second instead of every one\n");
+    fprintf(stderr, "  --bench    only times the conversions\n");
+}
+
+int main(int argc, char **argv) {
+    uint32_t step = 1;
+    bool only_bench = false;
+
+    for(int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "--step") == 0) step = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--bench") == 0) only_bench = true;
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (step == 0) step = 1;
+
+    if (!only_bench) check(step);
+    bench();
+
+    return failures ? 1 : 0;
+}
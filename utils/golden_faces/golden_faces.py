@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+"""Drive every watch face through a scripted set of button presses and compare what it draws against its golden.
+
+This builds the host build of the simulator (make HOST=1, see watch-library/host/main.c) with the GOLDEN firmware,
+which has every face in movement/watch_faces (see movement/alt_fw/golden.h). For each face, it writes a trace that
+boots the watch, presses MODE until the face comes up, and then runs SCRIPT; the host build replays it on its virtual
+clock and writes out the display, one frame per pass through the main loop that changed it, and the buzzer's notes.
+Those from the moment the face comes up, timed from then, are compared against goldens/<face>.txt. Every trace also
+sets the temperature and loads a short accelerometer recording, so the faces that read the sensors have something to
+show.
+
+The host build replays the same way every time, on any machine, so a difference is a change in what the face draws:
+look it over, and if it's what you meant, run again with --update to write the new goldens.
+
+Usage:
+    golden_faces.py                    builds, runs every face, and fails if any differs from its golden
+    golden_faces.py stopwatch totp     ...just these faces
+    golden_faces.py --update           writes the goldens instead
+    golden_faces.py --no-build         uses the last build
+"""
+import argparse
+import difflib
+import math
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+MAKE_DIR = os.path.join(HERE, '..', '..', 'movement', 'make')
+FACE_LIST = os.path.join(HERE, '..', '..', 'movement', 'alt_fw', 'golden.h')
+BINARY = os.path.join(MAKE_DIR, 'build-host', 'watch')
+GOLDENS = os.path.join(HERE, 'goldens')
+
+# every trace starts the clock at 2024-06-01 10:00:00 UTC.
+CLOCK = 1717236000000
+# what the sensors sense: a cool room, and a wrist swinging about twice a second (at 12.5 Hz, the rate Movement runs
+# the accelerometer at), in milli-g.
+TEMPERATURE = 21.5
+ACCELEROMETER = [(round(300 * math.sin(i * math.pi / 3)), round(-150 * math.cos(i * math.pi / 3)),
+                  round(1000 + 400 * math.sin(i * math.pi / 3))) for i in range(6)]
+# presses to get to the face: MODE, once a second. Movement changes faces on the tick after the press, so each press
+# comes a little after a tick, and the face has come up by the same time a second after the last one.
+NAVIGATION_START = 1200
+NAVIGATION_STEP = 1000
+PRESS = 100
+LONG_PRESS = 1500
+# then, timed from when the face comes up: (ms to wait, button, ms to hold it).
+SCRIPT = [
+    (2000, 'alarm', PRESS),
+    (2000, 'alarm', PRESS),
+    (2000, 'light', PRESS),
+    (2000, 'alarm', LONG_PRESS),
+    (2000, 'alarm', PRESS),
+    (2000, 'light', LONG_PRESS),
+    (2000, 'alarm', PRESS),
+    (2000, None, 0),
+]
+
+
+def faces():
+    """Returns the faces in the GOLDEN firmware, in order."""
+    with open(FACE_LIST) as f:
+        return re.findall(r'^\s*(\w+)_face,', f.read(), re.MULTILINE)
+
+
+def press(events, time, button, hold):
+    events.append((time, 'button', button + ' down'))
+    events.append((time + hold, 'button', button + ' up'))
+
+
+def trace_for(index):
+    """Returns the trace for the face at index, and the time it comes up."""
+    events = [
+        (0, 'clock', str(CLOCK)),
+        (0, 'temperature', str(TEMPERATURE)),
+        (0, 'accelerometer', ' '.join(str(value) for sample in ACCELEROMETER for value in sample)),
+    ]
+    time = NAVIGATION_START
+    for _ in range(index):
+        press(events, time, 'mode', PRESS)
+        time += NAVIGATION_STEP
+    start = time
+    for wait, button, hold in SCRIPT:
+        time += wait
+        if button:
+            press(events, time, button, hold)
+            time += hold
+    # the host build runs until the end.
+    events.append((time, 'end', ''))
+    return ''.join(('%d %s %s' % event).rstrip() + '\n' for event in events), start
+
+
+def frames_from(output, start):
+    """Returns the frames and notes in the host build's output from start on, timed from then.
+
+    Frames are a line with the time, then the display; everything else takes one line, with the time first. The bus
+    counts at the end are left out: they count everything since the watch booted, faces before this one too."""
+    entries = []
+    for line in output.splitlines(True):
+        match = re.match(r'^(\d+) ms(.*)$', line)
+        if match:
+            entries.append([int(match.group(1)), match.group(2), ''])
+        elif entries:
+            entries[-1][2] += line
+    kept = []
+    for time, what, text in entries:
+        if what.startswith(' bus '):
+            continue
+        if time > start:
+            kept.append((time - start, what, text))
+        elif not what:
+            # the display as it was when the face came up.
+            kept = [(0, what, text)]
+    return ''.join('%d ms%s\n%s' % entry for entry in kept)
+
+
+def run(index):
+    trace, start = trace_for(index)
+    with tempfile.TemporaryDirectory() as directory:
+        trace_path = os.path.join(directory, 'trace.txt')
+        output_path = os.path.join(directory, 'frames.txt')
+        with open(trace_path, 'w') as f:
+            f.write(trace)
+        subprocess.run([BINARY, '--trace', trace_path, '--output', output_path], check=True, stdout=subprocess.DEVNULL)
+        with open(output_path) as f:
+            return frames_from(f.read(), start)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('faces', nargs='*', help='faces to run, without the _face (all of them if none)')
+    parser.add_argument('--update', action='store_true', help='write the goldens instead of comparing against them')
+    parser.add_argument('--no-build', action='store_true', help='use the last host build')
+    args = parser.parse_args()
+
+    if not args.no_build:
+        # from scratch: the build doesn't track which firmware its objects were built for.
+        for target in ['clean', 'all']:
+            subprocess.run(['make', 'HOST=1', 'FIRMWARE=GOLDEN', target], cwd=MAKE_DIR, check=True, stdout=subprocess.DEVNULL)
+
+    all_faces = faces()
+    unknown = [face for face in args.faces if face not in all_faces]
+    if unknown:
+        parser.error('no such face: ' + ', '.join(unknown))
+
+    failed = []
+    for index, face in enumerate(all_faces):
+        if args.faces and face not in args.faces:
+            continue
+        frames = run(index)
+        golden = os.path.join(GOLDENS, face + '.txt')
+        if args.update:
+            os.makedirs(GOLDENS, exist_ok=True)
+            with open(golden, 'w') as f:
+                f.write(frames)
+            print('wrote', os.path.relpath(golden))
+            continue
+        expected = open(golden).read() if os.path.exists(golden) else ''
+        if frames != expected:
+            failed.append(face)
+            sys.stdout.writelines(difflib.unified_diff(expected.splitlines(True), frames.splitlines(True),
+                                                       'goldens/' + face + '.txt', face + ' now'))
+        else:
+            print('ok', face)
+
+    if failed:
+        print('%d of the faces differ from their goldens: %s' % (len(failed), ', '.join(failed)))
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
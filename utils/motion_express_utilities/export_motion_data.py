@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+"""Fetch accelerometer recordings from a watch running apps/motion-export, and decode them.
+
+The watch streams raw 256-byte flash pages over USB serial, each in a frame with a CRC-32:
+
+    page frame: 'P', uint16 page, 256 bytes of data, uint32 CRC-32 of page number and data
+    end frame:  'E', uint16 number of page frames sent, uint32 CRC-32 of that count
+
+If a frame arrives damaged, we ask again starting from that page. Decoded events are written as one
+CSV per event (the same files process_motion_dump.py writes), and optionally as NumPy arrays.
+
+Usage:
+    export_motion_data.py /dev/ttyACM0 [--raw dump.bin] [--numpy]
+    export_motion_data.py --from-raw dump.bin [--numpy]
+"""
+import argparse
+import struct
+import sys
+import zlib
+from pathlib import Path
+
+PAGE_SIZE = 256
+RECORDS_PER_PAGE = PAGE_SIZE // 8
+PAGE_FRAME = struct.Struct('<H256sI')
+END_FRAME = struct.Struct('<HI')
+
+RECORD_TYPE_HEADER = 0b10
+RECORD_TYPE_DATA = 0b01
+
+ACTIVITY_NAMES = {
+    'TE': 'testing',
+    'ID': 'idle',
+    'OF': 'off_wrist',
+    'SL': 'sleeping',
+    'WH': 'washing_hands',
+    'WA': 'walking',
+    'WB': 'walking_with_beverage',
+    'JO': 'jogging',
+    'RU': 'running',
+    'BI': 'biking',
+    'HI': 'hiking',
+    'EL': 'elliptical',
+    'SU': 'stairs_up',
+    'SD': 'stairs_down',
+    'WL': 'weight_lifting',
+}
+
+# milli-g per LSB, indexed by lis2dw_range_t; LP mode 1 is 12-bit, so four times coarser.
+RANGE_G = {0: 2, 1: 4, 2: 8, 3: 16}
+LSB_MG = {0: 0.244, 1: 0.488, 2: 0.976, 3: 1.952}
+FILTER_DIVISOR = {0: 2, 1: 4, 2: 10, 3: 20}
+STANDARD_GRAVITY = 9.80665
+
+
+def fetch_pages(port, baudrate=115200, timeout=5):
+    """Returns a dict of page number to page data, resuming after any damaged frame."""
+    import serial
+
+    pages = {}
+    first_page = 0
+    with serial.Serial(port, baudrate, timeout=timeout) as connection:
+        connection.reset_input_buffer()
+        while True:
+            connection.write(f'X{first_page}\n'.encode())
+            resume_from = None
+            while True:
+                frame_type = connection.read(1)
+                if not frame_type:
+                    raise TimeoutError('watch stopped responding')
+                if frame_type == b'P':
+                    raw = connection.read(PAGE_FRAME.size)
+                    if len(raw) < PAGE_FRAME.size:
+                        raise TimeoutError('watch stopped responding mid-frame')
+                    page, data, crc = PAGE_FRAME.unpack(raw)
+                    if zlib.crc32(raw[:-4]) != crc:
+                        # we can't trust the page number either; resume from just after the last good page.
+                        resume_from = max(pages) + 1 if pages else first_page
+                        break
+                    pages[page] = data
+                    print(f'\rReceived {len(pages)} pages', end='', file=sys.stderr)
+                elif frame_type == b'E':
+                    raw = connection.read(END_FRAME.size)
+                    count, crc = END_FRAME.unpack(raw)
+                    if zlib.crc32(raw[:2]) != crc:
+                        print('\nWarning: damaged end frame', file=sys.stderr)
+                    print(file=sys.stderr)
+                    return pages
+                # anything else is stray console output; skip it.
+            print(f'\nBad CRC, resuming from page {resume_from}', file=sys.stderr)
+            # drain the rest of the aborted transfer before asking again.
+            while connection.read(PAGE_SIZE * 16):
+                pass
+            first_page = resume_from
+
+
+def save_raw(pages, filename):
+    with open(filename, 'wb') as f:
+        for page in sorted(pages):
+            f.write(struct.pack('<H', page) + pages[page])
+
+
+def load_raw(filename):
+    pages = {}
+    with open(filename, 'rb') as f:
+        while chunk := f.read(2 + PAGE_SIZE):
+            page, = struct.unpack('<H', chunk[:2])
+            pages[page] = chunk[2:]
+    return pages
+
+
+def decode_events(pages):
+    """Yields (name, rows) for each recording, where each row is (timestamp_ms, x, y, z) in m/s^2."""
+    name = None
+    rows = []
+    header = None
+    lsb = 1.0
+    for page in sorted(pages):
+        for (value,) in struct.iter_unpack('<Q', pages[page]):
+            record_type = value & 0b11
+            if record_type == RECORD_TYPE_HEADER:
+                if name is not None:
+                    yield name, rows
+                    name, rows = None, []
+                header = {
+                    'range': (value >> 2) & 0b11,
+                    'activity': chr((value >> 16) & 0xFF) + chr((value >> 24) & 0xFF),
+                    'timestamp': (value >> 32) & 0xFFFFFFFF,
+                }
+            elif record_type == RECORD_TYPE_DATA and header is not None:
+                x = (value >> 2) & 0x3FFF
+                lpmode = (value >> 16) & 0b11
+                y = (value >> 18) & 0x3FFF
+                filter_setting = (value >> 32) & 0b11
+                z = (value >> 34) & 0x3FFF
+                counter = (value >> 48) & 0xFFFF
+                if name is None:
+                    lsb = LSB_MG[header['range']] * (4 if lpmode == 0 else 1)
+                    activity = ACTIVITY_NAMES.get(header['activity'], header['activity'])
+                    name = (f"{activity}.{header['timestamp']}.range{RANGE_G[header['range']]}"
+                            f"-lp{lpmode + 1}-filt{FILTER_DIVISOR[filter_setting]}").lower().replace('_', '-')
+                scale = STANDARD_GRAVITY * lsb / 1000
+                rows.append(((header['timestamp'] * 100 + counter) * 10,
+                             (x - 8192) * scale, (y - 8192) * scale, (z - 8192) * scale))
+    if name is not None:
+        yield name, rows
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('port', nargs='?', help='serial port of the watch, i.e. /dev/ttyACM0')
+    parser.add_argument('--from-raw', help='decode a raw dump saved earlier with --raw instead of fetching')
+    parser.add_argument('--raw', help='also save the raw pages to this file')
+    parser.add_argument('--numpy', action='store_true', help='also write each event as a .npy array')
+    parser.add_argument('--output', default='output', help='output directory (default: output)')
+    args = parser.parse_args()
+
+    if args.from_raw:
+        pages = load_raw(args.from_raw)
+    elif args.port:
+        pages = fetch_pages(args.port)
+    else:
+        parser.error('need a serial port or --from-raw')
+    if args.raw:
+        save_raw(pages, args.raw)
+
+    output = Path(args.output)
+    (output / 'plots').mkdir(parents=True, exist_ok=True)
+    num_events = 0
+    num_records = 0
+    with open(output / 'makeplots.sh', 'w') as s:
+        for name, rows in decode_events(pages):
+            num_events += 1
+            num_records += len(rows)
+            with open(output / f'{name}.csv', 'w') as f:
+                f.write('timestamp,accX,accY,accZ\n')
+                for row in rows:
+                    f.write('%d,%f,%f,%f\n' % row)
+            if args.numpy:
+                import numpy
+                numpy.save(output / f'{name}.npy', numpy.array(rows, dtype=numpy.float64))
+            s.write(f'../csv2gnuplot.sh -i "{name}.csv" -O "./plots/{name}.png"  -g "{name}.gnuplot" '
+                    f'-F png -W 1200 -H 675 -e -l -G ../plot.options && rm "{name}.gnuplot"\n')
+
+    print(f'Processed {num_records} records in {num_events} events from {len(pages)} pages!')
+    print(f'To generate plots: cd {output} && bash makeplots.sh')
+
+
+if __name__ == '__main__':
+    main()
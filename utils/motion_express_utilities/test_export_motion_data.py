@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""Checks export_motion_data.py on the host, against a fake watch.
+
+The fake watch answers "X<first page>" the way apps/motion-export does: a page frame for each used page from there
+on, then an end frame. One transfer can be made to arrive damaged, to check that the fetch resumes from the last
+good page. The records are built bit by bit from accelerometer_data_acquisition_record_t, to check the decoder.
+
+Usage:
+    test_export_motion_data.py
+"""
+import os
+import struct
+import sys
+import tempfile
+import types
+import zlib
+
+import export_motion_data as export
+
+failures = 0
+
+
+def expect(what, ok):
+    global failures
+    print('%-64s %s' % (what, 'ok' if ok else 'FAIL'))
+    if not ok:
+        failures += 1
+
+
+def page_frame(page, data):
+    body = struct.pack('<H', page) + data
+    return b'P' + body + struct.pack('<I', zlib.crc32(body))
+
+
+def end_frame(count):
+    body = struct.pack('<H', count)
+    return b'E' + body + struct.pack('<I', zlib.crc32(body))
+
+
+class FakeWatch:
+    """Stands in for serial.Serial. damage is a page number whose frame gets a flipped bit on the first transfer."""
+
+    def __init__(self, pages, damage=None, chatter=b''):
+        self.pages = pages
+        self.damage = damage
+        self.chatter = chatter
+        self.requests = []
+        self.buffer = b''
+
+    def __call__(self, port, baudrate, timeout):
+        return self
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        pass
+
+    def reset_input_buffer(self):
+        self.buffer = b''
+
+    def write(self, data):
+        self.requests.append(data.decode().strip())
+        first_page = int(data[1:])
+        sent = [page for page in sorted(self.pages) if page >= first_page]
+        stream = self.chatter
+        for page in sent:
+            frame = bytearray(page_frame(page, self.pages[page]))
+            if page == self.damage:
+                frame[100] ^= 0x10
+                self.damage = None
+            stream += bytes(frame)
+        self.buffer += stream + end_frame(len(sent))
+
+    def read(self, size):
+        data, self.buffer = self.buffer[:size], self.buffer[size:]
+        return data
+
+
+def fetch(watch):
+    sys.modules['serial'] = types.SimpleNamespace(Serial=watch)
+    stderr, sys.stderr = sys.stderr, open(os.devnull, 'w')
+    try:
+        return export.fetch_pages('/dev/fake')
+    finally:
+        sys.stderr.close()
+        sys.stderr = stderr
+
+
+def header_record(range_setting, activity, timestamp):
+    return 0b10 | range_setting << 2 | ord(activity[0]) << 16 | ord(activity[1]) << 24 | timestamp << 32
+
+
+def data_record(x, y, z, counter, lpmode=1, filter_setting=0):
+    return 0b01 | x << 2 | lpmode << 16 | y << 18 | filter_setting << 32 | z << 34 | counter << 48
+
+
+def page_of(records):
+    records = records + [0xFFFFFFFFFFFFFFFF] * (export.RECORDS_PER_PAGE - len(records))
+    return struct.pack('<%dQ' % export.RECORDS_PER_PAGE, *records)
+
+
+def check_fetch():
+    # pages 2 to 9 were written; the first two hold the bitmap, which the watch never sends.
+    pages = {page: bytes([page]) * export.PAGE_SIZE for page in range(2, 10)}
+
+    watch = FakeWatch(pages)
+    expect('fetch: every page arrives', fetch(watch) == pages)
+    expect('fetch: in one transfer', watch.requests == ['X0'])
+
+    watch = FakeWatch(pages, damage=5)
+    expect('fetch: a damaged page still arrives', fetch(watch) == pages)
+    expect('fetch: resumed from the damaged page', watch.requests == ['X0', 'X5'])
+
+    watch = FakeWatch(pages, damage=2)
+    expect('fetch: a damaged first page arrives', fetch(watch) == pages)
+    expect('fetch: resumed from the start', watch.requests == ['X0', 'X0'])
+
+    watch = FakeWatch(pages, chatter=b'boot\r\n')
+    expect('fetch: console output before the frames is skipped', fetch(watch) == pages)
+
+    with tempfile.TemporaryDirectory() as directory:
+        filename = os.path.join(directory, 'dump.bin')
+        export.save_raw(pages, filename)
+        expect('raw: saved pages load back the same', export.load_raw(filename) == pages)
+
+
+def check_decode():
+    # two events: walking at 4g with two samples, then idle at 2g with one, spilling onto a second page.
+    first = page_of([header_record(1, 'WA', 1000),
+                     data_record(8192 + 100, 8192 - 100, 8192, 0),
+                     data_record(8192, 8192, 8192 + 1024, 7)])
+    second = page_of([header_record(0, 'ID', 2000), data_record(8192 + 4, 8192, 8192, 1, lpmode=0, filter_setting=2)])
+    events = list(export.decode_events({3: second, 2: first}))
+
+    expect('decode: two events, in page order', [name for name, rows in events] ==
+           ['walking.1000.range4-lp2-filt2', 'idle.2000.range2-lp1-filt10'])
+    scale = export.STANDARD_GRAVITY * export.LSB_MG[1] / 1000
+    rows = events[0][1]
+    expect('decode: timestamps in ms from the header and counter', [row[0] for row in rows] == [1000000, 1000070])
+    expect('decode: samples centered and scaled to m/s^2',
+           abs(rows[0][1] - 100 * scale) < 1e-9 and abs(rows[0][2] + 100 * scale) < 1e-9 and rows[0][3] == 0 and
+           abs(rows[1][3] - 1024 * scale) < 1e-9)
+    # LP mode 1 is 12-bit, so each LSB counts four times as much.
+    scale = export.STANDARD_GRAVITY * export.LSB_MG[0] * 4 / 1000
+    expect('decode: LP mode 1 samples are four times coarser', abs(events[1][1][0][1] - 4 * scale) < 1e-9)
+    expect('decode: erased records end a page', len(rows) == 2 and len(events[1][1]) == 1)
+
+
+def main():
+    check_fetch()
+    check_decode()
+    print('FAILED' if failures else 'all passed')
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
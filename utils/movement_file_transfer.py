@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""Push files to, and pull files from, the filesystem of a watch running Movement, over USB serial.
+
+Uses the shell's get and put commands, which move data in CRC-checked frames:
+
+    frame: type byte, uint16 payload length, payload, uint32 CRC-32 of everything before it (little endian)
+    types: 'S' start (payload: uint32 size), 'D' data, 'E' end, 'X' error (payload: message)
+
+Each frame is answered with one byte: 'A' to accept it, 'N' to have it resent, or 'F' to abort.
+
+Usage:
+    movement_file_transfer.py /dev/ttyACM0 pull totp.dat [local_file]
+    movement_file_transfer.py /dev/ttyACM0 push local_file [totp.dat]
+"""
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+MAX_PAYLOAD = 256
+MAX_RETRIES = 5
+ACK, NAK, FAIL = b'A', b'N', b'F'
+
+
+class TransferError(Exception):
+    pass
+
+
+def send_frame(connection, frame_type, payload=b''):
+    header = frame_type + struct.pack('<H', len(payload))
+    frame = header + payload + struct.pack('<I', zlib.crc32(header + payload))
+    for _ in range(MAX_RETRIES):
+        connection.write(frame)
+        response = connection.read(1)
+        if response == ACK:
+            return
+        if response != NAK:
+            raise TransferError('watch aborted the transfer' if response == FAIL else 'watch stopped responding')
+    raise TransferError('too many retries')
+
+
+def receive_frame(connection):
+    for _ in range(MAX_RETRIES):
+        header = connection.read(3)
+        if len(header) < 3:
+            raise TransferError('watch stopped responding')
+        length, = struct.unpack('<H', header[1:])
+        rest = connection.read(length + 4) if length <= MAX_PAYLOAD else b''
+        if len(rest) == length + 4 and zlib.crc32(header + rest[:-4]) == struct.unpack('<I', rest[-4:])[0]:
+            connection.write(ACK)
+            payload = rest[:-4]
+            if header[:1] == b'X':
+                raise TransferError(payload.decode(errors='replace'))
+            return header[:1], payload
+        connection.reset_input_buffer()
+        connection.write(NAK)
+    raise TransferError('too many retries')
+
+
+def start_command(connection, command):
+    """Sends a shell command, and skips past its echo so that the next byte read is the first frame."""
+    connection.reset_input_buffer()
+    connection.write(command.encode() + b'\n')
+    while True:
+        line = connection.readline()
+        if not line:
+            raise TransferError('no response from the watch; is Movement running?')
+        if line.decode(errors='replace').strip() == f'$ {command}':
+            return
+
+
+def pull(connection, remote_name, local_name):
+    start_command(connection, f'get {remote_name}')
+    frame_type, payload = receive_frame(connection)
+    if frame_type != b'S':
+        raise TransferError('unexpected frame')
+    size, = struct.unpack('<I', payload)
+    data = bytearray()
+    while True:
+        frame_type, payload = receive_frame(connection)
+        if frame_type == b'E':
+            break
+        data += payload
+        print(f'\r{len(data)} / {size} bytes', end='', file=sys.stderr)
+    print(file=sys.stderr)
+    if len(data) != size:
+        raise TransferError(f'expected {size} bytes, got {len(data)}')
+    with open(local_name, 'wb') as f:
+        f.write(data)
+
+
+def push(connection, local_name, remote_name):
+    with open(local_name, 'rb') as f:
+        data = f.read()
+    start_command(connection, f'put {remote_name} {len(data)}')
+    frame_type, _ = receive_frame(connection)
+    if frame_type != b'S':
+        raise TransferError('unexpected frame')
+    for offset in range(0, len(data), MAX_PAYLOAD):
+        send_frame(connection, b'D', data[offset:offset + MAX_PAYLOAD])
+        print(f'\r{min(offset + MAX_PAYLOAD, len(data))} / {len(data)} bytes', end='', file=sys.stderr)
+    print(file=sys.stderr)
+    # the watch acknowledges the end frame only once the file is closed.
+    send_frame(connection, b'E')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('port', help='serial port of the watch, i.e. /dev/ttyACM0')
+    parser.add_argument('direction', choices=['pull', 'push'])
+    parser.add_argument('source')
+    parser.add_argument('destination', nargs='?')
+    args = parser.parse_args()
+
+    import serial
+    with serial.Serial(args.port, 115200, timeout=3) as connection:
+        try:
+            if args.direction == 'pull':
+                pull(connection, args.source, args.destination or args.source)
+            else:
+                push(connection, args.source, args.destination or os.path.basename(args.source))
+        except TransferError as e:
+            sys.exit(f'{args.direction} failed: {e}')
+
+
+if __name__ == '__main__':
+    main()
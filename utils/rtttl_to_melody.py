@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+"""Compile RTTTL ringtones into the compact buzzer melody format played by watch_buzzer_play_melody.
+
+The format (documented in watch-library/shared/watch/watch_buzzer.h) is one byte for the length of a 32nd note in
+milliseconds, then one byte per command:
+
+    0x0n-0xBn  note C..B in the current octave, duration code n
+    0xCn       rest, duration code n
+    0xDn       set octave n
+    0xE0       start of a repeated passage
+    0xEn       repeat the passage n more times
+    0xFF       end
+
+Duration codes index DURATIONS below, in 32nd notes. The compiler only emits octave changes when the octave changes,
+and folds back-to-back repeats of a passage into a repeat marker.
+
+Usage:
+    rtttl_to_melody.py 'Beep:d=8,o=6,b=180:c,p,c,p,c'
+    rtttl_to_melody.py --file ringtones.txt            one RTTTL string per line
+    rtttl_to_melody.py --name my_melody 'Beep:d=8,o=6,b=180:c,p,c'
+
+Prints a C array for each melody, followed by its size in bytes (and the size as watch_buzzer_step_t array).
+"""
+import argparse
+import re
+import sys
+
+DURATIONS = [1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64, 96, 128, 192, 256]
+PITCHES = {'c': 0, 'c#': 1, 'd': 2, 'd#': 3, 'e': 4, 'f': 5, 'f#': 6, 'g': 7, 'g#': 8, 'a': 9, 'a#': 10, 'b': 11}
+REST = None
+OCTAVE_DEFAULT = 4  # the player's starting octave
+STEP_SIZE = 8       # sizeof(watch_buzzer_step_t) on the watch: an int sized enum and a uint16_t, padded
+
+
+class RtttlError(Exception):
+    pass
+
+
+def parse_rtttl(text):
+    """Returns the name, the length of a 32nd note in ms, and a list of (pitch, octave, 32nds); pitch None is a rest."""
+    try:
+        name, defaults, notes = text.strip().split(':')
+    except ValueError:
+        raise RtttlError('expected name:defaults:notes')
+
+    settings = {'d': 4, 'o': 6, 'b': 63}
+    for setting in filter(None, defaults.replace(' ', '').split(',')):
+        key, _, value = setting.partition('=')
+        if key not in settings or not value.isdigit():
+            raise RtttlError('bad default %r' % setting)
+        settings[key] = int(value)
+
+    # a quarter note lasts one beat, and a 32nd an eighth of that.
+    unit_ms = round(60000 / settings['b'] / 8)
+    if not 1 <= unit_ms <= 255:
+        raise RtttlError('tempo %d is out of range' % settings['b'])
+
+    parsed = []
+    pattern = re.compile(r'^(\d*)([a-gp]#?)(\.?)(\d?)(\.?)$')
+    for note in filter(None, notes.replace(' ', '').lower().split(',')):
+        match = pattern.match(note)
+        if not match:
+            raise RtttlError('bad note %r' % note)
+        duration, pitch, dot1, octave, dot2 = match.groups()
+        length = 32 // int(duration or settings['d'])
+        if dot1 or dot2:
+            length = length * 3 // 2 or 2
+        if pitch == 'p':
+            parsed.append((REST, None, length))
+        elif pitch not in PITCHES:
+            raise RtttlError('bad pitch %r' % pitch)
+        else:
+            parsed.append((PITCHES[pitch], int(octave or settings['o']), length))
+
+    return name, unit_ms, parsed
+
+
+def split_duration(length):
+    """Splits a length in 32nds into duration codes, longest first."""
+    codes = []
+    while length > 0:
+        code = max(i for i, d in enumerate(DURATIONS) if d <= length)
+        codes.append(code)
+        length -= DURATIONS[code]
+    return codes
+
+
+def encode_notes(notes, octave):
+    """Encodes notes starting from the given octave; returns the bytes and the octave afterwards."""
+    out = []
+    for pitch, note_octave, length in notes:
+        if pitch is REST:
+            out += [0xC0 | code for code in split_duration(length)]
+            continue
+        if note_octave != octave:
+            out.append(0xD0 | note_octave)
+            octave = note_octave
+        codes = split_duration(length)
+        # a note too long for one code is held with a rest; good enough for a piezo.
+        out.append(pitch << 4 | codes[0])
+        out += [0xC0 | code for code in codes[1:]]
+    return out, octave
+
+
+def encode(notes):
+    """Encodes notes, folding back-to-back repeats of a passage into a repeat marker where that saves bytes."""
+    out = []
+    octave = OCTAVE_DEFAULT
+    i = 0
+    while i < len(notes):
+        best = None
+        for length in range(len(notes[i:]) // 2, 0, -1):
+            passage = notes[i:i + length]
+            times = 1
+            while notes[i + length * times:i + length * (times + 1)] == passage and times < 16:
+                times += 1
+            if times < 2:
+                continue
+            # the passage gets an explicit octave (see below), plus the two repeat markers.
+            body, _ = encode_notes(passage, None)
+            saving = len(encode_notes(passage * times, octave)[0]) - (len(body) + 2)
+            if saving > 0 and (best is None or saving > best[0]):
+                best = (saving, length, times)
+        if best:
+            _, length, times = best
+            passage = notes[i:i + length]
+            out.append(0xE0)
+            # force an explicit octave at the top of the passage, so every pass sounds the same.
+            body, octave = encode_notes(passage, None)
+            out += body
+            out.append(0xE0 | (times - 1))
+            i += length * times
+        else:
+            body, octave = encode_notes(notes[i:i + 1], octave)
+            out += body
+            i += 1
+    out.append(0xFF)
+    return out
+
+
+def c_identifier(name):
+    identifier = re.sub(r'\W', '_', name.strip().lower()).strip('_') or 'melody'
+    return identifier if not identifier[0].isdigit() else '_' + identifier
+
+
+def compile_rtttl(text, name=None):
+    rtttl_name, unit_ms, notes = parse_rtttl(text)
+    melody = [unit_ms] + encode(notes)
+    identifier = name or c_identifier(rtttl_name) + '_melody'
+    lines = ['// %s: %d notes, %d bytes (%d as watch_buzzer_step_t)' % (rtttl_name, len(notes), len(melody),
+                                                                          len(notes) * STEP_SIZE)]
+    lines.append('static const uint8_t %s[] = {' % identifier)
+    for row in range(0, len(melody), 12):
+        lines.append('    ' + ', '.join('0x%02X' % b for b in melody[row:row + 12]) + ',')
+    lines.append('};')
+    return '\n'.join(lines), len(melody)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('rtttl', nargs='*', help='RTTTL strings')
+    parser.add_argument('--file', help='a file with one RTTTL string per line')
+    parser.add_argument('--name', help='the C identifier to use (only with a single melody)')
+    args = parser.parse_args()
+
+    ringtones = list(args.rtttl)
+    if args.file:
+        with open(args.file) as f:
+            ringtones += [line for line in f.read().splitlines() if line.strip() and not line.startswith('#')]
+    if not ringtones:
+        parser.error('no RTTTL given')
+    if args.name and len(ringtones) > 1:
+        parser.error('--name only works with a single melody')
+
+    total = 0
+    for text in ringtones:
+        try:
+            source, size = compile_rtttl(text, args.name)
+        except RtttlError as e:
+            print('error in %r: %s' % (text[:40], e), file=sys.stderr)
+            return 1
+        print(source)
+        print()
+        total += size
+    if len(ringtones) > 1:
+        print('// total: %d bytes' % total)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,233 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Checks the simulator's virtual I2C bus on the host, through the accelerometer's driver: an asynchronous FIFO read
+// gets every sample in order in one burst, and a transaction that the device NACKs, or that loses arbitration to
+// another controller, fails the read cleanly and leaves the samples in the FIFO for the next one. The counters the
+// page shows as Module.busStats() add up the transactions, bytes and wire time that each kind of transfer should
+// take. The clock is a variable that the checks move by hand.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "watch.h"
+#include "../../watch-library/simulator/watch/watch_sim_bus.c"
+#include "../../watch-library/simulator/watch/watch_sim_lis2dw.c"
+#include "../../watch-library/simulator/watch/watch_i2c.c"
+#include "../../watch-library/simulator/watch/watch_spi.c"
+#include "../../watch-library/shared/driver/lis2dw.c"
+
+// 100 Hz, in ms.
+#define SAMPLE_PERIOD 10
+
+static double now = 1.7e12;
+static int failures;
+
+/* stubs for what the bus and the sensor expect from the rest of the simulator */
+
+bool watch_get_pin_level(const uint8_t pin) {
+    // chip selects idle high, so the flash is never selected.
+    return true;
+}
+
+double watch_sim_bus_now(void) {
+    return now;
+}
+
+void watch_trace_event(const char *type, const char *data) {}
+
+static void _flash_nothing(void) {}
+static uint8_t _flash_exchange(uint8_t byte) { return 0xFF; }
+
+const watch_sim_spi_device_t watch_sim_flash = {
+    .cs_pin = 0,
+    .init = _flash_nothing,
+    .select = _flash_nothing,
+    .exchange = _flash_exchange,
+    .deselect = _flash_nothing,
+};
+
+/* checks */
+
+static void expect(const char *what, bool ok) {
+    printf("%-72s %s\n", what, ok ? "ok" : "FAIL");
+    if (!ok) failures++;
+}
+
+static lis2dw_fifo_t fifo;
+static bool read_done;
+static bool read_success;
+
+static void fifo_read_done(lis2dw_fifo_t *fifo_data, bool success, void *context) {
+    read_done = true;
+    read_success = success;
+}
+
+// the simulated bus finishes a transfer before queueing it returns, so the callback has run by the time this does.
+static bool read_fifo(void) {
+    read_done = false;
+    memset(&fifo, 0xAA, sizeof(fifo));
+    return lis2dw_read_fifo_async(&fifo, fifo_read_done, NULL) && read_done && read_success;
+}
+
+// the recording cycles through one axis at a time, so each reading says where in the cycle it came from.
+static int8_t axis_of(lis2dw_reading_t reading) {
+    if (reading.x && !reading.y && !reading.z) return 0;
+    if (!reading.x && reading.y && !reading.z) return 1;
+    if (!reading.x && !reading.y && reading.z) return 2;
+    return -1;
+}
+
+static bool readings_in_order(void) {
+    int8_t first = axis_of(fifo.readings[0]);
+    if (first < 0) return false;
+    for(int8_t i = 0; i < fifo.count; i++) {
+        if (axis_of(fifo.readings[i]) != (first + i) % 3) return false;
+    }
+    return true;
+}
+
+static void start_sensor(void) {
+    static const int16_t recording[] = {
+        500, 0, 0,
+        0, 500, 0,
+        0, 0, 500,
+    };
+
+    watch_sim_bus_init();
+    watch_sim_lis2dw_load_samples(recording, 3);
+    expect("the sensor answers", lis2dw_begin());
+    lis2dw_set_data_rate(LIS2DW_DATA_RATE_100_HZ);
+    lis2dw_set_fifo_mode(LIS2DW_FIFO_MODE_COLLECT_CONTINUOUS);
+}
+
+static void check_fifo_read(void) {
+    now += 10 * SAMPLE_PERIOD + SAMPLE_PERIOD / 2;
+    uint32_t transactions = watch_i2c_get_transaction_count();
+    expect("async read: succeeds", read_fifo());
+    expect("async read: gets ten samples at 100 Hz", fifo.count == 10);
+    expect("async read: a burst gets them in order", readings_in_order());
+    expect("async read: two transfers, each with a repeated start", watch_i2c_get_transaction_count() - transactions == 4);
+
+    expect("async read: an empty FIFO reads as no samples", read_fifo() && fifo.count == 0);
+}
+
+static void check_fault(const char *what, watch_sim_i2c_fault_t fault, uint32_t skip) {
+    char description[80];
+
+    now += 5 * SAMPLE_PERIOD;
+    watch_sim_bus_inject_i2c_fault(fault, skip);
+    bool ok = !read_fifo() && read_done && !read_success && fifo.count == 0;
+    snprintf(description, sizeof(description), "%s: the read fails with no samples", what);
+    expect(description, ok);
+
+    now += 5 * SAMPLE_PERIOD;
+    snprintf(description, sizeof(description), "%s: the next read gets everything since", what);
+    expect(description, read_fifo() && fifo.count == 10 && readings_in_order());
+}
+
+static void check_faults(void) {
+    check_fault("NACK on the count", WATCH_SIM_I2C_FAULT_NACK, 0);
+    check_fault("NACK on the samples", WATCH_SIM_I2C_FAULT_NACK, 1);
+    check_fault("arbitration lost on the count", WATCH_SIM_I2C_FAULT_ARBITRATION_LOST, 0);
+    check_fault("arbitration lost on the samples", WATCH_SIM_I2C_FAULT_ARBITRATION_LOST, 1);
+
+    // the blocking functions can't report a failure, but a NACKed register reads as zero and the next one is fine.
+    watch_sim_bus_inject_i2c_fault(WATCH_SIM_I2C_FAULT_NACK, 1);
+    expect("NACK on a register read: reads zero", lis2dw_get_device_id() == 0);
+    expect("NACK on a register read: the next one is fine", lis2dw_get_device_id() == LIS2DW_WHO_AM_I_VAL);
+
+    // a NACK is the start, the address and its acknowledge, and a stop: 11 bits at 100 kHz. losing arbitration
+    // during the address leaves the stop to the other controller.
+    uint8_t reg = LIS2DW_REG_WHO_AM_I;
+    watch_sim_bus_reset_stats();
+    watch_sim_bus_inject_i2c_fault(WATCH_SIM_I2C_FAULT_NACK, 0);
+    watch_i2c_send(LIS2DW_ADDRESS, &reg, 1);
+    watch_sim_bus_stats_t stats = watch_sim_bus_get_stats(WATCH_SIM_BUS_I2C);
+    expect("NACK: one transaction, no bytes, 110 us", stats.transactions == 1 && stats.bytes == 0 && stats.time_us == 110);
+    watch_sim_bus_reset_stats();
+    watch_sim_bus_inject_i2c_fault(WATCH_SIM_I2C_FAULT_ARBITRATION_LOST, 0);
+    watch_i2c_send(LIS2DW_ADDRESS, &reg, 1);
+    stats = watch_sim_bus_get_stats(WATCH_SIM_BUS_I2C);
+    expect("arbitration lost: one transaction, no bytes, 100 us", stats.transactions == 1 && stats.bytes == 0 && stats.time_us == 100);
+}
+
+static bool stats_are(watch_sim_bus_t bus, uint32_t transactions, uint32_t bytes, uint32_t time_us) {
+    watch_sim_bus_stats_t stats = watch_sim_bus_get_stats(bus);
+    return stats.transactions == transactions && stats.bytes == bytes && stats.time_us == time_us;
+}
+
+static void check_counters(void) {
+    // at 100 kHz, each phase is a start and the address with its acknowledge (10 bits), then nine bits a byte; one
+    // stop ends the transaction.
+    watch_sim_bus_reset_stats();
+    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL6, 0);
+    expect("I2C write8: one transaction, two bytes, 290 us", stats_are(WATCH_SIM_BUS_I2C, 1, 2, 290));
+
+    // the register address goes out in one transaction and the value comes back in another.
+    watch_sim_bus_reset_stats();
+    lis2dw_get_device_id();
+    expect("I2C read8: two transactions, two bytes, 400 us", stats_are(WATCH_SIM_BUS_I2C, 2, 2, 400));
+
+    // a write then a read with a repeated start between them is still one transaction, with one stop.
+    uint8_t reg = LIS2DW_REG_OUT_X_L | 0x80;
+    uint8_t data[6];
+    watch_sim_bus_reset_stats();
+    watch_sim_bus_i2c_transfer(LIS2DW_ADDRESS, &reg, 1, data, sizeof(data));
+    expect("I2C repeated start: one transaction, seven bytes, 840 us", stats_are(WATCH_SIM_BUS_I2C, 1, 7, 840));
+
+    watch_sim_bus_reset_stats();
+    watch_sim_bus_i2c_transfer(0x7F, &reg, 1, NULL, 0);
+    expect("I2C to no device: NACKed, 110 us", stats_are(WATCH_SIM_BUS_I2C, 1, 0, 110));
+    expect("I2C: the SPI counts are left alone", stats_are(WATCH_SIM_BUS_SPI, 0, 0, 0));
+
+    // at 1 MHz, eight bits a byte; a transaction is a select to a deselect with bytes in between.
+    uint8_t command[4] = {0x03, 0, 0, 0};
+    uint8_t page[256];
+    watch_sim_bus_reset_stats();
+    watch_sim_bus_pin_changed(watch_sim_flash.cs_pin, false);
+    watch_spi_write(command, sizeof(command));
+    watch_spi_read(page, sizeof(page));
+    watch_sim_bus_pin_changed(watch_sim_flash.cs_pin, true);
+    expect("SPI read: one transaction, 260 bytes, 2080 us", stats_are(WATCH_SIM_BUS_SPI, 1, 260, 2080));
+    expect("SPI: the I2C counts are left alone", stats_are(WATCH_SIM_BUS_I2C, 0, 0, 0));
+
+    watch_sim_bus_pin_changed(watch_sim_flash.cs_pin, false);
+    watch_sim_bus_pin_changed(watch_sim_flash.cs_pin, true);
+    expect("SPI: a select with nothing clocked isn't a transaction", stats_are(WATCH_SIM_BUS_SPI, 1, 260, 2080));
+
+    watch_sim_bus_reset_stats();
+    expect("reset: zeroes both buses", stats_are(WATCH_SIM_BUS_I2C, 0, 0, 0) && stats_are(WATCH_SIM_BUS_SPI, 0, 0, 0));
+}
+
+int main(void) {
+    start_sensor();
+    check_fifo_read();
+    check_faults();
+    check_counters();
+
+    printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
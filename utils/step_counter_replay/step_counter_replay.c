@@ -0,0 +1,341 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Replays accelerometer recordings through Movement's step counter, the way the watch would feed it: samples arrive
+// in FIFO batches once per tick, the wake-up interrupt is emulated from the same samples while the counter is
+// dormant, and the RTC only moves on once a second however fast the ticks come. With no arguments, it runs a set of
+// synthetic traces with known step counts and exits nonzero if any of them is off.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// built in, so that each trace can start the counter from scratch.
+#include "../../movement/step_counter.c"
+
+#define SAMPLE_RATE 25
+#define STANDARD_GRAVITY 9.80665
+#define DEFAULT_TOLERANCE 0.1
+
+typedef struct {
+    lis2dw_reading_t *samples;
+    size_t count;
+    size_t capacity;
+} trace_t;
+
+typedef struct {
+    uint32_t steps;
+    uint32_t wakeups;
+    uint32_t active_seconds;
+    int32_t dormant_at;     // the second the counter last went dormant, or -1 if it was still active at the end
+} replay_result_t;
+
+static time_t simulated_time;
+static sensor_hub_subscription_t *subscription;
+
+/* stubs for what step_counter.c expects from the watch library and Movement */
+
+watch_date_time watch_rtc_get_date_time(void) {
+    struct tm tm;
+    watch_date_time date_time;
+
+    gmtime_r(&simulated_time, &tm);
+    date_time.unit.year = tm.tm_year + 1900 - 2020;
+    date_time.unit.month = tm.tm_mon + 1;
+    date_time.unit.day = tm.tm_mday;
+    date_time.unit.hour = tm.tm_hour;
+    date_time.unit.minute = tm.tm_min;
+    date_time.unit.second = tm.tm_sec;
+
+    return date_time;
+}
+
+bool sensor_hub_subscribe(sensor_hub_subscription_t *s) {
+    subscription = s;
+    return true;
+}
+
+int32_t filesystem_get_file_size(char *filename) {
+    return -1;
+}
+
+bool filesystem_read_file(char *filename, char *buf, int32_t length) {
+    return false;
+}
+
+bool filesystem_write_file(char *filename, char *text, int32_t length) {
+    return true;
+}
+
+/* traces */
+
+static void trace_append(trace_t *trace, double x_mg, double y_mg, double z_mg) {
+    if (trace->count == trace->capacity) {
+        trace->capacity = trace->capacity ? trace->capacity * 2 : 1024;
+        trace->samples = realloc(trace->samples, trace->capacity * sizeof(lis2dw_reading_t));
+    }
+    // the inverse of _step_counter_raw_to_milli_g: 14-bit samples at ±4g, left justified like the LIS2DW's.
+    double axes[3] = {x_mg, y_mg, z_mg};
+    int16_t raw[3];
+    for(int i = 0; i < 3; i++) {
+        long value = lround(axes[i] * 4096.0 / 1999.0);
+        if (value > 8191) value = 8191;
+        if (value < -8192) value = -8192;
+        raw[i] = (int16_t)(value * 4);
+    }
+    trace->samples[trace->count++] = (lis2dw_reading_t){raw[0], raw[1], raw[2]};
+}
+
+// rows of timestamp,accX,accY,accZ in m/s², as written by process_motion_dump.py and export_motion_data.py.
+static bool trace_load_csv(trace_t *trace, const char *filename) {
+    FILE *f = fopen(filename, "r");
+    if (f == NULL) return false;
+
+    char line[256];
+    double timestamp, x, y, z;
+    while (fgets(line, sizeof(line), f)) {
+        // skips the header row and anything else that isn't a sample.
+        if (sscanf(line, "%lf,%lf,%lf,%lf", &timestamp, &x, &y, &z) != 4) continue;
+        double scale = 1000.0 / STANDARD_GRAVITY;
+        trace_append(trace, x * scale, y * scale, z * scale);
+    }
+    fclose(f);
+
+    return true;
+}
+
+static uint32_t noise_state = 1;
+
+static double noise(double amplitude_mg) {
+    noise_state = noise_state * 1664525 + 1013904223;
+    return ((double)(noise_state >> 8) / (1 << 24) * 2 - 1) * amplitude_mg;
+}
+
+static void trace_add_still(trace_t *trace, double seconds) {
+    for(int i = 0; i < seconds * SAMPLE_RATE; i++) {
+        trace_append(trace, 120 + noise(15), -80 + noise(15), 990 + noise(15));
+    }
+}
+
+// the wrist swings forward and back once per two steps, and the footfalls land on the vertical axis.
+static void trace_add_gait(trace_t *trace, double seconds, double steps_per_second, double amplitude_mg) {
+    for(int i = 0; i < seconds * SAMPLE_RATE; i++) {
+        double t = (double)i / SAMPLE_RATE;
+        double step = sin(2 * M_PI * steps_per_second * t);
+        double swing = sin(M_PI * steps_per_second * t);
+        trace_append(trace,
+                     120 + amplitude_mg * 0.3 * swing + noise(25),
+                     -80 + amplitude_mg * 0.2 * step + noise(25),
+                     990 + amplitude_mg * step + noise(25));
+    }
+}
+
+static void trace_add_tap(trace_t *trace) {
+    trace_append(trace, 120, -80, 1900);
+    trace_append(trace, 120, -80, 400);
+    trace_add_still(trace, 0.4);
+}
+
+/* replay */
+
+static bool _wakeup_fires(const lis2dw_reading_t *samples, size_t count, lis2dw_reading_t *last) {
+    // the wake-up function looks at the change from one sample to the next; call it 12.5 Hz, the dormant rate.
+    int32_t threshold = ((int32_t)subscription->wakeup_threshold * 4000 / 64) * 4096 / 1999 * 4;
+    bool fired = false;
+    for(size_t i = 0; i < count; i += 2) {
+        if (abs(samples[i].x - last->x) > threshold ||
+            abs(samples[i].y - last->y) > threshold ||
+            abs(samples[i].z - last->z) > threshold) fired = true;
+        *last = samples[i];
+    }
+    return fired;
+}
+
+// suspend_at is the second at which Movement enters low energy mode and suspends the counter, or 0 to stay awake.
+// in low energy mode, the sensor hub only keeps subscriptions that ask for it, and a wake-up brings Movement back.
+static replay_result_t replay(const trace_t *trace, uint8_t ticks_per_second, uint32_t suspend_at) {
+    replay_result_t result = {0, 0, 0, -1};
+    bool low_energy = false;
+
+    memset(&step_counter_state, 0, sizeof(step_counter_state));
+    subscription = NULL;
+    // 2024-06-01 09:59:30: the first tick is in a new minute, so the counter starts today's record before any steps.
+    simulated_time = 1717235970;
+    step_counter_setup();
+
+    lis2dw_reading_t last = trace->count ? trace->samples[0] : (lis2dw_reading_t){0};
+    bool wakeup_pending = false;
+    size_t position = 0;
+    uint32_t tick = 0;
+    while (position < trace->count) {
+        size_t end = (size_t)(tick + 1) * SAMPLE_RATE / ticks_per_second;
+        if (end > trace->count) end = trace->count;
+
+        // the hub calls back on the tick after the interrupt; a subscriber that starts the FIFO then gets samples
+        // from the next read on.
+        bool fifo_running = subscription->fifo_callback != NULL;
+        if (wakeup_pending) {
+            wakeup_pending = false;
+            low_energy = false;
+            if (!step_counter_state.active) result.wakeups++;
+            subscription->wakeup_callback(LIS2DW_WAKEUP_SRC_WAKEUP, subscription->context);
+        }
+        if (fifo_running) {
+            for(size_t i = position; i < end; i += 32) {
+                lis2dw_fifo_t fifo;
+                fifo.count = (end - i) < 32 ? (end - i) : 32;
+                memcpy(fifo.readings, &trace->samples[i], fifo.count * sizeof(lis2dw_reading_t));
+                subscription->fifo_callback(&fifo, subscription->context);
+            }
+        }
+        if (subscription->wakeup_threshold && (!low_energy || subscription->keep_in_low_energy)) {
+            wakeup_pending = _wakeup_fires(&trace->samples[position], end - position, &last);
+        }
+        position = end;
+
+        tick++;
+        if (tick % ticks_per_second == 0) {
+            simulated_time++;
+            if (step_counter_state.active) result.active_seconds++;
+        }
+        bool was_active = step_counter_state.active;
+        step_counter_handle_tick();
+        if (was_active && !step_counter_state.active) result.dormant_at = tick / ticks_per_second;
+        if (step_counter_state.active) result.dormant_at = -1;
+        if (suspend_at && tick == suspend_at * ticks_per_second) {
+            low_energy = true;
+            step_counter_suspend();
+        }
+    }
+    result.steps = step_counter_get_steps(0);
+
+    return result;
+}
+
+static bool check(const char *name, const trace_t *trace, replay_result_t result, int32_t expected, double tolerance) {
+    double seconds = (double)trace->count / SAMPLE_RATE;
+    printf("%-40s %7.1f s %5u steps", name, seconds, result.steps);
+    printf(" %3u wake-ups %6u s active", result.wakeups, result.active_seconds);
+    if (expected < 0) {
+        printf("\n");
+        return true;
+    }
+    double error = expected ? ((double)result.steps - expected) / expected : result.steps;
+    bool ok = fabs(error) <= tolerance;
+    printf(" (expected %d, %+.1f%%) %s\n", expected, error * 100, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+static bool run_synthetic_traces(void) {
+    bool ok = true;
+    trace_t trace = {0};
+    replay_result_t result;
+
+    trace.count = 0;
+    trace_add_still(&trace, 3);
+    trace_add_gait(&trace, 60, 1.8, 350);
+    trace_add_still(&trace, 20);
+    result = replay(&trace, 1, 0);
+    ok &= check("walking, 1.8 steps/s", &trace, result, 108, DEFAULT_TOLERANCE);
+
+    trace.count = 0;
+    trace_add_still(&trace, 3);
+    trace_add_gait(&trace, 60, 2.8, 900);
+    trace_add_still(&trace, 20);
+    result = replay(&trace, 1, 0);
+    ok &= check("running, 2.8 steps/s", &trace, result, 168, DEFAULT_TOLERANCE);
+
+    trace.count = 0;
+    trace_add_still(&trace, 120);
+    result = replay(&trace, 1, 0);
+    ok &= check("sitting still", &trace, result, 0, 0);
+
+    // fewer than a run's worth of bumps shouldn't count.
+    trace.count = 0;
+    trace_add_still(&trace, 3);
+    for(int i = 0; i < 3; i++) trace_add_tap(&trace);
+    trace_add_still(&trace, 20);
+    result = replay(&trace, 1, 0);
+    ok &= check("three taps on the table", &trace, result, 0, 0);
+
+    // with a face asking for 4 Hz ticks, the counter should still wait out its timeout in seconds, not ticks.
+    for(uint8_t ticks_per_second = 1; ticks_per_second <= 16; ticks_per_second *= 4) {
+        char name[64];
+        trace.count = 0;
+        trace_add_still(&trace, 3);
+        trace_add_gait(&trace, 30, 1.8, 350);
+        trace_add_still(&trace, 30);
+        result = replay(&trace, ticks_per_second, 0);
+        snprintf(name, sizeof(name), "walking, then resting; %u Hz tick", ticks_per_second);
+        ok &= check(name, &trace, result, 54, DEFAULT_TOLERANCE);
+        int32_t rested = result.dormant_at - 33;
+        bool timed_out = rested >= STEP_COUNTER_IDLE_TIMEOUT - 1 && rested <= STEP_COUNTER_IDLE_TIMEOUT + 2;
+        printf("%-40s went dormant %d s after the last step %s\n", "", rested, timed_out ? "ok" : "FAIL");
+        ok &= timed_out;
+    }
+
+    // Movement enters low energy mode while the counter is dormant; the next walk should still wake it up.
+    trace.count = 0;
+    trace_add_still(&trace, 3);
+    trace_add_gait(&trace, 30, 1.8, 350);
+    trace_add_still(&trace, 40);
+    trace_add_gait(&trace, 30, 1.8, 350);
+    trace_add_still(&trace, 20);
+    result = replay(&trace, 1, 63);
+    ok &= check("walking after low energy mode", &trace, result, 108, DEFAULT_TOLERANCE);
+
+    free(trace.samples);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) return run_synthetic_traces() ? 0 : 1;
+
+    bool ok = true;
+    for(int i = 1; i < argc; i++) {
+        // a recording can be given as file.csv=steps, to check the count against one made by hand.
+        char filename[1024];
+        int32_t expected = -1;
+        snprintf(filename, sizeof(filename), "%s", argv[i]);
+        char *equals = strrchr(filename, '=');
+        if (equals != NULL) {
+            *equals = 0;
+            expected = atoi(equals + 1);
+        }
+
+        trace_t trace = {0};
+        if (!trace_load_csv(&trace, filename)) {
+            fprintf(stderr, "can't read %s\n", filename);
+            ok = false;
+            continue;
+        }
+        const char *name = strrchr(filename, '/');
+        ok &= check(name ? name + 1 : filename, &trace, replay(&trace, 1, 0), expected, DEFAULT_TOLERANCE);
+        free(trace.samples);
+    }
+
+    return ok ? 0 : 1;
+}
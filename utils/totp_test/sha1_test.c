@@ -0,0 +1,364 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Checks TOTP-MCU's SHA-1 against the FIPS 180 examples and the RFC 2202 HMAC-SHA1 test cases, then feeds the same
+// messages in every split and at every alignment writeBytes handles differently (a byte at a time, unaligned whole
+// blocks, a partial block topped up) to make sure they all hash alike. Then it times hashing against the byte at a
+// time implementation it replaced, kept below as it was.
+//
+// The cycles are the host's (the time stamp counter on x86, nanoseconds elsewhere), so they're for comparing one
+// version against another, not for budgeting the watch.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sha1.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLE_UNIT "cycles"
+static inline uint64_t cycles_now(void) {
+    return __rdtsc();
+}
+#else
+#define CYCLE_UNIT "ns"
+static inline uint64_t cycles_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+#endif
+
+#define BENCH_BYTES (1 << 20)
+#define BENCH_RUNS 5
+
+static int failures;
+
+static void hex(char *out, const uint8_t *bytes, size_t length) {
+    for(size_t i = 0; i < length; i++) sprintf(out + i * 2, "%02x", bytes[i]);
+}
+
+static void expect(const char *what, const uint8_t *digest, const char *expected) {
+    char got[HASH_LENGTH * 2 + 1];
+    hex(got, digest, HASH_LENGTH);
+    bool ok = strcmp(got, expected) == 0;
+    printf("%-40s %s %s\n", what, got, ok ? "ok" : "FAIL");
+    if (!ok) {
+        printf("%-40s %s expected\n", "", expected);
+        failures++;
+    }
+}
+
+/* FIPS 180 */
+
+static const struct {
+    const char *name;
+    const char *message;
+    const char *digest;
+} fips_vectors[] = {
+    {"empty", "", "da39a3ee5e6b4b0d3255bfef95601890afd80709"},
+    {"abc", "abc", "a9993e364706816aba3e25717850c26c9cd0d89d"},
+    {"448 bits", "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", "84983e441c3bd26ebaae4aa1f95129e5e54670f1"},
+    {"896 bits", "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+     "a49b2446a02c645bf419f995b67091253a04a259"},
+};
+
+static void check_fips(void) {
+    for(size_t i = 0; i < sizeof(fips_vectors) / sizeof(fips_vectors[0]); i++) {
+        init();
+        writeBytes((const uint8_t *)fips_vectors[i].message, strlen(fips_vectors[i].message));
+        expect(fips_vectors[i].name, result(), fips_vectors[i].digest);
+    }
+
+    // a million a's, fed in pieces of a size that crosses block boundaries at every offset.
+    static uint8_t a[1000];
+    memset(a, 'a', sizeof(a));
+    init();
+    for(uint32_t fed = 0; fed < 1000000; ) {
+        uint32_t piece = fed % 997 + 1;
+        if (piece > 1000000 - fed) piece = 1000000 - fed;
+        writeBytes(a, piece);
+        fed += piece;
+    }
+    expect("a million a's", result(), "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+}
+
+/* RFC 2202 */
+
+static void check_hmac(void) {
+    static const struct {
+        const char *name;
+        uint8_t key[80];
+        uint8_t key_length;
+        const char *data;
+        uint8_t data_repeat;    // some cases are one byte repeated; data is then that byte
+        const char *digest;
+    } cases[] = {
+        {"HMAC case 1", {[0 ... 19] = 0x0b}, 20, "Hi There", 0, "b617318655057264e28bc0b6fb378c8ef146be00"},
+        {"HMAC case 2", "Jefe", 4, "what do ya want for nothing?", 0, "effcdf6ae5eb2fa2d27416d5f184df9c259a7c79"},
+        {"HMAC case 3", {[0 ... 19] = 0xaa}, 20, "\xdd", 50, "125d7342b9ac11cd91a39af48aa17b4f63f175d3"},
+        {"HMAC case 4", {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25},
+         25, "\xcd", 50, "4c9007f4026250c6bc8414f9bf50c86c2d7235da"},
+        {"HMAC case 5", {[0 ... 19] = 0x0c}, 20, "Test With Truncation", 0, "4c1a03424b55e07fe7f27be1d58bb9324a9a5a04"},
+        {"HMAC case 6, 80 byte key", {[0 ... 79] = 0xaa}, 80, "Test Using Larger Than Block-Size Key - Hash Key First", 0,
+         "aa4ae5e15272d00e95705637ce8a3b55ed402112"},
+        {"HMAC case 7, 80 byte key", {[0 ... 79] = 0xaa}, 80,
+         "Test Using Larger Than Block-Size Key and Larger Than One Block-Size Data", 0,
+         "e8e99d0f45237d786d6bbaa7965c7808bbff1a91"},
+    };
+
+    for(size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        uint8_t data[80];
+        uint8_t length = cases[i].data_repeat;
+        if (length) memset(data, cases[i].data[0], length);
+        else memcpy(data, cases[i].data, length = strlen(cases[i].data));
+
+        initHmac(cases[i].key, cases[i].key_length);
+        writeArray(data, length);
+        expect(cases[i].name, resultHmac(), cases[i].digest);
+
+        // and again from the midstates, as the TOTP key contexts do.
+        uint32_t inner[5], outer[5];
+        char name[64];
+        initHmacMidstates(cases[i].key, cases[i].key_length, inner, outer);
+        initHmacFromMidstate(inner);
+        writeArray(data, length);
+        snprintf(name, sizeof(name), "%s, from midstates", cases[i].name);
+        expect(name, resultHmacFromMidstate(outer), cases[i].digest);
+    }
+}
+
+/* splits and alignments */
+
+static void check_splits(void) {
+    uint8_t message[200 + 4];
+    uint8_t reference[HASH_LENGTH];
+    int before = failures;
+
+    for(size_t i = 0; i < sizeof(message); i++) message[i] = i * 131 + 7;
+    for(uint32_t length = 0; length <= 200; length++) {
+        // a byte at a time is the reference: it only ever goes through addUncounted.
+        init();
+        for(uint32_t i = 0; i < length; i++) writeBytes(message + i, 1);
+        memcpy(reference, result(), HASH_LENGTH);
+
+        for(uint32_t align = 0; align < 4; align++) {
+            for(uint32_t split = 0; split <= length; split += (length < 70 ? 1 : 13)) {
+                // copied to each alignment, so both the word-at-a-time and the byte swapping paths get a turn.
+                uint8_t copy[sizeof(message) + 4];
+                memcpy(copy + align, message, length);
+                init();
+                writeBytes(copy + align, split);
+                writeBytes(copy + align + split, length - split);
+                if (memcmp(result(), reference, HASH_LENGTH) != 0) {
+                    if (failures++ - before < 10) printf("FAIL: %u bytes split at %u, aligned +%u\n", length, split, align);
+                }
+            }
+        }
+    }
+    printf("%-40s %s\n", "every split of up to 200 bytes", failures == before ? "ok" : "FAIL");
+}
+
+/* the implementation this replaced, for timing */
+
+static struct {
+    union { uint8_t b[BLOCK_LENGTH]; uint32_t w[BLOCK_LENGTH / 4]; } buffer;
+    union { uint8_t b[HASH_LENGTH]; uint32_t w[HASH_LENGTH / 4]; } state;
+    uint8_t buffer_offset;
+    uint32_t byte_count;
+} legacy;
+
+static uint32_t legacy_rol32(uint32_t number, uint8_t bits) {
+    return ((number << bits) | (uint32_t)(number >> (32 - bits)));
+}
+
+static void legacy_hash_block(void) {
+    uint8_t i;
+    uint32_t a, b, c, d, e, t;
+
+    a = legacy.state.w[0];
+    b = legacy.state.w[1];
+    c = legacy.state.w[2];
+    d = legacy.state.w[3];
+    e = legacy.state.w[4];
+    for (i = 0; i < 80; i++) {
+        if (i >= 16) {
+            t = legacy.buffer.w[(i + 13) & 15] ^ legacy.buffer.w[(i + 8) & 15] ^ legacy.buffer.w[(i + 2) & 15] ^ legacy.buffer.w[i & 15];
+            legacy.buffer.w[i & 15] = legacy_rol32(t, 1);
+        }
+        if (i < 20) {
+            t = (d ^ (b & (c ^ d))) + 0x5a827999;
+        } else if (i < 40) {
+            t = (b ^ c ^ d) + 0x6ed9eba1;
+        } else if (i < 60) {
+            t = ((b & c) | (d & (b | c))) + 0x8f1bbcdc;
+        } else {
+            t = (b ^ c ^ d) + 0xca62c1d6;
+        }
+        t += legacy_rol32(a, 5) + e + legacy.buffer.w[i & 15];
+        e = d;
+        d = c;
+        c = legacy_rol32(b, 30);
+        b = a;
+        a = t;
+    }
+    legacy.state.w[0] += a;
+    legacy.state.w[1] += b;
+    legacy.state.w[2] += c;
+    legacy.state.w[3] += d;
+    legacy.state.w[4] += e;
+}
+
+static void legacy_add_uncounted(uint8_t data) {
+    legacy.buffer.b[legacy.buffer_offset ^ 3] = data;
+    legacy.buffer_offset++;
+    if (legacy.buffer_offset == BLOCK_LENGTH) {
+        legacy_hash_block();
+        legacy.buffer_offset = 0;
+    }
+}
+
+static void legacy_init(void) {
+    static const uint32_t init_state[] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+    memcpy(legacy.state.w, init_state, HASH_LENGTH);
+    legacy.byte_count = 0;
+    legacy.buffer_offset = 0;
+}
+
+// the old writeArray was a function in another file, so keep this one out of line too: a byte at a time then costs
+// a call per byte on both sides.
+__attribute__((noinline)) static void legacy_write(const uint8_t *data, uint32_t length) {
+    while (length--) {
+        ++legacy.byte_count;
+        legacy_add_uncounted(*data++);
+    }
+}
+
+static uint8_t *legacy_result(void) {
+    legacy_add_uncounted(0x80);
+    while (legacy.buffer_offset != 56) legacy_add_uncounted(0x00);
+    legacy_add_uncounted(0);
+    legacy_add_uncounted(0);
+    legacy_add_uncounted(0);
+    legacy_add_uncounted(legacy.byte_count >> 29);
+    legacy_add_uncounted(legacy.byte_count >> 21);
+    legacy_add_uncounted(legacy.byte_count >> 13);
+    legacy_add_uncounted(legacy.byte_count >> 5);
+    legacy_add_uncounted(legacy.byte_count << 3);
+    for (uint8_t i = 0; i < 5; i++) legacy.state.w[i] = __builtin_bswap32(legacy.state.w[i]);
+    return legacy.state.b;
+}
+
+/* timing */
+
+static void hash_bulk(const uint8_t *data) {
+    init();
+    writeBytes(data, BENCH_BYTES);
+    result();
+}
+
+static void hash_bytewise(const uint8_t *data) {
+    init();
+    for(uint32_t i = 0; i < BENCH_BYTES; i++) writeBytes(data + i, 1);
+    result();
+}
+
+static void hash_legacy_bytewise(const uint8_t *data) {
+    legacy_init();
+    for(uint32_t i = 0; i < BENCH_BYTES; i++) legacy_write(data + i, 1);
+    legacy_result();
+}
+
+// the best of a few runs, so that a clock speeding up or an interruption halfway through doesn't count.
+static double cycles_per_byte(void (*hash)(const uint8_t *), const uint8_t *data) {
+    uint64_t best = UINT64_MAX;
+    for(int run = 0; run < BENCH_RUNS; run++) {
+        uint64_t start = cycles_now();
+        hash(data);
+        uint64_t cycles = cycles_now() - start;
+        if (cycles < best) best = cycles;
+    }
+    return (double)best / BENCH_BYTES;
+}
+
+static void bench(void) {
+    uint8_t *data = malloc(BENCH_BYTES + 1);
+    uint8_t digest[HASH_LENGTH];
+
+    for(uint32_t i = 0; i <= BENCH_BYTES; i++) data[i] = i * 131 + 7;
+
+    // the old code has to agree before its time means anything.
+    hash_legacy_bytewise(data);
+    memcpy(digest, legacy.state.b, HASH_LENGTH);
+    init();
+    writeBytes(data, BENCH_BYTES);
+    if (memcmp(digest, result(), HASH_LENGTH) != 0) {
+        printf("FAIL: the old and new implementations differ\n");
+        failures++;
+    }
+
+    double aligned = cycles_per_byte(hash_bulk, data);
+    double unaligned = cycles_per_byte(hash_bulk, data + 1);
+    double bytewise = cycles_per_byte(hash_bytewise, data);
+    double old = cycles_per_byte(hash_legacy_bytewise, data);
+
+    // a TOTP code's worth: the inner and outer hashes from midstates, each one short block.
+    uint8_t key[20] = "12345678901234567890";
+    uint8_t counter[8] = {0};
+    uint32_t inner[5], outer[5];
+    uint64_t best = UINT64_MAX;
+    initHmacMidstates(key, sizeof(key), inner, outer);
+    for(int run = 0; run < BENCH_RUNS; run++) {
+        uint64_t start = cycles_now();
+        for(uint32_t i = 0; i < 100000; i++) {
+            counter[7] = i;
+            initHmacFromMidstate(inner);
+            writeArray(counter, 8);
+            resultHmacFromMidstate(outer);
+        }
+        uint64_t cycles = cycles_now() - start;
+        if (cycles < best) best = cycles;
+    }
+    double hmac = (double)best / 100000;
+
+    printf("bulk, aligned:        %6.2f %s/byte\n", aligned, CYCLE_UNIT);
+    printf("bulk, unaligned:      %6.2f %s/byte\n", unaligned, CYCLE_UNIT);
+    printf("a byte at a time:     %6.2f %s/byte\n", bytewise, CYCLE_UNIT);
+    printf("before, byte at a time: %4.2f %s/byte\n", old, CYCLE_UNIT);
+    printf("HMAC of a TOTP counter from midstates: %.0f %s\n", hmac, CYCLE_UNIT);
+
+    free(data);
+}
+
+int main(void) {
+    check_fips();
+    check_hmac();
+    check_splits();
+    bench();
+    if (failures) printf("%d failures\n", failures);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Checks TOTP-MCU's codes against the test vectors in RFC 6238, appendix B, for HMAC-SHA1 and HMAC-SHA256, through
+// both the key context API (initKeyContextWithOptions and getCodeFromContextSteps) and the original one (TOTP and
+// getCodeFromTimestamp). Then it times a code from a key context, which starts from the cached HMAC midstates, against
+// one that hashes the key's pads all over again, as every code did before the contexts.
+//
+// The cycles are the host's (the time stamp counter on x86, nanoseconds elsewhere), so they're for comparing one
+// version against another, not for budgeting the watch.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "TOTP.h"
+#include "sha1.h"
+#include "sha256.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLE_UNIT "cycles"
+static inline uint64_t cycles_now(void) {
+    return __rdtsc();
+}
+#else
+#define CYCLE_UNIT "ns"
+static inline uint64_t cycles_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+#endif
+
+#define TIME_STEP 30
+#define DIGITS 8
+#define BENCH_CODES 200000
+
+// the RFC's seeds: the ASCII digits 1 through 0, repeated to the length of the hash's block key.
+static uint8_t sha1_key[] = "12345678901234567890";
+static uint8_t sha256_key[] = "12345678901234567890123456789012";
+
+static const struct {
+    uint64_t time;      // the last one doesn't fit in a uint32_t timestamp, but its step does
+    uint32_t sha1;
+    uint32_t sha256;
+} vectors[] = {
+    {59, 94287082, 46119246},
+    {1111111109, 7081804, 68084774},
+    {1111111111, 14050471, 67062674},
+    {1234567890, 89005924, 91819424},
+    {2000000000, 69279037, 90698825},
+    {20000000000ULL, 65353130, 77737706},
+};
+
+static int failures;
+
+static void expect(const char *what, uint64_t time, uint8_t digits, uint32_t got, uint32_t expected) {
+    bool ok = got == expected;
+    printf("%-32s T=%-11llu %0*u %s\n", what, (unsigned long long)time, digits, got, ok ? "ok" : "FAIL");
+    if (!ok) {
+        printf("%-32s expected %0*u\n", "", digits, expected);
+        failures++;
+    }
+}
+
+static void check(void) {
+    totp_key_context sha1_context, sha256_context;
+
+    initKeyContextWithOptions(&sha1_context, sha1_key, sizeof(sha1_key) - 1, TIME_STEP, DIGITS, TOTP_SHA1);
+    initKeyContextWithOptions(&sha256_context, sha256_key, sizeof(sha256_key) - 1, TIME_STEP, DIGITS, TOTP_SHA256);
+    for(size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+        uint32_t steps = vectors[i].time / TIME_STEP;
+        expect("SHA1 context", vectors[i].time, DIGITS, getCodeFromContextSteps(&sha1_context, steps), vectors[i].sha1);
+        expect("SHA256 context", vectors[i].time, DIGITS, getCodeFromContextSteps(&sha256_context, steps), vectors[i].sha256);
+    }
+
+    // the original API: six digits of the same SHA-1 codes, from the timestamp where it fits.
+    TOTP(sha1_key, sizeof(sha1_key) - 1, TIME_STEP);
+    for(size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+        if (vectors[i].time > UINT32_MAX) continue;
+        expect("SHA1 TOTP(), six digits", vectors[i].time, 6, getCodeFromTimestamp(vectors[i].time), vectors[i].sha1 % 1000000);
+    }
+}
+
+/* timing */
+
+// a code the way they were made before the key contexts: the whole HMAC, key pads and all.
+static uint32_t sha1_code_without_context(uint32_t steps) {
+    uint8_t counter[8] = {0, 0, 0, 0, steps >> 24, steps >> 16, steps >> 8, steps};
+    initHmac(sha1_key, sizeof(sha1_key) - 1);
+    writeArray(counter, 8);
+    uint8_t *hash = resultHmac();
+    uint8_t offset = hash[HASH_LENGTH - 1] & 0xF;
+    uint32_t truncated = (uint32_t)hash[offset] << 24 | hash[offset + 1] << 16 | hash[offset + 2] << 8 | hash[offset + 3];
+    return (truncated & 0x7FFFFFFF) % 100000000;
+}
+
+static uint32_t sha256_code_without_context(uint32_t steps) {
+    totp_key_context context;
+    initKeyContextWithOptions(&context, sha256_key, sizeof(sha256_key) - 1, TIME_STEP, DIGITS, TOTP_SHA256);
+    return getCodeFromContextSteps(&context, steps);
+}
+
+static void bench(void) {
+    totp_key_context sha1_context, sha256_context;
+    volatile uint32_t sink = 0;
+    uint64_t start;
+
+    initKeyContextWithOptions(&sha1_context, sha1_key, sizeof(sha1_key) - 1, TIME_STEP, DIGITS, TOTP_SHA1);
+    initKeyContextWithOptions(&sha256_context, sha256_key, sizeof(sha256_key) - 1, TIME_STEP, DIGITS, TOTP_SHA256);
+
+    // the two ways have to agree before their times mean anything.
+    if (sha1_code_without_context(37037036) != getCodeFromContextSteps(&sha1_context, 37037036)) {
+        printf("FAIL: SHA1 codes with and without a key context differ\n");
+        failures++;
+    }
+
+    start = cycles_now();
+    for(uint32_t i = 0; i < BENCH_CODES; i++) sink += getCodeFromContextSteps(&sha1_context, i);
+    double sha1_with = (double)(cycles_now() - start) / BENCH_CODES;
+    start = cycles_now();
+    for(uint32_t i = 0; i < BENCH_CODES; i++) sink += sha1_code_without_context(i);
+    double sha1_without = (double)(cycles_now() - start) / BENCH_CODES;
+
+    start = cycles_now();
+    for(uint32_t i = 0; i < BENCH_CODES; i++) sink += getCodeFromContextSteps(&sha256_context, i);
+    double sha256_with = (double)(cycles_now() - start) / BENCH_CODES;
+    start = cycles_now();
+    for(uint32_t i = 0; i < BENCH_CODES; i++) sink += sha256_code_without_context(i);
+    double sha256_without = (double)(cycles_now() - start) / BENCH_CODES;
+
+    (void)sink;
+    printf("SHA1 code:   %7.0f %s from a key context, %7.0f hashing the key each time\n", sha1_with, CYCLE_UNIT, sha1_without);
+    printf("SHA256 code: %7.0f %s from a key context, %7.0f hashing the key each time\n", sha256_with, CYCLE_UNIT, sha256_without);
+}
+
+int main(void) {
+    check();
+    bench();
+    if (failures) printf("%d failures\n", failures);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,211 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Checks Movement's TOTP vault on the host: secrets added through the totp shell command, in base32 with the usual
+// variations, come back as the RFC 6238 and RFC 4226 codes; the file it writes reloads to the same accounts; and a
+// file with a record that doesn't make sense (too long a key, too many digits, an unknown algorithm) is refused as a
+// whole rather than handed to the HMAC. The filesystem is a single file in memory.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+// built in, so the checks can reach the vault's file format and reload it from scratch.
+#include "../../movement/totp_vault.c"
+
+#define SHA1_SECRET "GEZDGNBVGY3TQOJQGEZDGNBVGY3TQOJQ"     // RFC 6238's SHA-1 seed, "12345678901234567890"
+#define SHA256_SECRET "GEZDGNBVGY3TQOJQGEZDGNBVGY3TQOJQGEZDGNBVGY3TQOJQGEZA===="
+
+static char file[sizeof(totp_vault_header_t) + (TOTP_VAULT_MAX_ACCOUNTS + 1) * sizeof(totp_vault_record_t)];
+static int32_t file_size = -1;
+static int failures;
+
+/* stubs for what totp_vault.c expects from Movement */
+
+int32_t filesystem_get_file_size(char *filename) {
+    return file_size;
+}
+
+bool filesystem_read_file(char *filename, char *buf, int32_t length) {
+    if (file_size < 0 || length > file_size) return false;
+    memcpy(buf, file, length);
+    return true;
+}
+
+bool filesystem_write_file(char *filename, char *text, int32_t length) {
+    if (length > (int32_t)sizeof(file)) return false;
+    memcpy(file, text, length);
+    file_size = length;
+    return true;
+}
+
+bool shell_register_command(const shell_command_t *command) {
+    return true;
+}
+
+/* checks */
+
+static void expect(const char *what, bool ok) {
+    printf("%-56s %s\n", what, ok ? "ok" : "FAIL");
+    if (!ok) failures++;
+}
+
+// runs a line through the totp command, split into words the way the shell would.
+static int run(const char *line) {
+    char copy[256];
+    char *argv[SHELL_MAX_ARGS];
+    int argc = 0;
+
+    snprintf(copy, sizeof(copy), "%s", line);
+    for(char *word = strtok(copy, " "); word != NULL && argc < SHELL_MAX_ARGS; word = strtok(NULL, " ")) {
+        argv[argc++] = word;
+    }
+
+    return _totp_vault_cmd(argc, argv);
+}
+
+static void reset(void) {
+    file_size = -1;
+    _totp_vault_load();
+}
+
+static void check_codes(void) {
+    reset();
+    expect("add an RFC 6238 SHA-1 account", run("totp add s1 " SHA1_SECRET " 8 30 sha1") == 0);
+    expect("add an RFC 6238 SHA-256 account", run("totp add s2 " SHA256_SECRET " 8 30 sha256") == 0);
+    expect("add an RFC 4226 HOTP account", run("totp add h " SHA1_SECRET " 6 0") == 0);
+    expect("three accounts", totp_vault_get_count() == 3);
+    expect("SHA-1 code at T=59", totp_vault_get_code(0, 59) == 94287082);
+    expect("SHA-1 code at T=1111111109", totp_vault_get_code(0, 1111111109) == 7081804);
+    expect("SHA-256 code at T=59", totp_vault_get_code(1, 59) == 46119246);
+    expect("SHA-256 code at T=1234567890", totp_vault_get_code(1, 1234567890) == 91819424);
+    expect("a short label is padded with a space", totp_vault_get_account(2)->label[1] == ' ');
+
+    // RFC 4226, appendix D: the first codes of the same seed.
+    static const uint32_t hotp[] = {755224, 287082, 359152, 969429};
+    bool ok = true;
+    for(uint8_t i = 0; i < 4; i++) {
+        ok &= totp_vault_get_code(2, 0) == hotp[i];
+        ok &= totp_vault_advance_counter(2);
+    }
+    expect("HOTP codes for counters 0 to 3", ok);
+    expect("a TOTP account has no counter to advance", !totp_vault_advance_counter(0));
+
+    // the counter was saved as it went, so a reload picks up where we left off.
+    _totp_vault_load();
+    expect("the HOTP counter survives a reload", totp_vault_get_account(2)->counter == 4);
+    expect("the accounts survive a reload", totp_vault_get_count() == 3 && totp_vault_get_code(0, 59) == 94287082);
+
+    expect("adding an existing label replaces it", run("totp add s1 JBSWY3DPEHPK3PXP") == 0 && totp_vault_get_count() == 3);
+    expect("...with the new settings", totp_vault_get_account(0)->digits == 6 && totp_vault_get_code(0, 59) != 94287082);
+    expect("remove an account", run("totp rm s2") == 0 && totp_vault_get_count() == 2);
+    expect("the rest move up", totp_vault_get_account(1)->label[0] == 'h' && totp_vault_get_account(1)->counter == 4);
+    expect("removing a missing account fails", run("totp rm s2") != 0);
+}
+
+static void check_base32(void) {
+    uint8_t key[TOTP_VAULT_MAX_KEY_LENGTH];
+
+    expect("base32: JBSWY3DPEHPK3PXP", _totp_vault_base32_decode("JBSWY3DPEHPK3PXP", key, sizeof(key)) == 10 &&
+                                       memcmp(key, "Hello!\xde\xad\xbe\xef", 10) == 0);
+    expect("base32: lower case", _totp_vault_base32_decode("jbswy3dpehpk3pxp", key, sizeof(key)) == 10 &&
+                                 memcmp(key, "Hello!\xde\xad\xbe\xef", 10) == 0);
+    expect("base32: grouped with dashes", _totp_vault_base32_decode("JBSW-Y3DP-EHPK-3PXP", key, sizeof(key)) == 10 &&
+                                          memcmp(key, "Hello!\xde\xad\xbe\xef", 10) == 0);
+    expect("base32: stops at padding", _totp_vault_base32_decode(SHA256_SECRET, key, sizeof(key)) == 32 &&
+                                       memcmp(key, "12345678901234567890123456789012", 32) == 0);
+    expect("base32: rejects 0, 1, 8 and 9", _totp_vault_base32_decode("JBSWY3DPEHPK3PX0", key, sizeof(key)) < 0 &&
+                                            _totp_vault_base32_decode("JBSWY3DPEHPK3PX1", key, sizeof(key)) < 0 &&
+                                            _totp_vault_base32_decode("JBSWY3DPEHPK3PX8", key, sizeof(key)) < 0 &&
+                                            _totp_vault_base32_decode("JBSWY3DPEHPK3PX9", key, sizeof(key)) < 0);
+
+    char secret[128];
+    memset(secret, 'A', 103);
+    secret[103] = 0;
+    expect("base32: 64 bytes fit", _totp_vault_base32_decode(secret, key, sizeof(key)) == 64);
+    secret[103] = 'A';
+    secret[104] = 0;
+    expect("base32: 65 bytes don't", _totp_vault_base32_decode(secret, key, sizeof(key)) < 0);
+
+    reset();
+    expect("add refuses an empty secret", run("totp add ab ====") != 0);
+    expect("add refuses 5 digits", run("totp add ab " SHA1_SECRET " 5") != 0);
+    expect("add refuses 9 digits", run("totp add ab " SHA1_SECRET " 9") != 0);
+    expect("add refuses md5", run("totp add ab " SHA1_SECRET " 6 30 md5") != 0);
+    expect("add refuses a three letter label", run("totp add abc " SHA1_SECRET) != 0);
+    expect("nothing was written", file_size < 0);
+}
+
+// writes a good one-account vault, lets corrupt() spoil it, and checks whether it still loads.
+static void check_file(const char *what, void (*corrupt)(totp_vault_header_t *, totp_vault_record_t *), bool loads) {
+    reset();
+    run("totp add ab " SHA1_SECRET " 8 30");
+    corrupt((totp_vault_header_t *)file, _totp_vault_records(file));
+    _totp_vault_load();
+    expect(what, (totp_vault_get_count() == 1) == loads);
+}
+
+static void leave_alone(totp_vault_header_t *header, totp_vault_record_t *record) { }
+static void longest_key(totp_vault_header_t *header, totp_vault_record_t *record) { record->key_length = 64; }
+static void long_key(totp_vault_header_t *header, totp_vault_record_t *record) { record->key_length = 65; }
+static void no_key(totp_vault_header_t *header, totp_vault_record_t *record) { record->key_length = 0; }
+static void nine_digits(totp_vault_header_t *header, totp_vault_record_t *record) { record->account.digits = 9; }
+static void five_digits(totp_vault_header_t *header, totp_vault_record_t *record) { record->account.digits = 5; }
+static void md5(totp_vault_header_t *header, totp_vault_record_t *record) { record->account.algorithm = 2; }
+static void hotp(totp_vault_header_t *header, totp_vault_record_t *record) { record->account.period = 0; }
+static void bad_magic(totp_vault_header_t *header, totp_vault_record_t *record) { header->magic ^= 1; }
+static void version_2(totp_vault_header_t *header, totp_vault_record_t *record) { header->version = 2; }
+static void extra_count(totp_vault_header_t *header, totp_vault_record_t *record) { header->count = 2; }
+static void truncated(totp_vault_header_t *header, totp_vault_record_t *record) { file_size--; }
+
+static void check_format(void) {
+    expect("a header is 8 bytes", sizeof(totp_vault_header_t) == 8);
+    expect("a record is 80 bytes", sizeof(totp_vault_record_t) == 80);
+    reset();
+    run("totp add ab " SHA1_SECRET);
+    run("totp add cd " SHA1_SECRET);
+    expect("the file is a header and a record per account", file_size == 8 + 2 * 80);
+
+    check_file("file: as written loads", leave_alone, true);
+    check_file("file: a 64 byte key loads", longest_key, true);
+    check_file("file: an HOTP record loads", hotp, true);
+    check_file("file: a 65 byte key is refused", long_key, false);
+    check_file("file: an empty key is refused", no_key, false);
+    check_file("file: 9 digits are refused", nine_digits, false);
+    check_file("file: 5 digits are refused", five_digits, false);
+    check_file("file: an unknown algorithm is refused", md5, false);
+    check_file("file: the wrong magic is refused", bad_magic, false);
+    check_file("file: another version is refused", version_2, false);
+    check_file("file: a count past the end is refused", extra_count, false);
+    check_file("file: a short file is refused", truncated, false);
+}
+
+int main(void) {
+    check_codes();
+    check_base32();
+    check_format();
+    if (failures) printf("%d failures\n", failures);
+
+    return failures ? 1 : 0;
+}
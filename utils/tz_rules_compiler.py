@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""Compile tzdb daylight saving rules into the transition table Movement uses for its DST-aware time zones.
+
+For each zone below, the compiler asks the system's tz database for every change of UTC offset from 2020 through
+2083 (the years the RTC can hold), checks that the zone has one standard offset and one daylight offset with exactly
+two changes a year, and packs each year's changes into two 16-bit counts of quarter hours since midnight UTC on
+January 1st of that year. The output is a C header, included only by movement.c:
+
+    utils/tz_rules_compiler.py > movement/movement_timezones.h
+
+Zones are appended to Movement's fixed offsets, so a zone's index in the time zone setting is 41 plus its position
+here. Don't reorder or remove zones, or watches will wake up in a different zone after an update; add new ones at the
+end (the setting has room for 23), and bump MOVEMENT_NUM_DST_TIMEZONES in movement.h to match.
+"""
+import argparse
+import datetime
+import sys
+import zoneinfo
+
+# (code shown on the watch, tzdb name, description)
+ZONES = [
+    ('NY', 'America/New_York', 'US Eastern'),
+    ('CH', 'America/Chicago', 'US Central'),
+    ('DE', 'America/Denver', 'US Mountain'),
+    ('LA', 'America/Los_Angeles', 'US Pacific'),
+    ('AN', 'America/Anchorage', 'Alaska'),
+    ('HA', 'America/Halifax', 'Atlantic'),
+    ('SJ', 'America/St_Johns', 'Newfoundland'),
+    ('SA', 'America/Santiago', 'Chile'),
+    ('LO', 'Europe/London', 'UK'),
+    ('LI', 'Europe/Lisbon', 'Western Europe'),
+    ('CE', 'Europe/Paris', 'Central Europe'),
+    ('EE', 'Europe/Helsinki', 'Eastern Europe'),
+    ('AZ', 'Atlantic/Azores', 'Azores'),
+    ('JE', 'Asia/Jerusalem', 'Israel'),
+    ('SY', 'Australia/Sydney', 'Australian Eastern'),
+    ('AD', 'Australia/Adelaide', 'Australian Central'),
+    ('LH', 'Australia/Lord_Howe', 'Lord Howe Island'),
+    ('NZ', 'Pacific/Auckland', 'New Zealand'),
+    ('CT', 'Pacific/Chatham', 'Chatham Islands'),
+]
+
+FIRST_YEAR = 2020
+LAST_YEAR = 2083
+MAX_ZONES = 64 - 41
+QUARTER_HOUR = datetime.timedelta(minutes=15)
+
+
+class ZoneError(Exception):
+    pass
+
+
+def offset_minutes(zone, instant):
+    return int(instant.astimezone(zone).utcoffset().total_seconds()) // 60
+
+
+def find_change(zone, start, end):
+    """Bisects (start, end], which contains exactly one change of offset, down to the quarter hour it happens on."""
+    before = offset_minutes(zone, start)
+    while end - start > QUARTER_HOUR:
+        middle = start + ((end - start) // QUARTER_HOUR // 2) * QUARTER_HOUR
+        if offset_minutes(zone, middle) == before:
+            start = middle
+        else:
+            end = middle
+    return end
+
+
+def transitions(zone, year):
+    """Returns the UTC instants in the given year at which the zone's offset changes."""
+    # tz rules don't change offsets more than once a week, so sampling daily and bisecting finds every change.
+    day = datetime.timedelta(days=1)
+    instant = datetime.datetime(year, 1, 1, tzinfo=datetime.timezone.utc)
+    end = datetime.datetime(year + 1, 1, 1, tzinfo=datetime.timezone.utc)
+    changes = []
+    while instant < end:
+        following = min(instant + day, end)
+        if offset_minutes(zone, instant) != offset_minutes(zone, following):
+            changes.append(find_change(zone, instant, following))
+        instant = following
+    return changes
+
+
+def compile_zone(code, name):
+    zone = zoneinfo.ZoneInfo(name)
+    start = datetime.datetime(FIRST_YEAR, 1, 1, tzinfo=datetime.timezone.utc)
+    dst_at_start = bool(start.astimezone(zone).dst())
+    offsets = set()
+    packed = []
+    for year in range(FIRST_YEAR, LAST_YEAR + 1):
+        changes = transitions(zone, year)
+        if len(changes) != 2:
+            raise ZoneError('%s changes offset %d times in %d' % (name, len(changes), year))
+        year_start = datetime.datetime(year, 1, 1, tzinfo=datetime.timezone.utc)
+        for change in changes:
+            if offset_minutes(zone, change - datetime.timedelta(seconds=1)) == offset_minutes(zone, change):
+                raise ZoneError('%s changes offset off the quarter hour in %d' % (name, year))
+            offsets.add(offset_minutes(zone, change - QUARTER_HOUR))
+            offsets.add(offset_minutes(zone, change))
+            packed.append((change - year_start) // QUARTER_HOUR)
+    if len(offsets) != 2:
+        raise ZoneError('%s uses %d different offsets' % (name, len(offsets)))
+    standard, daylight = sorted(offsets)
+    return standard, daylight - standard, dst_at_start, packed
+
+
+def tzdata_version():
+    for path in zoneinfo.TZPATH:
+        try:
+            with open(path + '/tzdata.zi') as f:
+                return f.readline().split()[-1]
+        except OSError:
+            pass
+    return '(unknown version)'
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.parse_args()
+
+    if len(ZONES) > MAX_ZONES:
+        print('too many zones: the time zone setting only has room for %d' % MAX_ZONES, file=sys.stderr)
+        return 1
+
+    out = ['// Generated by utils/tz_rules_compiler.py from tzdata %s; do not edit.' % tzdata_version(),
+           '// Each zone has two transitions a year from %d through %d, as quarter hours since January 1st, 00:00 UTC.'
+           % (FIRST_YEAR, LAST_YEAR),
+           '',
+           '#ifndef MOVEMENT_TIMEZONES_H_',
+           '#define MOVEMENT_TIMEZONES_H_',
+           '',
+           '#include <stdint.h>',
+           '#include <stdbool.h>',
+           '',
+           '#define MOVEMENT_DST_FIRST_YEAR %d' % FIRST_YEAR,
+           '#define MOVEMENT_DST_LAST_YEAR %d' % LAST_YEAR,
+           '#define MOVEMENT_NUM_DST_ZONES %d' % len(ZONES),
+           '',
+           'typedef struct {',
+           '    int16_t standard_offset;    // minutes east of UTC',
+           '    uint8_t dst_delta;          // minutes added during daylight saving time',
+           '    bool dst_at_year_start;     // true south of the equator, where summer spans the new year',
+           '    char code[3];               // shown on the watch in place of the offset',
+           '    const uint16_t *transitions;',
+           '} movement_dst_zone_t;',
+           '']
+    zones = []
+    for code, name, description in ZONES:
+        try:
+            standard, delta, dst_at_start, packed = compile_zone(code, name)
+        except ZoneError as e:
+            print('error: %s' % e, file=sys.stderr)
+            return 1
+        identifier = 'movement_dst_transitions_' + code.lower()
+        out.append('// %s (%s)' % (name, description))
+        out.append('static const uint16_t %s[] = {' % identifier)
+        for row in range(0, len(packed), 12):
+            out.append('    ' + ', '.join('%5d' % q for q in packed[row:row + 12]) + ',')
+        out.append('};')
+        out.append('')
+        zones.append('    { %5d, %3d, %-5s, "%s", %s },' % (standard, delta, 'true' if dst_at_start else 'false',
+                                                          code, identifier))
+    out.append('static const movement_dst_zone_t movement_dst_zones[MOVEMENT_NUM_DST_ZONES] = {')
+    out += zones
+    out.append('};')
+    out.append('')
+    out.append('#endif // MOVEMENT_TIMEZONES_H_')
+    print('\n'.join(out))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -141,6 +141,17 @@ void Default_Handler(void)
 	}
 }
 
+/**
+ * \brief Retrieve the frequency the CPU is running at right now
+ *
+ * OSC16M runs at 4 MHz times (FSEL + 1), and GCLK0 passes it through undivided. FSEL is 8 MHz while USB is on and
+ * 16 MHz while watch_performance_boost is in effect, so delays stay the same length at every speed.
+ */
+static inline uint32_t _get_cpu_frequency(void)
+{
+	return 4000000 * (hri_oscctrl_read_OSC16MCTRL_FSEL_bf(OSCCTRL) + 1);
+}
+
 /**
  * \brief Retrieve the amount of cycles to delay for the given amount of us
  */
@@ -167,7 +178,7 @@ static inline uint32_t _get_cycles_for_us_internal(const uint16_t us, const uint
  */
 uint32_t _get_cycles_for_us(const uint16_t us)
 {
-	int32_t freq = hri_usbdevice_get_CTRLA_ENABLE_bit(USB) ? 8000000 : 4000000;
+	int32_t freq = _get_cpu_frequency();
 	return _get_cycles_for_us_internal(us, freq, CPU_FREQ_POWER);
 }
 
@@ -197,6 +208,6 @@ static inline uint32_t _get_cycles_for_ms_internal(const uint16_t ms, const uint
  */
 uint32_t _get_cycles_for_ms(const uint16_t ms)
 {
-	int32_t freq = hri_usbdevice_get_CTRLA_ENABLE_bit(USB) ? 8000000 : 4000000;
+	int32_t freq = _get_cpu_frequency();
 	return _get_cycles_for_ms_internal(ms, freq, CPU_FREQ_POWER);
 }
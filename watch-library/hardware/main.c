@@ -80,10 +80,16 @@ int main(void) {
         bool usb_enabled = hri_usbdevice_get_CTRLA_ENABLE_bit(USB);
         bool can_sleep = app_loop();
 
-        if (can_sleep && !usb_enabled) {
+        // the TCC stops in standby, so a buzzer sequence or an LED effect playing in the background holds us in idle;
+        // so does the SERCOM, for an I2C transfer still on the bus.
+        if (can_sleep && !usb_enabled && !watch_buzzer_is_playing() && !watch_led_effect_is_running() && !watch_i2c_is_busy()) {
             app_prepare_for_standby();
             sleep(4);
             app_wake_from_standby();
+        } else if (can_sleep) {
+            // standby would stop the USB peripheral (or the buzzer, the LED or the I2C bus), but we can still idle the CPU;
+            // the USB task's 1 kHz interrupt, the buzzer's timer interrupt, or any other interrupt, brings us back around.
+            sleep(2);
         }
     }
 
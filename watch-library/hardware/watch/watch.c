@@ -46,6 +46,68 @@ bool watch_is_usb_enabled(void) {
     return USB->DEVICE.CTRLA.bit.ENABLE;
 }
 
+void watch_set_low_power_efficiency(bool enabled) {
+    if (enabled) {
+        // clear any stale detection before re-arming, so the handler doesn't turn right back around.
+        SUPC->INTFLAG.reg = SUPC_INTFLAG_BOD33DET;
+        SUPC->VREG.bit.LPEFF = 1;
+        SUPC->INTENSET.bit.BOD33DET = 1;
+    } else {
+        SUPC->VREG.bit.LPEFF = 0;
+    }
+}
+
+bool watch_get_low_power_efficiency(void) {
+    return SUPC->VREG.bit.LPEFF;
+}
+
+static uint8_t _performance_boosts;
+static uint8_t _performance_saved_fsel;
+static uint8_t _performance_saved_wait_states;
+
+static void _watch_set_main_clock(uint8_t fsel) {
+    uint32_t old_frequency = watch_get_cpu_frequency();
+
+    // let any conversions and transfers finish at the speed they started at.
+    watch_adc_wait_for_idle();
+    watch_i2c_wait_for_idle();
+
+    hri_oscctrl_write_OSC16MCTRL_FSEL_bf(OSCCTRL, fsel);
+    while (!hri_oscctrl_get_STATUS_OSC16MRDY_bit(OSCCTRL));
+
+    _watch_tcc_clock_changed();
+    _watch_buzzer_clock_changed(old_frequency);
+    _watch_adc_clock_changed();
+    _watch_i2c_clock_changed();
+    _watch_spi_clock_changed();
+    _watch_uart_clock_changed();
+    _watch_usb_clock_changed();
+}
+
+void watch_performance_boost(void) {
+    if (_performance_boosts++) return;
+
+    _performance_saved_fsel = hri_oscctrl_read_OSC16MCTRL_FSEL_bf(OSCCTRL);
+    _performance_saved_wait_states = hri_nvmctrl_read_CTRLB_RWS_bf(NVMCTRL);
+    // 16 MHz needs performance level 2, which _init_chip already selected; this is a no-op unless someone changed it.
+    _set_performance_level(2);
+    // flash needs a wait state above 14 MHz once the battery is below 2.7 volts, so add one before speeding up.
+    hri_nvmctrl_write_CTRLB_RWS_bf(NVMCTRL, 1);
+    _watch_set_main_clock(OSCCTRL_OSC16MCTRL_FSEL_16_Val);
+}
+
+void watch_performance_restore(void) {
+    if (_performance_boosts == 0 || --_performance_boosts) return;
+
+    _watch_set_main_clock(_performance_saved_fsel);
+    hri_nvmctrl_write_CTRLB_RWS_bf(NVMCTRL, _performance_saved_wait_states);
+}
+
+uint32_t watch_get_cpu_frequency(void) {
+    // OSC16M runs at 4 MHz times (FSEL + 1), and GCLK0 passes it through undivided.
+    return 4000000 * (hri_oscctrl_read_OSC16MCTRL_FSEL_bf(OSCCTRL) + 1);
+}
+
 void watch_reset_to_bootloader(void) {
     volatile uint32_t *dbl_tap_ptr = ((volatile uint32_t *)(HSRAM_ADDR + HSRAM_SIZE - 4));
     *dbl_tap_ptr = 0xf01669ef; // from the UF2 bootloaer: uf2.h line 255
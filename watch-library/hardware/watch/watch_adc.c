@@ -25,15 +25,66 @@
 #include "watch_adc.h"
 #include "driver_init.h"
 
+static inline uint32_t _watch_adc_get_reference_voltage(const watch_adc_reference_voltage reference) {
+    switch (reference) {
+        case ADC_REFERENCE_INTREF:
+            return ADC_REFCTRL_REFSEL_INTREF_Val;
+            break;
+        case ADC_REFERENCE_VCC_DIV1POINT6:
+            return ADC_REFCTRL_REFSEL_INTVCC0_Val;
+            break;
+        case ADC_REFERENCE_VCC_DIV2:
+            return ADC_REFCTRL_REFSEL_INTVCC1_Val;
+            break;
+        case ADC_REFERENCE_VCC:
+            return ADC_REFCTRL_REFSEL_INTVCC2_Val;
+            break;
+    }
+
+    return 0;
+}
+
+// the ADC keeps its calibration and static settings across enables; only a reset clears them.
+static bool _adc_configured;
+// the first conversion after enabling the ADC or changing its reference is off, so it's thrown away.
+static bool _adc_needs_discard;
+// the reference for pin reads, as set by watch_set_analog_reference_voltage.
+static watch_adc_reference_voltage _adc_pin_reference = ADC_REFERENCE_VCC;
+
+// the sequence of reads in progress, if any.
+static watch_adc_read_t *_adc_reads;
+static uint8_t _adc_read_count;
+static uint8_t _adc_read_position;
+static bool _adc_discarding;
+static watch_adc_callback_t _adc_callback;
+static void *_adc_callback_context;
+// the blocking functions' settings, put back after a sequence.
+static uint8_t _adc_saved_samplenum;
+static uint8_t _adc_saved_samplen;
+
 static void _watch_sync_adc(void) {
     while (ADC->SYNCBUSY.reg);
 }
 
+static void _watch_adc_discard_conversion(void) {
+    // one sample is enough to settle things.
+    uint8_t samplenum = ADC->AVGCTRL.bit.SAMPLENUM;
+    ADC->AVGCTRL.bit.SAMPLENUM = ADC_AVGCTRL_SAMPLENUM_1_Val;
+    _watch_sync_adc();
+    ADC->SWTRIG.bit.START = 1;
+    while (!ADC->INTFLAG.bit.RESRDY);
+    (void)ADC->RESULT.reg;
+    ADC->AVGCTRL.bit.SAMPLENUM = samplenum;
+    _watch_sync_adc();
+    _adc_needs_discard = false;
+}
+
 static uint16_t _watch_get_analog_value(uint16_t channel) {
     if (ADC->INPUTCTRL.bit.MUXPOS != channel) {
         ADC->INPUTCTRL.bit.MUXPOS = channel;
         _watch_sync_adc();
     }
+    if (_adc_needs_discard) _watch_adc_discard_conversion();
 
     ADC->SWTRIG.bit.START = 1;
     while (!ADC->INTFLAG.bit.RESRDY); // wait for "result ready" flag
@@ -41,42 +92,70 @@ static uint16_t _watch_get_analog_value(uint16_t channel) {
     return ADC->RESULT.reg;
 }
 
+static void _watch_adc_set_reference(watch_adc_reference_voltage reference) {
+    uint8_t refsel = _watch_adc_get_reference_voltage(reference);
+    if (ADC->REFCTRL.bit.REFSEL == refsel) return;
+
+    ADC->CTRLA.bit.ENABLE = 0;
+    _watch_sync_adc();
+
+    if (reference == ADC_REFERENCE_INTREF) SUPC->VREF.bit.VREFOE = 1;
+    else SUPC->VREF.bit.VREFOE = 0;
+
+    ADC->REFCTRL.bit.REFSEL = refsel;
+    ADC->CTRLA.bit.ENABLE = 1;
+    _watch_sync_adc();
+    _adc_needs_discard = true;
+}
+
+static uint8_t _watch_adc_prescaler(void) {
+    // divide the main clock down to a 500kHz ADC clock: by 8 at 4 MHz, 16 with USB at 8 MHz, 32 when boosted to 16.
+    switch (watch_get_cpu_frequency()) {
+        case 16000000:
+            return ADC_CTRLB_PRESCALER_DIV32_Val;
+        case 8000000:
+            return ADC_CTRLB_PRESCALER_DIV16_Val;
+        default:
+            return ADC_CTRLB_PRESCALER_DIV8_Val;
+    }
+}
+
 void watch_enable_adc(void) {
     MCLK->APBCMASK.reg |= MCLK_APBCMASK_ADC;
     GCLK->PCHCTRL[ADC_GCLK_ID].reg = GCLK_PCHCTRL_GEN_GCLK0 | GCLK_PCHCTRL_CHEN;
 
-    uint16_t calib_reg = 0;
-    calib_reg = ADC_CALIB_BIASREFBUF((*(uint32_t *)ADC_FUSES_BIASREFBUF_ADDR >> ADC_FUSES_BIASREFBUF_Pos)) |
-                ADC_CALIB_BIASCOMP((*(uint32_t *)ADC_FUSES_BIASCOMP_ADDR >> ADC_FUSES_BIASCOMP_Pos));
+    if (!_adc_configured) {
+        uint16_t calib_reg = 0;
+        calib_reg = ADC_CALIB_BIASREFBUF((*(uint32_t *)ADC_FUSES_BIASREFBUF_ADDR >> ADC_FUSES_BIASREFBUF_Pos)) |
+                    ADC_CALIB_BIASCOMP((*(uint32_t *)ADC_FUSES_BIASCOMP_ADDR >> ADC_FUSES_BIASCOMP_Pos));
 
-    if (!ADC->SYNCBUSY.bit.SWRST) {
-        if (ADC->CTRLA.bit.ENABLE) {
-            ADC->CTRLA.bit.ENABLE = 0;
-            _watch_sync_adc();
+        if (!ADC->SYNCBUSY.bit.SWRST) {
+            if (ADC->CTRLA.bit.ENABLE) {
+                ADC->CTRLA.bit.ENABLE = 0;
+                _watch_sync_adc();
+            }
+            ADC->CTRLA.bit.SWRST = 1;
         }
-        ADC->CTRLA.bit.SWRST = 1;
-    }
-    _watch_sync_adc();
+        _watch_sync_adc();
 
-    if (USB->DEVICE.CTRLA.bit.ENABLE) {
-        // if USB is enabled, we are running an 8 MHz clock.
-        // divide by 16 for a 500kHz ADC clock.
-        ADC->CTRLB.bit.PRESCALER = ADC_CTRLB_PRESCALER_DIV16_Val;
-    } else {
-        // otherwise it's 4 Mhz. divide by 8 for a 500kHz ADC clock.
-        ADC->CTRLB.bit.PRESCALER = ADC_CTRLB_PRESCALER_DIV8_Val;
+        ADC->CALIB.reg = calib_reg;
+        ADC->INPUTCTRL.bit.MUXNEG = ADC_INPUTCTRL_MUXNEG_GND_Val;
+        ADC->CTRLC.bit.RESSEL = ADC_CTRLC_RESSEL_16BIT_Val;
+        _adc_configured = true;
     }
-    ADC->CALIB.reg = calib_reg;
+
+    // the main clock may have changed since the last time.
+    ADC->CTRLB.bit.PRESCALER = _watch_adc_prescaler();
+    // back to the documented defaults.
+    _adc_pin_reference = ADC_REFERENCE_VCC;
+    SUPC->VREF.bit.VREFOE = 0;
     ADC->REFCTRL.bit.REFSEL = ADC_REFCTRL_REFSEL_INTVCC2_Val;
-    ADC->INPUTCTRL.bit.MUXNEG = ADC_INPUTCTRL_MUXNEG_GND_Val;
-    ADC->CTRLC.bit.RESSEL = ADC_CTRLC_RESSEL_16BIT_Val;
     ADC->AVGCTRL.bit.SAMPLENUM = ADC_AVGCTRL_SAMPLENUM_16_Val;
     ADC->SAMPCTRL.bit.SAMPLEN = 0;
-    ADC->INTENSET.reg = ADC_INTENSET_RESRDY;
     ADC->CTRLA.bit.ENABLE = 1;
     _watch_sync_adc();
-    // throw away one measurement after reference change (the channel doesn't matter).
-    _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_SCALEDCOREVCC);
+    // the reference needs a conversion to settle; the next read will take care of it.
+    _adc_needs_discard = true;
 }
 
 void watch_enable_analog_input(const uint8_t pin) {
@@ -102,23 +181,32 @@ void watch_enable_analog_input(const uint8_t pin) {
     }
 }
 
-uint16_t watch_get_analog_pin_level(const uint8_t pin) {
+static uint8_t _watch_adc_channel(const uint8_t pin) {
     switch (pin) {
         case A0:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN12_Val);
+            return ADC_INPUTCTRL_MUXPOS_AIN12_Val;
         case A1:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN9_Val);
+            return ADC_INPUTCTRL_MUXPOS_AIN9_Val;
         case A2:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN10_Val);
+            return ADC_INPUTCTRL_MUXPOS_AIN10_Val;
         case A3:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN11_Val);
+            return ADC_INPUTCTRL_MUXPOS_AIN11_Val;
         case A4:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN8_Val);
+            return ADC_INPUTCTRL_MUXPOS_AIN8_Val;
+        case WATCH_ADC_VCC:
+            return ADC_INPUTCTRL_MUXPOS_SCALEDIOVCC_Val;
         default:
-            return 0;
+            return 0xFF;
     }
 }
 
+uint16_t watch_get_analog_pin_level(const uint8_t pin) {
+    uint8_t channel = _watch_adc_channel(pin);
+    if (channel == 0xFF || pin == WATCH_ADC_VCC) return 0;
+    watch_adc_wait_for_idle();
+    return _watch_get_analog_value(channel);
+}
+
 void watch_set_analog_num_samples(uint16_t samples) {
     // ignore any input that's not a power of 2 (i.e. only one bit set)
     if (__builtin_popcount(samples) != 1) return;
@@ -126,6 +214,7 @@ void watch_set_analog_num_samples(uint16_t samples) {
     uint8_t sample_val = __builtin_ctz(samples);
     // make sure the desired value is within range and set it, if so.
     if (sample_val <= ADC_AVGCTRL_SAMPLENUM_1024_Val) {
+        watch_adc_wait_for_idle();
         ADC->AVGCTRL.bit.SAMPLENUM = sample_val;
         _watch_sync_adc();
     }
@@ -135,56 +224,166 @@ void watch_set_analog_sampling_length(uint8_t cycles) {
     // for clarity the API asks the user how many cycles they want the measurement to take.
     // but the ADC always needs at least one cycle; it just wants to know how many *extra* cycles we want.
     // so we subtract one from the user-provided value, and clamp to the maximum.
+    watch_adc_wait_for_idle();
     ADC->SAMPCTRL.bit.SAMPLEN = (cycles - 1) & 0x3F;
     _watch_sync_adc();
 }
 
-static inline uint32_t _watch_adc_get_reference_voltage(const watch_adc_reference_voltage reference) {
-    switch (reference) {
-        case ADC_REFERENCE_INTREF:
-            return ADC_REFCTRL_REFSEL_INTREF_Val;
-            break;
-        case ADC_REFERENCE_VCC_DIV1POINT6:
-            return ADC_REFCTRL_REFSEL_INTVCC0_Val;
-            break;
-        case ADC_REFERENCE_VCC_DIV2:
-            return ADC_REFCTRL_REFSEL_INTVCC1_Val;
-            break;
-        case ADC_REFERENCE_VCC:
-            return ADC_REFCTRL_REFSEL_INTVCC2_Val;
-            break;
-    }
+void watch_set_analog_reference_voltage(watch_adc_reference_voltage reference) {
+    watch_adc_wait_for_idle();
+    _adc_pin_reference = reference;
+    _watch_adc_set_reference(reference);
+}
 
-    return 0;
+// a result at any number of samples, scaled to 16 bits. the ADC accumulates up to 16 samples, then shifts the sum
+// down to keep it in 16 bits.
+static uint16_t _watch_adc_scale_result(uint16_t result, uint8_t samplenum) {
+    if (samplenum < ADC_AVGCTRL_SAMPLENUM_16_Val) return result << (ADC_AVGCTRL_SAMPLENUM_16_Val - samplenum);
+    return result;
 }
 
-void watch_set_analog_reference_voltage(watch_adc_reference_voltage reference) {
-    ADC->CTRLA.bit.ENABLE = 0;
+static uint16_t _watch_adc_millivolts(uint16_t scaled_result) {
+    // we measure VCC / 4 against the 1.024 V reference.
+    return ((uint32_t)scaled_result * 1000) / (1024 << ADC_AVGCTRL_SAMPLENUM_16_Val);
+}
 
-    if (reference == ADC_REFERENCE_INTREF) SUPC->VREF.bit.VREFOE = 1;
-    else SUPC->VREF.bit.VREFOE = 0;
+uint16_t watch_get_vcc_voltage(void) {
+    watch_adc_wait_for_idle();
 
-    ADC->REFCTRL.bit.REFSEL = _watch_adc_get_reference_voltage(reference);
-    ADC->CTRLA.bit.ENABLE = 1;
+    // switch to the internal reference voltage, if we weren't already using it.
+    _watch_adc_set_reference(ADC_REFERENCE_INTREF);
+
+    // get the data
+    uint8_t samplenum = ADC->AVGCTRL.bit.SAMPLENUM;
+    uint16_t raw_val = _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_SCALEDIOVCC_Val);
+
+    // restore the reference for pin reads.
+    _watch_adc_set_reference(_adc_pin_reference);
+
+    return _watch_adc_millivolts(_watch_adc_scale_result(raw_val, samplenum));
+}
+
+static uint8_t _watch_adc_samplenum(watch_adc_read_t *read) {
+    if (read->samples == 0) return ADC_AVGCTRL_SAMPLENUM_16_Val;
+    return __builtin_ctz(read->samples);
+}
+
+static void _watch_adc_start_read(watch_adc_read_t *read) {
+    uint8_t samplenum = _watch_adc_samplenum(read);
+    uint8_t cycles = read->sampling_length ? read->sampling_length : 1;
+
+    _watch_adc_set_reference(read->pin == WATCH_ADC_VCC ? ADC_REFERENCE_INTREF : _adc_pin_reference);
+    ADC->INPUTCTRL.bit.MUXPOS = _watch_adc_channel(read->pin);
+    ADC->SAMPCTRL.bit.SAMPLEN = (cycles - 1) & 0x3F;
+    // a discard only needs the one sample; the real samplenum goes in once it's done.
+    _adc_discarding = _adc_needs_discard;
+    ADC->AVGCTRL.bit.SAMPLENUM = _adc_discarding ? ADC_AVGCTRL_SAMPLENUM_1_Val : samplenum;
     _watch_sync_adc();
-    // throw away one measurement after reference change (the channel doesn't matter).
-    _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_SCALEDCOREVCC);
+    _adc_needs_discard = false;
+    ADC->SWTRIG.bit.START = 1;
 }
 
-uint16_t watch_get_vcc_voltage(void) {
-    // stash the previous reference so we can restore it when we're done.
-    uint8_t oldref = ADC->REFCTRL.bit.REFSEL;
+static void _watch_adc_finish_sequence(void) {
+    watch_adc_read_t *reads = _adc_reads;
+    uint8_t count = _adc_read_count;
 
-    // if we weren't already using the internal reference voltage, select it now.
-    if (oldref != ADC_REFERENCE_INTREF) watch_set_analog_reference_voltage(ADC_REFERENCE_INTREF);
+    ADC->INTENCLR.reg = ADC_INTENCLR_RESRDY;
+    // put back what the blocking functions expect.
+    ADC->AVGCTRL.bit.SAMPLENUM = _adc_saved_samplenum;
+    ADC->SAMPCTRL.bit.SAMPLEN = _adc_saved_samplen;
+    _watch_sync_adc();
+    _watch_adc_set_reference(_adc_pin_reference);
+    _adc_reads = NULL;
 
-    // get the data
-    uint32_t raw_val = _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_SCALEDIOVCC_Val);
+    if (_adc_callback != NULL) _adc_callback(reads, count, _adc_callback_context);
+}
 
-    // restore the old reference, if needed.
-    if (oldref != ADC_REFERENCE_INTREF) watch_set_analog_reference_voltage(oldref);
+bool watch_adc_read_async(watch_adc_read_t *reads, uint8_t count, watch_adc_callback_t callback, void *context) {
+    if (_adc_reads != NULL || count == 0) return false;
 
-    return (uint16_t)((raw_val * 1000) / (1024 * 1 << ADC->AVGCTRL.bit.SAMPLENUM));
+    for(uint8_t i = 0; i < count; i++) {
+        // anything that isn't a power of 2 up to 1024 gets the default.
+        if (reads[i].samples > 1024 || __builtin_popcount(reads[i].samples) > 1) reads[i].samples = 0;
+        if (reads[i].sampling_length > 64) reads[i].sampling_length = 64;
+    }
+
+    _adc_reads = reads;
+    _adc_read_count = count;
+    _adc_read_position = 0;
+    _adc_callback = callback;
+    _adc_callback_context = context;
+    _adc_saved_samplenum = ADC->AVGCTRL.bit.SAMPLENUM;
+    _adc_saved_samplen = ADC->SAMPCTRL.bit.SAMPLEN;
+
+    NVIC_DisableIRQ(ADC_IRQn);
+    ADC->INTFLAG.reg = ADC_INTFLAG_RESRDY;
+    ADC->INTENSET.reg = ADC_INTENSET_RESRDY;
+    _watch_adc_start_read(&reads[0]);
+    NVIC_ClearPendingIRQ(ADC_IRQn);
+    NVIC_EnableIRQ(ADC_IRQn);
+
+    return true;
+}
+
+void watch_adc_read(watch_adc_read_t *reads, uint8_t count) {
+    watch_adc_wait_for_idle();
+    if (watch_adc_read_async(reads, count, NULL, NULL)) watch_adc_wait_for_idle();
+}
+
+bool watch_adc_is_busy(void) {
+    return _adc_reads != NULL;
+}
+
+void watch_adc_wait_for_idle(void) {
+    while (true) {
+        // check with interrupts masked, so the last conversion can't finish between the check and the WFI.
+        __disable_irq();
+        if (_adc_reads == NULL) {
+            __enable_irq();
+            return;
+        }
+        // IDLE mode stops the CPU but leaves the ADC and its clock running.
+        sleep(2);
+        __enable_irq();
+    }
+}
+
+void ADC_Handler(void) {
+    // reading the result clears the flag.
+    uint16_t result = ADC->RESULT.reg;
+    watch_adc_read_t *read;
+
+    if (_adc_reads == NULL) return;
+    read = &_adc_reads[_adc_read_position];
+
+    if (_adc_discarding) {
+        // that was the throwaway conversion; now the real one.
+        _adc_discarding = false;
+        ADC->AVGCTRL.bit.SAMPLENUM = _watch_adc_samplenum(read);
+        _watch_sync_adc();
+        ADC->SWTRIG.bit.START = 1;
+        return;
+    }
+
+    result = _watch_adc_scale_result(result, ADC->AVGCTRL.bit.SAMPLENUM);
+    read->result = read->pin == WATCH_ADC_VCC ? _watch_adc_millivolts(result) : result;
+
+    if (++_adc_read_position < _adc_read_count) {
+        _watch_adc_start_read(&_adc_reads[_adc_read_position]);
+    } else {
+        _watch_adc_finish_sequence();
+    }
+}
+
+void _watch_adc_clock_changed(void) {
+    if (!(MCLK->APBCMASK.reg & MCLK_APBCMASK_ADC) || !ADC->CTRLA.bit.ENABLE) return;
+    // watch_performance_boost waited for idle, so nothing is converting. the prescaler is enable-protected.
+    ADC->CTRLA.bit.ENABLE = 0;
+    _watch_sync_adc();
+    ADC->CTRLB.bit.PRESCALER = _watch_adc_prescaler();
+    ADC->CTRLA.bit.ENABLE = 1;
+    _watch_sync_adc();
+    _adc_needs_discard = true;
 }
 
 inline void watch_disable_analog_input(const uint8_t pin) {
@@ -192,6 +391,7 @@ inline void watch_disable_analog_input(const uint8_t pin) {
 }
 
 inline void watch_disable_adc(void) {
+    watch_adc_wait_for_idle();
     ADC->CTRLA.bit.ENABLE = 0;
     _watch_sync_adc();
 
@@ -30,13 +30,162 @@
     }
 }
 inline void watch_set_buzzer_period(uint32_t period) {
+    _watch_led_period_changing();
     hri_tcc_write_PERBUF_reg(TCC0, period);
+    _watch_led_set_period(period);
 }
 
 void watch_disable_buzzer(void) {
     _watch_disable_tcc();
 }
 
+static volatile struct {
+    bool playing;
+    watch_buzzer_cursor_t cursor;
+    uint32_t ticks_remaining;
+    ext_irq_cb_t callback;
+} buzzer_sequence;
+
+// Sequences are timed with TC1 (TC0 runs the USB tasks, TC2 is reserved for the 9-pin connector, and TC3 counts
+// RTC timestamps).
+// It runs one shot from the main clock divided by 1024, so each step costs one interrupt, not one per buzzer cycle.
+static void _watch_buzzer_enable_timer(void) {
+    // TC1 shares its generic clock channel with TC0, which is already fed from GCLK0 when USB is on.
+    hri_gclk_write_PCHCTRL_reg(GCLK, TC1_GCLK_ID, GCLK_PCHCTRL_GEN_GCLK0_Val | GCLK_PCHCTRL_CHEN);
+    hri_mclk_set_APBCMASK_TC1_bit(MCLK);
+    hri_tc_clear_CTRLA_ENABLE_bit(TC1);
+    hri_tc_wait_for_sync(TC1, TC_SYNCBUSY_ENABLE);
+    hri_tc_write_CTRLA_reg(TC1, TC_CTRLA_SWRST);
+    hri_tc_wait_for_sync(TC1, TC_SYNCBUSY_SWRST);
+    hri_tc_write_CTRLA_reg(TC1, TC_CTRLA_PRESCALER_DIV1024 | TC_CTRLA_MODE_COUNT16);
+    // count up to CC0, then stop and raise an overflow interrupt.
+    hri_tc_write_WAVE_reg(TC1, TC_WAVE_WAVEGEN_MFRQ);
+    hri_tc_set_CTRLB_ONESHOT_bit(TC1);
+    hri_tc_set_INTEN_OVF_bit(TC1);
+    NVIC_ClearPendingIRQ(TC1_IRQn);
+    NVIC_EnableIRQ(TC1_IRQn);
+    hri_tc_set_CTRLA_ENABLE_bit(TC1);
+    hri_tc_wait_for_sync(TC1, TC_SYNCBUSY_ENABLE);
+}
+
+// the LED's PWM shares the TCC's period, so each note rescales its duty cycles to keep its brightness. the caller
+// has already stopped any LED effect that DMA was playing with _watch_led_period_changing.
+static void _watch_buzzer_set_note(BuzzerNote note) {
+    if (note == BUZZER_NOTE_REST) {
+        watch_set_buzzer_off();
+        return;
+    }
+    hri_tcc_write_PERBUF_reg(TCC0, NotePeriods[note]);
+    hri_tcc_write_CCBUF_reg(TCC0, WATCH_BUZZER_TCC_CHANNEL, NotePeriods[note] / 2);
+    _watch_led_set_period(NotePeriods[note]);
+    watch_set_buzzer_on();
+}
+
+static void _watch_buzzer_disable_timer(void) {
+    NVIC_DisableIRQ(TC1_IRQn);
+    hri_tc_clear_CTRLA_ENABLE_bit(TC1);
+    hri_tc_wait_for_sync(TC1, TC_SYNCBUSY_ENABLE);
+    hri_mclk_clear_APBCMASK_TC1_bit(MCLK);
+}
+
+static void _watch_buzzer_run_timer(void) {
+    uint16_t ticks = buzzer_sequence.ticks_remaining > 0xFFFF ? 0xFFFF : buzzer_sequence.ticks_remaining;
+    buzzer_sequence.ticks_remaining -= ticks;
+    hri_tccount16_write_CC_reg(TC1, 0, ticks);
+    hri_tc_set_CTRLB_reg(TC1, TC_CTRLBSET_CMD_RETRIGGER);
+}
+
+// starts the next step, and returns false if there are none left.
+static bool _watch_buzzer_start_step(void) {
+    watch_buzzer_step_t step;
+    if (!_watch_buzzer_cursor_next((watch_buzzer_cursor_t *)&buzzer_sequence.cursor, &step)) return false;
+
+    _watch_buzzer_set_note(step.note);
+
+    buzzer_sequence.ticks_remaining = _watch_buzzer_step_ticks(step.duration_ms, watch_get_cpu_frequency());
+    _watch_buzzer_run_timer();
+
+    return true;
+}
+
+static void _watch_buzzer_end_sequence(void) {
+    _watch_buzzer_disable_timer();
+    watch_set_buzzer_off();
+    buzzer_sequence.playing = false;
+}
+
+static void _watch_buzzer_play(const watch_buzzer_step_t *sequence, const uint8_t *melody, uint8_t length, uint8_t loops, ext_irq_cb_t callback) {
+    watch_buzzer_abort_sequence();
+    if (!hri_tcc_get_CTRLA_reg(TCC0, TCC_CTRLA_ENABLE)) return;
+
+    // LED effects can't run while the period changes under them; watch_led_* don't start new ones while this plays.
+    _watch_led_period_changing();
+    _watch_buzzer_cursor_init((watch_buzzer_cursor_t *)&buzzer_sequence.cursor, sequence, melody, length, loops);
+    buzzer_sequence.callback = callback;
+    buzzer_sequence.playing = true;
+    _watch_buzzer_enable_timer();
+    if (!_watch_buzzer_start_step()) _watch_buzzer_end_sequence();
+}
+
+void watch_buzzer_play_sequence(const watch_buzzer_step_t *sequence, uint8_t length, uint8_t loops, ext_irq_cb_t callback) {
+    if (length == 0) return;
+    _watch_buzzer_play(sequence, NULL, length, loops, callback);
+}
+
+void watch_buzzer_play_melody(const uint8_t *melody, uint8_t loops, ext_irq_cb_t callback) {
+    _watch_buzzer_play(NULL, melody, 0, loops, callback);
+}
+
+void watch_buzzer_abort_sequence(void) {
+    if (!buzzer_sequence.playing) return;
+    _watch_buzzer_end_sequence();
+}
+
+bool watch_buzzer_is_playing(void) {
+    return buzzer_sequence.playing;
+}
+
+void _watch_buzzer_clock_changed(uint32_t old_frequency) {
+    // the step timer counts main clock cycles, so whatever is left of the current step has to be rescaled.
+    __disable_irq();
+    if (buzzer_sequence.playing) {
+        uint32_t ticks = buzzer_sequence.ticks_remaining;
+        if (!hri_tc_get_INTFLAG_OVF_bit(TC1)) {
+            // the current run is still going (a finished one-shot sits at zero), so add what's left of it.
+            hri_tc_set_CTRLB_reg(TC1, TC_CTRLBSET_CMD_READSYNC);
+            hri_tc_wait_for_sync(TC1, TC_SYNCBUSY_CTRLB);
+            uint16_t count = hri_tccount16_read_COUNT_reg(TC1);
+            uint16_t period = hri_tccount16_read_CC_reg(TC1, 0);
+            if (period > count) ticks += period - count;
+        }
+        // in MHz, so the product fits: the longest step is about a million ticks at 16 MHz.
+        ticks = ticks * (watch_get_cpu_frequency() / 1000000) / (old_frequency / 1000000);
+        buzzer_sequence.ticks_remaining = ticks ? ticks : 1;
+        // if the run just ended, its interrupt is moot now; the retriggered run covers the rest of the step.
+        hri_tc_clear_INTFLAG_OVF_bit(TC1);
+        NVIC_ClearPendingIRQ(TC1_IRQn);
+        _watch_buzzer_run_timer();
+    }
+    __enable_irq();
+}
+
+void TC1_Handler(void) {
+    hri_tc_clear_INTFLAG_OVF_bit(TC1);
+    if (!buzzer_sequence.playing) return;
+
+    // long notes take more than one run of the 16-bit counter.
+    if (buzzer_sequence.ticks_remaining) {
+        _watch_buzzer_run_timer();
+        return;
+    }
+
+    if (!_watch_buzzer_start_step()) {
+        ext_irq_cb_t callback = buzzer_sequence.callback;
+        _watch_buzzer_end_sequence();
+        if (callback != NULL) callback();
+    }
+}
+
 inline void watch_set_buzzer_on(void) {
     gpio_set_pin_direction(BUZZER, GPIO_DIRECTION_OUT);
     gpio_set_pin_function(BUZZER, WATCH_BUZZER_TCC_PINMUX);
@@ -48,13 +197,9 @@ inline void watch_set_buzzer_off(void) {
 }
 
 void watch_buzzer_play_note(BuzzerNote note, uint16_t duration_ms) {
-    if (note == BUZZER_NOTE_REST) {
-        watch_set_buzzer_off();
-    } else {
-        hri_tcc_write_PERBUF_reg(TCC0, NotePeriods[note]);
-        hri_tcc_write_CCBUF_reg(TCC0, WATCH_BUZZER_TCC_CHANNEL, NotePeriods[note] / 2);
-        watch_set_buzzer_on();
-    }
+    watch_buzzer_abort_sequence();
+    if (note != BUZZER_NOTE_REST) _watch_led_period_changing();
+    _watch_buzzer_set_note(note);
     delay_ms(duration_ms);
     watch_set_buzzer_off();
 }
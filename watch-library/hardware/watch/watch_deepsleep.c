@@ -109,6 +109,43 @@ void watch_disable_extwake_interrupt(uint8_t pin) {
     hri_rtcmode0_set_CTRLA_ENABLE_bit(RTC);
 }
 
+// the EIC channels, and the port B pins they're on, that watch_enter_sleep_mode leaves armed.
+static uint16_t sleep_mode_eic_channels;
+static uint32_t sleep_mode_portb_pins;
+
+void watch_set_sleep_mode_wake_pin(uint8_t pin, bool keep) {
+    uint8_t channel;
+
+    switch (pin) {
+        case A0:
+            channel = WATCH_A0_EIC_CHANNEL;
+            break;
+        case A1:
+            channel = WATCH_A1_EIC_CHANNEL;
+            break;
+        case A2:
+            channel = WATCH_A2_EIC_CHANNEL;
+            break;
+        case A3:
+            channel = WATCH_A3_EIC_CHANNEL;
+            break;
+        case A4:
+            channel = WATCH_A4_EIC_CHANNEL;
+            break;
+        default:
+            return;
+    }
+
+    // A0-A4 are all on port B.
+    if (keep) {
+        sleep_mode_eic_channels |= 1 << channel;
+        sleep_mode_portb_pins |= 1 << (pin & 0x1F);
+    } else {
+        sleep_mode_eic_channels &= ~(1 << channel);
+        sleep_mode_portb_pins &= ~(1 << (pin & 0x1F));
+    }
+}
+
 void watch_store_backup_data(uint32_t data, uint8_t reg) {
     if (reg < 8) {
         RTC->MODE0.BKUP[reg].reg = data;
@@ -131,6 +168,8 @@ static void _watch_disable_all_pins_except_rtc(void) {
     if (config & RTC_TAMPCTRL_IN0ACT_Msk) portb_pins_to_disable &= 0xFFFFFFFE;
     // same with RTC/IN[1] and PB02
     if (config & RTC_TAMPCTRL_IN1ACT_Msk) portb_pins_to_disable &= 0xFFFFFFFB;
+    // and leave any pins that were asked to wake us from sleep mode.
+    portb_pins_to_disable &= ~sleep_mode_portb_pins;
 
     // port A: always keep PA02 configured as-is; that's our ALARM button.
     gpio_set_port_direction(0, 0xFFFFFFFB, GPIO_DIRECTION_OFF);
@@ -141,7 +180,12 @@ static void _watch_disable_all_pins_except_rtc(void) {
 static void _watch_disable_all_peripherals_except_slcd(void) {
     _watch_disable_tcc();
     watch_disable_adc();
-    watch_disable_external_interrupts();
+    if (sleep_mode_eic_channels && hri_eic_get_CTRLA_reg(EIC, EIC_CTRLA_ENABLE)) {
+        // a sensor still needs to wake us; leave the EIC running with every other interrupt off.
+        hri_eic_clear_INTEN_reg(EIC, EIC_INTENCLR_MASK & ~sleep_mode_eic_channels);
+    } else {
+        watch_disable_external_interrupts();
+    }
     watch_disable_i2c();
     // TODO: replace this with a proper function when we remove the debug UART
     SERCOM3->USART.CTRLA.reg &= ~SERCOM_USART_CTRLA_ENABLE;
@@ -23,27 +23,68 @@
  */
 
 #include "watch_i2c.h"
+#include "hpl_sercom_config.h"
 
 struct io_descriptor *I2C_0_io;
 
+// queue of pending asynchronous transfers; the head is the one on the bus.
+static watch_i2c_transfer_t *_i2c_queue_head;
+static watch_i2c_transfer_t *_i2c_queue_tail;
+// progress through the transfer at the head of the queue.
+static uint16_t _i2c_tx_position;
+static uint16_t _i2c_rx_position;
+static bool _i2c_reading;
+// every start condition, including repeated starts.
+static volatile uint32_t _i2c_transaction_count;
+
+#define WATCH_I2C_CMD_READ 2
+#define WATCH_I2C_CMD_STOP 3
+
+// the config header works out BAUD for a 4 MHz clock at compile time; this does the same sum for whatever we're running at.
+static uint16_t _watch_i2c_baud(void) {
+    uint32_t frequency = watch_get_cpu_frequency();
+    uint32_t total = ((frequency - CONF_SERCOM_1_I2CM_BAUD * 10
+                       - CONF_SERCOM_1_I2CM_TRISE * (CONF_SERCOM_1_I2CM_BAUD / 100) * (frequency / 10000) / 1000) * 10 + 5)
+                     / (CONF_SERCOM_1_I2CM_BAUD * 10);
+    if (total > 0xFF * 2) return 0xFF;
+    if (total <= 1) return 1;
+    // BAUD and BAUDLOW split the total between the high and low halves of SCL.
+    return (total & 1) ? (total / 2) + ((total / 2 + 1) << 8) : total / 2;
+}
+
 void watch_enable_i2c(void) {
     I2C_0_init();
+    // I2C_0_init assumed a 4 MHz clock; the clock may be running faster.
+    hri_sercomi2cm_write_BAUD_reg(SERCOM1, _watch_i2c_baud());
     i2c_m_sync_get_io_descriptor(&I2C_0, &I2C_0_io);
     i2c_m_sync_enable(&I2C_0);
 }
 
+void _watch_i2c_clock_changed(void) {
+    if (!hri_mclk_get_APBCMASK_SERCOM1_bit(MCLK) || !hri_sercomi2cm_get_CTRLA_ENABLE_bit(SERCOM1)) return;
+    // watch_performance_boost waited for the queue to drain, so the bus is idle. BAUD is enable-protected.
+    i2c_m_sync_disable(&I2C_0);
+    hri_sercomi2cm_write_BAUD_reg(SERCOM1, _watch_i2c_baud());
+    i2c_m_sync_enable(&I2C_0);
+}
+
 void watch_disable_i2c(void) {
+    watch_i2c_wait_for_idle();
     i2c_m_sync_disable(&I2C_0);
 	hri_mclk_clear_APBCMASK_SERCOM1_bit(MCLK);
 }
 
 void watch_i2c_send(int16_t addr, uint8_t *buf, uint16_t length) {
+    watch_i2c_wait_for_idle();
     i2c_m_sync_set_periphaddr(&I2C_0, addr, I2C_M_SEVEN);
+    _i2c_transaction_count++;
     io_write(I2C_0_io, buf, length);
 }
 
 void watch_i2c_receive(int16_t addr, uint8_t *buf, uint16_t length) {
+    watch_i2c_wait_for_idle();
     i2c_m_sync_set_periphaddr(&I2C_0, addr, I2C_M_SEVEN);
+    _i2c_transaction_count++;
     io_read(I2C_0_io, buf, length);
 }
 
@@ -91,3 +132,126 @@ uint32_t watch_i2c_read32(int16_t addr, uint8_t reg) {
 
     return data;
 }
+
+static void _watch_i2c_start_transfer(watch_i2c_transfer_t *transfer) {
+    _i2c_tx_position = 0;
+    _i2c_rx_position = 0;
+    // a transfer with nothing to write goes straight to the read phase.
+    _i2c_reading = (transfer->tx_length == 0);
+    hri_sercomi2cm_clear_CTRLB_ACKACT_bit(SERCOM1);
+    // smart mode would ACK on every DATA read; we issue commands by hand so we can NACK the last byte.
+    hri_sercomi2cm_clear_CTRLB_SMEN_bit(SERCOM1);
+    _i2c_transaction_count++;
+    hri_sercomi2cm_write_ADDR_reg(SERCOM1, (transfer->addr << 1) | (_i2c_reading ? 1 : 0));
+}
+
+static void _watch_i2c_finish_transfer(bool success) {
+    watch_i2c_transfer_t *transfer = _i2c_queue_head;
+
+    _i2c_queue_head = transfer->next;
+    if (_i2c_queue_head == NULL) _i2c_queue_tail = NULL;
+    transfer->next = NULL;
+    transfer->status = success ? WATCH_I2C_TRANSFER_DONE : WATCH_I2C_TRANSFER_FAILED;
+
+    // start the next transfer before running the callback, so the bus stays busy while it runs.
+    if (_i2c_queue_head != NULL) {
+        _watch_i2c_start_transfer(_i2c_queue_head);
+    } else {
+        hri_sercomi2cm_clear_INTEN_reg(SERCOM1, SERCOM_I2CM_INTENSET_MB | SERCOM_I2CM_INTENSET_SB | SERCOM_I2CM_INTENSET_ERROR);
+    }
+
+    if (transfer->callback != NULL) transfer->callback(transfer);
+}
+
+bool watch_i2c_transfer_async(watch_i2c_transfer_t *transfer) {
+    if (transfer->status == WATCH_I2C_TRANSFER_PENDING) return false;
+    if (transfer->tx_length == 0 && transfer->rx_length == 0) return false;
+
+    transfer->status = WATCH_I2C_TRANSFER_PENDING;
+    transfer->next = NULL;
+
+    NVIC_DisableIRQ(SERCOM1_IRQn);
+    if (_i2c_queue_head == NULL) {
+        _i2c_queue_head = _i2c_queue_tail = transfer;
+        hri_sercomi2cm_clear_INTFLAG_reg(SERCOM1, SERCOM_I2CM_INTFLAG_MB | SERCOM_I2CM_INTFLAG_SB | SERCOM_I2CM_INTFLAG_ERROR);
+        hri_sercomi2cm_set_INTEN_reg(SERCOM1, SERCOM_I2CM_INTENSET_MB | SERCOM_I2CM_INTENSET_SB | SERCOM_I2CM_INTENSET_ERROR);
+        _watch_i2c_start_transfer(transfer);
+    } else {
+        _i2c_queue_tail->next = transfer;
+        _i2c_queue_tail = transfer;
+    }
+    NVIC_ClearPendingIRQ(SERCOM1_IRQn);
+    NVIC_EnableIRQ(SERCOM1_IRQn);
+
+    return true;
+}
+
+uint32_t watch_i2c_get_transaction_count(void) {
+    return _i2c_transaction_count;
+}
+
+bool watch_i2c_is_busy(void) {
+    return _i2c_queue_head != NULL;
+}
+
+void watch_i2c_wait_for_idle(void) {
+    while (true) {
+        // check the queue with interrupts masked, so the last completion can't sneak in between the check and the WFI.
+        // a pending interrupt still wakes the core from WFI with PRIMASK set.
+        __disable_irq();
+        if (_i2c_queue_head == NULL) {
+            __enable_irq();
+            return;
+        }
+        // IDLE mode stops the CPU but leaves SERCOM1 and its clocks running.
+        sleep(2);
+        __enable_irq();
+    }
+}
+
+void SERCOM1_Handler(void) {
+    watch_i2c_transfer_t *transfer = _i2c_queue_head;
+    uint8_t flags = hri_sercomi2cm_read_INTFLAG_reg(SERCOM1);
+    uint16_t status = hri_sercomi2cm_read_STATUS_reg(SERCOM1);
+
+    if (transfer == NULL) {
+        hri_sercomi2cm_clear_INTFLAG_reg(SERCOM1, flags);
+        return;
+    }
+
+    if ((flags & SERCOM_I2CM_INTFLAG_ERROR) || (status & (SERCOM_I2CM_STATUS_ARBLOST | SERCOM_I2CM_STATUS_BUSERR))) {
+        // bus error or arbitration lost; we no longer own the bus, so there's no stop to send.
+        hri_sercomi2cm_clear_STATUS_reg(SERCOM1, SERCOM_I2CM_STATUS_ARBLOST | SERCOM_I2CM_STATUS_BUSERR);
+        hri_sercomi2cm_clear_INTFLAG_reg(SERCOM1, flags);
+        _watch_i2c_finish_transfer(false);
+    } else if (flags & SERCOM_I2CM_INTFLAG_MB) {
+        // master on bus: the address or the last byte we wrote has been clocked out.
+        if (status & SERCOM_I2CM_STATUS_RXNACK) {
+            hri_sercomi2cm_write_CTRLB_CMD_bf(SERCOM1, WATCH_I2C_CMD_STOP);
+            _watch_i2c_finish_transfer(false);
+        } else if (_i2c_tx_position < transfer->tx_length) {
+            hri_sercomi2cm_write_DATA_reg(SERCOM1, transfer->tx_buffer[_i2c_tx_position++]);
+        } else if (transfer->rx_length) {
+            // repeated start for the read phase.
+            _i2c_reading = true;
+            _i2c_transaction_count++;
+            hri_sercomi2cm_write_ADDR_reg(SERCOM1, (transfer->addr << 1) | 1);
+        } else {
+            hri_sercomi2cm_write_CTRLB_CMD_bf(SERCOM1, WATCH_I2C_CMD_STOP);
+            _watch_i2c_finish_transfer(true);
+        }
+    } else if (flags & SERCOM_I2CM_INTFLAG_SB) {
+        // slave on bus: a byte has been received and the bus is held until we say what to do next.
+        bool last_byte = (_i2c_rx_position + 1 >= transfer->rx_length);
+        if (last_byte) {
+            hri_sercomi2cm_set_CTRLB_ACKACT_bit(SERCOM1);
+        }
+        transfer->rx_buffer[_i2c_rx_position++] = hri_sercomi2cm_read_DATA_reg(SERCOM1);
+        if (last_byte) {
+            hri_sercomi2cm_write_CTRLB_CMD_bf(SERCOM1, WATCH_I2C_CMD_STOP);
+            _watch_i2c_finish_transfer(true);
+        } else {
+            hri_sercomi2cm_write_CTRLB_CMD_bf(SERCOM1, WATCH_I2C_CMD_READ);
+        }
+    }
+}
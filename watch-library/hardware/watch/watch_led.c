@@ -24,9 +24,163 @@
 
 #include "watch_led.h"
 
+// LED effects are played by two DMA channels, one per LED, that copy a table of duty cycles into the TCC's compare
+// buffers, one entry per periodic event from the RTC. The event system hands the same event to both channels, so the
+// colors move in step, and the CPU only hears about it when the green channel (the lower priority one, so always the
+// last to move) finishes its final block.
+#define WATCH_LED_DMA_RED 0
+#define WATCH_LED_DMA_GREEN 1
+#define WATCH_LED_DMA_CHANNELS 2
+#define WATCH_LED_EVSYS_CHANNEL 0
+
+// a hold steps on the 64 Hz event, RTC PER1, or on a slower one if it's too long to count at 64 Hz.
+#define WATCH_LED_HOLD_RATE_SHIFT 1
+
+static DmacDescriptor led_descriptors[WATCH_LED_DMA_CHANNELS] __attribute__((aligned(16)));
+static DmacDescriptor led_writeback[WATCH_LED_DMA_CHANNELS] __attribute__((aligned(16)));
+// the block after a hold: a single write of zero.
+static DmacDescriptor led_off_descriptors[WATCH_LED_DMA_CHANNELS] __attribute__((aligned(16)));
+
+static const uint32_t led_duty_off = 0;
+static const uint8_t led_tcc_channels[WATCH_LED_DMA_CHANNELS] = {WATCH_RED_TCC_CHANNEL, WATCH_GREEN_TCC_CHANNEL};
+
+static struct {
+    volatile bool running;
+    // false while the LED is held without DMA: with no timeout, or timed by the CPU (see _watch_led_rtc_paces_effects).
+    bool dma;
+    // true while a hold is due to end at off_timestamp; without DMA, watch_led_effect_is_running ends it.
+    bool timed;
+    uint32_t off_timestamp;
+    // the color last set or, while an effect is running, the color it will end on.
+    uint8_t level[WATCH_LED_DMA_CHANNELS];
+    uint32_t duty[WATCH_LED_DMA_CHANNELS][WATCH_LED_EFFECT_MAX_STEPS];
+} led_effect;
+
+static inline uint32_t _watch_led_duty(uint32_t period, uint8_t level) {
+    return (period * level) / 255;
+}
+
+static void _watch_led_set_descriptor(DmacDescriptor *descriptor, uint8_t channel, const uint32_t *source, uint16_t count, bool increment, DmacDescriptor *next) {
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_WORD |
+                             (increment ? DMAC_BTCTRL_SRCINC : 0) |
+                             // the last block of the green channel is the one that tells us the effect is over.
+                             ((next == NULL && channel == WATCH_LED_DMA_GREEN) ? DMAC_BTCTRL_BLOCKACT_INT : DMAC_BTCTRL_BLOCKACT_NOACT);
+    descriptor->BTCNT.reg = count;
+    // an incrementing address points at the end of the block.
+    descriptor->SRCADDR.reg = (uint32_t)(increment ? source + count : source);
+    descriptor->DSTADDR.reg = (uint32_t)&TCC0->CCBUF[led_tcc_channels[channel]].reg;
+    descriptor->DESCADDR.reg = (uint32_t)next;
+}
+
+static void _watch_led_start_dma(uint8_t rate_shift) {
+    hri_mclk_set_AHBMASK_DMAC_bit(MCLK);
+    hri_mclk_set_APBCMASK_EVSYS_bit(MCLK);
+
+    // route the RTC's periodic event to both channels.
+    hri_gclk_write_PCHCTRL_reg(GCLK, EVSYS_GCLK_ID_0, GCLK_PCHCTRL_GEN_GCLK0_Val | GCLK_PCHCTRL_CHEN);
+    EVSYS->CHANNEL[WATCH_LED_EVSYS_CHANNEL].reg = EVSYS_CHANNEL_EVGEN(EVSYS_ID_GEN_RTC_PER_0 + rate_shift) |
+                                                  EVSYS_CHANNEL_PATH_RESYNCHRONIZED |
+                                                  EVSYS_CHANNEL_EDGSEL_RISING_EDGE;
+    EVSYS->USER[EVSYS_ID_USER_DMAC_CH_0 + WATCH_LED_DMA_RED].reg = EVSYS_USER_CHANNEL(WATCH_LED_EVSYS_CHANNEL + 1);
+    EVSYS->USER[EVSYS_ID_USER_DMAC_CH_0 + WATCH_LED_DMA_GREEN].reg = EVSYS_USER_CHANNEL(WATCH_LED_EVSYS_CHANNEL + 1);
+
+    // the descriptor sections can only be moved with the DMAC disabled, so leave them be if it's already running.
+    // channels 0 and 1 are the LED's; anything else using the DMAC would extend these sections past them.
+    if (!(DMAC->CTRL.reg & DMAC_CTRL_DMAENABLE)) {
+        DMAC->BASEADDR.reg = (uint32_t)led_descriptors;
+        DMAC->WRBADDR.reg = (uint32_t)led_writeback;
+        DMAC->CTRL.reg = DMAC_CTRL_DMAENABLE | DMAC_CTRL_LVLEN0;
+    }
+
+    // each event moves one beat: one duty cycle into one compare buffer.
+    for (uint8_t channel = 0; channel < WATCH_LED_DMA_CHANNELS; channel++) {
+        DMAC->CHID.reg = DMAC_CHID_ID(channel);
+        DMAC->CHCTRLB.reg = DMAC_CHCTRLB_LVL(0) | DMAC_CHCTRLB_TRIGSRC_DISABLE | DMAC_CHCTRLB_TRIGACT_BEAT |
+                            DMAC_CHCTRLB_EVIE | DMAC_CHCTRLB_EVACT_TRIG;
+        DMAC->CHINTFLAG.reg = DMAC_CHINTFLAG_MASK;
+        if (channel == WATCH_LED_DMA_GREEN) DMAC->CHINTENSET.reg = DMAC_CHINTENSET_TCMPL;
+    }
+    NVIC_ClearPendingIRQ(DMAC_IRQn);
+    NVIC_EnableIRQ(DMAC_IRQn);
+
+    led_effect.running = true;
+    led_effect.dma = true;
+    led_effect.timed = false;
+    for (uint8_t channel = 0; channel < WATCH_LED_DMA_CHANNELS; channel++) {
+        DMAC->CHID.reg = DMAC_CHID_ID(channel);
+        DMAC->CHCTRLA.reg = DMAC_CHCTRLA_ENABLE;
+    }
+}
+
+static bool _watch_led_dmac_in_use(void) {
+    for (uint8_t channel = 0; channel < DMAC_CH_NUM; channel++) {
+        DMAC->CHID.reg = DMAC_CHID_ID(channel);
+        if (DMAC->CHCTRLA.bit.ENABLE) return true;
+    }
+    return false;
+}
+
+static void _watch_led_stop_dma(void) {
+    // only the LED's channels stop here; anyone else's transfers carry on.
+    for (uint8_t channel = 0; channel < WATCH_LED_DMA_CHANNELS; channel++) {
+        DMAC->CHID.reg = DMAC_CHID_ID(channel);
+        DMAC->CHCTRLA.bit.ENABLE = 0;
+        while (DMAC->CHCTRLA.bit.ENABLE);
+        DMAC->CHINTENCLR.reg = DMAC_CHINTENCLR_MASK;
+        DMAC->CHINTFLAG.reg = DMAC_CHINTFLAG_MASK;
+    }
+    // the DMAC itself only goes off once no channel at all is left running.
+    if (!_watch_led_dmac_in_use()) {
+        NVIC_DisableIRQ(DMAC_IRQn);
+        DMAC->CTRL.reg = 0;
+        hri_mclk_clear_AHBMASK_DMAC_bit(MCLK);
+    }
+
+    EVSYS->USER[EVSYS_ID_USER_DMAC_CH_0 + WATCH_LED_DMA_RED].reg = 0;
+    EVSYS->USER[EVSYS_ID_USER_DMAC_CH_0 + WATCH_LED_DMA_GREEN].reg = 0;
+    EVSYS->CHANNEL[WATCH_LED_EVSYS_CHANNEL].reg = 0;
+    hri_gclk_write_PCHCTRL_reg(GCLK, EVSYS_GCLK_ID_0, 0);
+
+    led_effect.running = false;
+}
+
+// an RTC left running by firmware from before the periodic events were turned on can't pace effects; the events are
+// switched on the next time the time is set (see watch_rtc_set_date_time), since stopping the RTC any sooner would
+// lose time. until then, fades and breaths go straight to their color, and timed offs are timed by the CPU.
+static bool _watch_led_rtc_paces_effects(void) {
+    return (RTC->MODE2.EVCTRL.reg & RTC_MODE2_EVCTRL_PEREO_Msk) == RTC_MODE2_EVCTRL_PEREO_Msk;
+}
+
+static void _watch_led_play(const watch_led_effect_t *effect) {
+    // while the buzzer plays, the period the duty cycles were worked out for changes with every note.
+    if (!_watch_led_rtc_paces_effects() || watch_buzzer_is_playing()) {
+        // a fade lands where it would have ended, and a breath stays at its peak.
+        uint8_t peak = effect->loops ? effect->length / 2 : effect->length - 1;
+        watch_set_led_color(effect->red[peak], effect->green[peak]);
+        return;
+    }
+
+
+    uint32_t period = hri_tcc_read_PER_reg(TCC0);
+    for (uint8_t i = 0; i < effect->length; i++) {
+        led_effect.duty[WATCH_LED_DMA_RED][i] = _watch_led_duty(period, effect->red[i]);
+        led_effect.duty[WATCH_LED_DMA_GREEN][i] = _watch_led_duty(period, effect->green[i]);
+    }
+    for (uint8_t channel = 0; channel < WATCH_LED_DMA_CHANNELS; channel++) {
+        // a looping effect links its one block back to itself, and never ends on its own.
+        _watch_led_set_descriptor(&led_descriptors[channel], channel, led_effect.duty[channel], effect->length, true,
+                                  effect->loops ? &led_descriptors[channel] : NULL);
+    }
+    led_effect.level[WATCH_LED_DMA_RED] = effect->red[effect->length - 1];
+    led_effect.level[WATCH_LED_DMA_GREEN] = effect->green[effect->length - 1];
+    _watch_led_start_dma(effect->rate_shift);
+}
+
 void watch_enable_leds(void) {
     if (!hri_tcc_get_CTRLA_reg(TCC0, TCC_CTRLA_ENABLE)) {
         _watch_enable_tcc();
+        led_effect.level[WATCH_LED_DMA_RED] = 0;
+        led_effect.level[WATCH_LED_DMA_GREEN] = 0;
     }
 }
 
@@ -35,10 +189,13 @@ void watch_disable_leds(void) {
 }
 
 void watch_set_led_color(uint8_t red, uint8_t green) {
+    watch_led_stop_effect();
     if (hri_tcc_get_CTRLA_reg(TCC0, TCC_CTRLA_ENABLE)) {
         uint32_t period = hri_tcc_get_PER_reg(TCC0, TCC_PER_MASK);
         hri_tcc_write_CCBUF_reg(TCC0, WATCH_RED_TCC_CHANNEL, ((period * red * 1000ull) / 255000ull));
         hri_tcc_write_CCBUF_reg(TCC0, WATCH_GREEN_TCC_CHANNEL, ((period * green * 1000ull) / 255000ull));
+        led_effect.level[WATCH_LED_DMA_RED] = red;
+        led_effect.level[WATCH_LED_DMA_GREEN] = green;
     }
 }
 
@@ -57,3 +214,129 @@ void watch_set_led_yellow(void) {
 void watch_set_led_off(void) {
     watch_set_led_color(0, 0);
 }
+
+void watch_led_fade_to(uint8_t red, uint8_t green, uint16_t duration_ms) {
+    watch_led_stop_effect();
+    if (!hri_tcc_get_CTRLA_reg(TCC0, TCC_CTRLA_ENABLE)) return;
+
+    watch_led_effect_t effect;
+    _watch_led_effect_fade(&effect, led_effect.level[WATCH_LED_DMA_RED], led_effect.level[WATCH_LED_DMA_GREEN], red, green, duration_ms);
+    _watch_led_play(&effect);
+}
+
+void watch_led_breathe(uint8_t red, uint8_t green, uint16_t period_ms) {
+    watch_led_stop_effect();
+    if (!hri_tcc_get_CTRLA_reg(TCC0, TCC_CTRLA_ENABLE)) return;
+
+    watch_led_effect_t effect;
+    _watch_led_effect_breathe(&effect, red, green, period_ms);
+    _watch_led_play(&effect);
+}
+
+void watch_led_off_after(uint32_t duration_ms) {
+    watch_led_stop_effect();
+    if (!hri_tcc_get_CTRLA_reg(TCC0, TCC_CTRLA_ENABLE)) return;
+    if (led_effect.level[WATCH_LED_DMA_RED] == 0 && led_effect.level[WATCH_LED_DMA_GREEN] == 0) return;
+
+    // a block counts up to 65535 steps: about 17 minutes at 64 Hz, and 18 hours at 1 Hz.
+    uint8_t rate_shift = WATCH_LED_HOLD_RATE_SHIFT;
+    uint64_t steps;
+    while (true) {
+        steps = ((uint64_t)duration_ms * (128 >> rate_shift)) / 1000;
+        if (steps <= 0xFFFF || rate_shift == 7) break;
+        rate_shift++;
+    }
+    if (steps > 0xFFFF) steps = 0xFFFF;
+    if (steps == 0) steps = 1;
+
+    // the off time is kept either way, in case the buzzer takes the hold away from DMA (see _watch_led_period_changing).
+    uint32_t now = watch_rtc_get_timestamp();
+    led_effect.off_timestamp = now + ((uint64_t)duration_ms * WATCH_RTC_TIMESTAMP_FREQUENCY) / 1000;
+
+    if (!_watch_led_rtc_paces_effects() || watch_buzzer_is_playing()) {
+        // the main loop checks watch_led_effect_is_running every time it wakes, which is at least once a second
+        // while Movement is awake; that's where this hold ends.
+        if (now == 0) {
+            watch_set_led_off();
+            return;
+        }
+        led_effect.running = true;
+        led_effect.dma = false;
+        led_effect.timed = true;
+        return;
+    }
+
+    // hold by rewriting the current duty cycle once per event; the count of those writes is the timer.
+    uint32_t period = hri_tcc_read_PER_reg(TCC0);
+    for (uint8_t channel = 0; channel < WATCH_LED_DMA_CHANNELS; channel++) {
+        led_effect.duty[channel][0] = _watch_led_duty(period, led_effect.level[channel]);
+        _watch_led_set_descriptor(&led_off_descriptors[channel], channel, &led_duty_off, 1, false, NULL);
+        _watch_led_set_descriptor(&led_descriptors[channel], channel, led_effect.duty[channel], steps, false, &led_off_descriptors[channel]);
+        led_effect.level[channel] = 0;
+    }
+    _watch_led_start_dma(rate_shift);
+    // not timed by the CPU unless the buzzer takes it away from DMA, but it will need to know when to end if it is.
+    led_effect.timed = now != 0;
+}
+
+void watch_led_hold(void) {
+    watch_led_stop_effect();
+    if (!hri_tcc_get_CTRLA_reg(TCC0, TCC_CTRLA_ENABLE)) return;
+    if (led_effect.level[WATCH_LED_DMA_RED] == 0 && led_effect.level[WATCH_LED_DMA_GREEN] == 0) return;
+
+    // nothing to step: the compare buffers already hold the color. running just keeps the TCC out of standby.
+    led_effect.running = true;
+    led_effect.dma = false;
+    led_effect.timed = false;
+}
+
+void watch_led_stop_effect(void) {
+    if (!led_effect.running) return;
+    led_effect.timed = false;
+    if (!led_effect.dma) {
+        led_effect.running = false;
+        return;
+    }
+    _watch_led_stop_dma();
+
+    // leave the LED where the effect had got to.
+    uint32_t period = hri_tcc_read_PER_reg(TCC0);
+    if (period == 0) return;
+    led_effect.level[WATCH_LED_DMA_RED] = (hri_tcc_read_CCBUF_reg(TCC0, WATCH_RED_TCC_CHANNEL) * 255) / period;
+    led_effect.level[WATCH_LED_DMA_GREEN] = (hri_tcc_read_CCBUF_reg(TCC0, WATCH_GREEN_TCC_CHANNEL) * 255) / period;
+}
+
+void _watch_led_period_changing(void) {
+    if (!led_effect.running || !led_effect.dma) return;
+
+    bool timed = led_effect.timed;
+    // leaves the LED at the color the effect had got to.
+    watch_led_stop_effect();
+    if (timed) {
+        // a timed off becomes a hold that the CPU ends, as when the RTC can't pace it.
+        led_effect.running = true;
+        led_effect.dma = false;
+        led_effect.timed = true;
+    }
+}
+
+void _watch_led_set_period(uint32_t period) {
+    hri_tcc_write_CCBUF_reg(TCC0, WATCH_RED_TCC_CHANNEL, _watch_led_duty(period, led_effect.level[WATCH_LED_DMA_RED]));
+    hri_tcc_write_CCBUF_reg(TCC0, WATCH_GREEN_TCC_CHANNEL, _watch_led_duty(period, led_effect.level[WATCH_LED_DMA_GREEN]));
+}
+
+bool watch_led_effect_is_running(void) {
+    if (led_effect.running && led_effect.timed && (int32_t)(watch_rtc_get_timestamp() - led_effect.off_timestamp) >= 0) {
+        watch_set_led_off();
+    }
+    return led_effect.running;
+}
+
+void DMAC_Handler(void) {
+    // CHID selects the channel for whatever the interrupted code was doing, so put it back afterwards.
+    uint8_t chid = DMAC->CHID.reg;
+    DMAC->CHID.reg = DMAC_CHID_ID(WATCH_LED_DMA_GREEN);
+    // both channels are done; the levels already say where they ended.
+    if (DMAC->CHINTFLAG.reg & DMAC_CHINTFLAG_TCMPL) _watch_led_stop_dma();
+    DMAC->CHID.reg = chid;
+}
@@ -43,6 +43,7 @@ void _watch_init(void) {
     watch_disable_adc();
     // ...because we can enable the more efficient low power regulator if the system voltage is > 2.5V
     // still, enable LPEFF only if the battery voltage is comfortably above this threshold.
+    // (an app can revisit this later with watch_set_low_power_efficiency, as Movement's battery service does.)
     if (battery_voltage >= 2700) {
         SUPC->VREG.bit.LPEFF = 1;
     } else {
@@ -112,8 +113,22 @@ int getentropy(void *buf, size_t buflen) {
     return 0;
 }
 
+static uint32_t _watch_tcc_prescaler(void) {
+    // divide the main clock down to 1 MHz, so buzzer periods and LED levels mean the same thing at any speed.
+    switch (watch_get_cpu_frequency()) {
+        case 16000000:
+            return TCC_CTRLA_PRESCALER_DIV16;
+        case 8000000:
+            // if USB is enabled, we are running an 8 MHz clock.
+            return TCC_CTRLA_PRESCALER_DIV8;
+        default:
+            // otherwise it's 4 Mhz.
+            return TCC_CTRLA_PRESCALER_DIV4;
+    }
+}
+
 void _watch_enable_tcc(void) {
-    // clock TCC0 with the main clock (8 MHz) and enable the peripheral clock.
+    // clock TCC0 with the main clock and enable the peripheral clock.
     hri_gclk_write_PCHCTRL_reg(GCLK, TCC0_GCLK_ID, GCLK_PCHCTRL_GEN_GCLK0_Val | GCLK_PCHCTRL_CHEN);
     hri_mclk_set_APBCMASK_TCC0_bit(MCLK);
     // disable and reset TCC0.
@@ -121,14 +136,7 @@ void _watch_enable_tcc(void) {
     hri_tcc_wait_for_sync(TCC0, TCC_SYNCBUSY_ENABLE);
     hri_tcc_write_CTRLA_reg(TCC0, TCC_CTRLA_SWRST);
     hri_tcc_wait_for_sync(TCC0, TCC_SYNCBUSY_SWRST);
-    // divide the clock down to 1 MHz
-    if (hri_usbdevice_get_CTRLA_ENABLE_bit(USB)) {
-        // if USB is enabled, we are running an 8 MHz clock.
-        hri_tcc_write_CTRLA_reg(TCC0, TCC_CTRLA_PRESCALER_DIV8);
-    } else {
-        // otherwise it's 4 Mhz.
-        hri_tcc_write_CTRLA_reg(TCC0, TCC_CTRLA_PRESCALER_DIV4);
-    }
+    hri_tcc_write_CTRLA_reg(TCC0, _watch_tcc_prescaler());
     // We're going to use normal PWM mode, which means period is controlled by PER, and duty cycle is controlled by
     // each compare channel's value:
     //  * Buzzer tones are set by setting PER to the desired period for a given frequency, and CC[1] to half of that
@@ -158,7 +166,21 @@ void _watch_enable_tcc(void) {
     gpio_set_pin_function(GREEN, WATCH_GREEN_TCC_PINMUX);
 }
 
+void _watch_tcc_clock_changed(void) {
+    if (!hri_mclk_get_APBCMASK_TCC0_bit(MCLK) || !hri_tcc_get_CTRLA_ENABLE_bit(TCC0)) return;
+    // the prescaler is enable-protected. PER and CC survive the round trip, so the LED and buzzer only skip a beat.
+    hri_tcc_clear_CTRLA_ENABLE_bit(TCC0);
+    hri_tcc_wait_for_sync(TCC0, TCC_SYNCBUSY_ENABLE);
+    hri_tcc_write_CTRLA_PRESCALER_bf(TCC0, _watch_tcc_prescaler() >> TCC_CTRLA_PRESCALER_Pos);
+    hri_tcc_set_CTRLA_ENABLE_bit(TCC0);
+    hri_tcc_wait_for_sync(TCC0, TCC_SYNCBUSY_ENABLE);
+}
+
 void _watch_disable_tcc(void) {
+    // a sequence can't keep time without the TCC, and an LED effect has nothing left to drive.
+    watch_buzzer_abort_sequence();
+    watch_led_stop_effect();
+
     // disable all PWM pins
     gpio_set_pin_direction(BUZZER, GPIO_DIRECTION_OFF);
     gpio_set_pin_function(BUZZER, GPIO_PIN_FUNCTION_OFF);
@@ -172,6 +194,11 @@ void _watch_disable_tcc(void) {
     hri_mclk_clear_APBCMASK_TCC0_bit(MCLK);
 }
 
+// TC0 counts GCLK0 divided by 64, and overflows once a millisecond: 125 at 8 MHz, 250 while boosted to 16 MHz.
+static uint8_t _watch_usb_task_period(void) {
+    return watch_get_cpu_frequency() / 64 / 1000;
+}
+
 void _watch_enable_usb(void) {
     // disable USB, just in case.
     hri_usb_clear_CTRLA_ENABLE_bit(USB);
@@ -217,7 +244,7 @@ void _watch_enable_usb(void) {
     gpio_set_pin_function(PIN_PA25, PINMUX_PA25G_USB_DP);
 
     // before we init TinyUSB, we are going to need a periodic callback to handle TinyUSB tasks.
-    // TC2 and TC3 are reserved for devices on the 9-pin connector, so let's use TC0.
+    // TC2 is reserved for devices on the 9-pin connector, and TC3 runs the RTC timestamp counter, so let's use TC0.
     // clock TC0 with the 8 MHz clock on GCLK0.
     hri_gclk_write_PCHCTRL_reg(GCLK, TC0_GCLK_ID, GCLK_PCHCTRL_GEN_GCLK0_Val | GCLK_PCHCTRL_CHEN);
     // and enable the peripheral clock.
@@ -231,7 +258,7 @@ void _watch_enable_usb(void) {
     hri_tc_write_CTRLA_reg(TC0, TC_CTRLA_PRESCALER_DIV64 |  // divide the 8 MHz clock by 64 to count at 125 KHz
                                 TC_CTRLA_MODE_COUNT8 |      // count in 8-bit mode
                                 TC_CTRLA_RUNSTDBY);         // run in standby, just in case we figure that out
-    hri_tccount8_write_PER_reg(TC0, 125);                   // 125000 Hz / 125 = 1,000 Hz
+    hri_tccount8_write_PER_reg(TC0, _watch_usb_task_period()); // 125000 Hz / 125 = 1,000 Hz
     // set an interrupt on overflow; this will call TC0_Handler below.
     hri_tc_set_INTEN_OVF_bit(TC0);
     NVIC_ClearPendingIRQ(TC0_IRQn);
@@ -243,43 +270,116 @@ void _watch_enable_usb(void) {
     hri_tc_set_CTRLA_ENABLE_bit(TC0);
 }
 
+void _watch_usb_clock_changed(void) {
+    if (!hri_mclk_get_APBCMASK_TC0_bit(MCLK)) return;
+    // keep the USB task at 1 kHz; a count already past the new period just wraps once, which TinyUSB doesn't mind.
+    hri_tccount8_write_PER_reg(TC0, _watch_usb_task_period());
+}
+
 // this function ends up getting called by printf to log stuff to the USB console.
 int _write(int file, char *ptr, int len) {
     (void)file;
     if (hri_usbdevice_get_CTRLA_ENABLE_bit(USB)) {
-        tud_cdc_n_write(0, (void const*)ptr, len);
-        tud_cdc_n_write_flush(0);
+        // TinyUSB sends a packet whenever a full one is waiting; cdc_task flushes the remainder within a millisecond,
+        // so that a burst of small printf calls goes out in as few packets as possible.
+        int written = tud_cdc_n_write(0, (void const*)ptr, len);
+        // if a host has the port open, wait for the TX FIFO to drain instead of dropping data; bulk transfers
+        // (like a binary flash dump) can fill it faster than the 1 kHz USB task empties it. Since the USB task
+        // runs from the TC0 interrupt, this must not be called from an interrupt of equal or higher priority.
+        while (written < len && tud_cdc_n_connected(0) && !__get_IPSR()) {
+            // check with interrupts masked, so the USB task can't make room between the check and the WFI.
+            __disable_irq();
+            // IDLE mode stops the CPU but leaves TC0 and the USB peripheral running; the next packet out wakes us.
+            if (!tud_cdc_n_write_available(0)) sleep(2);
+            __enable_irq();
+            written += tud_cdc_n_write(0, (void const*)(ptr + written), len - written);
+        }
         return len;
     }
 
     return 0;
 }
 
-static char buf[256] = {0};
+// Received bytes go into a ring buffer from the USB task, and _read assembles them into lines.
+// The indices are eight bits wide, so they wrap around the 256-byte buffer on their own.
+static uint8_t usb_rx_buffer[256];
+static volatile uint8_t usb_rx_head = 0;    // written only by cdc_task
+static volatile uint8_t usb_rx_tail = 0;    // written only by _read
+static volatile uint32_t usb_task_ticks = 0;    // counts runs of the 1 kHz USB task, for timeouts
+static char usb_line[256];
+static uint16_t usb_line_length = 0;
 
 int _read(int file, char *ptr, int len) {
     (void)file;
-    int actual_length = strlen(buf);
-    if (actual_length) {
-        memcpy(ptr, buf, min(len, actual_length));
-        return actual_length;
+    while (usb_rx_tail != usb_rx_head) {
+        char c = usb_rx_buffer[usb_rx_tail];
+        usb_rx_tail = usb_rx_tail + 1;
+        // treat \r, \n and \r\n alike, and ignore the empty lines that result.
+        if (c == '\r') c = '\n';
+        if (c == '\n' && usb_line_length == 0) continue;
+        // if the line is too long, drop the excess, but always leave room for the newline.
+        if (c == '\n' || usb_line_length < sizeof(usb_line) - 1) usb_line[usb_line_length++] = c;
+        if (c == '\n') {
+            int length = min(len, usb_line_length);
+            memcpy(ptr, usb_line, length);
+            usb_line_length = 0;
+            return length;
+        }
     }
+
     return 0;
 }
 
+size_t watch_usb_read_bytes(uint8_t *buf, size_t length, uint16_t timeout_ms) {
+    size_t count = 0;
+    uint32_t start = usb_task_ticks;
+    // without USB, there's no task to time out with, and nothing to read anyway.
+    if (!hri_usbdevice_get_CTRLA_ENABLE_bit(USB)) return 0;
+    while (count < length) {
+        // check with interrupts masked, so the USB task can't fill the buffer between the check and the WFI.
+        __disable_irq();
+        if (usb_rx_tail == usb_rx_head) {
+            if (usb_task_ticks - start >= timeout_ms) {
+                __enable_irq();
+                break;
+            }
+            // IDLE mode stops the CPU but leaves TC0 running; the USB task wakes us within a millisecond.
+            sleep(2);
+            __enable_irq();
+            continue;
+        }
+        __enable_irq();
+        buf[count++] = usb_rx_buffer[usb_rx_tail];
+        usb_rx_tail = usb_rx_tail + 1;
+    }
+
+    return count;
+}
+
 void USB_Handler(void) {
     tud_int_handler(0);
 }
 
 static void cdc_task(void) {
-    if (tud_cdc_n_available(0)) {
-        tud_cdc_n_read(0, buf, sizeof(buf));
-    } else {
-        memset(buf, 0, 256);
+    uint8_t head = usb_rx_head;
+    // one slot stays empty, so that a full buffer can be told apart from an empty one.
+    uint32_t space = 255 - (uint8_t)(head - usb_rx_tail);
+
+    // anything that doesn't fit stays in TinyUSB's FIFO, and the host waits until there's room.
+    while (space && tud_cdc_n_available(0)) {
+        uint32_t count = tud_cdc_n_read(0, usb_rx_buffer + head, min(space, 256 - head));
+        if (!count) break;
+        head += count;
+        space -= count;
     }
+    usb_rx_head = head;
+
+    // send whatever printf left in the TX FIFO, now that it's had a millisecond to accumulate.
+    tud_cdc_n_write_flush(0);
 }
 
 void TC0_Handler(void) {
+    usb_task_ticks++;
     tud_task();
     cdc_task();
     TC0->COUNT8.INTFLAG.reg |= TC_INTFLAG_OVF;
@@ -41,7 +41,9 @@ static void _sync_rtc(void) {
 void _watch_rtc_init(void) {
     MCLK->APBAMASK.reg |= MCLK_APBAMASK_RTC;
 
-    if (_watch_rtc_is_enabled()) return; // don't reset the RTC if it's already set up.
+    // don't reset the RTC if it's already set up, or stop it to change anything: it would lose time. an RTC set up
+    // by older firmware won't be putting out the periodic events that pace LED effects until the time is next set.
+    if (_watch_rtc_is_enabled()) return;
 
     RTC->MODE2.CTRLA.bit.ENABLE = 0;
     _sync_rtc();
@@ -52,11 +54,24 @@ void _watch_rtc_init(void) {
     RTC->MODE2.CTRLA.bit.MODE = RTC_MODE2_CTRLA_MODE_CLOCK_Val;
     RTC->MODE2.CTRLA.bit.PRESCALER = RTC_MODE2_CTRLA_PRESCALER_DIV1024_Val;
     RTC->MODE2.CTRLA.bit.CLOCKSYNC = 1;
+    // the periodic events cost nothing until something listens for them (see watch_led.c).
+    RTC->MODE2.EVCTRL.reg = RTC_MODE2_EVCTRL_PEREO_Msk;
     RTC->MODE2.CTRLA.bit.ENABLE = 1;
     _sync_rtc();
 }
 
 void watch_rtc_set_date_time(watch_date_time date_time) {
+    if ((RTC->MODE2.EVCTRL.reg & RTC_MODE2_EVCTRL_PEREO_Msk) != RTC_MODE2_EVCTRL_PEREO_Msk) {
+        // EVCTRL can only be written with the RTC disabled. the clock is being replaced anyway, so this is the one
+        // time stopping it costs nothing; turn on the periodic events that _watch_rtc_init couldn't.
+        RTC->MODE2.CTRLA.bit.ENABLE = 0;
+        _sync_rtc();
+        RTC->MODE2.EVCTRL.reg |= RTC_MODE2_EVCTRL_PEREO_Msk;
+        RTC->MODE2.CLOCK.reg = date_time.reg;
+        RTC->MODE2.CTRLA.bit.ENABLE = 1;
+        _sync_rtc();
+        return;
+    }
     RTC->MODE2.CLOCK.reg = date_time.reg;
     _sync_rtc();
 }
@@ -124,6 +139,71 @@ void watch_rtc_disable_alarm_callback(void) {
     RTC->MODE2.INTENCLR.reg = RTC_MODE2_INTENCLR_ALARM0;
 }
 
+// the upper half of the timestamp; TC3 counts the lower half.
+static volatile uint16_t timestamp_overflows;
+
+void watch_rtc_enable_timestamp_counter(void) {
+    if (hri_mclk_get_APBCMASK_TC3_bit(MCLK) && hri_tc_get_CTRLA_ENABLE_bit(TC3)) return;
+
+    // the TC's prescaler can't divide by 32, so give it a generator of its own: GCLK4 runs from the same 32.768 kHz
+    // oscillator as GCLK3 (and keeps running in standby like it does), divided down to 1024 Hz.
+    hri_gclk_write_GENCTRL_reg(GCLK, 4, GCLK_GENCTRL_SRC(hri_gclk_read_GENCTRL_SRC_bf(GCLK, 3)) |
+                                        GCLK_GENCTRL_DIV(32) | GCLK_GENCTRL_RUNSTDBY | GCLK_GENCTRL_GENEN);
+    hri_gclk_write_PCHCTRL_reg(GCLK, TC3_GCLK_ID, GCLK_PCHCTRL_GEN_GCLK4_Val | GCLK_PCHCTRL_CHEN);
+    hri_mclk_set_APBCMASK_TC3_bit(MCLK);
+    hri_tc_clear_CTRLA_ENABLE_bit(TC3);
+    hri_tc_wait_for_sync(TC3, TC_SYNCBUSY_ENABLE);
+    hri_tc_write_CTRLA_reg(TC3, TC_CTRLA_SWRST);
+    hri_tc_wait_for_sync(TC3, TC_SYNCBUSY_SWRST);
+    hri_tc_write_CTRLA_reg(TC3, TC_CTRLA_PRESCALER_DIV1 | TC_CTRLA_MODE_COUNT16 | TC_CTRLA_RUNSTDBY);
+    hri_tc_set_INTEN_OVF_bit(TC3);
+    timestamp_overflows = 0;
+    NVIC_ClearPendingIRQ(TC3_IRQn);
+    NVIC_EnableIRQ(TC3_IRQn);
+    hri_tc_set_CTRLA_ENABLE_bit(TC3);
+    hri_tc_wait_for_sync(TC3, TC_SYNCBUSY_ENABLE);
+}
+
+void watch_rtc_disable_timestamp_counter(void) {
+    if (!hri_mclk_get_APBCMASK_TC3_bit(MCLK)) return;
+    NVIC_DisableIRQ(TC3_IRQn);
+    hri_tc_clear_CTRLA_ENABLE_bit(TC3);
+    hri_tc_wait_for_sync(TC3, TC_SYNCBUSY_ENABLE);
+    hri_mclk_clear_APBCMASK_TC3_bit(MCLK);
+    hri_gclk_write_PCHCTRL_reg(GCLK, TC3_GCLK_ID, 0);
+    hri_gclk_write_GENCTRL_reg(GCLK, 4, 0);
+}
+
+static uint16_t _watch_rtc_read_timestamp_count(void) {
+    // the count lives in the TC's clock domain; ask for a fresh copy before reading it.
+    hri_tc_set_CTRLB_reg(TC3, TC_CTRLBSET_CMD_READSYNC);
+    hri_tc_wait_for_sync(TC3, TC_SYNCBUSY_CTRLB);
+    return hri_tccount16_read_COUNT_reg(TC3);
+}
+
+uint32_t watch_rtc_get_timestamp(void) {
+    if (!hri_mclk_get_APBCMASK_TC3_bit(MCLK)) return 0;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t overflows = timestamp_overflows;
+    uint16_t count = _watch_rtc_read_timestamp_count();
+    // if we were called with interrupts masked, the count may have wrapped without TC3_Handler seeing it. we can't
+    // tell whether that happened before or after our read, so read again now that we know it has.
+    if (hri_tc_get_INTFLAG_OVF_bit(TC3)) {
+        overflows++;
+        count = _watch_rtc_read_timestamp_count();
+    }
+    __set_PRIMASK(primask);
+
+    return (overflows << 16) | count;
+}
+
+void TC3_Handler(void) {
+    hri_tc_clear_INTFLAG_OVF_bit(TC3);
+    timestamp_overflows++;
+}
+
 void RTC_Handler(void) {
     uint16_t interrupt_status = RTC->MODE2.INTFLAG.reg;
     uint16_t interrupt_enabled = RTC->MODE2.INTENSET.reg;
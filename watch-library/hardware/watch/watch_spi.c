@@ -23,15 +23,30 @@
  */
 
 #include "watch_spi.h"
+#include "hpl_sercom_config.h"
 
 struct io_descriptor *spi_io;
 
+static uint8_t _watch_spi_baud(void) {
+    // the config header works this out for a 4 MHz clock; the clock may be running faster.
+    return watch_get_cpu_frequency() / (2 * CONF_SERCOM_3_SPI_BAUD) - 1;
+}
+
 void watch_enable_spi(void) {
     SPI_0_init();
+    spi_m_sync_set_baudrate(&SPI_0, _watch_spi_baud());
     spi_m_sync_get_io_descriptor(&SPI_0, &spi_io);
     spi_m_sync_enable(&SPI_0);
 }
 
+void _watch_spi_clock_changed(void) {
+    if (spi_io == NULL) return;
+    // transfers are synchronous, so there's nothing in flight to disturb.
+    spi_m_sync_disable(&SPI_0);
+    spi_m_sync_set_baudrate(&SPI_0, _watch_spi_baud());
+    spi_m_sync_enable(&SPI_0);
+}
+
 void watch_disable_spi(void) {
     spi_m_sync_disable(&SPI_0);
     spi_io = NULL;
@@ -27,6 +27,14 @@
 
 struct usart_sync_descriptor USART_0;
 struct io_descriptor *uart_io;
+static uint32_t _uart_baud;
+
+static uint16_t _watch_uart_baud(void) {
+    // arithmetic baud generation with 16x oversampling, from whatever the main clock is running at:
+    // BAUD = 65536 * (1 - 16 * baud / f), rounded to the nearest step.
+    uint32_t frequency = watch_get_cpu_frequency();
+    return (uint16_t)(65536 - ((((uint64_t)_uart_baud << 20) + frequency / 2) / frequency));
+}
 
 void watch_enable_uart(const uint8_t tx_pin, const uint8_t rx_pin, uint32_t baud) {
     SERCOM_USART_CTRLA_Type ctrla;
@@ -93,13 +101,8 @@ void watch_enable_uart(const uint8_t tx_pin, const uint8_t rx_pin, uint32_t baud
     SERCOM3->USART.CTRLA.reg = ctrla.reg;
     SERCOM3->USART.CTRLB.reg = ctrlb.reg;
 
-    if (hri_usbdevice_get_CTRLA_ENABLE_bit(USB)) {
-        uint64_t br = 65536 - ((65536 * 16.0f * baud) / 8000000);
-        SERCOM3->USART.BAUD.reg = (uint16_t)br;
-    } else {
-        uint64_t br = 65536 - ((65536 * 16.0f * baud) / 4000000);
-        SERCOM3->USART.BAUD.reg = (uint16_t)br;
-    }
+    _uart_baud = baud;
+    SERCOM3->USART.BAUD.reg = _watch_uart_baud();
 
     SERCOM3->USART.CTRLA.reg |= SERCOM_USART_CTRLA_ENABLE;
 
@@ -116,3 +119,15 @@ char watch_uart_getc(void) {
     io_read(uart_io, &retval, 1);
     return retval;
 }
+
+void _watch_uart_clock_changed(void) {
+    // SERCOM3 also does SPI; only retime it if it's still a UART.
+    if (uart_io == NULL || !hri_mclk_get_APBCMASK_SERCOM3_bit(MCLK)) return;
+    if (SERCOM3->USART.CTRLA.bit.MODE != 1 || !SERCOM3->USART.CTRLA.bit.ENABLE) return;
+    // BAUD is enable-protected. writes wait for their last character to go out, so nothing is in flight.
+    SERCOM3->USART.CTRLA.bit.ENABLE = 0;
+    while (SERCOM3->USART.SYNCBUSY.bit.ENABLE);
+    SERCOM3->USART.BAUD.reg = _watch_uart_baud();
+    SERCOM3->USART.CTRLA.bit.ENABLE = 1;
+    while (SERCOM3->USART.SYNCBUSY.bit.ENABLE);
+}
@@ -0,0 +1,52 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _EMSCRIPTEN_H_INCLUDED
+#define _EMSCRIPTEN_H_INCLUDED
+
+// The host build compiles the simulator's sources natively (see make.mk), so they include this in place of
+// Emscripten's header. There's no page to run JavaScript on: EM_ASM blocks compile to nothing and the EM_ASM_INT and
+// EM_ASM_DOUBLE ones to zero, so anything the simulator needs from them has to come through C instead. The timers
+// are real, but they run on the host build's virtual clock (see main.c), which jumps straight from one to the next.
+
+#include <stdbool.h>
+
+#define EM_ASM(code, ...) ((void)0)
+#define EM_ASM_INT(code, ...) (0)
+#define EM_ASM_DOUBLE(code, ...) (0.0)
+#define EMSCRIPTEN_KEEPALIVE
+
+typedef int EM_BOOL;
+#define EM_TRUE 1
+#define EM_FALSE 0
+
+double emscripten_get_now(void);
+void emscripten_sleep(unsigned int ms);
+
+long emscripten_set_timeout(void (*callback)(void *user_data), double ms, void *user_data);
+void emscripten_clear_timeout(long id);
+long emscripten_set_interval(void (*callback)(void *user_data), double ms, void *user_data);
+void emscripten_clear_interval(long id);
+
+#endif
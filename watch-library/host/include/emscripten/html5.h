@@ -0,0 +1,82 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _EMSCRIPTEN_HTML5_H_INCLUDED
+#define _EMSCRIPTEN_HTML5_H_INCLUDED
+
+// Just enough of Emscripten's HTML5 API for the simulator's sources to build natively. There's no page, so nothing
+// ever calls the input callbacks; the host build presses buttons through simulate_button (see watch_main_loop.h).
+
+#include "../emscripten.h"
+
+#define EMSCRIPTEN_EVENT_KEYDOWN 2
+#define EMSCRIPTEN_EVENT_KEYUP 3
+#define EMSCRIPTEN_EVENT_MOUSEDOWN 5
+#define EMSCRIPTEN_EVENT_MOUSEUP 6
+#define EMSCRIPTEN_EVENT_MOUSEOUT 36
+#define EMSCRIPTEN_EVENT_FOCUS 13
+#define EMSCRIPTEN_EVENT_TOUCHSTART 22
+
+#define EMSCRIPTEN_EVENT_TARGET_DOCUMENT ((const char *)1)
+
+typedef struct {
+    char key[32];
+    EM_BOOL repeat;
+} EmscriptenKeyboardEvent;
+
+typedef struct {
+    unsigned short buttons;
+} EmscriptenMouseEvent;
+
+typedef struct {
+    int numTouches;
+} EmscriptenTouchEvent;
+
+typedef struct {
+    char id[128];
+} EmscriptenFocusEvent;
+
+typedef EM_BOOL (*em_key_callback_func)(int eventType, const EmscriptenKeyboardEvent *keyEvent, void *userData);
+typedef EM_BOOL (*em_mouse_callback_func)(int eventType, const EmscriptenMouseEvent *mouseEvent, void *userData);
+typedef EM_BOOL (*em_touch_callback_func)(int eventType, const EmscriptenTouchEvent *touchEvent, void *userData);
+typedef EM_BOOL (*em_focus_callback_func)(int eventType, const EmscriptenFocusEvent *focusEvent, void *userData);
+
+// setting a callback does nothing, but it still takes the callback, so the functions the simulator would have set
+// aren't unused.
+#define _EMSCRIPTEN_SET_CALLBACK(name, type) \
+    static inline int name(const char *target, void *userData, EM_BOOL useCapture, type callback) { return 0; }
+_EMSCRIPTEN_SET_CALLBACK(emscripten_set_keydown_callback, em_key_callback_func)
+_EMSCRIPTEN_SET_CALLBACK(emscripten_set_keyup_callback, em_key_callback_func)
+_EMSCRIPTEN_SET_CALLBACK(emscripten_set_focus_callback, em_focus_callback_func)
+_EMSCRIPTEN_SET_CALLBACK(emscripten_set_blur_callback, em_focus_callback_func)
+_EMSCRIPTEN_SET_CALLBACK(emscripten_set_mousedown_callback, em_mouse_callback_func)
+_EMSCRIPTEN_SET_CALLBACK(emscripten_set_mouseup_callback, em_mouse_callback_func)
+_EMSCRIPTEN_SET_CALLBACK(emscripten_set_mouseout_callback, em_mouse_callback_func)
+_EMSCRIPTEN_SET_CALLBACK(emscripten_set_touchstart_callback, em_touch_callback_func)
+_EMSCRIPTEN_SET_CALLBACK(emscripten_set_touchend_callback, em_touch_callback_func)
+
+long emscripten_request_animation_frame(EM_BOOL (*callback)(double time, void *user_data), void *user_data);
+void emscripten_cancel_animation_frame(long id);
+
+#endif
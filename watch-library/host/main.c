@@ -0,0 +1,299 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "watch.h"
+#include "watch_main_loop.h"
+#include "watch_sim_bus.h"
+#include "watch_trace.h"
+#include "watch_host.h"
+
+#include <emscripten.h>
+#include <emscripten/html5.h>
+
+// The host build: the simulator's sources, built natively, on a virtual clock. Nothing waits for real time; the
+// timers below run in the order they come due, and the clock jumps straight from one to the next, so a trace replays
+// the same way every time, on any machine, as fast as it can. The main loop is the simulator's (see
+// simulator/main.c), with animation frames every ANIMATION_FRAME_INTERVAL ms of virtual time.
+
+#define ANIMATION_FRAME_INTERVAL 16
+#define MAX_TIMERS 64
+
+#define ANIMATION_FRAME_ID_IS_VALID(id) ((id) >= 0)
+#define ANIMATION_FRAME_ID_INVALID (-1)
+#define ANIMATION_FRAME_ID_SUSPENDED (-2)
+
+typedef struct {
+    long id;            // 0 if the slot is free
+    uint32_t sequence;  // timers due at the same time run in the order they were set
+    double due;
+    double interval;    // 0 for timeouts
+    void (*callback)(void *user_data);
+    EM_BOOL (*frame_callback)(double time, void *user_data);
+    void *user_data;
+} host_timer_t;
+
+static host_timer_t timers[MAX_TIMERS];
+static long next_timer_id = 1;
+static uint32_t next_sequence;
+static double now;
+
+static bool sleeping = true;
+static bool suspended;
+static volatile long animation_frame_id = ANIMATION_FRAME_ID_INVALID;
+
+static EM_BOOL main_loop(double time, void *userData);
+
+static long _host_add_timer(double delay, double interval, void (*callback)(void *), EM_BOOL (*frame_callback)(double, void *), void *user_data) {
+    for (uint8_t i = 0; i < MAX_TIMERS; i++) {
+        if (timers[i].id) continue;
+        timers[i] = (host_timer_t) {
+            .id = next_timer_id++,
+            .sequence = next_sequence++,
+            .due = now + (delay > 0 ? delay : 0),
+            .interval = interval,
+            .callback = callback,
+            .frame_callback = frame_callback,
+            .user_data = user_data,
+        };
+        return timers[i].id;
+    }
+    fprintf(stderr, "out of timers\n");
+    abort();
+}
+
+static void _host_remove_timer(long id) {
+    for (uint8_t i = 0; i < MAX_TIMERS; i++) {
+        if (timers[i].id == id) timers[i].id = 0;
+    }
+}
+
+void watch_host_run_until(double time) {
+    while (true) {
+        host_timer_t *next = NULL;
+        for (uint8_t i = 0; i < MAX_TIMERS; i++) {
+            if (!timers[i].id || timers[i].due > time) continue;
+            if (next == NULL || timers[i].due < next->due || (timers[i].due == next->due && timers[i].sequence < next->sequence)) {
+                next = &timers[i];
+            }
+        }
+        if (next == NULL) break;
+
+        if (next->due > now) now = next->due;
+        // take the timer off the list (or put it back for later) before calling it, since the callback may well
+        // set timers of its own, or sleep, which runs this again.
+        host_timer_t timer = *next;
+        if (timer.interval > 0) {
+            next->due += timer.interval;
+            next->sequence = next_sequence++;
+        } else {
+            next->id = 0;
+        }
+        if (timer.frame_callback) timer.frame_callback(now, timer.user_data);
+        else timer.callback(timer.user_data);
+    }
+    if (time > now) now = time;
+}
+
+long watch_host_set_interval(void (*callback)(void *user_data), double delay, double interval, void *user_data) {
+    return _host_add_timer(delay, interval, callback, NULL, user_data);
+}
+
+double emscripten_get_now(void) {
+    return now;
+}
+
+void emscripten_sleep(unsigned int ms) {
+    watch_host_run_until(now + ms);
+}
+
+long emscripten_set_timeout(void (*callback)(void *user_data), double ms, void *user_data) {
+    return _host_add_timer(ms, 0, callback, NULL, user_data);
+}
+
+void emscripten_clear_timeout(long id) {
+    _host_remove_timer(id);
+}
+
+long emscripten_set_interval(void (*callback)(void *user_data), double ms, void *user_data) {
+    // a zero interval would never let the clock move on.
+    return _host_add_timer(ms, ms > 0 ? ms : 1, callback, NULL, user_data);
+}
+
+void emscripten_clear_interval(long id) {
+    _host_remove_timer(id);
+}
+
+long emscripten_request_animation_frame(EM_BOOL (*callback)(double time, void *user_data), void *user_data) {
+    return _host_add_timer(ANIMATION_FRAME_INTERVAL, 0, NULL, callback, user_data);
+}
+
+void emscripten_cancel_animation_frame(long id) {
+    _host_remove_timer(id);
+}
+
+// faces that seed rand() from time() get the simulated clock, so they roll the same way on every replay.
+time_t time(time_t *t) {
+    time_t seconds = (time_t)(watch_sim_bus_now() / 1000);
+    if (t) *t = seconds;
+    return seconds;
+}
+
+static inline void request_next_frame(void) {
+    if (animation_frame_id == ANIMATION_FRAME_ID_INVALID) {
+        animation_frame_id = emscripten_request_animation_frame(main_loop, NULL);
+    }
+}
+
+static EM_BOOL main_loop(double time, void *userData) {
+    if (main_loop_is_sleeping()) {
+        request_next_frame();
+        return EM_FALSE;
+    }
+
+    if (sleeping) {
+        sleeping = false;
+        app_wake_from_standby();
+    }
+
+    animation_frame_id = ANIMATION_FRAME_ID_INVALID;
+    bool can_sleep = app_loop();
+    commit_display_frame();
+
+    if (can_sleep) {
+        app_prepare_for_standby();
+        sleeping = true;
+        animation_frame_id = ANIMATION_FRAME_ID_INVALID;
+        return EM_FALSE;
+    }
+
+    request_next_frame();
+    return EM_FALSE;
+}
+
+void resume_main_loop(void) {
+    if (!ANIMATION_FRAME_ID_IS_VALID(animation_frame_id)) {
+        animation_frame_id = emscripten_request_animation_frame(main_loop, NULL);
+    }
+}
+
+void suspend_main_loop(void) {
+    if (ANIMATION_FRAME_ID_IS_VALID(animation_frame_id)) {
+        emscripten_cancel_animation_frame(animation_frame_id);
+    }
+
+    animation_frame_id = ANIMATION_FRAME_ID_SUSPENDED;
+}
+
+void main_loop_sleep(uint32_t ms) {
+    suspended = true;
+    emscripten_sleep(ms);
+    suspended = false;
+}
+
+bool main_loop_is_sleeping(void) {
+    return suspended;
+}
+
+static void usage(const char *name) {
+    fprintf(stderr, "usage: %s [--trace FILE] [--output FILE] [--until MS]\n", name);
+    fprintf(stderr, "  --trace FILE   replays a trace recorded in the simulator (see watch_trace.h)\n");
+    fprintf(stderr, "  --output FILE  writes what the watch does there instead of to stdout\n");
+    fprintf(stderr, "  --until MS     runs until then, in ms of virtual time; by default, until the trace ends\n");
+}
+
+static char *read_file(const char *path) {
+    FILE *file = fopen(path, "rb");
+    char *text = NULL;
+    size_t length = 0;
+    size_t read;
+
+    if (file == NULL) {
+        perror(path);
+        return NULL;
+    }
+    do {
+        text = realloc(text, length + 4096 + 1);
+        read = fread(text + length, 1, 4096, file);
+        length += read;
+    } while (read);
+    text[length] = 0;
+    fclose(file);
+
+    return text;
+}
+
+int main(int argc, char **argv) {
+    const char *trace = NULL;
+    const char *output = NULL;
+    double until = -1;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "--trace") == 0) trace = argv[++i];
+        else if (i + 1 < argc && strcmp(argv[i], "--output") == 0) output = argv[++i];
+        else if (i + 1 < argc && strcmp(argv[i], "--until") == 0) until = atof(argv[++i]);
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    FILE *file = stdout;
+    if (output && (file = fopen(output, "w")) == NULL) {
+        perror(output);
+        return 1;
+    }
+    watch_trace_set_output(file);
+
+    // the trace sets the clock before anything reads it, so the watch boots at the time it was recorded.
+    if (trace) {
+        char *text = read_file(trace);
+        if (text == NULL) return 1;
+        if (!watch_trace_replay(text)) {
+            fprintf(stderr, "%s: a trace starts with the clock\n", trace);
+            return 1;
+        }
+        free(text);
+    }
+
+    app_init();
+    _watch_init();
+    app_setup();
+    commit_display_frame();
+
+    resume_main_loop();
+    if (until >= 0) {
+        watch_host_run_until(until);
+    } else {
+        // a millisecond at a time, so the run stops with the trace's last event.
+        while (watch_trace_is_replaying()) watch_host_run_until(emscripten_get_now() + 1);
+    }
+
+    if (file != stdout) fclose(file);
+
+    return 0;
+}
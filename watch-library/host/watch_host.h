@@ -0,0 +1,40 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_HOST_H_INCLUDED
+#define _WATCH_HOST_H_INCLUDED
+
+// What the host build's own sources (main.c and watch_rtc.c) share. Everything else in the host build is the
+// simulator's, built natively against the shims in include/; that includes replaying traces (see watch_trace.h).
+
+#include <stdbool.h>
+
+/// Runs every timer that comes due on the virtual clock up to time (in ms since the program started), in order, then
+/// leaves the clock at time.
+void watch_host_run_until(double time);
+
+/// Like emscripten_set_interval, but the first call comes after delay ms instead of after one interval.
+long watch_host_set_interval(void (*callback)(void *user_data), double delay, double interval, void *user_data);
+
+#endif
@@ -0,0 +1,212 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include "watch_rtc.h"
+#include "watch_trace.h"
+#include "watch_utility.h"
+#include "watch_main_loop.h"
+#include "watch_sim_bus.h"
+#include "watch_host.h"
+
+#include <emscripten.h>
+
+// the host build's RTC. it keeps UTC, in C, where the simulator's keeps the page's local time with JavaScript's Date,
+// and runs on the virtual clock (see main.c): it read clock_base milliseconds since 1970 when the virtual clock read
+// clock_set_at. periodic callbacks and the alarm fire on the second boundaries they would on the watch.
+#define HOST_DEFAULT_CLOCK 1717236000000.0 // 2024-06-01 10:00:00
+
+static double clock_base = HOST_DEFAULT_CLOCK;
+static double clock_set_at;
+
+static long tick_callbacks[8] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+static ext_irq_cb_t tick_callback_functions[8];
+
+static long alarm_interval_id = -1;
+static watch_date_time alarm_date_time;
+static watch_rtc_alarm_match alarm_mask;
+ext_irq_cb_t alarm_callback;
+ext_irq_cb_t btn_alarm_callback;
+ext_irq_cb_t a2_callback;
+ext_irq_cb_t a4_callback;
+
+static double _watch_rtc_now(void) {
+    return clock_base + emscripten_get_now() - clock_set_at;
+}
+
+double watch_sim_bus_now(void) {
+    return _watch_rtc_now();
+}
+
+long watch_sim_call_at(double time, void (*callback)(void *user_data), void *user_data) {
+    return emscripten_set_timeout(callback, time - _watch_rtc_now(), user_data);
+}
+
+bool _watch_rtc_is_enabled(void) {
+    return true;
+}
+
+void _watch_rtc_init(void) {
+}
+
+static void _watch_rtc_set_now(double ms) {
+    clock_base = ms;
+    clock_set_at = emscripten_get_now();
+    // the hardware compares the alarm and the prescaler against the clock, so moving the clock moves them too.
+    for (int i = 0; i < 8; i++) {
+        if (tick_callbacks[i] != -1) watch_rtc_register_periodic_callback(tick_callback_functions[i], 128 >> i);
+    }
+    if (alarm_callback) watch_rtc_register_alarm_callback(alarm_callback, alarm_date_time, alarm_mask);
+}
+
+void simulate_clock(double ms) {
+    char buf[24];
+    _watch_rtc_set_now(ms);
+    sprintf(buf, "%.0f", ms);
+    watch_trace_event("clock", buf);
+    resume_main_loop();
+}
+
+void watch_rtc_set_date_time(watch_date_time date_time) {
+    _watch_rtc_set_now(watch_utility_date_time_to_unix_time(date_time, 0) * 1000.0);
+}
+
+watch_date_time watch_rtc_get_date_time(void) {
+    return watch_utility_date_time_from_unix_time((uint32_t)(_watch_rtc_now() / 1000), 0);
+}
+
+static double timestamp_start = -1;
+
+void watch_rtc_enable_timestamp_counter(void) {
+    if (timestamp_start < 0) timestamp_start = _watch_rtc_now();
+}
+
+void watch_rtc_disable_timestamp_counter(void) {
+    timestamp_start = -1;
+}
+
+uint32_t watch_rtc_get_timestamp(void) {
+    if (timestamp_start < 0) return 0;
+    return (uint64_t)((_watch_rtc_now() - timestamp_start) * WATCH_RTC_TIMESTAMP_FREQUENCY / 1000);
+}
+
+void watch_rtc_register_tick_callback(ext_irq_cb_t callback) {
+    watch_rtc_register_periodic_callback(callback, 1);
+}
+
+void watch_rtc_disable_tick_callback(void) {
+    watch_rtc_disable_periodic_callback(1);
+}
+
+static void watch_invoke_periodic_callback(void *userData) {
+    ext_irq_cb_t callback = userData;
+    callback();
+    resume_main_loop();
+}
+
+void watch_rtc_register_periodic_callback(ext_irq_cb_t callback, uint8_t frequency) {
+    // we told them, it has to be a power of 2.
+    if (__builtin_popcount(frequency) != 1) return;
+
+    // PER7 (1 Hz) through PER0 (128 Hz), as on the hardware; also an index for our list of tick callbacks.
+    uint8_t per_n = __builtin_clz(frequency << 24);
+    double interval = 1000.0 / frequency;
+    double delay = interval - fmod(_watch_rtc_now(), interval);
+
+    if (tick_callbacks[per_n] != -1) emscripten_clear_interval(tick_callbacks[per_n]);
+    tick_callbacks[per_n] = watch_host_set_interval(watch_invoke_periodic_callback, delay, interval, (void *)callback);
+    tick_callback_functions[per_n] = callback;
+}
+
+void watch_rtc_disable_periodic_callback(uint8_t frequency) {
+    if (__builtin_popcount(frequency) != 1) return;
+    uint8_t per_n = __builtin_clz(frequency << 24);
+    if (tick_callbacks[per_n] != -1) {
+        emscripten_clear_interval(tick_callbacks[per_n]);
+        tick_callbacks[per_n] = -1;
+    }
+}
+
+void watch_rtc_disable_matching_periodic_callbacks(uint8_t mask) {
+    for (int i = 0; i < 8; i++) {
+        if (tick_callbacks[i] != -1 && (mask & (1 << (7 - i))) != 0) {
+            emscripten_clear_interval(tick_callbacks[i]);
+            tick_callbacks[i] = -1;
+        }
+    }
+}
+
+void watch_rtc_disable_all_periodic_callbacks(void) {
+    watch_rtc_disable_matching_periodic_callbacks(0xFF);
+}
+
+static void watch_invoke_alarm_callback(void *userData) {
+    if (alarm_callback) alarm_callback();
+}
+
+void watch_rtc_register_alarm_callback(ext_irq_cb_t callback, watch_date_time alarm_time, watch_rtc_alarm_match mask) {
+    uint32_t period;
+    uint32_t offset;
+
+    watch_rtc_disable_alarm_callback();
+
+    // the alarm matches once a period, offset into it by the fields it compares. the clock is UTC, so days start on
+    // multiples of 86400 seconds.
+    switch (mask) {
+        case ALARM_MATCH_SS:
+            period = 60;
+            offset = alarm_time.unit.second;
+            break;
+        case ALARM_MATCH_MMSS:
+            period = 60 * 60;
+            offset = alarm_time.unit.minute * 60 + alarm_time.unit.second;
+            break;
+        case ALARM_MATCH_HHMMSS:
+            period = 24 * 60 * 60;
+            offset = alarm_time.unit.hour * 3600 + alarm_time.unit.minute * 60 + alarm_time.unit.second;
+            break;
+        default:
+            return;
+    }
+
+    double now = _watch_rtc_now();
+    uint64_t seconds = (uint64_t)(now / 1000);
+    double next = (double)(seconds - seconds % period + offset) * 1000;
+    if (next <= now) next += period * 1000.0;
+
+    alarm_date_time = alarm_time;
+    alarm_mask = mask;
+    alarm_callback = callback;
+    alarm_interval_id = watch_host_set_interval(watch_invoke_alarm_callback, next - now, period * 1000.0, NULL);
+}
+
+void watch_rtc_disable_alarm_callback(void) {
+    alarm_callback = NULL;
+
+    if (alarm_interval_id != -1) {
+        emscripten_clear_interval(alarm_interval_id);
+        alarm_interval_id = -1;
+    }
+}
@@ -29,10 +29,23 @@ bool lis2dw_begin(void) {
     if (lis2dw_get_device_id() != LIS2DW_WHO_AM_I_VAL) {
         return false;
     }
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL2, LIS2DW_CTRL2_VAL_BOOT);
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL2, LIS2DW_CTRL2_VAL_SOFT_RESET);
-    // Enable block data update (output registers not updated until MSB and LSB have been read) and address autoincrement
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL2, LIS2DW_CTRL2_VAL_BDU | LIS2DW_CTRL2_VAL_IF_ADD_INC);
+    // Boot, soft reset, then enable block data update (output registers not updated until MSB and LSB have been read)
+    // and address autoincrement. These are queued back to back, and we sleep until the bus has clocked them all out.
+    static uint8_t commands[3][2] = {
+        {LIS2DW_REG_CTRL2, LIS2DW_CTRL2_VAL_BOOT},
+        {LIS2DW_REG_CTRL2, LIS2DW_CTRL2_VAL_SOFT_RESET},
+        {LIS2DW_REG_CTRL2, LIS2DW_CTRL2_VAL_BDU | LIS2DW_CTRL2_VAL_IF_ADD_INC},
+    };
+    static watch_i2c_transfer_t transfers[3];
+    for(uint8_t i = 0; i < 3; i++) {
+        transfers[i] = (watch_i2c_transfer_t) {
+            .addr = LIS2DW_ADDRESS,
+            .tx_buffer = commands[i],
+            .tx_length = 2,
+        };
+        watch_i2c_transfer_async(&transfers[i]);
+    }
+    watch_i2c_wait_for_idle();
 
     // Parameters at startup: 
     //  * Data rate 0 (powered down)
@@ -190,6 +203,10 @@ inline void lis2dw_enable_fifo(void) {
     watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_CTRL, LIS2DW_FIFO_CTRL_MODE_COLLECT_AND_STOP | LIS2DW_FIFO_CTRL_FTH);
 }
 
+void lis2dw_set_fifo_mode(lis2dw_fifo_mode_t mode) {
+    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_CTRL, (mode << 5) | LIS2DW_FIFO_CTRL_FTH);
+}
+
 bool lis2dw_read_fifo(lis2dw_fifo_t *fifo_data) {
     uint8_t temp = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_SAMPLE);
     bool overrun = !!(temp & LIS2DW_FIFO_SAMPLE_OVERRUN);
@@ -203,6 +220,80 @@ bool lis2dw_read_fifo(lis2dw_fifo_t *fifo_data) {
     return overrun;
 }
 
+// the samples are read straight into the readings, which works because both the sensor and our cores are little-endian.
+_Static_assert(sizeof(lis2dw_reading_t) == 6, "lis2dw_reading_t must match the layout of OUT_X_L through OUT_Z_H");
+
+static struct {
+    watch_i2c_transfer_t count_transfer;
+    watch_i2c_transfer_t data_transfer;
+    uint8_t count_register;
+    uint8_t data_register;
+    uint8_t fifo_samples;
+    lis2dw_fifo_t *fifo_data;   // NULL when no read is in progress
+    lis2dw_fifo_cb_t callback;
+    void *context;
+} lis2dw_fifo_read;
+
+static void _lis2dw_finish_fifo_read(bool success) {
+    lis2dw_fifo_t *fifo_data = lis2dw_fifo_read.fifo_data;
+
+    if (!success) fifo_data->count = 0;
+    lis2dw_fifo_read.fifo_data = NULL;
+    lis2dw_fifo_read.callback(fifo_data, success, lis2dw_fifo_read.context);
+}
+
+static void _lis2dw_fifo_data_done(watch_i2c_transfer_t *transfer) {
+    _lis2dw_finish_fifo_read(transfer->status == WATCH_I2C_TRANSFER_DONE);
+}
+
+static void _lis2dw_fifo_count_done(watch_i2c_transfer_t *transfer) {
+    lis2dw_fifo_t *fifo_data = lis2dw_fifo_read.fifo_data;
+
+    if (transfer->status != WATCH_I2C_TRANSFER_DONE) {
+        _lis2dw_finish_fifo_read(false);
+        return;
+    }
+    fifo_data->count = lis2dw_fifo_read.fifo_samples & LIS2DW_FIFO_SAMPLE_COUNT;
+    if (fifo_data->count == 0) {
+        _lis2dw_finish_fifo_read(true);
+        return;
+    }
+    // with the FIFO on, reading past OUT_Z_H wraps back to OUT_X_L and the next sample, so one burst gets them all.
+    lis2dw_fifo_read.data_register = LIS2DW_REG_OUT_X_L | 0x80;
+    lis2dw_fifo_read.data_transfer = (watch_i2c_transfer_t) {
+        .addr = LIS2DW_ADDRESS,
+        .tx_buffer = &lis2dw_fifo_read.data_register,
+        .tx_length = 1,
+        .rx_buffer = (uint8_t *)fifo_data->readings,
+        .rx_length = fifo_data->count * sizeof(lis2dw_reading_t),
+        .callback = _lis2dw_fifo_data_done,
+    };
+    if (!watch_i2c_transfer_async(&lis2dw_fifo_read.data_transfer)) _lis2dw_finish_fifo_read(false);
+}
+
+bool lis2dw_read_fifo_async(lis2dw_fifo_t *fifo_data, lis2dw_fifo_cb_t callback, void *context) {
+    if (lis2dw_fifo_read.fifo_data != NULL) return false;
+
+    lis2dw_fifo_read.fifo_data = fifo_data;
+    lis2dw_fifo_read.callback = callback;
+    lis2dw_fifo_read.context = context;
+    lis2dw_fifo_read.count_register = LIS2DW_REG_FIFO_SAMPLE;
+    lis2dw_fifo_read.count_transfer = (watch_i2c_transfer_t) {
+        .addr = LIS2DW_ADDRESS,
+        .tx_buffer = &lis2dw_fifo_read.count_register,
+        .tx_length = 1,
+        .rx_buffer = &lis2dw_fifo_read.fifo_samples,
+        .rx_length = 1,
+        .callback = _lis2dw_fifo_count_done,
+    };
+    if (!watch_i2c_transfer_async(&lis2dw_fifo_read.count_transfer)) {
+        lis2dw_fifo_read.fifo_data = NULL;
+        return false;
+    }
+
+    return true;
+}
+
 void lis2dw_clear_fifo(void) {
     watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_CTRL, LIS2DW_FIFO_CTRL_MODE_OFF);
     watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_CTRL, LIS2DW_FIFO_CTRL_MODE_COLLECT_AND_STOP | LIS2DW_FIFO_CTRL_FTH);
@@ -233,6 +324,11 @@ lis2dw_wakeup_source lis2dw_get_wakeup_source() {
     return (lis2dw_wakeup_source) watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_WAKE_UP_SRC);
 }
 
+void lis2dw_disable_wakeup_int1(void) {
+    uint8_t configuration = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL4_INT1);
+    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL4_INT1, configuration & ~LIS2DW_CTRL4_INT1_WU);
+}
+
 lis2dw_interrupt_source lis2dw_get_interrupt_source(void) {
     return (lis2dw_interrupt_source) watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_ALL_INT_SRC);
 }
@@ -331,12 +331,23 @@ void lis2dw_disable_fifo(void);
 
 void lis2dw_enable_fifo(void);
 
+void lis2dw_set_fifo_mode(lis2dw_fifo_mode_t mode);
+
 bool lis2dw_read_fifo(lis2dw_fifo_t *fifo_data);
 
+/// Called from the I2C interrupt when an asynchronous FIFO read finishes. On failure, fifo_data->count is zero.
+typedef void (*lis2dw_fifo_cb_t)(lis2dw_fifo_t *fifo_data, bool success, void *context);
+
+/// Reads the FIFO in two I2C transfers, its sample count and then every sample in one burst, and returns without
+/// waiting for them. Returns false if a read is already in progress. fifo_data must stay valid until the callback.
+bool lis2dw_read_fifo_async(lis2dw_fifo_t *fifo_data, lis2dw_fifo_cb_t callback, void *context);
+
 void lis2dw_clear_fifo(void);
 
 void lis2dw_configure_wakeup_int1(uint8_t threshold, bool latch, bool active_state);
 
+void lis2dw_disable_wakeup_int1(void);
+
 lis2dw_interrupt_source lis2dw_get_interrupt_source(void);
 
 lis2dw_wakeup_source lis2dw_get_wakeup_source(void);
@@ -49,8 +49,14 @@ void thermistor_driver_disable(void) {
 float thermistor_driver_get_temperature(void) {
     // set the enable pin to the level that powers the thermistor circuit.
     watch_set_pin_level(THERMISTOR_ENABLE_PIN, THERMISTOR_ENABLE_VALUE);
-    // get the sense pin level
-    uint16_t value = watch_get_analog_pin_level(THERMISTOR_SENSE_PIN);
+    // get the sense pin level, sleeping while the ADC works.
+    watch_adc_read_t read = {
+        .pin = THERMISTOR_SENSE_PIN,
+        .samples = 16,
+        .sampling_length = 1,
+    };
+    watch_adc_read(&read, 1);
+    uint16_t value = read.result;
     // and then set the enable pin to the opposite value to power down the thermistor circuit.
     watch_set_pin_level(THERMISTOR_ENABLE_PIN, !THERMISTOR_ENABLE_VALUE);
 
@@ -25,6 +25,7 @@
 
 #ifndef WATCH_H_
 #define WATCH_H_
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include "driver_init.h"
@@ -80,16 +81,62 @@ bool watch_is_buzzer_or_led_enabled(void);
   */
 bool watch_is_usb_enabled(void);
 
+/** @brief Enables or disables the voltage regulator's low power efficiency mode (SUPC->VREG.LPEFF).
+  * @details The regulator draws less in standby with this set, but it only works with a supply above 2.5 volts.
+  *          _watch_init sets it at boot if the battery is above 2.7 volts, and the brownout detector clears it if
+  *          the battery dips below 2.6 volts; enabling it here also re-arms that brownout interrupt.
+  * @param enabled true to set LPEFF, false to clear it.
+  */
+void watch_set_low_power_efficiency(bool enabled);
+
+/** @brief Returns true if the voltage regulator's low power efficiency mode is set.
+  */
+bool watch_get_low_power_efficiency(void);
+
+/** @brief Runs the main clock at 16 MHz for a burst of heavy computation, like the astronomy faces' soft-float math.
+  * @details The watch normally runs at 4 MHz (8 MHz with USB). At four times the clock, a long calculation draws more
+  *          current but finishes so much sooner that it costs less charge overall, and the watch gets back to sleep
+  *          sooner. The buzzer, LED, ADC, I2C, SPI, UART and USB task timer are retimed on the way up and back down,
+  *          so notes, brightness, conversions, baud rates and USB polling don't change, and delay_ms and delay_us
+  *          count cycles for whatever speed the clock is running at. Boosts nest: the clock only comes back down once
+  *          every call here has been matched by a call to watch_performance_restore.
+  * @note Don't sleep while boosted; restore first.
+  */
+void watch_performance_boost(void);
+
+/** @brief Undoes one call to watch_performance_boost, returning the main clock to its usual speed after the last.
+  */
+void watch_performance_restore(void);
+
+/** @brief Returns the frequency of the main clock, which runs the CPU and most peripherals, in hertz.
+  */
+uint32_t watch_get_cpu_frequency(void);
+
 /** @brief Resets in the UF2 bootloader mode
   */
 void watch_reset_to_bootloader(void);
 
-/** @brief Reads up to len bytes from the USB serial.
+/** @brief Reads a line from the USB serial.
+  * @details Incoming bytes are buffered in the background, and this function only returns data once a full
+  *          line has arrived, so it's cheap to call on every pass through your app_loop. Lines may end in
+  *          \n, \r or \r\n; the line you receive always ends in a single \n, and is not null terminated.
   * @param file ignored, you can pass in 0
   * @param ptr pointer to a buffer of at least len bytes
-  * @param len the number of bytes you wish to read, max 256.
-  * @return The number of bytes read, or zero if no bytes were read.
+  * @param len the size of your buffer. Lines longer than this (or than 255 bytes) are truncated.
+  * @return The number of bytes read, or zero if no complete line is available yet.
   */
 int read(int file, char *ptr, int len);
 
+/** @brief Reads raw bytes from the USB serial, for binary protocols.
+  * @details This bypasses the line assembly that read does, but shares its buffer, so don't mix the two in the
+  *          middle of a line. Bytes are returned exactly as the host sent them.
+  * @param buf pointer to a buffer of at least length bytes
+  * @param length the number of bytes you wish to read
+  * @param timeout_ms the total time, in milliseconds, to wait for bytes to arrive
+  * @return The number of bytes read; less than length if the timeout expired.
+  * @note The CPU sleeps in IDLE while it waits, and the 1 kHz USB task wakes it; so this must not be called from
+  *       an interrupt of equal or higher priority than the USB task's TC0.
+  */
+size_t watch_usb_read_bytes(uint8_t *buf, size_t length, uint16_t timeout_ms);
+
 #endif /* WATCH_H_ */
\ No newline at end of file
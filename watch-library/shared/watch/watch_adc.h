@@ -35,6 +35,8 @@
 /// @{
 /** @brief Enables the ADC peripheral. You must call this before attempting to read a value
   *        from an analog pin.
+  * @details The first call after a reset calibrates the ADC, which takes a while; after that,
+  *          enabling and disabling it is cheap, so it's fine to turn it on only for each reading.
   */
 void watch_enable_adc(void);
 
@@ -146,12 +148,57 @@ uint16_t watch_get_vcc_voltage(void);
   */
 void watch_disable_analog_input(const uint8_t pin);
 
-/** @brief Disables the ADC peripheral.
+/** @brief Disables the ADC peripheral, after any reads in progress have finished.
   * @note You will need to call watch_enable_adc to re-enable the ADC peripheral. When you do, it will
-  *       have the default settings of 16 samples and 1 measurement cycle; if you customized these
-  *       parameters, you will need to set them up again.
+  *       have the default settings of 16 samples, 1 measurement cycle and the VCC reference; if you
+  *       customized these parameters, you will need to set them up again.
   **/
 void watch_disable_adc(void);
 
+/// Pass this as the pin of a watch_adc_read_t to measure the supply voltage.
+#define WATCH_ADC_VCC 0xFF
+
+/** @brief One measurement in a sequence of ADC reads.
+  * @details The settings apply to this read only; the ones set with watch_set_analog_num_samples and
+  *          watch_set_analog_sampling_length are left alone. Pins are measured against the reference
+  *          set with watch_set_analog_reference_voltage; WATCH_ADC_VCC always uses the internal one.
+  */
+typedef struct {
+    uint8_t pin;                ///< One of pins A0-A4, which must be set up with watch_enable_analog_input, or WATCH_ADC_VCC.
+    uint16_t samples;           ///< The number of samples to average: a power of 2 up to 1024, or 0 for the default of 16.
+    uint8_t sampling_length;    ///< ADC cycles to sample for, from 1 to 64, or 0 for the default of 1.
+    uint16_t result;            ///< Filled in when the read is done: for pins, the level scaled to 16 bits (0-65535)
+                                ///< whatever the number of samples; for WATCH_ADC_VCC, millivolts.
+} watch_adc_read_t;
+
+/// Completion callback for watch_adc_read_async. Called from the ADC interrupt; keep it short.
+typedef void (*watch_adc_callback_t)(watch_adc_read_t *reads, uint8_t count, void *context);
+
+/** @brief Starts a sequence of reads in one burst and returns immediately.
+  * @details Each conversion is started from the ADC interrupt when the last one finishes, so the CPU
+  *          can sleep in the meantime. The caller owns the reads, and must keep them around until the
+  *          callback runs or watch_adc_is_busy returns false. The ADC must be enabled.
+  * @param reads The measurements to take, in order.
+  * @param count The number of reads.
+  * @param callback Optional; called once all of the reads are done.
+  * @param context Passed to the callback.
+  * @return true if the reads were started; false if a sequence is already running or count is 0.
+  */
+bool watch_adc_read_async(watch_adc_read_t *reads, uint8_t count, watch_adc_callback_t callback, void *context);
+
+/** @brief Takes a sequence of reads, idling the CPU until they're done.
+  * @param reads The measurements to take, in order. Their results are filled in on return.
+  * @param count The number of reads.
+  */
+void watch_adc_read(watch_adc_read_t *reads, uint8_t count);
+
+/** @brief Returns true if a sequence of reads is in progress.
+  */
+bool watch_adc_is_busy(void);
+
+/** @brief Waits for a sequence of reads to finish, idling the CPU between conversions.
+  */
+void watch_adc_wait_for_idle(void);
+
 /// @}
 #endif
@@ -153,12 +153,93 @@ typedef enum BuzzerNote {
   * @param note The note you wish to play, or BUZZER_NOTE_REST to disable output for the given duration.
   * @param duration_ms The duration of the note.
   * @note Note that this will block your UI for the duration of the note's play time, and it will
-  *       after this call, the buzzer period will be set to the period of this note.
+  *       after this call, the buzzer period will be set to the period of this note. To play notes
+  *       without blocking, see watch_buzzer_play_sequence.
   */
 void watch_buzzer_play_note(BuzzerNote note, uint16_t duration_ms);
 
+/// @brief One step of a sequence for watch_buzzer_play_sequence: a note (or BUZZER_NOTE_REST) and how long to hold it.
+typedef struct {
+    BuzzerNote note;
+    uint16_t duration_ms;
+} watch_buzzer_step_t;
+
+/** @brief Plays a sequence of notes in the background, and returns immediately.
+  * @param sequence The notes to play. This array is read as it plays, so it must outlive the sequence; make it
+  *                 static const.
+  * @param length The number of steps in the sequence.
+  * @param loops How many times to play the sequence through; 0 is treated as 1.
+  * @param callback An optional function to call once the sequence has finished playing (but not if it is
+  *                 stopped early). On hardware it is called from an interrupt, so keep it short.
+  * @note The sequence is timed by the buzzer's own TCC interrupts. The TCC does not run in standby, so while a
+  *       sequence plays, the main loop idles the CPU instead of entering standby; it still sleeps between
+  *       interrupts. Starting a new sequence, or calling watch_buzzer_play_note, stops the one already playing.
+  *       The buzzer must be enabled with watch_enable_buzzer first; if it isn't, this does nothing. The LED shares
+  *       the TCC's period, so an LED effect in progress stops where it is (see watch_led_fade_to).
+  */
+void watch_buzzer_play_sequence(const watch_buzzer_step_t *sequence, uint8_t length, uint8_t loops, ext_irq_cb_t callback);
+
+/** @brief Plays a melody in the compact format below in the background, and returns immediately.
+  * @details A melody is a byte string. The first byte is the length of a 32nd note in milliseconds (60000 / BPM / 8);
+  *          the rest are commands, each one byte, with the command in the high nibble and its argument in the low:
+  *          - 0x0n-0xBn: a note, C through B in the current octave, lasting duration code n (see below).
+  *          - 0xCn: a rest lasting duration code n.
+  *          - 0xDn: sets the octave to n; it starts out at 4 (so A is A4, 440 Hz). Notes outside A1-B8 are rests.
+  *          - 0xE0: marks the start of a repeated passage.
+  *          - 0xEn: jumps back to the mark n more times (one level only; no nesting).
+  *          - 0xFF: the end of the melody.
+  *          Duration codes 0-15 stand for 1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64, 96, 128, 192 and 256 32nd notes,
+  *          so a quarter note is code 5 and a dotted quarter code 6. The BUZZER_MELODY_ macros below spell these out,
+  *          and utils/rtttl_to_melody.py compiles RTTTL ringtones into this format.
+  * @param melody The melody. It is read as it plays, so it must outlive the melody; make it static const.
+  * @param loops How many times to play the melody through; 0 is treated as 1.
+  * @param callback An optional function to call once the melody has finished playing, as for
+  *                 watch_buzzer_play_sequence.
+  * @note This shares its player with watch_buzzer_play_sequence: starting either one stops the other, and
+  *       watch_buzzer_abort_sequence and watch_buzzer_is_playing apply to both.
+  */
+void watch_buzzer_play_melody(const uint8_t *melody, uint8_t loops, ext_irq_cb_t callback);
+
+#define BUZZER_MELODY_NOTE(pitch, duration) ((uint8_t)(((pitch) << 4) | (duration))) ///< pitch 0 (C) to 11 (B)
+#define BUZZER_MELODY_REST(duration) ((uint8_t)(0xC0 | (duration)))
+#define BUZZER_MELODY_OCTAVE(octave) ((uint8_t)(0xD0 | (octave)))
+#define BUZZER_MELODY_REPEAT_START 0xE0
+#define BUZZER_MELODY_REPEAT(times) ((uint8_t)(0xE0 | (times)))  ///< times: 1 to 15 more times
+#define BUZZER_MELODY_END 0xFF
+
+/** @brief Stops the sequence started by watch_buzzer_play_sequence, if any, and silences the buzzer.
+  */
+void watch_buzzer_abort_sequence(void);
+
+/** @brief Checks whether a sequence started by watch_buzzer_play_sequence is still playing.
+  */
+bool watch_buzzer_is_playing(void);
+
 /// @brief An array of periods for all the notes on a piano, corresponding to the names in BuzzerNote.
 extern const uint16_t NotePeriods[108];
 
+/// Where a background buzzer sequence or melody is up to. Shared by the hardware and simulator buzzer drivers.
+typedef struct {
+    const watch_buzzer_step_t *sequence;    // the steps being played, or NULL if playing a melody
+    const uint8_t *melody;                  // the melody being played, or NULL if playing a sequence
+    uint16_t position;
+    uint8_t length;
+    uint8_t loops_remaining;
+    uint8_t octave;
+    uint8_t repeats_remaining;
+    bool repeating;
+    uint16_t repeat_start;
+} watch_buzzer_cursor_t;
+
+/// Starts a cursor at the beginning of a sequence (with its length) or a melody (length is ignored).
+void _watch_buzzer_cursor_init(watch_buzzer_cursor_t *cursor, const watch_buzzer_step_t *sequence, const uint8_t *melody, uint8_t length, uint8_t loops);
+
+/// Gets the next step to play, decoding the melody format described in watch_buzzer.h. Returns false at the end.
+bool _watch_buzzer_cursor_next(watch_buzzer_cursor_t *cursor, watch_buzzer_step_t *step);
+
+/// Converts a step's length to ticks of the hardware's step timer, which counts the main clock divided by 1024. A
+/// step is always at least one tick.
+uint32_t _watch_buzzer_step_ticks(uint16_t duration_ms, uint32_t cpu_frequency);
+
 /// @}
 #endif
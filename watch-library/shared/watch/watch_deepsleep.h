@@ -93,6 +93,18 @@ void watch_register_extwake_callback(uint8_t pin, ext_irq_cb_t callback, bool le
   */
 void watch_disable_extwake_interrupt(uint8_t pin);
 
+/** @brief Keeps an external interrupt on one of the nine-pin connector's pins armed through Sleep Mode, so that a
+  *        sensor can wake the watch from it the way the extwake pins do.
+  * @details watch_enter_sleep_mode normally turns the EIC off with every other peripheral. A pin kept here stays an
+  *          input, and the EIC stays on with only the kept pins' interrupts enabled; it runs from the 32.768 kHz
+  *          crystal, so it works in STANDBY. Register the interrupt with watch_register_interrupt_callback first. The
+  *          callback runs as usual when it wakes the watch; app_setup then resets the EIC, so register it again there.
+  *          This does nothing for Deep Sleep or BACKUP mode.
+  * @param pin One of A0, A1, A2, A3 or A4.
+  * @param keep true to keep this pin's interrupt armed in Sleep Mode, false to turn it off with the rest again.
+  */
+void watch_set_sleep_mode_wake_pin(uint8_t pin, bool keep);
+
 /** @brief Stores data in one of the RTC's backup registers, which retain their data in BACKUP mode.
   * @param data An unsigned 32 bit integer with the data you wish to store.
   * @param reg A register from 0-7.
@@ -102,5 +102,57 @@ uint32_t watch_i2c_read24(int16_t addr, uint8_t reg);
           bit packing, you may need to shuffle some bits around.
   */
 uint32_t watch_i2c_read32(int16_t addr, uint8_t reg);
+
+typedef enum {
+    WATCH_I2C_TRANSFER_IDLE = 0,    ///< The transfer has not been queued yet.
+    WATCH_I2C_TRANSFER_PENDING,     ///< The transfer is waiting in the queue or is on the bus.
+    WATCH_I2C_TRANSFER_DONE,        ///< The transfer completed successfully.
+    WATCH_I2C_TRANSFER_FAILED,      ///< The device NACKed, or a bus error or arbitration loss occurred.
+} watch_i2c_transfer_status_t;
+
+struct watch_i2c_transfer;
+
+/// Completion callback for an asynchronous transfer. Called from the SERCOM interrupt; keep it short.
+typedef void (*watch_i2c_transfer_cb_t)(struct watch_i2c_transfer *transfer);
+
+/** @brief Describes a single asynchronous I2C transaction: an optional write phase followed by an optional read phase.
+  * @details If both tx_length and rx_length are nonzero, the read phase begins with a repeated start, which is what
+  *          most register-based devices expect. The caller owns this struct and both buffers, and must keep them
+  *          alive until the transfer's status is no longer WATCH_I2C_TRANSFER_PENDING.
+  */
+typedef struct watch_i2c_transfer {
+    int16_t addr;                       ///< The 7-bit address of the device.
+    uint8_t *tx_buffer;                 ///< Bytes to write, or NULL if tx_length is 0.
+    uint16_t tx_length;                 ///< Number of bytes to write.
+    uint8_t *rx_buffer;                 ///< Storage for bytes read, or NULL if rx_length is 0.
+    uint16_t rx_length;                 ///< Number of bytes to read.
+    watch_i2c_transfer_cb_t callback;   ///< Optional; called when the transfer completes or fails.
+    void *context;                      ///< Not touched by the driver; for use by the callback.
+    volatile watch_i2c_transfer_status_t status;
+    struct watch_i2c_transfer *next;    ///< Private; used to link the queue of pending transfers.
+} watch_i2c_transfer_t;
+
+/** @brief Queues a transfer on the I2C bus and returns immediately.
+  * @details Transfers are run in the order they were queued, driven entirely by the SERCOM interrupt, so the CPU
+  *          can sleep while the bus is busy. The blocking functions above wait for the queue to drain before they
+  *          touch the bus, so it is safe to mix the two styles.
+  * @param transfer The transaction to perform. Must not already be pending.
+  * @return true if the transfer was queued; false if it was already pending or has nothing to do.
+  */
+bool watch_i2c_transfer_async(watch_i2c_transfer_t *transfer);
+
+/** @brief Returns true if any asynchronous transfers are queued or in progress.
+  */
+bool watch_i2c_is_busy(void);
+
+/** @brief Waits for all queued asynchronous transfers to complete, idling the CPU between bus interrupts.
+  */
+void watch_i2c_wait_for_idle(void);
+
+/** @brief Returns the number of I2C transactions started since boot, blocking and asynchronous alike.
+  * @details Every start condition counts, so a register read (a write of the address, then a repeated start to read
+  *          it) counts as two. Take the difference of two calls to see what a piece of code costs on the bus.
+  */
+uint32_t watch_i2c_get_transaction_count(void);
 /// @}
 #endif
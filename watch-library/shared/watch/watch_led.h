@@ -84,5 +84,69 @@ void watch_set_led_yellow(void);
 /** @brief Turns both the red and the green LEDs off. */
 void watch_set_led_off(void);
 
+/** @brief Fades the LED from its current color to a new one.
+  * @details Effects play in the background: on the watch, the DMA controller feeds a table of duty cycles to the
+  *          LED's PWM outputs in step with one of the RTC's periodic events, so once an effect has started, the CPU
+  *          is not woken again until it ends. Setting a color, starting another effect or disabling the LEDs stops
+  *          the effect in progress. Fades run in up to 64 steps, at anywhere from 128 steps a second (for short
+  *          fades) down to one a second.
+  * @param red The red value from 0-255 to end on.
+  * @param green The green value from 0-255 to end on.
+  * @param duration_ms How long the fade should take, in milliseconds.
+  * @note Like a custom color, an effect needs the TCC running, so the watch can't enter STANDBY while one is
+  *       running; the main loop idles instead (see watch_led_effect_is_running).
+  * @note Effects are paced by the RTC's periodic events, which firmware older than this didn't turn on. An RTC that
+  *       has kept running since then gets them the next time the time is set; until that happens, fades and breaths
+  *       go straight to their color and watch_led_off_after is timed by the CPU.
+  * @note The buzzer shares the TCC's period, and changes it with every note. While a buzzer sequence or melody plays,
+  *       effects behave as they do without the RTC's events, and starting a sequence stops the effect in progress
+  *       where it is (a watch_led_off_after carries on, timed by the CPU). The LED keeps its brightness throughout.
+  */
+void watch_led_fade_to(uint8_t red, uint8_t green, uint16_t duration_ms);
+
+/** @brief Makes the LED breathe: fade up to a color and back down to off, over and over until stopped.
+  * @param red The red value from 0-255 at the top of each breath.
+  * @param green The green value from 0-255 at the top of each breath.
+  * @param period_ms The length of one breath, in milliseconds.
+  */
+void watch_led_breathe(uint8_t red, uint8_t green, uint16_t period_ms);
+
+/** @brief Holds the LED at its current color, then turns it off, without any further work from the CPU.
+  * @details The hold is timed in 64ths of a second for up to about 17 minutes, and in coarser steps beyond that, up
+  *          to about 18 hours. To stay lit indefinitely, use watch_led_hold instead.
+  * @param duration_ms How long to keep the LED on, in milliseconds.
+  */
+void watch_led_off_after(uint32_t duration_ms);
+
+/** @brief Keeps the LED at its current color until you set another color, start an effect or call
+  *        watch_led_stop_effect. Movement uses this while the LIGHT button is held down.
+  * @note Like any effect, a hold keeps the watch out of STANDBY for as long as it lasts.
+  */
+void watch_led_hold(void);
+
+/** @brief Stops the effect in progress, if any, leaving the LED at whatever color it had reached. */
+void watch_led_stop_effect(void);
+
+/** @brief Returns true if an LED effect is running in the background. */
+bool watch_led_effect_is_running(void);
+
+/// @brief The longest table of steps an LED effect can play.
+#define WATCH_LED_EFFECT_MAX_STEPS 64
+
+/// @brief The steps of an LED effect, as built by the shared effect code for each platform to play.
+typedef struct {
+    uint8_t red[WATCH_LED_EFFECT_MAX_STEPS];
+    uint8_t green[WATCH_LED_EFFECT_MAX_STEPS];
+    uint8_t length;     ///< number of steps in the table.
+    uint8_t rate_shift; ///< the effect steps at 128 >> rate_shift Hz, i.e. on the RTC's PER<rate_shift> event.
+    bool loops;         ///< true if the effect starts over when it reaches the end of the table.
+} watch_led_effect_t;
+
+/// Builds a fade from one color to another. You should not call this from your app.
+void _watch_led_effect_fade(watch_led_effect_t *effect, uint8_t from_red, uint8_t from_green, uint8_t to_red, uint8_t to_green, uint16_t duration_ms);
+
+/// Builds one breath, from off up to the given color and back down. You should not call this from your app.
+void _watch_led_effect_breathe(watch_led_effect_t *effect, uint8_t red, uint8_t green, uint16_t period_ms);
+
 /// @}
 #endif
@@ -41,6 +41,22 @@ void _watch_disable_tcc(void);
 /// Called by main.c if plugged in to USB. You should not call this from your app.
 void _watch_enable_usb(void);
 
+/// Called by watch_performance_boost and watch_performance_restore after the main clock changes speed, to retime the
+/// peripherals that run from it. You should not call these from your app.
+void _watch_tcc_clock_changed(void);
+void _watch_buzzer_clock_changed(uint32_t old_frequency);
+void _watch_adc_clock_changed(void);
+void _watch_i2c_clock_changed(void);
+void _watch_spi_clock_changed(void);
+void _watch_uart_clock_changed(void);
+void _watch_usb_clock_changed(void);
+
+/// Called by the buzzer, which shares the TCC's period with the LED, before and as it changes that period. An effect
+/// that DMA is writing can't follow the period, so the first ends it, keeping the LED's color and any timed off, and
+/// the second rescales the LED's compare buffers to the new period. You should not call these from your app.
+void _watch_led_period_changing(void);
+void _watch_led_set_period(uint32_t period);
+
 // this function ends up getting called by printf to log stuff to the USB console.
 int _write(int file, char *ptr, int len);
 
@@ -21,8 +21,93 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
-#include "driver_init.h"
+#include "watch.h"
 
 // note: the buzzer uses a 1 MHz clock. these values were determined by dividing 1,000,000 by the target frequency.
 // i.e. for a 440 Hz tone (A4 on the piano), 1MHz/440Hz = 2273
 const uint16_t NotePeriods[108] = {18182,17161,16197,15288,14430,13620,12857,12134,11453,10811,10204,9631,9091,8581,8099,7645,7216,6811,6428,6068,5727,5405,5102,4816,4545,4290,4050,3822,3608,3405,3214,3034,2863,2703,2551,2408,2273,2145,2025,1911,1804,1703,1607,1517,1432,1351,1276,1204,1136,1073,1012,956,902,851,804,758,716,676,638,602,568,536,506,478,451,426,402,379,358,338,319,301,284,268,253,239,225,213,201,190,179,169,159,150,142,134,127};
+
+// durations in a melody are 4-bit codes, indexing this table of 32nd notes (RTTTL's shortest note); the odd ones
+// are the dotted values.
+static const uint16_t MelodyDurations[16] = {1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64, 96, 128, 192, 256};
+
+#define MELODY_DEFAULT_OCTAVE 4
+
+uint32_t _watch_buzzer_step_ticks(uint16_t duration_ms, uint32_t cpu_frequency) {
+    // one millisecond is MHz * 125 / 128 ticks; in MHz, so the product fits: 65535 ms at 16 MHz is 131 million.
+    uint32_t ticks = ((uint32_t)duration_ms * (cpu_frequency / 1000000) * 125) >> 7;
+    return ticks ? ticks : 1;
+}
+
+void _watch_buzzer_cursor_init(watch_buzzer_cursor_t *cursor, const watch_buzzer_step_t *sequence, const uint8_t *melody, uint8_t length, uint8_t loops) {
+    cursor->sequence = sequence;
+    cursor->melody = melody;
+    cursor->length = length;
+    cursor->loops_remaining = loops ? loops - 1 : 0;
+    // a melody starts with its time unit; the commands come after.
+    cursor->position = melody ? 1 : 0;
+    cursor->octave = MELODY_DEFAULT_OCTAVE;
+    cursor->repeating = false;
+    cursor->repeat_start = cursor->position;
+}
+
+bool _watch_buzzer_cursor_next(watch_buzzer_cursor_t *cursor, watch_buzzer_step_t *step) {
+    if (cursor->melody == NULL) {
+        if (cursor->position == cursor->length) {
+            if (cursor->loops_remaining == 0) return false;
+            cursor->loops_remaining--;
+            cursor->position = 0;
+        }
+        *step = cursor->sequence[cursor->position++];
+        return true;
+    }
+
+    while (true) {
+        uint8_t command = cursor->melody[cursor->position++];
+        uint8_t argument = command & 0xF;
+
+        switch (command >> 4) {
+            case 0xC:
+                // rest
+                step->note = BUZZER_NOTE_REST;
+                step->duration_ms = cursor->melody[0] * MelodyDurations[argument];
+                return true;
+            case 0xD:
+                cursor->octave = argument;
+                break;
+            case 0xE:
+                if (argument == 0) {
+                    cursor->repeat_start = cursor->position;
+                } else {
+                    if (!cursor->repeating) {
+                        cursor->repeating = true;
+                        cursor->repeats_remaining = argument;
+                    }
+                    if (cursor->repeats_remaining) {
+                        cursor->repeats_remaining--;
+                        cursor->position = cursor->repeat_start;
+                    } else {
+                        cursor->repeating = false;
+                    }
+                }
+                break;
+            case 0xF:
+                // end of the melody
+                if (cursor->loops_remaining == 0) {
+                    return false;
+                } else {
+                    uint8_t loops_remaining = cursor->loops_remaining - 1;
+                    _watch_buzzer_cursor_init(cursor, NULL, cursor->melody, 0, 0);
+                    cursor->loops_remaining = loops_remaining;
+                }
+                break;
+            default: {
+                // a note: BuzzerNote starts at A1, three semitones before C2. Out of range notes become rests.
+                int16_t note = (cursor->octave - 2) * 12 + 3 + (command >> 4);
+                step->note = (note < 0 || note >= BUZZER_NOTE_REST) ? BUZZER_NOTE_REST : (BuzzerNote)note;
+                step->duration_ms = cursor->melody[0] * MelodyDurations[argument];
+                return true;
+            }
+        }
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "watch.h"
+
+// picks the fastest RTC event (128 >> shift Hz) that fits the effect into the step table, and returns its step count.
+static uint8_t _watch_led_effect_pick_rate(watch_led_effect_t *effect, uint16_t duration_ms) {
+    uint32_t steps;
+    uint8_t shift = 0;
+    while (true) {
+        steps = ((uint32_t)duration_ms * (128 >> shift)) / 1000;
+        if (steps <= WATCH_LED_EFFECT_MAX_STEPS || shift == 7) break;
+        shift++;
+    }
+    if (steps > WATCH_LED_EFFECT_MAX_STEPS) steps = WATCH_LED_EFFECT_MAX_STEPS;
+    if (steps == 0) steps = 1;
+
+    effect->rate_shift = shift;
+    effect->length = steps;
+    return steps;
+}
+
+static inline uint8_t _watch_led_interpolate(uint8_t from, uint8_t to, uint8_t step, uint8_t steps) {
+    return from + (((int16_t)to - from) * step) / steps;
+}
+
+void _watch_led_effect_fade(watch_led_effect_t *effect, uint8_t from_red, uint8_t from_green, uint8_t to_red, uint8_t to_green, uint16_t duration_ms) {
+    uint8_t steps = _watch_led_effect_pick_rate(effect, duration_ms);
+    effect->loops = false;
+    // the first step already moves away from the current color, and the last one lands on the new one.
+    for (uint8_t i = 1; i <= steps; i++) {
+        effect->red[i - 1] = _watch_led_interpolate(from_red, to_red, i, steps);
+        effect->green[i - 1] = _watch_led_interpolate(from_green, to_green, i, steps);
+    }
+}
+
+void _watch_led_effect_breathe(watch_led_effect_t *effect, uint8_t red, uint8_t green, uint16_t period_ms) {
+    uint8_t steps = _watch_led_effect_pick_rate(effect, period_ms);
+    effect->loops = true;
+    for (uint8_t i = 0; i < steps; i++) {
+        // a triangle wave, squared so that it lingers near off the way breathing does.
+        uint16_t triangle = (i < steps / 2 ? i : steps - i) * 510 / steps;
+        if (triangle > 255) triangle = 255;
+        uint16_t level = triangle * triangle / 255;
+        effect->red[i] = red * level / 255;
+        effect->green[i] = green * level / 255;
+    }
+}
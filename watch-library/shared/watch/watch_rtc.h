@@ -128,7 +128,8 @@ void watch_rtc_disable_tick_callback(void);
   *
   *       Also note that the RTC peripheral does not have sub-second resolution, so even if you set a 2 or 4 Hz interval,
   *       the system will not have any way of telling you where you are within a given second; watch_rtc_get_date_time
-  *       will return the exact same timestamp until the second ticks over.
+  *       will return the exact same timestamp until the second ticks over. If you need to know how far apart two
+  *       events were, use watch_rtc_get_timestamp instead.
   */
 void watch_rtc_register_periodic_callback(ext_irq_cb_t callback, uint8_t frequency);
 
@@ -147,5 +148,31 @@ void watch_rtc_disable_matching_periodic_callbacks(uint8_t mask);
   */
 void watch_rtc_disable_all_periodic_callbacks(void);
 
+/// @brief The rate of the timestamp counter, in ticks per second.
+#define WATCH_RTC_TIMESTAMP_FREQUENCY (1024)
+
+/** @brief Starts a free-running counter for timing things more finely than the RTC's one second resolution.
+  * @details The counter is TC3, clocked at 1024 Hz by GCLK4, which divides down the same 32.768 kHz oscillator
+  *          as the RTC. It runs in STANDBY, and only interrupts the CPU once every 64 seconds, when its 16-bit count
+  *          wraps around; so you can take timestamps good to a millisecond without running a fast tick. Calling this
+  *          function when the counter is already running does nothing.
+  * @note This takes TC3, which used to be held back for devices on the 9-pin connector along with TC2; only TC2 is
+  *       reserved now. TC2 and TC3 share a generic clock channel, so while the counter runs, TC2 is clocked at
+  *       1024 Hz from GCLK4 too. A sensor board that needs TC2 at another clock can't use it alongside the
+  *       timestamp counter. The SAM L22 has no other TC to move the counter to: TC0 paces USB, TC1 steps the
+  *       buzzer's melodies, and TCC0 drives the buzzer and the LED.
+  */
+void watch_rtc_enable_timestamp_counter(void);
+
+/** @brief Stops the timestamp counter. Timestamps read afterwards are meaningless. */
+void watch_rtc_disable_timestamp_counter(void);
+
+/** @brief Returns the number of timestamp ticks since the counter started.
+  * @return A count of 1/1024ths of a second, which wraps around after about 48 days. Subtract two timestamps
+  *         (as unsigned 32-bit integers) to get the time between them.
+  * @note Safe to call from interrupt handlers, e.g. to time a button press.
+  */
+uint32_t watch_rtc_get_timestamp(void);
+
 /// @}
 #endif
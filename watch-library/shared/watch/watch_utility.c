@@ -35,27 +35,22 @@ const char * watch_utility_get_weekday(watch_date_time date_time) {
     return weekdays[(date_time.unit.day + 13 * (date_time.unit.month + 1) / 5 + date_time.unit.year + date_time.unit.year / 4 + 525) % 7];
 }
 
+// Neri and Schneider's calendar algorithms (see watch_utility.h) count days from March 1st, which puts the leap day at
+// the end of the year and lets a multiply and a shift stand in for each division. The Cortex M0+ has no divide
+// instruction, so every division by a variable is a trip through a slow library routine; these constants are exact
+// over every input these functions can see.
+#define DAYS_TO_1970            719468  // days from March 1st, year 0 to January 1st, 1970 in the proleptic Gregorian calendar
+#define DAYS_TO_MARCH_2000      11017   // days from January 1st, 1970 to March 1st, 2000
+#define DAYS_TO_2020            18262   // days from January 1st, 1970 to January 1st, 2020
+#define DAYS_TO_2084            41638   // days from January 1st, 1970 to January 1st, 2084
+
 uint32_t watch_utility_convert_to_unix_time(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second, uint32_t utc_offset) {
-    uint16_t DAYS_SO_FAR[] = {
-        0,   // Jan
-        31,  // Feb
-        59,  // March
-        90,  // April
-        120, // May
-        151, // June
-        181, // July
-        212, // August
-        243, // September
-        273, // October
-        304, // November
-        334  // December
-    };
-
-    uint32_t year_adj = year + 4800;
-    uint32_t febs = year_adj - (month <= 2 ? 1 : 0);  /* Februaries since base. */
-    uint32_t leap_days = 1 + (febs / 4) - (febs / 100) + (febs / 400);
-    uint32_t days = 365 * year_adj + leap_days + DAYS_SO_FAR[month - 1] + day - 1;
-    days -= 2472692;  /* Adjust to Unix epoch. */
+    // January and February count as months 13 and 14 of the year before.
+    uint32_t january_or_february = month <= 2;
+    uint32_t y = year - january_or_february;
+    uint32_t m = month + 12 * january_or_february;
+    uint32_t century = (y * 5243) >> 19;                // y / 100, exact for any year a uint32_t timestamp can hold
+    uint32_t days = ((1461 * y) >> 2) - century + (century >> 2) + ((979 * m - 2919) >> 5) + day - 1 - DAYS_TO_1970;
 
     uint32_t timestamp = days * 86400;
     timestamp += hour * 3600;
@@ -70,78 +65,33 @@ uint32_t watch_utility_date_time_to_unix_time(watch_date_time date_time, uint32_
     return watch_utility_convert_to_unix_time(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day, date_time.unit.hour, date_time.unit.minute, date_time.unit.second, utc_offset);
 }
 
-#define LEAPOCH (946684800LL + 86400*(31+29))
-
-#define DAYS_PER_400Y (365*400 + 97)
-#define DAYS_PER_100Y (365*100 + 24)
-#define DAYS_PER_4Y   (365*4   + 1)
-
 watch_date_time watch_utility_date_time_from_unix_time(uint32_t timestamp, uint32_t utc_offset) {
     watch_date_time retval;
     retval.reg = 0;
-    int32_t days, secs;
-    int32_t remdays, remsecs, remyears;
-    int32_t qc_cycles, c_cycles, q_cycles;
-    int32_t years, months;
-    int32_t wday, yday, leap;
-    static const int8_t days_in_month[] = {31,30,31,30,31,31,30,31,30,31,31,29};
     timestamp += utc_offset;
 
-    secs = timestamp - LEAPOCH;
-    days = secs / 86400;
-    remsecs = secs % 86400;
-    if (remsecs < 0) {
-        remsecs += 86400;
-        days--;
-    }
-
-    wday = (3+days)%7;
-    if (wday < 0) wday += 7;
-
-    qc_cycles = (int)(days / DAYS_PER_400Y);
-    remdays = days % DAYS_PER_400Y;
-    if (remdays < 0) {
-        remdays += DAYS_PER_400Y;
-        qc_cycles--;
-    }
-
-    c_cycles = remdays / DAYS_PER_100Y;
-    if (c_cycles == 4) c_cycles--;
-    remdays -= c_cycles * DAYS_PER_100Y;
-
-    q_cycles = remdays / DAYS_PER_4Y;
-    if (q_cycles == 25) q_cycles--;
-    remdays -= q_cycles * DAYS_PER_4Y;
-
-    remyears = remdays / 365;
-    if (remyears == 4) remyears--;
-    remdays -= remyears * 365;
-
-    leap = !remyears && (q_cycles || !c_cycles);
-    yday = remdays + 31 + 28 + leap;
-    if (yday >= 365+leap) yday -= 365+leap;
-
-    years = remyears + 4*q_cycles + 100*c_cycles + 400*qc_cycles;
-
-    for (months=0; days_in_month[months] <= remdays; months++)
-        remdays -= days_in_month[months];
-
-    years += 2000;
-
-    months += 2;
-    if (months >= 12) {
-        months -=12;
-        years++;
-    }
-
-    if (years < 2020 || years > 2083) return retval;
-    retval.unit.year = years - WATCH_RTC_REFERENCE_YEAR;
-    retval.unit.month = months + 1;
-    retval.unit.day = remdays + 1;
-
-    retval.unit.hour = remsecs / 3600;
-    retval.unit.minute = remsecs / 60 % 60;
-    retval.unit.second = remsecs % 60;
+    // timestamp / 86400, as 86400 is 675 << 7. this is the one product that needs 64 bits.
+    uint32_t days = ((timestamp >> 7) * (uint64_t)50903317) >> 35;
+    uint32_t seconds = timestamp - days * 86400;
+    if (days < DAYS_TO_2020 || days >= DAYS_TO_2084) return retval;
+
+    // every fourth year is a leap year from 2000 through 2099, so we only need the four year cycle from here on.
+    uint32_t n = days - DAYS_TO_MARCH_2000;
+    uint32_t year = (n * 91867 + 73728) >> 25;          // (4n + 3) / 1461
+    uint32_t day_of_year = (4 * n + 3 - 1461 * year) >> 2;
+    uint32_t month_and_day = 2141 * day_of_year + 197913;
+    uint32_t january_or_february = day_of_year >= 306;
+
+    retval.unit.year = year + january_or_february + 2000 - WATCH_RTC_REFERENCE_YEAR;
+    retval.unit.month = (month_and_day >> 16) - 12 * january_or_february;
+    retval.unit.day = (((month_and_day & 0xFFFF) * 31345) >> 26) + 1;   // (month_and_day % 65536) / 2141
+
+    uint32_t hour = (seconds * 37283) >> 27;            // seconds / 3600
+    seconds -= hour * 3600;
+    uint32_t minute = (seconds * 2185) >> 17;           // seconds / 60
+    retval.unit.hour = hour;
+    retval.unit.minute = minute;
+    retval.unit.second = seconds - minute * 60;
 
     return retval;
 }
@@ -196,3 +146,17 @@ uint32_t watch_utility_offset_timestamp(uint32_t now, int8_t hours, int8_t minut
     new += seconds;
     return new;
 }
+
+static const uint32_t crc32_nibble_table[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+uint32_t watch_utility_crc32(uint32_t crc, const uint8_t *data, size_t length) {
+    crc = ~crc;
+    for(size_t i = 0; i < length; i++) {
+        crc = crc32_nibble_table[(crc ^ data[i]) & 0xF] ^ (crc >> 4);
+        crc = crc32_nibble_table[(crc ^ (data[i] >> 4)) & 0xF] ^ (crc >> 4);
+    }
+    return ~crc;
+}
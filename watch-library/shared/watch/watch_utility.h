@@ -56,8 +56,8 @@ const char * watch_utility_get_weekday(watch_date_time date_time);
   * @param second The second of the date you wish to convert.
   * @param utc_offset The number of seconds that date_time is offset from UTC, or 0 if the time is UTC.
   * @return A UNIX timestamp for the given date/time and UTC offset.
-  * @note Implemented by Wesley Ellis (tahnok) and based on BSD-licensed code by Josh Haberman:
-  *       https://blog.reverberate.org/2020/05/12/optimizing-date-algorithms.html
+  * @note Uses the calendar algorithms from Cassio Neri and Lorenz Schneider, "Euclidean affine functions and their
+  *       application to calendar algorithms" (2022), which trade every division for a multiply and a shift.
   */
 uint32_t watch_utility_convert_to_unix_time(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second, uint32_t utc_offset);
 
@@ -79,8 +79,8 @@ watch_duration_t watch_utility_seconds_to_duration(uint32_t seconds);
   * @param utc_offset The number of seconds that you wish date_time to be offset from UTC.
   * @return A watch_date_time for the given UNIX timestamp and UTC offset, or if outside the range that
   *         watch_date_time can represent, a watch_date_time with all fields set to 0.
-  * @note Adapted from MIT-licensed code from musl, Copyright © 2005-2014 Rich Felker, et al.:
-  *       https://github.com/esmil/musl/blob/1cc81f5cb0df2b66a795ff0c26d7bbc4d16e13c6/src/time/__secs_to_tm.c
+  * @note Uses the calendar algorithms from Cassio Neri and Lorenz Schneider (see watch_utility_convert_to_unix_time),
+  *       simplified for the years 2000-2099, where every fourth year is a leap year.
   */
 watch_date_time watch_utility_date_time_from_unix_time(uint32_t timestamp, uint32_t utc_offset);
 
@@ -103,8 +103,8 @@ bool watch_utility_convert_to_12_hour(watch_date_time *date_time);
   * @param destination_utc_offset The number of seconds from UTC in the destination time zone
   * @return A watch_date_time for the given UNIX timestamp and UTC offset, or if outside the range that
   *         watch_date_time can represent, a watch_date_time with all fields set to 0.
-  * @note Adapted from MIT-licensed code from musl, Copyright © 2005-2014 Rich Felker, et al.:
-  *       https://github.com/esmil/musl/blob/1cc81f5cb0df2b66a795ff0c26d7bbc4d16e13c6/src/time/__secs_to_tm.c
+  * @note Uses the calendar algorithms from Cassio Neri and Lorenz Schneider (see watch_utility_convert_to_unix_time),
+  *       simplified for the years 2000-2099, where every fourth year is a leap year.
   */
 watch_date_time watch_utility_date_time_convert_zone(watch_date_time date_time, uint32_t origin_utc_offset, uint32_t destination_utc_offset);
 
@@ -132,4 +132,13 @@ float watch_utility_thermistor_temperature(uint16_t value, bool highside, float
  */
 uint32_t watch_utility_offset_timestamp(uint32_t now, int8_t hours, int8_t minutes, int8_t seconds);
 
+/** @brief Computes the standard CRC-32 (the one used by zip, PNG and Python's zlib.crc32) of a buffer.
+  * @param crc 0 to start a new checksum, or the result of a previous call to continue one.
+  * @param data The bytes to checksum.
+  * @param length The number of bytes in data.
+  * @return The updated CRC-32.
+  * @note Uses a 16-entry table, so it costs 64 bytes of flash instead of a kilobyte.
+  */
+uint32_t watch_utility_crc32(uint32_t crc, const uint8_t *data, size_t length);
+
 #endif
@@ -59,6 +59,7 @@ static EM_BOOL main_loop(double time, void *userData) {
 
     animation_frame_id = ANIMATION_FRAME_ID_INVALID;
     bool can_sleep = app_loop();
+    commit_display_frame();
 
     if (can_sleep) {
         app_prepare_for_standby();
@@ -105,6 +106,7 @@ int main(void) {
     app_init();
     _watch_init();
     app_setup();
+    commit_display_frame();
 
     resume_main_loop();
 
@@ -4,10 +4,35 @@ bool watch_is_buzzer_or_led_enabled(void) {
     return false;
 }
 
+static bool _low_power_efficiency = true;
+
 bool watch_is_usb_enabled(void) {
     return true;
 }
 
+void watch_set_low_power_efficiency(bool enabled) {
+    _low_power_efficiency = enabled;
+}
+
+bool watch_get_low_power_efficiency(void) {
+    return _low_power_efficiency;
+}
+
 void watch_reset_to_bootloader(void) {
     // No bootloader in the simulator; nothing to do here
 }
+
+static uint8_t _performance_boosts;
+
+void watch_performance_boost(void) {
+    // the browser runs as fast as it runs; just keep count, so watch_get_cpu_frequency answers like the watch would.
+    _performance_boosts++;
+}
+
+void watch_performance_restore(void) {
+    if (_performance_boosts) _performance_boosts--;
+}
+
+uint32_t watch_get_cpu_frequency(void) {
+    return _performance_boosts ? 16000000 : 4000000;
+}
@@ -22,13 +22,31 @@
  * SOFTWARE.
  */
 
+#include <math.h>
 #include "watch_adc.h"
+#include "watch_sim_bus.h"
+#include "thermistor_driver.h"
 
 void watch_enable_adc(void) {}
 
 void watch_enable_analog_input(const uint8_t pin) {}
 
+static uint16_t _watch_thermistor_level(void) {
+    // the thermistor's resistance at the page's temperature, from its B coefficient...
+    double kelvin = watch_sim_ambient_temperature() + 273.15;
+    double nominal_kelvin = THERMISTOR_NOMINAL_TEMPERATURE + 273.15;
+    double resistance = THERMISTOR_NOMINAL_RESISTANCE * exp(THERMISTOR_B_COEFFICIENT * (1 / kelvin - 1 / nominal_kelvin));
+
+    // ...and what the divider makes of it, scaled the way watch_utility_thermistor_temperature expects.
+    if (THERMISTOR_HIGH_SIDE) return lround(1023.0 * 64 * THERMISTOR_SERIES_RESISTANCE / (resistance + THERMISTOR_SERIES_RESISTANCE));
+    return lround(65535.0 * resistance / (resistance + THERMISTOR_SERIES_RESISTANCE));
+}
+
 uint16_t watch_get_analog_pin_level(const uint8_t pin) {
+    // the thermistor only reads right while its divider is powered.
+    if (pin == THERMISTOR_SENSE_PIN && watch_get_pin_level(THERMISTOR_ENABLE_PIN) == THERMISTOR_ENABLE_VALUE) {
+        return _watch_thermistor_level();
+    }
     return 32767; // pretend it's half of VCC
 }
 
@@ -46,3 +64,25 @@ uint16_t watch_get_vcc_voltage(void) {
 inline void watch_disable_analog_input(const uint8_t pin) {}
 
 inline void watch_disable_adc(void) {}
+
+bool watch_adc_read_async(watch_adc_read_t *reads, uint8_t count, watch_adc_callback_t callback, void *context) {
+    if (count == 0) return false;
+
+    // conversions take no time here, so the whole sequence is done before this returns.
+    for(uint8_t i = 0; i < count; i++) {
+        reads[i].result = reads[i].pin == WATCH_ADC_VCC ? watch_get_vcc_voltage() : watch_get_analog_pin_level(reads[i].pin);
+    }
+    if (callback != NULL) callback(reads, count, context);
+
+    return true;
+}
+
+void watch_adc_read(watch_adc_read_t *reads, uint8_t count) {
+    watch_adc_read_async(reads, count, NULL, NULL);
+}
+
+bool watch_adc_is_busy(void) {
+    return false;
+}
+
+void watch_adc_wait_for_idle(void) {}
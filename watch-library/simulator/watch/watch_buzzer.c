@@ -24,8 +24,10 @@
 
 #include "watch_buzzer.h"
 #include "watch_main_loop.h"
+#include "watch_trace.h"
 
 #include <emscripten.h>
+#include <emscripten/html5.h>
 
 static bool buzzer_enabled = false;
 static uint32_t buzzer_period;
@@ -45,6 +47,7 @@ void watch_set_buzzer_period(uint32_t period) {
 }
 
 void watch_disable_buzzer(void) {
+    watch_buzzer_abort_sequence();
     buzzer_enabled = false;
     buzzer_period = NotePeriods[BUZZER_NOTE_A4];
 
@@ -59,6 +62,7 @@ void watch_disable_buzzer(void) {
 void watch_set_buzzer_on(void) {
     if (!buzzer_enabled) return;
 
+    watch_trace_buzzer(buzzer_period ? (1000000 + buzzer_period / 2) / buzzer_period : 0);
     EM_ASM({
         const audioContext = Module['audioContext'];
         if (!audioContext) return;
@@ -83,6 +87,7 @@ void watch_set_buzzer_on(void) {
 void watch_set_buzzer_off(void) {
     if (!buzzer_enabled) return;
 
+    watch_trace_buzzer(0);
     EM_ASM({
         const audioContext = Module['audioContext'];
         if (audioContext && audioContext._gain) {
@@ -91,7 +96,74 @@ void watch_set_buzzer_off(void) {
     });
 }
 
+static struct {
+    bool playing;
+    watch_buzzer_cursor_t cursor;
+    ext_irq_cb_t callback;
+    long timeout_id;
+} buzzer_sequence;
+
+static void _watch_buzzer_sequence_timeout(void *userData);
+
+// starts the next step, and returns false if there are none left.
+static bool _watch_buzzer_start_step(void) {
+    watch_buzzer_step_t step;
+    if (!_watch_buzzer_cursor_next(&buzzer_sequence.cursor, &step)) return false;
+
+    if (step.note == BUZZER_NOTE_REST) {
+        watch_set_buzzer_off();
+    } else {
+        watch_set_buzzer_period(NotePeriods[step.note]);
+        watch_set_buzzer_on();
+    }
+    buzzer_sequence.timeout_id = emscripten_set_timeout(_watch_buzzer_sequence_timeout, step.duration_ms, NULL);
+
+    return true;
+}
+
+static void _watch_buzzer_sequence_timeout(void *userData) {
+    (void) userData;
+
+    if (!_watch_buzzer_start_step()) {
+        ext_irq_cb_t callback = buzzer_sequence.callback;
+        watch_set_buzzer_off();
+        buzzer_sequence.playing = false;
+        if (callback != NULL) callback();
+        resume_main_loop();
+    }
+}
+
+static void _watch_buzzer_play(const watch_buzzer_step_t *sequence, const uint8_t *melody, uint8_t length, uint8_t loops, ext_irq_cb_t callback) {
+    watch_buzzer_abort_sequence();
+    if (!buzzer_enabled) return;
+
+    _watch_buzzer_cursor_init(&buzzer_sequence.cursor, sequence, melody, length, loops);
+    buzzer_sequence.callback = callback;
+    buzzer_sequence.playing = _watch_buzzer_start_step();
+}
+
+void watch_buzzer_play_sequence(const watch_buzzer_step_t *sequence, uint8_t length, uint8_t loops, ext_irq_cb_t callback) {
+    if (length == 0) return;
+    _watch_buzzer_play(sequence, NULL, length, loops, callback);
+}
+
+void watch_buzzer_play_melody(const uint8_t *melody, uint8_t loops, ext_irq_cb_t callback) {
+    _watch_buzzer_play(NULL, melody, 0, loops, callback);
+}
+
+void watch_buzzer_abort_sequence(void) {
+    if (!buzzer_sequence.playing) return;
+    emscripten_clear_timeout(buzzer_sequence.timeout_id);
+    buzzer_sequence.playing = false;
+    watch_set_buzzer_off();
+}
+
+bool watch_buzzer_is_playing(void) {
+    return buzzer_sequence.playing;
+}
+
 void watch_buzzer_play_note(BuzzerNote note, uint16_t duration_ms) {
+    watch_buzzer_abort_sequence();
     if (note == BUZZER_NOTE_REST) {
         watch_set_buzzer_off();
     } else {
@@ -46,6 +46,12 @@ void watch_disable_extwake_interrupt(uint8_t pin) {
     }
 }
 
+void watch_set_sleep_mode_wake_pin(uint8_t pin, bool keep) {
+    // the simulator never turns the interrupts off to begin with.
+    (void) pin;
+    (void) keep;
+}
+
 void watch_store_backup_data(uint32_t data, uint8_t reg) {
     if (reg < 8) {
         watch_backup_data[reg] = data;
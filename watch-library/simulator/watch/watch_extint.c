@@ -22,8 +22,10 @@
  * SOFTWARE.
  */
 
+#include <stdio.h>
 #include "watch_extint.h"
 #include "watch_main_loop.h"
+#include "watch_trace.h"
 
 #include <emscripten.h>
 #include <emscripten/html5.h>
@@ -149,6 +151,10 @@ static EM_BOOL watch_invoke_interrupt_callback(const uint8_t button_id, watch_in
     }
 
     const bool level = (event & INTERRUPT_TRIGGER_RISING) != 0;
+    static const char *button_names[] = { NULL, "light", "mode", "alarm" };
+    char trace[12];
+    sprintf(trace, "%s %s", button_names[button_id], level ? "down" : "up");
+    watch_trace_event("button", trace);
     EM_ASM({
         const classList = document.querySelector('#btn' + $0).classList;
         const highlight = 'highlight';
@@ -169,6 +175,11 @@ static EM_BOOL watch_invoke_interrupt_callback(const uint8_t button_id, watch_in
     return EM_TRUE;
 }
 
+void simulate_button(uint8_t pin, bool pressed) {
+    uint8_t button_id = pin == BTN_MODE ? BTN_ID_MODE : pin == BTN_LIGHT ? BTN_ID_LIGHT : BTN_ID_ALARM;
+    watch_invoke_interrupt_callback(button_id, pressed ? INTERRUPT_TRIGGER_RISING : INTERRUPT_TRIGGER_FALLING);
+}
+
 void watch_register_interrupt_callback(const uint8_t pin, ext_irq_cb_t callback, watch_interrupt_trigger trigger) {
     if (pin == BTN_MODE) {
         external_interrupt_mode_callback = callback;
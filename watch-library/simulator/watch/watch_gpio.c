@@ -23,6 +23,7 @@
  */
 
 #include "watch_gpio.h"
+#include "watch_sim_bus.h"
 
 static bool pin_levels[UINT8_MAX];
 
@@ -43,5 +44,7 @@ void watch_enable_digital_output(const uint8_t pin) {}
 void watch_disable_digital_output(const uint8_t pin) {}
 
 void watch_set_pin_level(const uint8_t pin, const bool level) {
+    if (pin_levels[pin] == level) return;
     pin_levels[pin] = level;
+    watch_sim_bus_pin_changed(pin, level);
 }
@@ -25,17 +25,66 @@
 #include "watch_led.h"
 
 #include <emscripten.h>
+#include <emscripten/html5.h>
 
-void watch_enable_leds(void) {}
-
-void watch_disable_leds(void) {}
+// the browser steps effects with timers, at the rate the watch's RTC events would.
+static struct {
+    bool running;
+    uint8_t red;
+    uint8_t green;
+    watch_led_effect_t effect;
+    uint8_t position;
+    long interval_id;
+    long timeout_id;
+} led_effect;
 
-void watch_set_led_color(uint8_t red, uint8_t green) {
+static void _watch_led_show(uint8_t red, uint8_t green) {
+    led_effect.red = red;
+    led_effect.green = green;
     EM_ASM({
         document.getElementById('light').style.opacity = $1 / 255;
     }, red, green);
 }
 
+static void _watch_led_effect_step(void *userData) {
+    (void) userData;
+
+    _watch_led_show(led_effect.effect.red[led_effect.position], led_effect.effect.green[led_effect.position]);
+    if (++led_effect.position < led_effect.effect.length) return;
+
+    if (led_effect.effect.loops) {
+        led_effect.position = 0;
+    } else {
+        emscripten_clear_interval(led_effect.interval_id);
+        led_effect.running = false;
+    }
+}
+
+static void _watch_led_off_timeout(void *userData) {
+    (void) userData;
+
+    _watch_led_show(0, 0);
+    led_effect.running = false;
+}
+
+static void _watch_led_play(void) {
+    led_effect.position = 0;
+    led_effect.running = true;
+    led_effect.interval_id = emscripten_set_interval(_watch_led_effect_step, 1000.0 / (128 >> led_effect.effect.rate_shift), NULL);
+    led_effect.timeout_id = 0;
+}
+
+void watch_enable_leds(void) {}
+
+void watch_disable_leds(void) {
+    watch_led_stop_effect();
+}
+
+void watch_set_led_color(uint8_t red, uint8_t green) {
+    watch_led_stop_effect();
+    _watch_led_show(red, green);
+}
+
 void watch_set_led_red(void) {
     watch_set_led_color(255, 0);
 }
@@ -51,3 +100,44 @@ void watch_set_led_yellow(void) {
 void watch_set_led_off(void) {
     watch_set_led_color(0, 0);
 }
+
+void watch_led_fade_to(uint8_t red, uint8_t green, uint16_t duration_ms) {
+    watch_led_stop_effect();
+    _watch_led_effect_fade(&led_effect.effect, led_effect.red, led_effect.green, red, green, duration_ms);
+    _watch_led_play();
+}
+
+void watch_led_breathe(uint8_t red, uint8_t green, uint16_t period_ms) {
+    watch_led_stop_effect();
+    _watch_led_effect_breathe(&led_effect.effect, red, green, period_ms);
+    _watch_led_play();
+}
+
+void watch_led_off_after(uint32_t duration_ms) {
+    watch_led_stop_effect();
+    if (led_effect.red == 0 && led_effect.green == 0) return;
+
+    led_effect.running = true;
+    led_effect.interval_id = 0;
+    led_effect.timeout_id = emscripten_set_timeout(_watch_led_off_timeout, duration_ms, NULL);
+}
+
+void watch_led_hold(void) {
+    watch_led_stop_effect();
+    if (led_effect.red == 0 && led_effect.green == 0) return;
+
+    led_effect.running = true;
+    led_effect.interval_id = 0;
+    led_effect.timeout_id = 0;
+}
+
+void watch_led_stop_effect(void) {
+    if (!led_effect.running) return;
+    if (led_effect.interval_id) emscripten_clear_interval(led_effect.interval_id);
+    if (led_effect.timeout_id) emscripten_clear_timeout(led_effect.timeout_id);
+    led_effect.running = false;
+}
+
+bool watch_led_effect_is_running(void) {
+    return led_effect.running;
+}
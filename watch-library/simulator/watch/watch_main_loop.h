@@ -31,3 +31,13 @@ void resume_main_loop(void);
 void main_loop_sleep(uint32_t ms);
 
 bool main_loop_is_sleeping(void);
+
+// records the display as it stands after a pass through app_loop, if it changed (see watch_slcd.c).
+void commit_display_frame(void);
+
+// presses or releases the button on the given pin, the way the page's keys and buttons do (see watch_extint.c).
+void simulate_button(uint8_t pin, bool pressed);
+
+// sets the simulated clock to ms since 1970, the way the page's time controls and a trace's clock events do (see
+// watch_rtc.c).
+void simulate_clock(double ms);
@@ -24,11 +24,21 @@
 
 #include "watch_private.h"
 #include "watch_utility.h"
+#include "watch_trace.h"
+#include "watch_sim_bus.h"
 #include <sys/time.h>
+#include <emscripten.h>
 
 void _watch_init(void) {
     // External wake depends on RTC; calendar is a required module.
     _watch_rtc_init();
+    watch_trace_init();
+    watch_sim_bus_init();
+}
+
+// the HAL's busy wait, for drivers that pace themselves with it. this one lets the page run in the meantime.
+void delay_ms(const uint16_t ms) {
+    emscripten_sleep(ms);
 }
 
 // this function is called by arc4random to get entropy for random number generation.
@@ -63,7 +73,7 @@ int _write(int file, char *ptr, int len) {
     return 0;
 }
 
-int _read(int file, char *ptr, int len) {
-    // TODO: hook to UI
+size_t watch_usb_read_bytes(uint8_t *buf, size_t length, uint16_t timeout_ms) {
+    // the simulator's console only passes text lines; there is no binary channel.
     return 0;
 }
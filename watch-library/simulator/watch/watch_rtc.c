@@ -22,32 +22,89 @@
  * SOFTWARE.
  */
 
+#include <stdio.h>
 #include "watch_rtc.h"
 #include "watch_main_loop.h"
+#include "watch_trace.h"
+#include "watch_sim_bus.h"
 
 #include <emscripten.h>
 #include <emscripten/html5.h>
 
-static double time_offset = 0;
+// the simulated clock runs time_scale times faster than the real one: it read sim_base milliseconds (since 1970) when
+// the real clock (emscripten_get_now) read real_base. the page changes the scale through Module.timeScale, sets the
+// clock through Module.timeSet, and can skip straight to the next alarm by setting Module.timeJump; every timer below
+// is scheduled in simulated time. the page can read the clock with Module.simulatedNow().
+static double time_scale = 1;
+static double sim_base = -1;
+static double real_base;
+static long time_control_interval_id = -1;
+
 static long tick_callbacks[8] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+static ext_irq_cb_t tick_callback_functions[8];
 
 static long alarm_interval_id = -1;
 static long alarm_timeout_id = -1;
 static double alarm_interval;
+static watch_date_time alarm_date_time;
+static watch_rtc_alarm_match alarm_mask;
 ext_irq_cb_t alarm_callback;
 ext_irq_cb_t btn_alarm_callback;
 ext_irq_cb_t a2_callback;
 ext_irq_cb_t a4_callback;
 
+static void _watch_rtc_poll_time_controls(void *userData);
+
+static void _watch_rtc_publish_clock(void) {
+    EM_ASM({
+        Module['clock'] = { base: $0, real: $1, scale: $2 };
+        Module['simulatedNow'] = Module['simulatedNow'] || function() {
+            const clock = Module['clock'];
+            return clock.base + (performance.now() - clock.real) * clock.scale;
+        };
+    }, sim_base, real_base, time_scale);
+}
+
+static double _watch_rtc_now(void) {
+    if (sim_base < 0) {
+        sim_base = EM_ASM_DOUBLE({ return Date.now(); });
+        real_base = emscripten_get_now();
+        _watch_rtc_publish_clock();
+    }
+    return sim_base + (emscripten_get_now() - real_base) * time_scale;
+}
+
+static void _watch_rtc_set_now(double now) {
+    sim_base = now;
+    real_base = emscripten_get_now();
+    _watch_rtc_publish_clock();
+}
+
+double watch_sim_bus_now(void) {
+    return _watch_rtc_now();
+}
+
+long watch_sim_call_at(double time, void (*callback)(void *user_data), void *user_data) {
+    double delay = (time - _watch_rtc_now()) / time_scale;
+    // the page can speed the clock up in the meantime; checking back at least as often as the time controls are
+    // polled keeps the wait from overshooting by much.
+    if (delay > 100) delay = 100;
+    return emscripten_set_timeout(callback, delay > 0 ? delay : 0, user_data);
+}
+
 bool _watch_rtc_is_enabled(void) {
     return true;
 }
 
 void _watch_rtc_init(void) {
+    _watch_rtc_now();
+    if (time_control_interval_id == -1) {
+        time_control_interval_id = emscripten_set_interval(_watch_rtc_poll_time_controls, 100, NULL);
+    }
 }
 
 void watch_rtc_set_date_time(watch_date_time date_time) {
-    time_offset = EM_ASM_DOUBLE({
+    _watch_rtc_set_now(EM_ASM_DOUBLE({
         const year = 2020 + (($0 >> 26) & 0x3f);
         const month = ($0 >> 22) & 0xf;
         const day = ($0 >> 17) & 0x1f;
@@ -55,24 +112,41 @@ void watch_rtc_set_date_time(watch_date_time date_time) {
         const minute = ($0 >> 6) & 0x3f;
         const second = $0 & 0x3f;
         const date = new Date(year, month - 1, day, hour, minute, second);
-        return date - Date.now();
-    }, date_time.reg);
+        return date.getTime();
+    }, date_time.reg));
+    // the hardware compares the alarm against the clock, so moving the clock moves the alarm.
+    if (alarm_callback) watch_rtc_register_alarm_callback(alarm_callback, alarm_date_time, alarm_mask);
 }
 
 watch_date_time watch_rtc_get_date_time(void) {
     watch_date_time retval;
     retval.reg = EM_ASM_INT({
-        const date = new Date(Date.now() + $0);
+        const date = new Date($0);
         return date.getSeconds() |
             (date.getMinutes() << 6) |
             (date.getHours() << 12) |
             (date.getDate() << 17) |
             ((date.getMonth() + 1) << 22) |
             ((date.getFullYear() - 2020) << 26);
-    }, time_offset);
+    }, _watch_rtc_now());
     return retval;
 }
 
+static double timestamp_start = -1;
+
+void watch_rtc_enable_timestamp_counter(void) {
+    if (timestamp_start < 0) timestamp_start = _watch_rtc_now();
+}
+
+void watch_rtc_disable_timestamp_counter(void) {
+    timestamp_start = -1;
+}
+
+uint32_t watch_rtc_get_timestamp(void) {
+    if (timestamp_start < 0) return 0;
+    return (uint64_t)((_watch_rtc_now() - timestamp_start) * WATCH_RTC_TIMESTAMP_FREQUENCY / 1000);
+}
+
 void watch_rtc_register_tick_callback(ext_irq_cb_t callback) {
     watch_rtc_register_periodic_callback(callback, 1);
 }
@@ -98,10 +172,11 @@ void watch_rtc_register_periodic_callback(ext_irq_cb_t callback, uint8_t frequen
     uint8_t per_n = __builtin_clz(tmp);
 
     // this also maps nicely to an index for our list of tick callbacks.
-    double interval = 1000 / frequency; // in msec
+    double interval = 1000.0 / frequency / time_scale; // in msec of real time
 
     if (tick_callbacks[per_n] != -1) emscripten_clear_interval(tick_callbacks[per_n]);
     tick_callbacks[per_n] = emscripten_set_interval(watch_invoke_periodic_callback, interval, (void *)callback);
+    tick_callback_functions[per_n] = callback;
 }
 
 void watch_rtc_disable_periodic_callback(uint8_t frequency) {
@@ -131,30 +206,16 @@ static void watch_invoke_alarm_interval_callback(void *userData) {
 }
 
 static void watch_invoke_alarm_callback(void *userData) {
+    alarm_timeout_id = -1;
     if (alarm_callback) alarm_callback();
-    alarm_interval_id = emscripten_set_interval(watch_invoke_alarm_interval_callback, alarm_interval, NULL);
+    alarm_interval_id = emscripten_set_interval(watch_invoke_alarm_interval_callback, alarm_interval / time_scale, NULL);
 }
 
-void watch_rtc_register_alarm_callback(ext_irq_cb_t callback, watch_date_time alarm_time, watch_rtc_alarm_match mask) {
-    watch_rtc_disable_alarm_callback();
-
-    switch (mask) {
-        case ALARM_MATCH_DISABLED:
-            return;
-        case ALARM_MATCH_SS:
-            alarm_interval = 60 * 1000;
-            break;
-        case ALARM_MATCH_MMSS:
-            alarm_interval = 60 * 60 * 1000;
-            break;
-        case ALARM_MATCH_HHMMSS:
-            alarm_interval = 60 * 60 * 60 * 1000;
-            break;
-    }
-
-    double timeout = EM_ASM_DOUBLE({
-        const now = Date.now();
-        const date = new Date(now + $0);
+// milliseconds of simulated time until the alarm next matches the clock.
+static double _watch_rtc_time_until_alarm(void) {
+    return EM_ASM_DOUBLE({
+        const now = $0;
+        const date = new Date(now);
 
         const hour = ($1 >> 12) & 0x1f;
         const minute = ($1 >> 6) & 0x3f;
@@ -177,10 +238,30 @@ void watch_rtc_register_alarm_callback(ext_irq_cb_t callback, watch_date_time al
         }
 
         return date - now;
-    }, time_offset, alarm_time.reg, mask);
+    }, _watch_rtc_now(), alarm_date_time.reg, alarm_mask);
+}
+
+void watch_rtc_register_alarm_callback(ext_irq_cb_t callback, watch_date_time alarm_time, watch_rtc_alarm_match mask) {
+    watch_rtc_disable_alarm_callback();
+
+    switch (mask) {
+        case ALARM_MATCH_DISABLED:
+            return;
+        case ALARM_MATCH_SS:
+            alarm_interval = 60 * 1000;
+            break;
+        case ALARM_MATCH_MMSS:
+            alarm_interval = 60 * 60 * 1000;
+            break;
+        case ALARM_MATCH_HHMMSS:
+            alarm_interval = 24 * 60 * 60 * 1000;
+            break;
+    }
 
+    alarm_date_time = alarm_time;
+    alarm_mask = mask;
     alarm_callback = callback;
-    alarm_timeout_id = emscripten_set_timeout(watch_invoke_alarm_callback, timeout, NULL);
+    alarm_timeout_id = emscripten_set_timeout(watch_invoke_alarm_callback, _watch_rtc_time_until_alarm() / time_scale, NULL);
 }
 
 void watch_rtc_disable_alarm_callback(void) {
@@ -197,3 +278,51 @@ void watch_rtc_disable_alarm_callback(void) {
         alarm_interval_id = -1;
     }
 }
+
+static void _watch_rtc_set_time_scale(double scale) {
+    // carry on from the current simulated time, and put every timer on the new scale.
+    sim_base = _watch_rtc_now();
+    real_base = emscripten_get_now();
+    time_scale = scale;
+    _watch_rtc_publish_clock();
+    for (int i = 0; i < 8; i++) {
+        if (tick_callbacks[i] != -1) watch_rtc_register_periodic_callback(tick_callback_functions[i], 128 >> i);
+    }
+    if (alarm_callback) watch_rtc_register_alarm_callback(alarm_callback, alarm_date_time, alarm_mask);
+}
+
+static void _watch_rtc_jump_to_next_event(void) {
+    // periodic callbacks are skipped over; the alarm is what wakes the watch from low energy mode, and what drives
+    // Movement's background tasks, so it's the event worth jumping to.
+    if (!alarm_callback) return;
+    double time_until_alarm = _watch_rtc_time_until_alarm();
+    // if it's matching right now, it has already fired; jump to the time after.
+    if (time_until_alarm <= 0) time_until_alarm += alarm_interval;
+    _watch_rtc_set_now(_watch_rtc_now() + time_until_alarm);
+    watch_rtc_register_alarm_callback(alarm_callback, alarm_date_time, alarm_mask);
+}
+
+static void _watch_rtc_trace_clock(void) {
+    char buf[24];
+    sprintf(buf, "%.0f", _watch_rtc_now());
+    watch_trace_event("clock", buf);
+}
+
+void simulate_clock(double ms) {
+    _watch_rtc_set_now(ms);
+    if (alarm_callback) watch_rtc_register_alarm_callback(alarm_callback, alarm_date_time, alarm_mask);
+    _watch_rtc_trace_clock();
+    resume_main_loop();
+}
+
+static void _watch_rtc_poll_time_controls(void *userData) {
+    double scale = EM_ASM_DOUBLE({ return Module['timeScale'] > 0 ? Module['timeScale'] : 1; });
+    if (scale != time_scale) _watch_rtc_set_time_scale(scale);
+    double time_set = EM_ASM_DOUBLE({ const time = Module['timeSet']; Module['timeSet'] = null; return time > 0 ? time : -1; });
+    if (time_set > 0) simulate_clock(time_set);
+    if (EM_ASM_INT({ const jump = Module['timeJump']; Module['timeJump'] = false; return jump ? 1 : 0; })) {
+        _watch_rtc_jump_to_next_event();
+        _watch_rtc_trace_clock();
+        resume_main_loop();
+    }
+}
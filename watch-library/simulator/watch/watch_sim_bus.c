@@ -0,0 +1,205 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <emscripten.h>
+#include "watch_sim_bus.h"
+#include "watch_trace.h"
+#include "watch.h"
+
+// the watch's bus speeds: CONF_SERCOM_1_I2CM_BAUD and CONF_SERCOM_3_SPI_BAUD in hpl_sercom_config.h.
+#define WATCH_SIM_I2C_BAUD 100000
+#define WATCH_SIM_SPI_BAUD 1000000
+// what the SERCOM clocks out when it's only reading.
+#define WATCH_SIM_SPI_DUMMY_BYTE 0xFF
+
+static const watch_sim_i2c_device_t *i2c_devices[] = {
+    &watch_sim_lis2dw,
+};
+
+static const watch_sim_spi_device_t *spi_devices[] = {
+    &watch_sim_flash,
+};
+
+#define NUM_I2C_DEVICES (sizeof(i2c_devices) / sizeof(i2c_devices[0]))
+#define NUM_SPI_DEVICES (sizeof(spi_devices) / sizeof(spi_devices[0]))
+
+static bool spi_selected[NUM_SPI_DEVICES];
+// bytes clocked since the last device was selected; a select-to-deselect with any bytes in it is one transaction.
+static uint32_t spi_bytes_in_transaction;
+
+static watch_sim_bus_stats_t bus_stats[WATCH_SIM_NUM_BUSES];
+
+static watch_sim_i2c_fault_t i2c_fault;
+static uint32_t i2c_fault_skip;
+
+static float ambient_temperature = 25;
+
+static void _watch_sim_bus_count(watch_sim_bus_t bus, uint32_t transactions, uint32_t bytes, uint32_t bits, uint32_t baud) {
+    bus_stats[bus].transactions += transactions;
+    bus_stats[bus].bytes += bytes;
+    bus_stats[bus].time_us += (uint32_t)(((uint64_t)bits * 1000000 + baud / 2) / baud);
+}
+
+void watch_sim_bus_init(void) {
+    for(uint8_t i = 0; i < NUM_I2C_DEVICES; i++) i2c_devices[i]->init();
+    for(uint8_t i = 0; i < NUM_SPI_DEVICES; i++) {
+        spi_devices[i]->init();
+        // pins start low in the simulator, so anything on a chip select starts out selected.
+        spi_selected[i] = !watch_get_pin_level(spi_devices[i]->cs_pin);
+        if (spi_selected[i]) spi_devices[i]->select();
+    }
+
+    EM_ASM({
+        const stats = $0 >> 2;
+        const count = function(bus) {
+            const base = stats + bus * 3;
+            return { transactions: HEAPU32[base], bytes: HEAPU32[base + 1], timeUs: HEAPU32[base + 2] };
+        };
+        Module['busStats'] = function() {
+            return { i2c: count(0), spi: count(1) };
+        };
+        Module['resetBusStats'] = function() {
+            HEAPU32.fill(0, stats, stats + $1 * 3);
+        };
+        Module['setTemperature'] = function(temperature) {
+            Module['_watch_sim_set_ambient_temperature'](temperature);
+        };
+    }, bus_stats, WATCH_SIM_NUM_BUSES);
+}
+
+static const watch_sim_i2c_device_t *_watch_sim_bus_i2c_device(uint8_t addr) {
+    for(uint8_t i = 0; i < NUM_I2C_DEVICES; i++) {
+        if (i2c_devices[i]->addr == addr) return i2c_devices[i];
+    }
+    return NULL;
+}
+
+void watch_sim_bus_inject_i2c_fault(watch_sim_i2c_fault_t fault, uint32_t skip) {
+    i2c_fault = fault;
+    i2c_fault_skip = skip;
+}
+
+bool watch_sim_bus_i2c_transfer(uint8_t addr, const uint8_t *tx, uint16_t tx_length, uint8_t *rx, uint16_t rx_length) {
+    const watch_sim_i2c_device_t *device = _watch_sim_bus_i2c_device(addr);
+    watch_sim_i2c_fault_t fault = WATCH_SIM_I2C_FAULT_NONE;
+
+    if (i2c_fault != WATCH_SIM_I2C_FAULT_NONE && i2c_fault_skip-- == 0) {
+        fault = i2c_fault;
+        i2c_fault = WATCH_SIM_I2C_FAULT_NONE;
+    }
+    if (device == NULL || fault == WATCH_SIM_I2C_FAULT_NACK) {
+        // start, the address, and a NACK; then the controller gives up with a stop.
+        if (rx_length) memset(rx, 0, rx_length);
+        _watch_sim_bus_count(WATCH_SIM_BUS_I2C, 1, 0, 1 + 9 + 1, WATCH_SIM_I2C_BAUD);
+        return false;
+    }
+    if (fault == WATCH_SIM_I2C_FAULT_ARBITRATION_LOST) {
+        // start and the address, which the other controller wins; it sends the stop, not us.
+        if (rx_length) memset(rx, 0, rx_length);
+        _watch_sim_bus_count(WATCH_SIM_BUS_I2C, 1, 0, 1 + 9, WATCH_SIM_I2C_BAUD);
+        return false;
+    }
+
+    // each phase is a start (or repeated start) and the address, then the data; every byte takes nine bits with its
+    // acknowledge. one stop at the end.
+    uint32_t bits = 1;
+    if (tx_length) {
+        device->start(false);
+        for(uint16_t i = 0; i < tx_length; i++) device->write(tx[i]);
+        bits += 1 + 9 + 9 * tx_length;
+    }
+    if (rx_length) {
+        if (tx_length) device->stop();
+        device->start(true);
+        for(uint16_t i = 0; i < rx_length; i++) rx[i] = device->read();
+        bits += 1 + 9 + 9 * rx_length;
+    }
+    device->stop();
+
+    _watch_sim_bus_count(WATCH_SIM_BUS_I2C, 1, tx_length + rx_length, bits, WATCH_SIM_I2C_BAUD);
+    return true;
+}
+
+void watch_sim_bus_spi_transfer(const uint8_t *tx, uint8_t *rx, uint16_t length) {
+    const watch_sim_spi_device_t *device = NULL;
+    for(uint8_t i = 0; i < NUM_SPI_DEVICES; i++) {
+        if (spi_selected[i]) {
+            device = spi_devices[i];
+            break;
+        }
+    }
+
+    for(uint16_t i = 0; i < length; i++) {
+        uint8_t out = tx ? tx[i] : WATCH_SIM_SPI_DUMMY_BYTE;
+        // with nothing driving MISO, the line reads low.
+        uint8_t in = device ? device->exchange(out) : 0;
+        if (rx) rx[i] = in;
+    }
+
+    spi_bytes_in_transaction += length;
+    _watch_sim_bus_count(WATCH_SIM_BUS_SPI, 0, length, 8 * length, WATCH_SIM_SPI_BAUD);
+}
+
+void watch_sim_bus_pin_changed(uint8_t pin, bool level) {
+    for(uint8_t i = 0; i < NUM_SPI_DEVICES; i++) {
+        if (spi_devices[i]->cs_pin != pin || spi_selected[i] == !level) continue;
+        spi_selected[i] = !level;
+        if (spi_selected[i]) {
+            spi_bytes_in_transaction = 0;
+            spi_devices[i]->select();
+        } else {
+            if (spi_bytes_in_transaction) _watch_sim_bus_count(WATCH_SIM_BUS_SPI, 1, 0, 0, WATCH_SIM_SPI_BAUD);
+            spi_bytes_in_transaction = 0;
+            spi_devices[i]->deselect();
+        }
+    }
+}
+
+watch_sim_bus_stats_t watch_sim_bus_get_stats(watch_sim_bus_t bus) {
+    return bus_stats[bus];
+}
+
+void watch_sim_bus_reset_stats(void) {
+    memset(bus_stats, 0, sizeof(bus_stats));
+}
+
+float watch_sim_ambient_temperature(void) {
+    return ambient_temperature;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void watch_sim_set_ambient_temperature(float temperature) {
+    char buf[16];
+    ambient_temperature = temperature;
+    snprintf(buf, sizeof(buf), "%g", temperature);
+    watch_trace_event("temperature", buf);
+}
+
+EMSCRIPTEN_KEEPALIVE
+void watch_sim_trace_inputs(void) {
+    watch_sim_set_ambient_temperature(ambient_temperature);
+    watch_sim_lis2dw_trace_samples();
+}
@@ -0,0 +1,135 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_SIM_BUS_H_INCLUDED
+#define _WATCH_SIM_BUS_H_INCLUDED
+
+// The simulator's virtual sensor bus. watch_i2c.c and watch_spi.c hand every byte to an emulated device instead of
+// dropping it, so sensor code runs off-device against something that answers like the real parts:
+//   * an LIS2DW accelerometer at LIS2DW_ADDRESS on I2C, with its registers and FIFO, fed from a recording
+//     (watch_sim_lis2dw.c);
+//   * a W25Q16-style SPI flash on chip select A3, with program and erase times (watch_sim_flash.c).
+// The thermistor is analog, so it lives in watch_adc.c.
+//
+// The bus also keeps count of transactions, bytes and the time they'd spend on the wire at the watch's bus speeds, so
+// sensor pipelines can be compared without hardware. From the page, Module.busStats() returns the counts for each bus
+// and Module.resetBusStats() zeroes them.
+//
+// What the sensors sense (the accelerometer's samples and the temperature) is set through the functions below, from
+// the page or from a replayed trace, and each change goes into the trace being recorded (see watch_trace.h). The
+// flash needs nothing of the sort: it starts out erased, and only the watch writes to it.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/// An emulated I2C device. A transaction is a start, then bytes in one direction, then a stop or repeated start.
+typedef struct {
+    uint8_t addr;
+    void (*init)(void);
+    void (*start)(bool read);       ///< Called after the device's address; read is the R/W bit.
+    void (*write)(uint8_t byte);
+    uint8_t (*read)(void);
+    void (*stop)(void);             ///< Called at a stop or repeated start.
+} watch_sim_i2c_device_t;
+
+/// An emulated SPI device, selected while its chip select pin is low.
+typedef struct {
+    uint8_t cs_pin;
+    void (*init)(void);
+    void (*select)(void);
+    uint8_t (*exchange)(uint8_t byte);  ///< Takes the byte on MOSI and returns the byte on MISO.
+    void (*deselect)(void);
+} watch_sim_spi_device_t;
+
+typedef struct {
+    uint32_t transactions;
+    uint32_t bytes;
+    uint32_t time_us;   ///< Time on the wire, including start, address, stop and acknowledge bits.
+} watch_sim_bus_stats_t;
+
+typedef enum {
+    WATCH_SIM_BUS_I2C = 0,
+    WATCH_SIM_BUS_SPI,
+    WATCH_SIM_NUM_BUSES
+} watch_sim_bus_t;
+
+/// Ways to make an I2C transaction fail, for testing how drivers cope.
+typedef enum {
+    WATCH_SIM_I2C_FAULT_NONE = 0,
+    WATCH_SIM_I2C_FAULT_NACK,               ///< The device NACKs its address, as if it weren't there.
+    WATCH_SIM_I2C_FAULT_ARBITRATION_LOST,   ///< Another controller wins the bus during the address.
+} watch_sim_i2c_fault_t;
+
+extern const watch_sim_i2c_device_t watch_sim_lis2dw;
+extern const watch_sim_spi_device_t watch_sim_flash;
+
+/// Sets up the emulated devices and the page's hooks. Called by _watch_init.
+void watch_sim_bus_init(void);
+
+/// Runs one I2C transaction: tx_length bytes written, then rx_length bytes read after a repeated start, if both are
+/// given. Returns false if no device answers at addr or a fault was injected, in which case the read bytes are zeroes.
+bool watch_sim_bus_i2c_transfer(uint8_t addr, const uint8_t *tx, uint16_t tx_length, uint8_t *rx, uint16_t rx_length);
+
+/// Makes an I2C transaction fail the given way: the next one, or the one after skip more have gone through. The
+/// device never sees it.
+void watch_sim_bus_inject_i2c_fault(watch_sim_i2c_fault_t fault, uint32_t skip);
+
+/// Clocks length bytes through the selected SPI device; either buffer may be NULL. With nothing selected, reads zeroes.
+void watch_sim_bus_spi_transfer(const uint8_t *tx, uint8_t *rx, uint16_t length);
+
+/// Tells the bus a pin changed level, so it can select and deselect SPI devices. Called by watch_set_pin_level.
+void watch_sim_bus_pin_changed(uint8_t pin, bool level);
+
+/// Returns the counts for a bus since the last reset.
+watch_sim_bus_stats_t watch_sim_bus_get_stats(watch_sim_bus_t bus);
+
+/// Zeroes the counts for every bus.
+void watch_sim_bus_reset_stats(void);
+
+/// The simulated clock, in milliseconds since 1970, for devices that do things on their own time. It's the RTC's
+/// (see watch_rtc.c).
+double watch_sim_bus_now(void);
+
+/// Calls callback around when the simulated clock reads time (in ms since 1970). The simulator's timers run on the
+/// real clock, and the page can move the simulated one in the meantime, so the callback should check the time and
+/// wait again if it's early. Returns an id for emscripten_clear_timeout.
+long watch_sim_call_at(double time, void (*callback)(void *user_data), void *user_data);
+
+/// The temperature around the watch in °C; 25°C until it's set.
+float watch_sim_ambient_temperature(void);
+
+/// Sets the temperature around the watch in °C, as the page's control (Module.setTemperature) and a trace do.
+void watch_sim_set_ambient_temperature(float temperature);
+
+/// Loads a recording for the accelerometer to play, from the start, looping: count samples of x, y and z in milli-g.
+/// The page's Module.loadAccelerometerCsv(text) and a trace come through here; a count of zero unloads it.
+void watch_sim_lis2dw_load_samples(const int16_t *samples, uint32_t count);
+
+/// Records the accelerometer's recording in the trace, as loading it does.
+void watch_sim_lis2dw_trace_samples(void);
+
+/// Records what the sensors are sensing in the trace, so a recording starts from there. Called when one starts.
+void watch_sim_trace_inputs(void);
+
+#endif
@@ -0,0 +1,199 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "watch_sim_bus.h"
+#include "spiflash.h"
+
+// A W25Q16 SPI flash, as on the Sensor Watch's motion sensor board: 2 MB, programmed a 256-byte page at a time and
+// erased to 0xFF a sector or more at a time. Programs and erases take as long as the data sheet's typical times, in
+// simulated time, and the chip ignores everything but status reads until they're done, like the real one. Writes and
+// erases need a write enable first. The contents start erased with every page load.
+
+#define FLASH_SIZE (2 * 1024 * 1024)
+#define FLASH_PAGE_SIZE 256
+#define FLASH_SECTOR_SIZE 4096
+#define FLASH_JEDEC_ID 0xEF4015
+#define FLASH_DEVICE_ID 0x14
+
+#define CMD_BLOCK_ERASE_32K 0x52
+#define CMD_BLOCK_ERASE_64K 0xD8
+#define CMD_CHIP_ERASE_ALT 0x60
+#define CMD_READ_STATUS3 0x15
+#define CMD_MANUFACTURER_DEVICE_ID 0x90
+
+// typical times from the W25Q16JV data sheet, in ms.
+#define FLASH_PAGE_PROGRAM_TIME 0.4
+#define FLASH_SECTOR_ERASE_TIME 45
+#define FLASH_BLOCK_ERASE_32K_TIME 120
+#define FLASH_BLOCK_ERASE_64K_TIME 150
+#define FLASH_CHIP_ERASE_TIME 5000
+#define FLASH_WRITE_STATUS_TIME 10
+
+#define FLASH_STATUS_BUSY 0b01
+#define FLASH_STATUS_WEL 0b10
+
+static uint8_t flash_memory[FLASH_SIZE];
+
+static struct {
+    uint8_t command;
+    uint32_t position;          // bytes exchanged since the chip was selected
+    uint32_t address;
+    bool ignoring;              // the command came in while the chip was busy
+    bool write_enabled;
+    double busy_until;          // simulated ms
+    uint8_t page[FLASH_PAGE_SIZE];
+    bool page_written;
+} flash;
+
+static bool _flash_busy(void) {
+    return flash.busy_until && watch_sim_bus_now() < flash.busy_until;
+}
+
+static void _flash_init(void) {
+    memset(flash_memory, 0xFF, sizeof(flash_memory));
+    memset(&flash, 0, sizeof(flash));
+}
+
+static void _flash_select(void) {
+    flash.position = 0;
+}
+
+static uint8_t _flash_exchange(uint8_t byte) {
+    uint32_t position = flash.position++;
+
+    if (position == 0) {
+        flash.command = byte;
+        flash.address = 0;
+        flash.page_written = false;
+        flash.ignoring = _flash_busy() && byte != CMD_READ_STATUS && byte != CMD_READ_STATUS2 && byte != CMD_READ_STATUS3;
+        return 0;
+    }
+    if (flash.ignoring) return 0;
+
+    switch (flash.command) {
+        case CMD_READ_STATUS:
+            return (_flash_busy() ? FLASH_STATUS_BUSY : 0) | (flash.write_enabled ? FLASH_STATUS_WEL : 0);
+        case CMD_READ_JEDEC_ID:
+            return position <= 3 ? (FLASH_JEDEC_ID >> (8 * (3 - position))) & 0xFF : 0;
+        case CMD_WAKE:
+            return position >= 4 ? FLASH_DEVICE_ID : 0;
+        case CMD_MANUFACTURER_DEVICE_ID:
+            if (position < 4) return 0;
+            return position % 2 ? FLASH_DEVICE_ID : FLASH_JEDEC_ID >> 16;
+        case CMD_READ_DATA:
+        case CMD_FAST_READ_DATA:
+        case CMD_PAGE_PROGRAM:
+        case CMD_SECTOR_ERASE:
+        case CMD_BLOCK_ERASE_32K:
+        case CMD_BLOCK_ERASE_64K:
+            if (position <= 3) {
+                flash.address = (flash.address << 8 | byte) % FLASH_SIZE;
+                if (position == 3 && flash.command == CMD_PAGE_PROGRAM) memset(flash.page, 0xFF, sizeof(flash.page));
+                return 0;
+            }
+            if (flash.command == CMD_READ_DATA || (flash.command == CMD_FAST_READ_DATA && position > 4)) {
+                return flash_memory[(flash.address + position - (flash.command == CMD_READ_DATA ? 4 : 5)) % FLASH_SIZE];
+            }
+            if (flash.command == CMD_PAGE_PROGRAM) {
+                // past the end of the page, the address wraps around to its start.
+                flash.page[(flash.address + position - 4) % FLASH_PAGE_SIZE] &= byte;
+                flash.page_written = true;
+            }
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+static void _flash_erase(uint32_t size, double time) {
+    uint32_t start = flash.address & ~(size - 1);
+    memset(flash_memory + start, 0xFF, size);
+    flash.busy_until = watch_sim_bus_now() + time;
+}
+
+static void _flash_deselect(void) {
+    if (flash.position == 0 || flash.ignoring) return;
+
+    switch (flash.command) {
+        case CMD_ENABLE_WRITE:
+            flash.write_enabled = true;
+            return;
+        case CMD_DISABLE_WRITE:
+            flash.write_enabled = false;
+            return;
+        case CMD_ENABLE_RESET:
+        case CMD_RESET:
+            flash.write_enabled = false;
+            return;
+        default:
+            break;
+    }
+
+    // the rest change the contents, and only go ahead with a whole address and a write enable.
+    if (!flash.write_enabled) return;
+    switch (flash.command) {
+        case CMD_PAGE_PROGRAM:
+            if (!flash.page_written) return;
+            {
+                uint32_t page_start = flash.address & ~(FLASH_PAGE_SIZE - 1);
+                for(uint16_t i = 0; i < FLASH_PAGE_SIZE; i++) flash_memory[page_start + i] &= flash.page[i];
+            }
+            flash.busy_until = watch_sim_bus_now() + FLASH_PAGE_PROGRAM_TIME;
+            break;
+        case CMD_SECTOR_ERASE:
+            if (flash.position < 4) return;
+            _flash_erase(FLASH_SECTOR_SIZE, FLASH_SECTOR_ERASE_TIME);
+            break;
+        case CMD_BLOCK_ERASE_32K:
+            if (flash.position < 4) return;
+            _flash_erase(32 * 1024, FLASH_BLOCK_ERASE_32K_TIME);
+            break;
+        case CMD_BLOCK_ERASE_64K:
+            if (flash.position < 4) return;
+            _flash_erase(64 * 1024, FLASH_BLOCK_ERASE_64K_TIME);
+            break;
+        case CMD_CHIP_ERASE:
+        case CMD_CHIP_ERASE_ALT:
+            flash.address = 0;
+            _flash_erase(FLASH_SIZE, FLASH_CHIP_ERASE_TIME);
+            break;
+        case CMD_WRITE_STATUS_BYTE1:
+        case CMD_WRITE_STATUS_BYTE2:
+            // protection and quad enable bits aren't emulated.
+            flash.busy_until = watch_sim_bus_now() + FLASH_WRITE_STATUS_TIME;
+            break;
+        default:
+            return;
+    }
+    flash.write_enabled = false;
+}
+
+const watch_sim_spi_device_t watch_sim_flash = {
+    .cs_pin = A3,
+    .init = _flash_init,
+    .select = _flash_select,
+    .exchange = _flash_exchange,
+    .deselect = _flash_deselect,
+};
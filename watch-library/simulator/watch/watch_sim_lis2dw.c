@@ -0,0 +1,335 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <emscripten.h>
+#include "watch_sim_bus.h"
+#include "watch_trace.h"
+#include "lis2dw.h"
+
+// An LIS2DW12 as the driver uses it: the control registers, the output registers, the temperature sensor and the
+// 32-sample FIFO. Samples come from a recording loaded with watch_sim_lis2dw_load_samples: on the page, that's
+// Module.loadAccelerometerCsv(text), one sample per line, the last three columns being x, y and z in milli-g (so "x,y,z"
+// and "time,x,y,z" both work), and in a trace, an accelerometer event. The recording loops; without one, the watch lies flat and still. Samples are produced at the configured data rate in simulated
+// time, whenever the watch next talks to the sensor.
+// Not emulated: wake-up, tap, free fall and 6D detection (their source registers read zero), self test, the high
+// pass filter and the single conversion mode.
+
+#define LIS2DW_NUM_REGISTERS 0x40
+#define LIS2DW_FIFO_DEPTH 32
+// LSB of the 16-bit output at ±2g, in milli-g; doubles with each step of range.
+#define LIS2DW_SENSITIVITY_2G 0.061
+// how many samples to catch up on after a long sleep; more than that would all have been overwritten anyway.
+#define LIS2DW_MAX_CATCH_UP (LIS2DW_FIFO_DEPTH + 1)
+
+static struct {
+    uint8_t registers[LIS2DW_NUM_REGISTERS];
+    uint8_t pointer;
+    bool pointer_pending;       // the first byte written in a transaction sets the pointer
+    int16_t output[3];
+    bool data_ready;
+    int16_t fifo[LIS2DW_FIFO_DEPTH][3];
+    uint8_t fifo_head;
+    uint8_t fifo_count;
+    bool fifo_overrun;
+    double next_sample;         // simulated ms; 0 when powered down
+} lis2dw;
+
+// the recording, which a reset leaves alone: it's what the sensor is feeling, not its state.
+static struct {
+    int16_t *samples;           // x, y and z in milli-g, three to a sample
+    uint32_t count;
+    uint32_t position;
+} recording;
+
+static void _lis2dw_reset(void) {
+    memset(&lis2dw, 0, sizeof(lis2dw));
+    lis2dw.registers[LIS2DW_REG_WHO_AM_I] = LIS2DW_WHO_AM_I_VAL;
+    lis2dw.registers[LIS2DW_REG_CTRL2] = LIS2DW_CTRL2_VAL_IF_ADD_INC;
+}
+
+static double _lis2dw_sample_period(void) {
+    uint8_t ctrl1 = lis2dw.registers[LIS2DW_REG_CTRL1];
+    uint8_t rate = ctrl1 >> 4;
+    bool high_performance = ((ctrl1 >> 2) & 0b11) == LIS2DW_MODE_HIGH_PERFORMANCE;
+
+    if (rate == LIS2DW_DATA_RATE_POWERDOWN) return 0;
+    if (rate == LIS2DW_DATA_RATE_LOWEST) return high_performance ? 80 : 625;
+    // low power mode tops out at 200 Hz.
+    if (!high_performance && rate > LIS2DW_DATA_RATE_200_HZ) rate = LIS2DW_DATA_RATE_200_HZ;
+    if (rate > LIS2DW_DATA_RATE_HP_1600_HZ) rate = LIS2DW_DATA_RATE_HP_1600_HZ;
+    // 12.5 Hz, doubling from there.
+    return 80.0 / (1 << (rate - LIS2DW_DATA_RATE_12_5_HZ));
+}
+
+static void _lis2dw_convert(const int16_t *milli_g, int16_t *out) {
+    uint8_t ctrl1 = lis2dw.registers[LIS2DW_REG_CTRL1];
+    uint8_t range = (lis2dw.registers[LIS2DW_REG_CTRL6] >> 4) & 0b11;
+    // low power mode 1 has 12 bits of resolution, everything else 14, left justified.
+    bool twelve_bit = ((ctrl1 >> 2) & 0b11) != LIS2DW_MODE_HIGH_PERFORMANCE && (ctrl1 & 0b11) == LIS2DW_LP_MODE_1;
+    double lsb = LIS2DW_SENSITIVITY_2G * (1 << range);
+
+    for(uint8_t axis = 0; axis < 3; axis++) {
+        double value = milli_g[axis] / lsb;
+        if (value > INT16_MAX) value = INT16_MAX;
+        if (value < INT16_MIN) value = INT16_MIN;
+        out[axis] = (int16_t)value & (twelve_bit ? ~0xF : ~0x3);
+    }
+}
+
+static void _lis2dw_produce_sample(uint32_t skipped) {
+    int16_t milli_g[3] = {0, 0, 1000};
+    int16_t sample[3];
+
+    if (recording.count) {
+        recording.position = (recording.position + skipped) % recording.count;
+        memcpy(milli_g, recording.samples + recording.position * 3, sizeof(milli_g));
+        recording.position = (recording.position + 1) % recording.count;
+    }
+    _lis2dw_convert(milli_g, sample);
+
+    memcpy(lis2dw.output, sample, sizeof(sample));
+    lis2dw.data_ready = true;
+
+    uint8_t mode = lis2dw.registers[LIS2DW_REG_FIFO_CTRL] >> 5;
+    if (mode == LIS2DW_FIFO_MODE_OFF) return;
+    if (lis2dw.fifo_count == LIS2DW_FIFO_DEPTH) {
+        // FIFO mode stops when it's full; continuous mode drops the oldest sample.
+        lis2dw.fifo_overrun = true;
+        if (mode == LIS2DW_FIFO_MODE_COLLECT_AND_STOP || mode == LIS2DW_FIFO_MODE_CONTINUOUS_TO_FIFO) return;
+        lis2dw.fifo_head = (lis2dw.fifo_head + 1) % LIS2DW_FIFO_DEPTH;
+        lis2dw.fifo_count--;
+    }
+    memcpy(lis2dw.fifo[(lis2dw.fifo_head + lis2dw.fifo_count) % LIS2DW_FIFO_DEPTH], sample, sizeof(sample));
+    lis2dw.fifo_count++;
+}
+
+static void _lis2dw_update(void) {
+    double period = _lis2dw_sample_period();
+    if (period == 0) return;
+
+    double now = watch_sim_bus_now();
+    if (now < lis2dw.next_sample) return;
+    uint32_t due = (now - lis2dw.next_sample) / period + 1;
+
+    uint32_t skipped = 0;
+    if (due > LIS2DW_MAX_CATCH_UP) {
+        skipped = due - LIS2DW_MAX_CATCH_UP;
+        lis2dw.next_sample += skipped * period;
+    }
+    while (lis2dw.next_sample <= now) {
+        _lis2dw_produce_sample(skipped);
+        skipped = 0;
+        lis2dw.next_sample += period;
+    }
+}
+
+static uint8_t _lis2dw_fifo_threshold(void) {
+    return lis2dw.registers[LIS2DW_REG_FIFO_CTRL] & LIS2DW_FIFO_CTRL_FTH;
+}
+
+static uint8_t _lis2dw_read_register(uint8_t reg) {
+    int16_t *output = lis2dw.output;
+    if ((lis2dw.registers[LIS2DW_REG_FIFO_CTRL] >> 5) != LIS2DW_FIFO_MODE_OFF && lis2dw.fifo_count) {
+        output = lis2dw.fifo[lis2dw.fifo_head];
+    }
+    // 25°C reads as zero; the 12-bit reading has 16 LSB per degree, the 8-bit one just the one.
+    int16_t temperature = (watch_sim_ambient_temperature() - 25) * 16;
+
+    switch (reg) {
+        case LIS2DW_REG_OUT_TEMP_L:
+            return (temperature << 4) & 0xFF;
+        case LIS2DW_REG_OUT_TEMP_H:
+            return (temperature >> 4) & 0xFF;
+        case LIS2DW_REG_OUT_TEMP:
+            return (temperature >> 4) & 0xFF;
+        case LIS2DW_REG_STATUS:
+        case LIS2DW_REG_STATUS_DUP:
+            return (lis2dw.fifo_count >= _lis2dw_fifo_threshold() ? LIS2DW_STATUS_VAL_FIFO_THS : 0) | lis2dw.data_ready;
+        case LIS2DW_REG_OUT_X_L:
+        case LIS2DW_REG_OUT_X_H:
+        case LIS2DW_REG_OUT_Y_L:
+        case LIS2DW_REG_OUT_Y_H:
+        case LIS2DW_REG_OUT_Z_L:
+        case LIS2DW_REG_OUT_Z_H:
+        {
+            uint8_t offset = reg - LIS2DW_REG_OUT_X_L;
+            uint8_t value = output[offset / 2] >> ((offset & 1) * 8);
+            if (reg == LIS2DW_REG_OUT_Z_H) {
+                // reading the last output byte moves on to the next sample.
+                lis2dw.data_ready = false;
+                if (output != lis2dw.output) {
+                    memcpy(lis2dw.output, output, sizeof(lis2dw.output));
+                    lis2dw.fifo_head = (lis2dw.fifo_head + 1) % LIS2DW_FIFO_DEPTH;
+                    lis2dw.fifo_count--;
+                }
+            }
+            return value;
+        }
+        case LIS2DW_REG_FIFO_SAMPLE:
+            return (lis2dw.fifo_count >= _lis2dw_fifo_threshold() ? LIS2DW_FIFO_SAMPLE_THRESHOLD : 0) |
+                   (lis2dw.fifo_overrun ? LIS2DW_FIFO_SAMPLE_OVERRUN : 0) | lis2dw.fifo_count;
+        default:
+            return lis2dw.registers[reg];
+    }
+}
+
+static void _lis2dw_write_register(uint8_t reg, uint8_t value) {
+    switch (reg) {
+        case LIS2DW_REG_CTRL1:
+            if ((value ^ lis2dw.registers[reg]) >> 2) {
+                // a new rate or mode starts a new sample period.
+                lis2dw.registers[reg] = value;
+                double period = _lis2dw_sample_period();
+                lis2dw.next_sample = period ? watch_sim_bus_now() + period : 0;
+            }
+            lis2dw.registers[reg] = value;
+            break;
+        case LIS2DW_REG_CTRL2:
+            if (value & (LIS2DW_CTRL2_VAL_BOOT | LIS2DW_CTRL2_VAL_SOFT_RESET)) {
+                // both bits clear themselves once the reset is done, which here is right away.
+                _lis2dw_reset();
+            } else {
+                lis2dw.registers[reg] = value;
+            }
+            break;
+        case LIS2DW_REG_FIFO_CTRL:
+            if ((value >> 5) == LIS2DW_FIFO_MODE_OFF || (value >> 5) != (lis2dw.registers[reg] >> 5)) {
+                // bypass mode empties the FIFO, and so does changing modes.
+                lis2dw.fifo_count = 0;
+                lis2dw.fifo_overrun = false;
+            }
+            lis2dw.registers[reg] = value;
+            break;
+        case LIS2DW_REG_CTRL3:
+        case LIS2DW_REG_CTRL4_INT1:
+        case LIS2DW_REG_CTRL5_INT2:
+        case LIS2DW_REG_CTRL6:
+        case LIS2DW_REG_TAP_THS_X:
+        case LIS2DW_REG_TAP_THS_Y:
+        case LIS2DW_REG_TAP_THS_Z:
+        case LIS2DW_REG_INT1_DUR:
+        case LIS2DW_REG_WAKE_UP_THS:
+        case LIS2DW_REG_WAKE_UP_DUR:
+        case LIS2DW_REG_FREE_FALL:
+        case LIS2DW_REG_CTRL7:
+            lis2dw.registers[reg] = value;
+            break;
+        default:
+            // read only.
+            break;
+    }
+}
+
+static void _lis2dw_advance_pointer(void) {
+    if (!(lis2dw.registers[LIS2DW_REG_CTRL2] & LIS2DW_CTRL2_VAL_IF_ADD_INC)) return;
+    if (lis2dw.pointer == LIS2DW_REG_OUT_Z_H && (lis2dw.registers[LIS2DW_REG_FIFO_CTRL] >> 5) != LIS2DW_FIFO_MODE_OFF) {
+        // with the FIFO on, the pointer wraps back to the first output register, so a burst reads sample after sample.
+        lis2dw.pointer = LIS2DW_REG_OUT_X_L;
+    } else {
+        lis2dw.pointer = (lis2dw.pointer + 1) % LIS2DW_NUM_REGISTERS;
+    }
+}
+
+static void _lis2dw_init(void) {
+    _lis2dw_reset();
+    EM_ASM({
+        Module['loadAccelerometerCsv'] = function(text) {
+            const values = [];
+            text.split('\n').forEach(function(line) {
+                // anything that can't be part of a number separates columns.
+                const columns = line.split(/[^-+.0-9eE]+/).filter(Boolean).map(Number);
+                if (columns.length < 3 || columns.some(isNaN)) return;
+                values.push.apply(values, columns.slice(-3));
+            });
+            const samples = _malloc(values.length * 2 + 2);
+            HEAP16.set(Int16Array.from(values), samples >> 1);
+            Module['_watch_sim_lis2dw_load_samples'](samples, values.length / 3);
+            _free(samples);
+            return values.length / 3;
+        };
+    });
+}
+
+EMSCRIPTEN_KEEPALIVE
+void watch_sim_lis2dw_load_samples(const int16_t *samples, uint32_t count) {
+    int16_t *copy = count ? malloc(count * 3 * sizeof(int16_t)) : NULL;
+
+    if (count && copy == NULL) count = 0;
+    if (count) memcpy(copy, samples, count * 3 * sizeof(int16_t));
+    free(recording.samples);
+    recording.samples = copy;
+    recording.count = count;
+    recording.position = 0;
+    watch_sim_lis2dw_trace_samples();
+}
+
+void watch_sim_lis2dw_trace_samples(void) {
+    // "-32768 " is the longest a value gets.
+    char *buf = malloc(recording.count * 3 * 7 + 1);
+    size_t length = 0;
+
+    if (buf == NULL) return;
+    buf[0] = 0;
+    for(uint32_t i = 0; i < recording.count * 3; i++) {
+        length += sprintf(buf + length, i ? " %d" : "%d", recording.samples[i]);
+    }
+    watch_trace_event("accelerometer", buf);
+    free(buf);
+}
+
+static void _lis2dw_start(bool read) {
+    _lis2dw_update();
+    lis2dw.pointer_pending = !read;
+}
+
+static void _lis2dw_write(uint8_t byte) {
+    if (lis2dw.pointer_pending) {
+        // the driver sets the top bit to ask for consecutive reads, as on the LIS3DH; IF_ADD_INC is what counts here.
+        lis2dw.pointer = byte % LIS2DW_NUM_REGISTERS;
+        lis2dw.pointer_pending = false;
+        return;
+    }
+    _lis2dw_write_register(lis2dw.pointer, byte);
+    _lis2dw_advance_pointer();
+}
+
+static uint8_t _lis2dw_read(void) {
+    uint8_t value = _lis2dw_read_register(lis2dw.pointer);
+    _lis2dw_advance_pointer();
+    return value;
+}
+
+static void _lis2dw_stop(void) {}
+
+const watch_sim_i2c_device_t watch_sim_lis2dw = {
+    .addr = LIS2DW_ADDRESS,
+    .init = _lis2dw_init,
+    .start = _lis2dw_start,
+    .write = _lis2dw_write,
+    .read = _lis2dw_read,
+    .stop = _lis2dw_stop,
+};
@@ -25,6 +25,10 @@
 #include "watch_slcd.h"
 #include "watch_private_display.h"
 #include "hpl_slcd_config.h"
+#include "watch_main_loop.h"
+#include "watch_trace.h"
+
+#include <string.h>
 
 #include <emscripten.h>
 #include <emscripten/html5.h>
@@ -38,35 +42,146 @@ static long blink_interval_id = - 1;
 static bool tick_state;
 static long tick_interval_id = -1;
 
+// the state of every segment, one word per COM with a bit per SEG. setting pixels only touches this; the page reads it
+// straight out of wasm memory once per animation frame, and only restyles the segments that changed. that's for the
+// eye: what gets recorded or printed (see watch_trace_display) is the display as each pass through the main loop, or
+// each blink, left it, so the frames don't depend on how fast the page happens to be painting.
+static uint32_t segment_state[3];
+static uint32_t committed_state[3];
+static bool committed;
+static volatile uint8_t display_flush_pending;
+
+static void _watch_schedule_display_flush(void) {
+    if (display_flush_pending) return;
+    display_flush_pending = 1;
+    EM_ASM({
+        var request_frame = typeof requestAnimationFrame == 'function' ? requestAnimationFrame : function(callback) {
+            setTimeout(function() { callback(performance.now()); });
+        };
+        request_frame(function(now) {
+            var display = Module['display'];
+            if (!display) {
+                display = Module['display'] = { segments: [], drawn: null, last_frame: now, fps: 0 };
+                // index the segment elements once, by COM * 32 + SEG.
+                if (typeof document != 'undefined') document.querySelectorAll("[data-com][data-seg]").forEach(function(e) {
+                    var index = e.dataset.com * 32 + +e.dataset.seg;
+                    (display.segments[index] = display.segments[index] || []).push(e);
+                });
+            }
+            var start = performance.now();
+            var updates = 0;
+            for (var com = 0; com < 3; com++) {
+                var state = HEAPU32[($0 >> 2) + com];
+                var changed = display.drawn ? (state ^ display.drawn[com]) : 0xFFFFFFFF;
+                for (var seg = 0; changed; seg++, changed >>>= 1) {
+                    if (!(changed & 1) || !display.segments[com * 32 + seg]) continue;
+                    var opacity = (state >>> seg) & 1;
+                    display.segments[com * 32 + seg].forEach(function(e) { e.style.opacity = opacity; });
+                    updates++;
+                }
+            }
+            display.drawn = HEAPU32.slice($0 >> 2, ($0 >> 2) + 3);
+            HEAPU8[$1] = 0;
+
+            var elapsed = performance.now() - start;
+            if (now > display.last_frame) display.fps = display.fps * 0.9 + 100 / (now - display.last_frame);
+            display.last_frame = now;
+            var counter = typeof document != 'undefined' && document.getElementById('frame_time');
+            if (counter) counter.textContent = 'display: ' + elapsed.toFixed(2) + ' ms for ' + updates + ' segments, ' + display.fps.toFixed(1) + ' updates/s';
+        });
+    }, segment_state, &display_flush_pending);
+}
+
+void commit_display_frame(void) {
+    if (committed && memcmp(segment_state, committed_state, sizeof(segment_state)) == 0) return;
+    memcpy(committed_state, segment_state, sizeof(segment_state));
+    committed = true;
+    watch_trace_display(committed_state);
+}
+
+static bool _watch_segment_is_lit(const uint32_t segments[3], uint8_t com, uint8_t seg) {
+    // Segment_Map uses COM 3 for segments a position doesn't have.
+    return com < 3 && ((segments[com] >> seg) & 1);
+}
+
+size_t watch_trace_render_display(const uint32_t segments[3], char *text) {
+    // each line is a run of positions, three characters wide, and gaps one character wide; a gap of -2 is the colon.
+    static const int8_t lines[2][8] = {
+        {0, 1, -1, -1, 2, 3, -3, -3},
+        {4, 5, -2, 6, 7, -1, 8, 9},
+    };
+    static const struct { uint8_t com; uint8_t seg; const char *name; } indicators[] = {
+        {0, 17, "SIGNAL"}, {0, 16, "BELL"}, {2, 17, "PM"}, {2, 16, "24H"}, {1, 10, "LAP"},
+    };
+    size_t length = 0;
+
+    for (uint8_t line = 0; line < 2; line++) {
+        char rows[3][25];
+        uint8_t width = 0;
+        for (uint8_t i = 0; i < 8 && lines[line][i] != -3; i++) {
+            int8_t position = lines[line][i];
+            if (position < 0) {
+                bool colon = position == -2 && _watch_segment_is_lit(segments, 1, 16);
+                rows[0][width] = ' ';
+                rows[1][width] = rows[2][width] = colon ? '.' : ' ';
+                width++;
+                continue;
+            }
+            bool lit[8];
+            for (uint8_t segment = 0; segment < 8; segment++) {
+                uint8_t mapping = (Segment_Map[position] >> (segment * 8)) & 0xFF;
+                lit[segment] = _watch_segment_is_lit(segments, mapping >> 6, mapping & 0x3F);
+            }
+            memcpy(rows[0] + width, (char[]){' ', lit[0] ? '_' : ' ', lit[7] ? '\'' : ' '}, 3);
+            memcpy(rows[1] + width, (char[]){lit[5] ? '|' : ' ', lit[6] ? '_' : ' ', lit[1] ? '|' : ' '}, 3);
+            memcpy(rows[2] + width, (char[]){lit[4] ? '|' : ' ', lit[3] ? '_' : ' ', lit[2] ? '|' : ' '}, 3);
+            width += 3;
+        }
+        for (uint8_t row = 0; row < 3; row++) {
+            if (length) text[length++] = '\n';
+            memcpy(text + length, rows[row], width);
+            length += width;
+        }
+    }
+
+    bool first = true;
+    for (uint8_t i = 0; i < sizeof(indicators) / sizeof(indicators[0]); i++) {
+        if (!_watch_segment_is_lit(segments, indicators[i].com, indicators[i].seg)) continue;
+        text[length++] = first ? '\n' : ' ';
+        first = false;
+        strcpy(text + length, indicators[i].name);
+        length += strlen(indicators[i].name);
+    }
+    text[length] = 0;
+
+    return length;
+}
+
 void watch_enable_display(void) {
     watch_clear_display();
 }
 
 void watch_set_pixel(uint8_t com, uint8_t seg) {
-    EM_ASM({
-        document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
-            .forEach((e) => e.style.opacity = 1);
-    }, com, seg);
+    segment_state[com] |= 1ul << seg;
+    _watch_schedule_display_flush();
 }
 
 void watch_clear_pixel(uint8_t com, uint8_t seg) {
-    EM_ASM({
-        document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
-            .forEach((e) => e.style.opacity = 0);
-    }, com, seg);
+    segment_state[com] &= ~(1ul << seg);
+    _watch_schedule_display_flush();
 }
 
 void watch_clear_display(void) {
-    EM_ASM({
-        document.querySelectorAll("[data-com][data-seg]")
-            .forEach((e) => e.style.opacity = 0);
-    });
+    segment_state[0] = segment_state[1] = segment_state[2] = 0;
+    _watch_schedule_display_flush();
 }
 
 static void watch_invoke_blink_callback(void *userData) {
     blink_state = !blink_state;
     watch_display_character(blink_state ? blink_character : ' ', 7);
     watch_clear_pixel(2, 10); // clear segment B of position 7 since it can't blink
+    // the glass blinks on its own, between passes through the main loop; each blink is a frame of its own.
+    commit_display_frame();
 }
 
 void watch_start_character_blink(char character, uint32_t duration) {
@@ -94,6 +209,7 @@ static void watch_invoke_tick_callback(void *userData) {
         watch_clear_pixel(0, 3);
         watch_set_pixel(0, 2);
     }
+    commit_display_frame();
 }
 
 void watch_start_tick_animation(uint32_t duration) {
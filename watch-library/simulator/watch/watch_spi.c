@@ -23,13 +23,25 @@
  */
 
 #include "watch_spi.h"
+#include "watch_sim_bus.h"
+
+// the virtual bus in watch_sim_bus.c decides which device is listening, from its chip select.
 
 void watch_enable_spi(void) {}
 
 void watch_disable_spi(void) {}
 
-bool watch_spi_write(const uint8_t *buf, uint16_t length) { return false; }
+bool watch_spi_write(const uint8_t *buf, uint16_t length) {
+    watch_sim_bus_spi_transfer(buf, NULL, length);
+    return true;
+}
 
-bool watch_spi_read(uint8_t *buf, uint16_t length) { return false; }
+bool watch_spi_read(uint8_t *buf, uint16_t length) {
+    watch_sim_bus_spi_transfer(NULL, buf, length);
+    return true;
+}
 
-bool watch_spi_transfer(const uint8_t *data_out, uint8_t *data_in, uint16_t length) { return false; }
+bool watch_spi_transfer(const uint8_t *data_out, uint8_t *data_in, uint16_t length) {
+    watch_sim_bus_spi_transfer(data_out, data_in, length);
+    return true;
+}
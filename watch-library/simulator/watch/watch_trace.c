@@ -0,0 +1,283 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "watch.h"
+#include "watch_trace.h"
+#include "watch_main_loop.h"
+#include "watch_sim_bus.h"
+#include "watch_private.h"
+
+#include <emscripten.h>
+
+typedef struct {
+    double time;        // ms since the trace started
+    const char *type;
+    const char *data;   // empty if there's none
+} trace_event_t;
+
+static struct {
+    char *text;         // our copy of the trace; events point into it
+    char *next;         // the line after the event below
+    trace_event_t event;
+    double start;       // the clock when the trace started, in ms since 1970
+    long timeout_id;
+    bool replaying;
+} replay = { .timeout_id = -1 };
+
+static FILE *output;
+// a line for the serial console that movement hasn't read yet.
+static char serial_line[256];
+
+void watch_trace_init(void) {
+    EM_ASM({
+        const elapsed = function() { return Math.round(Module['simulatedNow']() - Module['traceStart']); };
+        Module['trace'] = null;
+        Module['traceEvent'] = function(type, data) {
+            if (Module['trace']) Module['trace'].push(elapsed() + ' ' + type + (data === undefined ? '' : ' ' + data));
+        };
+        // recording (or replaying) a trace also records its output: display frames and buzzer notes.
+        Module['startTraceOutput'] = function(start) {
+            Module['traceStart'] = start;
+            Module['recordDisplay'] = true;
+            Module['displayFrames'] = [];
+            Module['buzzerLog'] = [];
+        };
+        Module['startTraceRecording'] = function() {
+            Module['startTraceOutput'](Module['simulatedNow']());
+            Module['trace'] = ['0 clock ' + Math.round(Module['traceStart'])];
+            Module['_watch_sim_trace_inputs']();
+        };
+        Module['stopTraceRecording'] = function() {
+            if (!Module['trace']) return '';
+            Module['trace'].push(elapsed() + ' end');
+            const text = Module['trace'].join('\n');
+            Module['trace'] = null;
+            Module['recordDisplay'] = false;
+            return text;
+        };
+        Module['replayTrace'] = function(text, callback) {
+            const length = lengthBytesUTF8(text) + 1;
+            const buffer = _malloc(length);
+            stringToUTF8(text, buffer, length);
+            const ok = Module['_watch_trace_replay'](buffer);
+            _free(buffer);
+            if (!ok) throw 'A trace starts with the clock';
+            Module['replayCallback'] = callback;
+        };
+    });
+}
+
+void watch_trace_event(const char *type, const char *data) {
+    EM_ASM({
+        if (Module['trace']) Module['traceEvent'](UTF8ToString($0), $1 ? UTF8ToString($1) : undefined);
+    }, type, data);
+}
+
+static double _watch_trace_elapsed(void) {
+    return watch_sim_bus_now() - replay.start;
+}
+
+// reads the next event into replay.event, skipping anything that isn't one; false at the end of the trace.
+static bool _watch_trace_read_event(void) {
+    while (*replay.next) {
+        char *line = replay.next;
+        char *end = line + strcspn(line, "\n");
+        replay.next = *end ? end + 1 : end;
+        *end = 0;
+        if (end > line && end[-1] == '\r') end[-1] = 0;
+
+        char *type;
+        double time = strtod(line, &type);
+        if (type == line || *type != ' ') continue;
+        type++;
+        char *data = type + strcspn(type, " ");
+        if (*data) *data++ = 0;
+        if (!*type) continue;
+
+        replay.event = (trace_event_t) { .time = time, .type = type, .data = data };
+        return true;
+    }
+    return false;
+}
+
+static void _watch_trace_replay_accelerometer(const char *data) {
+    // three numbers a sample, and each takes at least two characters with its separator.
+    int16_t *samples = malloc((strlen(data) / 2 + 3) * sizeof(int16_t));
+    uint32_t count = 0;
+    char *end;
+
+    if (samples == NULL) return;
+    for (long value = strtol(data, &end, 10); end != data; value = strtol(data, &end, 10)) {
+        samples[count++] = value;
+        data = end;
+    }
+    watch_sim_lis2dw_load_samples(samples, count / 3);
+    free(samples);
+}
+
+static void _watch_trace_replay_event(const trace_event_t *event) {
+    if (strcmp(event->type, "clock") == 0) {
+        simulate_clock(atof(event->data));
+    } else if (strcmp(event->type, "button") == 0) {
+        static const struct { const char *name; uint8_t pin; } buttons[] = {
+            {"alarm", BTN_ALARM}, {"light", BTN_LIGHT}, {"mode", BTN_MODE},
+        };
+        size_t length = strcspn(event->data, " ");
+        bool pressed = strcmp(event->data + length, " down") == 0;
+        for (uint8_t i = 0; i < sizeof(buttons) / sizeof(buttons[0]); i++) {
+            if (strlen(buttons[i].name) == length && strncmp(event->data, buttons[i].name, length) == 0) {
+                simulate_button(buttons[i].pin, pressed);
+            }
+        }
+    } else if (strcmp(event->type, "serial") == 0) {
+        snprintf(serial_line, sizeof(serial_line), "%s\n", event->data);
+        resume_main_loop();
+    } else if (strcmp(event->type, "temperature") == 0) {
+        watch_sim_set_ambient_temperature(atof(event->data));
+    } else if (strcmp(event->type, "accelerometer") == 0) {
+        _watch_trace_replay_accelerometer(event->data);
+    }
+    // anything else (the end of the recording, say) only marks a time.
+}
+
+static void _watch_trace_replay_stop(void) {
+    if (replay.timeout_id != -1) {
+        emscripten_clear_timeout(replay.timeout_id);
+        replay.timeout_id = -1;
+    }
+    free(replay.text);
+    replay.text = NULL;
+    replay.replaying = false;
+}
+
+static void _watch_trace_replay_finish(void) {
+    watch_sim_bus_stats_t i2c = watch_sim_bus_get_stats(WATCH_SIM_BUS_I2C);
+    watch_sim_bus_stats_t spi = watch_sim_bus_get_stats(WATCH_SIM_BUS_SPI);
+
+    _watch_trace_replay_stop();
+    if (output) {
+        fprintf(output, "%.0f ms bus I2C %u transactions %u bytes %u us, SPI %u transactions %u bytes %u us\n",
+                _watch_trace_elapsed(), (unsigned)i2c.transactions, (unsigned)i2c.bytes, (unsigned)i2c.time_us,
+                (unsigned)spi.transactions, (unsigned)spi.bytes, (unsigned)spi.time_us);
+    }
+    EM_ASM({
+        const callback = Module['replayCallback'];
+        Module['replayCallback'] = null;
+        Module['recordDisplay'] = false;
+        if (callback) callback({ frames: Module['displayFrames'], buzzer: Module['buzzerLog'], bus: Module['busStats']() });
+    });
+}
+
+// replays every event that's due, then waits for the clock to reach the next one. the clock can move under us (the
+// page's controls, or a clock event in the trace), so the wait can end early; it just waits again.
+static void _watch_trace_replay_step(void *userData) {
+    replay.timeout_id = -1;
+    while (replay.replaying) {
+        double due = replay.start + replay.event.time;
+        if (watch_sim_bus_now() < due - 0.5) {
+            replay.timeout_id = watch_sim_call_at(due, _watch_trace_replay_step, NULL);
+            return;
+        }
+        _watch_trace_replay_event(&replay.event);
+        if (!_watch_trace_read_event()) _watch_trace_replay_finish();
+    }
+}
+
+EMSCRIPTEN_KEEPALIVE
+bool watch_trace_replay(const char *text) {
+    _watch_trace_replay_stop();
+
+    replay.text = strdup(text);
+    if (replay.text == NULL) return false;
+    replay.next = replay.text;
+    if (!_watch_trace_read_event() || strcmp(replay.event.type, "clock") != 0) {
+        _watch_trace_replay_stop();
+        return false;
+    }
+
+    // the first clock event starts the clock for the trace, whenever it comes; later ones are jumps within it.
+    replay.start = atof(replay.event.data);
+    replay.replaying = true;
+    watch_sim_bus_reset_stats();
+    EM_ASM({ Module['startTraceOutput']($0); }, replay.start);
+    simulate_clock(replay.start);
+    if (!_watch_trace_read_event()) _watch_trace_replay_finish();
+    else _watch_trace_replay_step(NULL);
+
+    return true;
+}
+
+bool watch_trace_is_replaying(void) {
+    return replay.replaying;
+}
+
+void watch_trace_set_output(FILE *file) {
+    output = file;
+}
+
+void watch_trace_display(const uint32_t segments[3]) {
+    if (output == NULL && !EM_ASM_INT({ return Module['recordDisplay'] || Module['printDisplay'] ? 1 : 0; })) return;
+
+    char text[WATCH_TRACE_DISPLAY_TEXT_SIZE];
+    watch_trace_render_display(segments, text);
+    if (output) fprintf(output, "%.0f ms\n%s\n", _watch_trace_elapsed(), text);
+    EM_ASM({
+        // frames carry both the real time and the simulated time (see watch_rtc.c) they were committed at.
+        const now = performance.now();
+        const simulated = Module['simulatedNow'] ? Math.round(Module['simulatedNow']() - (Module['traceStart'] || 0)) : now;
+        const frame = { time: now, simulated: simulated, state: Array.from(HEAPU32.subarray($0 >> 2, ($0 >> 2) + 3)), text: UTF8ToString($1) };
+        if (Module['recordDisplay']) (Module['displayFrames'] = Module['displayFrames'] || []).push(frame);
+        if (Module['printDisplay']) out(frame.simulated + ' ms\n' + frame.text);
+    }, segments, text);
+}
+
+void watch_trace_buzzer(uint32_t frequency) {
+    if (output) {
+        if (frequency) fprintf(output, "%.0f ms buzzer %u Hz\n", _watch_trace_elapsed(), (unsigned)frequency);
+        else fprintf(output, "%.0f ms buzzer off\n", _watch_trace_elapsed());
+    }
+    EM_ASM({
+        if (Module['buzzerLog']) Module['buzzerLog'].push([Math.round(Module['simulatedNow']() - Module['traceStart']), $0]);
+    }, frequency);
+}
+
+// the serial console. a replayed trace leaves its lines above; the page leaves each line typed into it in tx (see
+// shell.html).
+int _read(int file, char *ptr, int len) {
+    int length = strlen(serial_line);
+    if (length) {
+        if (length > len) length = len;
+        memcpy(ptr, serial_line, length);
+        serial_line[0] = 0;
+        return length;
+    }
+    return EM_ASM_INT({
+        if (typeof tx == 'undefined' || !tx) return 0;
+        const length = stringToUTF8(tx, $0, $1);
+        tx = '';
+        return length;
+    }, ptr, len);
+}
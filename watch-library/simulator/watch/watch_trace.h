@@ -0,0 +1,84 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 The Sensor Watch Contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_TRACE_H_INCLUDED
+#define _WATCH_TRACE_H_INCLUDED
+
+// Traces of everything that happens to the simulated watch from the outside, so a session can be replayed later.
+// A trace is plain text, one event per line: milliseconds of simulated time since the trace started, the event type,
+// and its data. The types are:
+//   clock <ms>                  the simulated clock was set to this many ms since 1970 (always the first line)
+//   button <alarm|light|mode> <down|up>
+//   serial <line>               a line typed into the serial console
+//   temperature <°C>            the temperature around the watch (see watch_sim_bus.h)
+//   accelerometer <x y z ...>   a recording loaded for the accelerometer, in milli-g, three numbers a sample
+//   end                         the recording stopped
+// A recording starts with the clock and whatever the sensors are sensing at the time; the flash isn't in it, since it
+// starts out erased and only the watch writes to it, so replaying the rest writes it all again.
+//
+// From the page, Module.startTraceRecording() starts a trace and Module.stopTraceRecording() returns it;
+// Module.replayTrace(text, callback) plays one back and hands the callback the display frames, buzzer notes and bus
+// counts it produced (see watch_slcd.c, watch_buzzer.c and watch_sim_bus.c), so two runs can be compared. Replay
+// follows the simulated clock, not the real one, so it keeps up with the page's time controls; in the host build
+// (see watch-library/host), where the clock is virtual, it comes out the same on every run.
+//
+// A display frame is the display as one pass through the main loop (or one blink) left it, not one paint of the page,
+// and each carries the ASCII art watch_trace_render_display draws for it, so frames can be compared without a page.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/// Room for the text of one display frame: six rows of digits and a row of indicators, with their newlines.
+#define WATCH_TRACE_DISPLAY_TEXT_SIZE 256
+
+/// Sets up the page side of tracing. Called by _watch_init.
+void watch_trace_init(void);
+
+/// Records an event, if a trace is being recorded.
+void watch_trace_event(const char *type, const char *data);
+
+/// Starts replaying a trace (the text is copied), first setting the clock from its first line. Stops any replay
+/// already going. Returns false if the text isn't a trace.
+bool watch_trace_replay(const char *text);
+
+/// Whether a replay is still going.
+bool watch_trace_is_replaying(void);
+
+/// Also writes what the watch does to file, as text: each display frame, each buzzer note, and the bus counts when a
+/// replay finishes, every one after the ms since the trace started. The host build writes its output this way.
+void watch_trace_set_output(FILE *file);
+
+/// Records (or prints) a display frame: the state of every segment, one word per COM. Called by watch_slcd.c.
+void watch_trace_display(const uint32_t segments[3]);
+
+/// Records a buzzer note: its frequency in Hz, or zero when the buzzer goes quiet. Called by watch_buzzer.c.
+void watch_trace_buzzer(uint32_t frequency);
+
+/// Draws a display frame as ASCII art: the top line of digits, then the bottom one, three rows each, then the lit
+/// indicators, if any. text needs WATCH_TRACE_DISPLAY_TEXT_SIZE bytes. Returns the length, without the terminator.
+size_t watch_trace_render_display(const uint32_t segments[3], char *text);
+
+#endif